@@ -15,21 +15,141 @@ using namespace ICommon::P;            using namespace ICollector::P;
 using namespace ICrypt::P;             using namespace ICVarDef::P;
 using namespace IDir::P;               using namespace IError::P;
 using namespace IEvtMain::P;           using namespace IFileMap::P;
-using namespace IFlags::P;             using namespace ILockable::P;
-using namespace ILog::P;               using namespace ILuaIdent::P;
-using namespace ILuaLib::P;            using namespace IPSplit::P;
-using namespace IMemory::P;            using namespace IMutex::P;
-using namespace IName::P;              using namespace ISerial::P;
-using namespace IStd::P;               using namespace IStdLib::P;
-using namespace IString::P;            using namespace ISystem::P;
-using namespace ISysUtil::P;           using namespace IUtf::P;
-using namespace Lib::OS::SevenZip;
+using namespace IFlags::P;             using namespace IJobs::P;
+using namespace ILockable::P;          using namespace ILog::P;
+using namespace ILuaIdent::P;          using namespace ILuaLib::P;
+using namespace IPSplit::P;            using namespace IMemory::P;
+using namespace IMutex::P;             using namespace IName::P;
+using namespace ISerial::P;            using namespace IStd::P;
+using namespace IStdLib::P;            using namespace IString::P;
+using namespace ISystem::P;            using namespace ISysUtil::P;
+using namespace IUtf::P;               using namespace Lib::OS::SevenZip;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
-/* -- Public typedefs ------------------------------------------------------ */
+/* == Decoded solid block cache ============================================ **
+** ######################################################################### **
+** ## When a file is extracted from a solid block, the entire block has   ## **
+** ## to be decompressed. We keep the most recently decoded blocks so     ## **
+** ## that sibling files in the same block can just be copied out.        ## **
+** ######################################################################### **
+** ------------------------------------------------------------------------- */
+class ArchiveCache :                   // Members initially private
+  /* -- Base classes ------------------------------------------------------- */
+  private MutexLock                    // Serialise access to the cache
+{ /* -- Private typedefs --------------------------------------------------- */
+  struct Block                         // Decoded solid block
+  { /* --------------------------------------------------------------------- */
+    const void    *vpArchive;          // Archive the block belongs to
+    unsigned       uBlock;             // Block index in the archive
+    Memory         mData;              // Decoded block data
+  };/* --------------------------------------------------------------------- */
+  using BlockList   = StdList<Block>;  // Blocks (most recently used first)
+  using BlockListIt = BlockList::iterator; // Iterator to a block
+  /* -- Private variables -------------------------------------------------- */
+  BlockList        blBlocks;           // Cached blocks
+  size_t           stBudget,           // Maximum bytes to cache
+                   stBytes;            // Bytes currently cached
+  AtomicSizeT      astHits,            // Files copied from cached blocks
+                   astMisses,          // Files not in cached blocks
+                   astEvicted;         // Blocks evicted from the cache
+  /* -- Find a block ------------------------------------------------------- */
+  BlockListIt ArchiveCacheFindUnsafe(const void*const vpArchive,
+    const unsigned uBlock)
+  { return StdFindIf(seq, blBlocks.begin(), blBlocks.end(),
+      [vpArchive, uBlock](const Block &bItem)
+        { return bItem.vpArchive == vpArchive && bItem.uBlock == uBlock; }); }
+  /* -- Evict least recently used blocks until 'stLimit' bytes remain ------ */
+  void ArchiveCacheTrimUnsafe(const size_t stLimit)
+  { // Until we are under the limit, remove the oldest block
+    while(stBytes > stLimit)
+    { // Remove the oldest block
+      stBytes -= blBlocks.back().mData.MemSize();
+      blBlocks.pop_back();
+      ++astEvicted;
+    }
+  }
+  /* -- Copy a file from a cached block (false if not cached) ------ */ public:
+  bool ArchiveCacheGet(const void*const vpArchive, const unsigned uBlock,
+    const size_t stOffset, const size_t stSize, Memory &mOut)
+  { // Lock the cache
+    return MutexCall([this, vpArchive, uBlock, stOffset, stSize, &mOut](){
+      // Find the block and return if not found
+      const BlockListIt bliIt{ ArchiveCacheFindUnsafe(vpArchive, uBlock) };
+      if(bliIt == blBlocks.end()) { ++astMisses; return false; }
+      // Block is now the most recently used
+      blBlocks.splice(blBlocks.begin(), blBlocks, bliIt);
+      // Copy the file out of the block while the block can't be evicted
+      mOut = Memory{ stSize, bliIt->mData.MemRead(stOffset, stSize) };
+      ++astHits;
+      // Success
+      return true;
+    });
+  }
+  /* -- Add a decoded block ------------------------------------------------ */
+  void ArchiveCacheAdd(const void*const vpArchive, const unsigned uBlock,
+    Memory &&mData)
+  { // Lock the cache
+    MutexCall([this, vpArchive, uBlock, &mData](){
+      // Ignore if the block can never fit or another thread already decoded
+      // and added the same block.
+      if(mData.MemSize() > stBudget ||
+         ArchiveCacheFindUnsafe(vpArchive, uBlock) != blBlocks.end()) return;
+      // Make room for the block
+      ArchiveCacheTrimUnsafe(stBudget - mData.MemSize());
+      // Add the block as the most recently used
+      stBytes += mData.MemSize();
+      blBlocks.push_front({ vpArchive, uBlock, StdMove(mData) });
+    });
+  }
+  /* -- Remove all blocks belonging to an archive -------------------------- */
+  void ArchiveCachePurge(const void*const vpArchive)
+  { // Lock the cache
+    MutexCall([this, vpArchive](){
+      // Remove blocks belonging to the archive
+      blBlocks.remove_if([this, vpArchive](const Block &bItem){
+        // Ignore if not the archive
+        if(bItem.vpArchive != vpArchive) return false;
+        // Remove the block
+        stBytes -= bItem.mData.MemSize();
+        return true;
+      });
+    });
+  }
+  /* -- Return counters ---------------------------------------------------- */
+  size_t ArchiveCacheGetBlocks()
+    { return MutexCall([this](){ return blBlocks.size(); }); }
+  size_t ArchiveCacheGetBytes()
+    { return MutexCall([this](){ return stBytes; }); }
+  size_t ArchiveCacheGetBudget() const { return stBudget; }
+  size_t ArchiveCacheGetHits() const { return astHits; }
+  size_t ArchiveCacheGetMisses() const { return astMisses; }
+  size_t ArchiveCacheGetEvicted() const { return astEvicted; }
+  /* -- Set maximum bytes to cache ----------------------------------------- */
+  CVarReturn ArchiveCacheSetBudget(const size_t stNBudget)
+  { // Lock the cache
+    return MutexCall([this, stNBudget](){
+      // Set the new budget and evict blocks that no longer fit
+      stBudget = stNBudget;
+      ArchiveCacheTrimUnsafe(stBudget);
+      // Success
+      return ACCEPT;
+    });
+  }
+  /* -- Constructor -------------------------------------------------------- */
+  ArchiveCache() :
+    /* -- Initialisers ----------------------------------------------------- */
+    stBudget(0),                       // Initialise maximum bytes to cache
+    stBytes(0),                        // Initialise bytes cached
+    astHits{ 0 },                      // Initialise cache hits
+    astMisses{ 0 },                    // Initialise cache misses
+    astEvicted{ 0 }                    // Initialise evicted blocks
+    /* -- No code ---------------------------------------------------------- */
+    {}
+};/* -- Public typedefs ---------------------------------------------------- */
 CTOR_BEGIN_ASYNC(Archives, Archive, CLHelperSafe,
   /* ----------------------------------------------------------------------- */
   StdString        strArchiveExt;      // Archive extension
+  ArchiveCache     acBlocks;           // Decoded solid block cache
   size_t           stExtractBufSize;   // Extract buffer size
   ISzAlloc         isaData;            // Allocator functions
   /* -- Alloc function for lzma -------------------------------------------- */
@@ -54,7 +174,19 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
   private MutexLock,                   // Mutex for condition variable
   private condition_variable           // Waiting for async ops to complete
 { /* -- Private Variables -------------------------------------------------- */
-  AtomicSizeT      astInUse;           // API in use reference count
+  AtomicSizeT      astInUse;           // Readers in use reference count
+  /* ----------------------------------------------------------------------- */
+  struct ArchiveReader                 // An opened archive file handle
+  { /* --------------------------------------------------------------------- */
+    CFileInStream  cfisData;           // LZMA file stream data
+    CLookToRead2   cltrData;           // LZMA lookup data
+  };/* --------------------------------------------------------------------- */
+  using ArchiveReaders    = StdList<ArchiveReader>;    // Extra readers
+  using ArchiveReaderPtrs = StdVector<ArchiveReader*>; // Idle readers
+  /* ----------------------------------------------------------------------- */
+  ArchiveReader    arBase;             // Reader that loaded the archive
+  ArchiveReaders   arsExtra;           // Readers opened when base was busy
+  ArchiveReaderPtrs arpsIdle;          // Readers not in use
   /* ----------------------------------------------------------------------- */
   StrUIntMap       suimFiles,          // Files and directories as a map means
                    suimDirs;           // quick access to assets via filenames
@@ -63,9 +195,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
                           suimcivDirs; // 0-indexed directories in the archive
   /* ----------------------------------------------------------------------- */
   uint64_t         ullArchPos;         // Position of archive in file
-  CFileInStream    cfisData;           // LZMA file stream data
-  CLookToRead2     cltrData;           // LZMA lookup data
-  CSzArEx          csaeData;           // LZMA archive Data
+  CSzArEx          csaeData;           // LZMA archive Data (shared)
   /* ----------------------------------------------------------------------- */
 #if defined(WINDOWS)                   // Using Windows?
   /* -- Open a stream ------------------------------------------------------ */
@@ -87,7 +217,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
 #endif                                 // Operating system check
   /* -- Process extracted data --------------------------------------------- */
   FileMap ArchiveExtract(const StdStringView &ssvFile, const unsigned uSrcId,
-    CLookToRead2 &cltrRef, CSzArEx &csaeRef)
+    CLookToRead2 &cltrRef)
   { // Storage for buffer
     unsigned char *ucpData = nullptr;
     // Capture exceptions so we can clean up
@@ -102,7 +232,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
       unsigned uBlockIndex = StdMaxUInt;
       // Decompress the buffer using our base handles and throw error if it
       // failed
-      if(const int iCode = SzArEx_Extract(&csaeRef, &cltrRef.vt, uSrcId,
+      if(const int iCode = SzArEx_Extract(&csaeData, &cltrRef.vt, uSrcId,
          &uBlockIndex, &ucpData, &stUncompressed, &stOffset, &stCompressed,
          &cParent->isaData, &cParent->isaData))
         XC("Failed to extract file",
@@ -139,8 +269,11 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
       // but there is really no need to deny this kind of loading.
       Memory mData{ stCompressed,
         reinterpret_cast<void*>(ucpData + stOffset) };
-      // Free the data that was allocated by LZMA as we had to copy it
-      cParent->isaData.Free(nullptr, reinterpret_cast<void*>(ucpData));
+      // Give the decoded block to the cache so sibling files in the same block
+      // do not need to be decoded again. The cache frees it if it won't fit.
+      Memory mBlock{ stUncompressed, reinterpret_cast<void*>(ucpData), true };
+      ucpData = nullptr;
+      cParent->acBlocks.ArchiveCacheAdd(this, uBlockIndex, StdMove(mBlock));
       // Return newly added item
       FileMap fmFile{ ssvFile, StdMove(mData), ArchiveGetCreatedTime(uSrcId),
         ArchiveGetModifiedTime(uSrcId) };
@@ -159,7 +292,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
   }
   /* -- Free the decopmression buffer if it was created -------------------- */
   void ArchiveCleanupLookToRead(CLookToRead2 &cltrRef)
-    { if(cltrData.buf) ISzAlloc_Free(&cParent->isaData, cltrRef.buf); }
+    { if(cltrRef.buf) ISzAlloc_Free(&cParent->isaData, cltrRef.buf); }
   /* -- Initialise Look2Read structs --------------------------------------- */
   void ArchiveSetupLookToRead(CFileInStream &cfisRef, CLookToRead2 &cltrRef)
   { // Setup vtables and stream pointers
@@ -169,7 +302,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
     // Need to allocate transfer buffer in later LZMA.
     cltrRef.buf = reinterpret_cast<Byte*>
       (ISzAlloc_Alloc(&cParent->isaData, cParent->stExtractBufSize));
-    if(!cltrData.buf)
+    if(!cltrRef.buf)
       XC("Error allocating buffer for archive!",
         "Archive", NameGet(), "Bytes", cParent->stExtractBufSize);
     cltrRef.bufSize = cParent->stExtractBufSize;
@@ -177,6 +310,83 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
     // done for us.
     LookToRead2_INIT(&cltrRef)
   }
+  /* -- Open an extra reader ----------------------------------------------- */
+  void ArchiveReaderOpen(ArchiveReader &arReader)
+  { // Open new archive handle and throw error if it failed. We don't need to
+    // seek to the archive position as the extractor always seeks to the
+    // absolute position of the data it needs.
+    if(const int iCode = ArchiveOpenFile(&arReader.cfisData.file))
+      XCS("Failed to open archive!", "Archive", NameGet(), "Code", iCode);
+    // Setup look to read structs and close the file if it failed
+    try { ArchiveSetupLookToRead(arReader.cfisData, arReader.cltrData); }
+    catch(const StdException &)
+      { File_Close(&arReader.cfisData.file); throw; }
+  }
+  /* -- Close a reader ----------------------------------------------------- */
+  void ArchiveReaderClose(ArchiveReader &arReader)
+  { // Free the look to read buffer and close archive handle
+    ArchiveCleanupLookToRead(arReader.cltrData);
+    if(File_Close(&arReader.cfisData.file))
+      cLog->LogWarningExSafe("Archive failed to close archive '$': $!",
+        NameGet(), SysError());
+  }
+  /* -- Take an idle reader or open a new one ------------------------------ */
+  ArchiveReader &ArchiveReaderAcquire()
+  { // Lock the readers list
+    return MutexUniqueCall([this](UniqueLock &ulLock)->ArchiveReader&{
+      // Because the 7-zip API doesn't support sharing file handles, each
+      // thread needs its own handle. Only open as many as there are threads
+      // that can extract at the same time (the workers and the engine
+      // thread). Otherwise wait for another thread to release one.
+      wait(ulLock, [this]{ return !arpsIdle.empty() ||
+        arsExtra.size() < cJobs->JobsGetWorkersTarget(); });
+      // Reader is now in use. This tells the destructor to wait until all the
+      // readers are released.
+      ++astInUse;
+      // Have an idle reader? Take it
+      if(!arpsIdle.empty())
+      { // Take the reader
+        ArchiveReader &arReader = *arpsIdle.back();
+        arpsIdle.pop_back();
+        // Return the reader
+        return arReader;
+      } // Open a new reader and remove it if it failed
+      ArchiveReader &arReader = arsExtra.emplace_back();
+      try { ArchiveReaderOpen(arReader); }
+      catch(const StdException &)
+        { arsExtra.pop_back(); --astInUse; throw; }
+      // Log the new reader
+      cLog->LogDebugExSafe("Archive '$' opened reader #$.",
+        NameGet(), arsExtra.size());
+      // Return the reader
+      return arReader;
+    });
+  }
+  /* -- Return a reader to the idle list ----------------------------------- */
+  void ArchiveReaderRelease(ArchiveReader &arReader)
+  { // Lock the readers list and return the reader
+    MutexCall([this, &arReader](){
+      arpsIdle.push_back(&arReader);
+      --astInUse;
+    });
+    // Wake any thread waiting for a reader or the destructor
+    notify_all();
+  }
+  /* -- Get solid block index and offset of a file (false if not solid) ---- */
+  bool ArchiveGetBlockInfo(const unsigned uSrcId, unsigned &uBlock,
+    size_t &stOffset) const
+  { // Get block the file is in and return if it has none (empty file)
+    uBlock = csaeData.FileToFolder[uSrcId];
+    if(uBlock == StdMaxUInt) return false;
+    // Get first file in the block and return if the block only has one file
+    const unsigned uFirst = csaeData.FolderToFile[uBlock];
+    if(csaeData.FolderToFile[uBlock + 1] - uFirst <= 1) return false;
+    // Get offset of the file inside the decoded block
+    stOffset = static_cast<size_t>(csaeData.UnpackPositions[uSrcId] -
+      csaeData.UnpackPositions[uFirst]);
+    // Success
+    return true;
+  }
   /* -- Get creation/modification time helper ------------------------------ */
   StdTimeT ArchiveSzTimeToStdTime(const size_t stId,
     const CSzBitUi64s &csbuTime) const
@@ -215,8 +425,9 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
     { return suimcivFiles[stIndex]; }
   const StrUIntMapConstIt &ArchiveGetDir(const size_t stIndex) const
     { return suimcivDirs[stIndex]; }
-  /* -- Return number of extra archives opened ----------------------------- */
+  /* -- Return number of readers in use and extra readers opened ----------- */
   size_t ArchiveGetInUse() const { return astInUse; }
+  size_t ArchiveGetReaders() const { return arsExtra.size(); }
   /* -- Return if iterator is valid ---------------------------------------- */
   bool ArchiveIsFileIteratorValid(const StrUIntMapConstIt &suimciIt) const
     { return suimciIt != suimFiles.cend(); }
@@ -225,85 +436,35 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
     { return suimFiles.find(ssvFile); }
   /* -- Loads a file from archive by iterator ------------------------------ */
   FileMap ArchiveExtract(const StrUIntMapConstIt &suimciIt)
-  { // Lock mutex. We don't care if we can't lock it though because we will
-    // open another archive if we cannot lock it.
-    return MutexUniqueCall([this, &suimciIt](UniqueLock &ulLock){
-      // Create class to notify destructor when leaving this scope
-      const class Notify { public: Archive &aRef;
-        explicit Notify(Archive &aNRef) : aRef(aNRef) {}
-        ~Notify() { aRef.notify_one(); } } cNotify(*this);
-      // Get filename and filename id from iterator
-      const StdString &strFile = suimciIt->first;
-      const unsigned &uSrcId = suimciIt->second;
-      // If the base archive file is in use?
-      if(!ulLock.owns_lock())
-      { // We need to adjust in-use counter when joining and leaving this scope
-        // This tells the destructor to wait until it is zero.
-        const class Counter { public: Archive &aRef;
-          explicit Counter(Archive &aNRef) : aRef(aNRef) { ++aRef.astInUse; }
-          ~Counter() { --aRef.astInUse; } } cCounter(*this);
-        // Because the API doesn't support sharing file handles, we will need
-        // to re-open the archive again with new data. We don't need to collect
-        // any filename data again though thankfully so this should still be
-        // quite a speedy process.
-        CFileInStream cfisData2{};
-        CSzArEx csaeData2{};
-        CLookToRead2 cltrData2{};
-        // Capture exceptions so we can clean up 7zip api
-        try
-        { // Open new archive and throw error if it failed
-          if(const int iCode = ArchiveOpenFile(&cfisData2.file))
-            XC("Failed to open archive!",
-              "Archive", NameGet(),      "Index", suimciIt->second,
-              "File",    suimciIt->first, "Code",  iCode,
-              "Reason",  CodecGetLzmaErrString(iCode));
-          // Custom start position specified
-          if(ullArchPos > 0 &&
-             cSystem->SeekFile(ArchiveCFISToOSHandle(cfisData),
-               ullArchPos) != ullArchPos)
-            XC("Failed to seek in archive!",
-              "Archive", NameGet(),      "Index",    suimciIt->second,
-              "File",    suimciIt->first, "Position", ullArchPos);
-          // Load archive
-          ArchiveSetupLookToRead(cfisData2, cltrData2);
-          // Init lzma data
-          SzArEx_Init(&csaeData2);
-          // Initialise archive database and if failed, just log it
-          if(const int iCode = SzArEx_Open(&csaeData2,
-            &cltrData2.vt, &cParent->isaData, &cParent->isaData))
-              XC("Failed to load archive!",
-                "Archive", NameGet(),      "Index", suimciIt->second,
-                "File",    suimciIt->first, "Code",  iCode,
-                "Reason",  CodecGetLzmaErrString(iCode));
-          // Decompress the buffer using our duplicated handles
-          FileMap fmFile{
-            ArchiveExtract(strFile, uSrcId, cltrData2, csaeData2) };
-          // Clean up look to read
-          ArchiveCleanupLookToRead(cltrData2);
-          // Free memory
-          SzArEx_Free(&csaeData2, &cParent->isaData);
-          // Close archive
-          if(File_Close(&cfisData2.file))
-            cLog->LogWarningExSafe("Archive failed to close archive '$': $!",
-              NameGet(), SysError());
-          // Done
-          return fmFile;
-        } // exception occured
-        catch(const StdException &)
-        { // Clean up look to read
-          ArchiveCleanupLookToRead(cltrData2);
-          // Free memory
-          SzArEx_Free(&csaeData2, &cParent->isaData);
-          // Close archive
-          if(File_Close(&cfisData2.file))
-            cLog->LogWarningExSafe("Archive failed to close archive '$': $!",
-              NameGet(), SysError());
-          // Show new exception for plain error message
-          throw;
-        } // Extract block
-      } // Extract and return decompressed file
-      else return ArchiveExtract(strFile, uSrcId, cltrData, csaeData);
-    }, try_to_lock);
+  { // Get filename and filename id from iterator
+    const StdString &strFile = suimciIt->first;
+    const unsigned &uSrcId = suimciIt->second;
+    // If the file is in a solid block that was recently decoded then we can
+    // just copy it from the cache.
+    unsigned uBlock;
+    size_t stOffset;
+    if(ArchiveGetBlockInfo(uSrcId, uBlock, stOffset))
+    { // Copy the file from the cache and if succeeded?
+      const size_t stSize = static_cast<size_t>(ArchiveGetSize(uSrcId));
+      Memory mData;
+      if(cParent->acBlocks.ArchiveCacheGet(this, uBlock, stOffset, stSize,
+        mData))
+      { // Log progress
+        cLog->LogInfoExSafe("Archive extracted '$'[$]{$} from '$' (cached).",
+          strFile, uBlock, stSize, NameGet());
+        // Return file
+        return { strFile, StdMove(mData), ArchiveGetCreatedTime(uSrcId),
+          ArchiveGetModifiedTime(uSrcId) };
+      }
+    } // Take a reader and make sure it is returned when leaving this scope
+    ArchiveReader &arReader = ArchiveReaderAcquire();
+    const class Release { public: Archive &aRef; ArchiveReader &arRef;
+      Release(Archive &aNRef, ArchiveReader &arNRef) :
+        aRef(aNRef), arRef(arNRef) {}
+      ~Release() { aRef.ArchiveReaderRelease(arRef); } }
+        rRelease(*this, arReader);
+    // Extract and return decompressed file
+    return ArchiveExtract(strFile, uSrcId, arReader.cltrData);
   }
   /* -- Loads a file from archive by filename ------------------------------ */
   FileMap ArchiveExtract(const StdStringView &ssvFile)
@@ -319,7 +480,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
   /* -- Loads the specified archive ---------------------------------------- */
   void AsyncReady(FileMap &)
   { // Open archive and throw and show errno if it failed
-    if(const int iCode = ArchiveOpenFile(&cfisData.file))
+    if(const int iCode = ArchiveOpenFile(&arBase.cfisData.file))
       XCS("Error opening archive!", "Archive", NameGet(), "Code", iCode);
     FlagSet(AE_FILEOPENED);
     // Custom start position specified?
@@ -328,23 +489,25 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
       cLog->LogDebugExSafe("Archive loading '$' from position $...",
         NameGet(), ullArchPos);
       // Seek to overlay in executable + 1 and if failed? Log the warning
-      if(cSystem->SeekFile(ArchiveCFISToOSHandle(cfisData),
+      if(cSystem->SeekFile(ArchiveCFISToOSHandle(arBase.cfisData),
            ullArchPos) != ullArchPos)
         cLog->LogWarningExSafe("Archive '$' seek error! [$].",
           NameGet(), SysError());
     } // Load from beginning? Log that we're loading from beginning
     else cLog->LogDebugExSafe("Archive loading '$'...", NameGet());
     // Setup look to read structs
-    ArchiveSetupLookToRead(cfisData, cltrData);
+    ArchiveSetupLookToRead(arBase.cfisData, arBase.cltrData);
     FlagSet(AE_SETUPL2R);
     // Init lzma data
     SzArEx_Init(&csaeData);
     FlagSet(AE_ARCHIVEINIT);
     // Initialise archive database and if failed, just log it
-    if(const int iCode = SzArEx_Open(&csaeData, &cltrData.vt,
+    if(const int iCode = SzArEx_Open(&csaeData, &arBase.cltrData.vt,
        &cParent->isaData, &cParent->isaData))
       return cLog->LogWarningExSafe("Archive '$' not opened with code $ ($)!",
         NameGet(), iCode, CodecGetLzmaErrString(iCode));
+    // The base reader can now be used for extraction
+    arpsIdle.push_back(&arBase);
     // Alocate memory for quick access via index vector. 7-zip won't tell us
     // how many files and directories there are individually so we'll reserve
     // memory for the maximum amount of entries in the 7-zip file. We'll shrink
@@ -410,12 +573,11 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
     ICHelperArchive{ cArchives },      // Initialise collector with this obj
     SerialSlave{ cParent->Serial() },  // Initialise identification number
     AsyncLoaderArchive{ this,          // Initialise async collector
-      EMC_MP_ARCHIVE },                // " our archive async event
+      EMC_MP_ARCHIVE, JP_BULK },       // " our archive event and priority
     ArchiveFlags{ AE_STANDBY },        // Set default archive flags
     astInUse(0),                       // Set threads in use
     ullArchPos(0),                     // Set archive initial position
-    cfisData{},                        // Clear file stream data
-    cltrData{},                        // Clear lookup stream data
+    arBase{},                          // Clear base reader data
     csaeData{}                         // Clear archive stream data
     /* -- No code ---------------------------------------------------------- */
     {}
@@ -437,12 +599,16 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
       // Wait for base and spawned file operations to finish
       MutexUniqueCall([this](UniqueLock &ulLock){
         wait(ulLock, [this]{ return !astInUse; }); });
-    } // Free archive structs if allocated
+    } // Remove any decoded blocks from the cache
+    cParent->acBlocks.ArchiveCachePurge(this);
+    // Close extra readers
+    for(ArchiveReader &arReader : arsExtra) ArchiveReaderClose(arReader);
+    // Free archive structs if allocated
     if(FlagIsSet(AE_ARCHIVEINIT)) SzArEx_Free(&csaeData, &cParent->isaData);
     // Memory allocated? Free memory allocated for buffer
-    if(FlagIsSet(AE_SETUPL2R)) ArchiveCleanupLookToRead(cltrData);
+    if(FlagIsSet(AE_SETUPL2R)) ArchiveCleanupLookToRead(arBase.cltrData);
     // Close archive handle
-    if(File_Close(&cfisData.file))
+    if(File_Close(&arBase.cfisData.file))
       cLog->LogWarningExSafe("Archive failed to close archive '$': $!",
         NameGet(), SysError());
     // Log shutdown
@@ -474,6 +640,9 @@ static Archive *ArchiveInitNew(const StdString &strFile, const size_t stSize=0)
   return !apClass->ArchiveGetFileList().empty() ||
     !apClass->ArchiveGetDirList().empty() ? apClass.release() : nullptr;
 }
+/* -- Set decoded solid block cache size ----------------------------------- */
+static CVarReturn ArchiveSetCacheSize(const size_t stSize)
+  { return cArchives->acBlocks.ArchiveCacheSetBudget(stSize); }
 /* -- Set extraction buffer size ------------------------------------------- */
 static CVarReturn ArchiveSetBufferSize(const size_t stSize)
   { return CVarSimpleSetIntNLG(cArchives->stExtractBufSize, stSize,
@@ -15,11 +15,12 @@ using namespace ICodec::P;             using namespace ICommon::P;
 using namespace ICollector::P;         using namespace ICVarDef::P;
 using namespace IDir::P;               using namespace IError::P;
 using namespace IEvtMain::P;           using namespace IFlags::P;
-using namespace ILockable::P;          using namespace ILog::P;
-using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace IMemory::P;            using namespace IName::P;
-using namespace ISerial::P;            using namespace IStd::P;
-using namespace IString::P;            using namespace ISysUtil::P;
+using namespace IJobs::P;              using namespace ILockable::P;
+using namespace ILog::P;               using namespace ILuaIdent::P;
+using namespace ILuaLib::P;            using namespace IMemory::P;
+using namespace IName::P;              using namespace ISerial::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISysUtil::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Public typedefs ------------------------------------------------------ */
@@ -264,7 +265,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Assets, Asset, ICHelperUnsafe),
     ICHelperAsset{ cAssets },          // Initially unregistered
     SerialSlave{ cParent->Serial() },  // Initialise identification number
     AsyncLoaderAsset{ this,            // Initialise async class with this
-      EMC_MP_ASSET },                  // ...and the event id for it.
+      EMC_MP_ASSET, JP_BULK },         // ...and the event id and priority.
     AssetFlags{ CD_NONE }              // Np asset load flags initially
     /* -- No code ---------------------------------------------------------- */
     {}
@@ -37,14 +37,14 @@ namespace IASync {                     // Start of private module namespace
 using namespace IAsset::P;             using namespace IClock::P;
 using namespace IChrono::P;            using namespace ICollector::P;
 using namespace IError::P;             using namespace IEvtMain::P;
-using namespace IFileMap::P;           using namespace ILog::P;
-using namespace ILuaBase::P;           using namespace ILuaEvt::P;
-using namespace ILuaUtil::P;           using namespace IMemory::P;
-using namespace IName::P;              using namespace IRefCtr::P;
+using namespace IFileMap::P;           using namespace IJobs::P;
+using namespace ILog::P;               using namespace ILuaBase::P;
+using namespace ILuaEvt::P;            using namespace ILuaUtil::P;
+using namespace IMemory::P;            using namespace IName::P;
+using namespace IProfile::P;           using namespace IRefCtr::P;
 using namespace IStd::P;               using namespace IString::P;
 using namespace ITime::P;              using namespace ISysPipe::P;
 using namespace ISystem::P;            using namespace ISysUtil::P;
-using namespace IThread::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* ------------------------------------------------------------------------- */
@@ -91,7 +91,7 @@ template<class MemberType, class ColType>class AsyncLoader :
   EvtMainCmd       emcAsyncCmd;        // Event command to fire on load
   /* -- Private variables -------------------------------------------------- */
   LuaEvtCallback   lecAsync;           // Async state and references
-  Thread           tAsyncThread;       // Asynchronous loading
+  Job              jAsyncJob;          // Asynchronous loading job
   StdString        strAsyncError;      // The last error exception
   ASyncCmdType     asctAsyncType;      // Async load init type
   AtomicUnsigned   auAsyncPid;         // Pid of executing process
@@ -106,15 +106,14 @@ template<class MemberType, class ColType>class AsyncLoader :
   /* -- Send completion ---------------------------------------------------- */
   void AsyncCompletion()
   { // Dispatch the result of the asynchronous event. Send a cancel instead if
-    // the thread wants to terminate.
-    AsyncCompletionDispatch(tAsyncThread.ThreadShouldExit() ?
+    // the job wants to terminate.
+    AsyncCompletionDispatch(jAsyncJob.JobShouldExit() ?
       AR_ABORT : AR_SUCCESS);
   }
   /* -- Send completion ---------------------------------------------------- */
   void AsyncCompletionWithParam(const int64_t llParam)
-  { // If thread was asked to abort? Dispatch the asynchronous event and return
-    if(tAsyncThread.ThreadShouldExit())
-      return AsyncCompletionDispatch(AR_ABORT);
+  { // If job was asked to abort? Dispatch the asynchronous event and return
+    if(jAsyncJob.JobShouldExit()) return AsyncCompletionDispatch(AR_ABORT);
     // Dispatch the asynchronous event with parameter. Unforunately we have to
     // cast any value we get into int64 because we read as int64 at the event
     // handling routine, unless we send a type as well which probably isn't
@@ -148,7 +147,7 @@ template<class MemberType, class ColType>class AsyncLoader :
   }
   /* ----------------------------------------------------------------------- */
   void AsyncCleanup()
-  { // Wait for thread to finish if not already
+  { // Wait for job to finish if not already
     AsyncStop();
     // Clear Lua stack string and recover memory as we are done with it. If
     // the member class wants to reuse this string now they can.
@@ -160,9 +159,8 @@ template<class MemberType, class ColType>class AsyncLoader :
     // Clear references and state or Lua's GC won't ever delete the class
     lecAsync.LuaRefDeInit();
   }
-  /* -- Get thread ---------------------------------------------- */ protected:
-  bool AsyncThreadIsCurrent() const
-    { return tAsyncThread.ThreadIsCurrent(); }
+  /* -- Get if job is running in this thread --------------------- */ protected:
+  bool AsyncThreadIsCurrent() const { return jAsyncJob.JobIsCurrent(); }
   /* -- Prepend message to the full stack message -------------------------- */
   void AsyncDoAddStackMessage(const char*const cpMsg)
     { strAsyncError.insert(0, cpMsg); }
@@ -191,7 +189,7 @@ template<class MemberType, class ColType>class AsyncLoader :
       // If we are writing more than one page? Copy full pages of buffers
       // until we are left with remainders.
       if(stExtra > stBuffer)
-        while(stPosition < stEnd && tAsyncThread.ThreadShouldNotExit())
+        while(stPosition < stEnd && jAsyncJob.JobShouldNotExit())
           AsyncWriteToPipe(spProcess, stPosition, stBuffer);
       // If theres remainder to write then write that too.
       if(stExtra) AsyncWriteToPipe(spProcess, stPosition, stExtra);
@@ -206,8 +204,8 @@ template<class MemberType, class ColType>class AsyncLoader :
     } // List of output
     MemoryList mlBlocks;
     size_t stTotalRead = 0;
-    // Until the thread says we should exit
-    while(tAsyncThread.ThreadShouldNotExit())
+    // Until the job says we should exit
+    while(jAsyncJob.JobShouldNotExit())
     { // Read process output and break out of loop if nothing read
       Memory mBuffer{ spProcess.ReadBlock(stBuffer) };
       if(mBuffer.MemIsEmpty()) break;
@@ -262,9 +260,11 @@ template<class MemberType, class ColType>class AsyncLoader :
   void AsyncParseFile()
     { FileMap fmData{ AssetExtract(NameGet()) };
       AsyncParseFileMap(fmData); }
-  /* -- Async off-main thread function ------------------------------------- */
-  ThreadStatus AsyncThreadMain(Thread&)
-  { // Capture exceptions. Remember that after these operations the memory at
+  /* -- Async off-main thread function (called by a worker) ---------------- */
+  void AsyncJobMain(Job&)
+  { // Record time spent loading
+    const ProfileZone pzZone{ "AsyncJobMain" };
+    // Capture exceptions. Remember that after these operations the memory at
     // mAsyncLoadData should be de-initialised. So don't use it again.
     try
     { // How are we loading?
@@ -298,8 +298,7 @@ template<class MemberType, class ColType>class AsyncLoader :
         } // Unknown asset load type
         default: XC("Internal error: Unknown asset load type!",
           "Type", asctAsyncType);
-      } // Return success to thread manager
-      return TS_OK;
+      }
     } // exception occured?
     catch(const StdException &eReason)
     { // Prepend the reason incase there are nested exceptions
@@ -307,9 +306,7 @@ template<class MemberType, class ColType>class AsyncLoader :
       // Signal completion
       AsyncCompletionDispatch(AR_ERROR);
       // Report error in log
-      cLog->LogErrorExSafe("(ASYNCLOADER THREAD EXCEPTION) $", strAsyncError);
-      // Return failure to thread manager
-      return TS_ERROR;
+      cLog->LogErrorExSafe("(ASYNCLOADER JOB EXCEPTION) $", strAsyncError);
     }
   }
   /* ----------------------------------------------------------------------- */
@@ -322,18 +319,18 @@ template<class MemberType, class ColType>class AsyncLoader :
     // Save the current stack because if an error occurs asynchronously, the
     // event subsystem executes the callback and will be empty.
     strAsyncError = StdMove(LuaUtilStack(lsS));
-    // Begin async thread
-    tAsyncThread.ThreadInit(
-      StrAppend(ssvLabel, ':', mtAsyncOwner.Serial()),
-      bind(&AsyncLoader<MemberType, ColType>::AsyncThreadMain, this, _1),
-        this);
+    // Log the job
+    cLog->LogDebugExSafe("AsyncLoader queued $:$ for '$'.",
+      ssvLabel, mtAsyncOwner.Serial(), ssvIdent);
+    // Queue the job in the worker pool
+    cJobs->JobsQueue(jAsyncJob);
   }
   /* ----------------------------------------------------------------------- */
   void AsyncStop()
   { // If a pid is set then we need to kill it
     if(auAsyncPid) { cSystem->TerminatePid(auAsyncPid); auAsyncPid = 0; }
-    // Wait for thread to terminate
-    tAsyncThread.ThreadDeInit();
+    // Remove the job from the queue or wait for it to finish
+    cJobs->JobsStop(jAsyncJob);
   }
   /* -- Push generic error handler ----------------------------------------- */
   int AsyncPushErrorHandler() const
@@ -384,7 +381,7 @@ template<class MemberType, class ColType>class AsyncLoader :
   /* -- Async do protected call dispatams already pushed onto lua stack) --- */
   void AsyncDoFinishLuaProtectedDispatch(const EvtMainEvent &emeEvent,
     const int iParam, const int iHandler)
-  { // Wait for the thread to stop
+  { // Wait for the job to stop
     AsyncStop();
     // Register the class from the requested collector type
     static_cast<ColType&>(mtAsyncOwner).CollectorRegister();
@@ -393,10 +390,10 @@ template<class MemberType, class ColType>class AsyncLoader :
     AsyncDoLuaProtectedDispatch(emeEvent, iParam, iHandler);
   }
   /* --------------------------------------------------------------- */ public:
-  void AsyncWait() { tAsyncThread.ThreadWait(); }
+  void AsyncWait() { cJobs->JobsWait(jAsyncJob); }
   /* ----------------------------------------------------------------------- */
   void AsyncCancel()
-  { // Wait for the thread to stop
+  { // Dequeue the job or wait for it to stop
     AsyncStop();
     // Dereference the class
     lecAsync.LuaEvtDeInit();
@@ -582,7 +579,7 @@ template<class MemberType, class ColType>class AsyncLoader :
           break;
         } // If there was an error?
         case AR_ERROR:
-        { // Wait for the thread to stop
+        { // Wait for the job to stop
           AsyncStop();
           // Push the error callback and if succeeded?
           AsyncDoLuaThrowErrorHandler(emeEvent);
@@ -611,13 +608,15 @@ template<class MemberType, class ColType>class AsyncLoader :
   /* -- Main constructor --------------------------------------------------- */
   AsyncLoader(                         // Initialise with derived class
     MemberType*const mtNAsyncOwner,    // The pointer to the class
-    const EvtMainCmd emcNAsyncCmd) :   // The event id to use
+    const EvtMainCmd emcNAsyncCmd,     // The event id to use
+    const JobPriority jpPriority) :    // Priority in the worker pool
     /* -- Initialisers ----------------------------------------------------- */
     mtAsyncOwner{ *mtNAsyncOwner },    // Initialise owner of this class
     emcAsyncCmd(emcNAsyncCmd),         // Initialise event id
     lecAsync{ mtNAsyncOwner,           // Initialise Lua event class...
               emcNAsyncCmd },          // ...with owner class and event cmd.
-    tAsyncThread{ STP_LOW },           // Initialise low priority thread
+    jAsyncJob{ jpPriority,             // Initialise job with priority...
+      bind(&AsyncLoader<MemberType, ColType>::AsyncJobMain, this, _1) },
     asctAsyncType(BA_NONE),            // Initialise load source type
     auAsyncPid(0)                      // Initialise pid for BA_EXECUTE
     /* -- No code ---------------------------------------------------------- */
@@ -628,13 +627,13 @@ template<class MemberType, class ColType>class AsyncLoader :
   // waiting for it to be called will NOT be cleaned up properly and cause
   // memory leaks.
   DTORHELPER(~AsyncLoader,
-    // Ignore if thread isn't running
-    if(tAsyncThread.ThreadIsNotJoinable()) return;
+    // Ignore if job isn't queued or running
+    if(jAsyncJob.JobIsStandby()) return;
     // Print a warning to say that we should not be allowing this destructor
-    // the clean up the thread
+    // the clean up the job
     cLog->LogWarningExSafe("AsyncLoader waiting for '$' to unload in its own "
       "destructor. There could be memory leaks!", strAsyncError);
-    // Wait for the thread to stop
+    // Dequeue the job or wait for it to stop
     AsyncStop();
   )
 };/* -- Function to wait for async of all members in a collector ----------- */
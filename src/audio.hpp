@@ -14,12 +14,12 @@ using namespace ICVarDef::P;           using namespace ICVarLib::P;
 using namespace IError::P;             using namespace IEvtMain::P;
 using namespace IHelper::P;            using namespace ILog::P;
 using namespace ILuaFunc::P;           using namespace IMixer::P;
-using namespace IOal::P;               using namespace ISample::P;
-using namespace ISource::P;            using namespace IStd::P;
-using namespace IStream::P;            using namespace IString::P;
-using namespace ISysUtil::P;           using namespace IThread::P;
-using namespace ITime::P;              using namespace IVideo::P;
-using namespace Lib::OpenAL::Types;
+using namespace IOal::P;               using namespace IProfile::P;
+using namespace ISample::P;            using namespace ISource::P;
+using namespace IStd::P;               using namespace IStream::P;
+using namespace IString::P;            using namespace ISysUtil::P;
+using namespace IThread::P;            using namespace ITime::P;
+using namespace IVideo::P;             using namespace Lib::OpenAL::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* ========================================================================= */
@@ -86,6 +86,7 @@ class Audio :                          // Audio manager class
     // Unload all buffers for streams and samples and destroy all sources
     VideoDeInit();
     StreamDeInit();
+    SampleEndVoices();
     SourceDeInit();
     SampleDeInit();
     // Deinit and reinit context
@@ -121,9 +122,14 @@ class Audio :                          // Audio manager class
   ThreadStatus AudioThreadMainSysEvents(Thread &) try
   { // Loop forever until thread exit signalled.
     while(tAudThread.ThreadShouldNotExit())
-    { // Manage stream classes
-      StreamManage();
-      // Suspend thread for the user requested time
+    { // Record time spent managing audio this iteration
+      { const ProfileZone pzZone{ "AudioThreadMain" };
+        // Manage stream classes and compressed samples
+        StreamManage();
+        SampleManage();
+        // Find sources that stopped playing so they can be reused
+        SourceManage();
+      } // Suspend thread for the user requested time
       StdSuspend(acdThreadDelay.load());
     } // Terminate thread
     return TS_OK;
@@ -203,8 +209,13 @@ class Audio :                          // Audio manager class
     for(AudioResetCheckTime();             // Reset device list check time
         tAudThread.ThreadShouldNotExit();  // Enum until thread exit signalled
         StdSuspend(acdThreadDelay.load())) // Suspend thread pecified time
-    { // Manage all streams audio.
+    { // Record time spent managing audio this iteration
+      const ProfileZone pzZone{ "AudioThreadMain" };
+      // Manage all streams audio and compressed samples.
       StreamManage();
+      SampleManage();
+      // Find sources that stopped playing so they can be reused
+      SourceManage();
       // Verify the hardware setup and reset if there are any descreprencies.
       // If there were no descreprencies detected then loop again.
       if(AudioVerify()) continue;
@@ -427,6 +438,7 @@ class Audio :                          // Audio manager class
     cVideos->CollectorDestroyUnsafe();
     cStreams->CollectorDestroyUnsafe();
     cSamples->CollectorDestroyUnsafe();
+    SampleDeInit();
     cSources->CollectorDestroyUnsafe();
     // Unload handles
     AudioDeInitContext();
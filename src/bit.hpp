@@ -8,6 +8,8 @@
 #pragma once                           // Only one incursion allowed
 /* ------------------------------------------------------------------------- */
 namespace IBit {                       // Start of private module namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IEndian::P;            using namespace IStd::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Reverse a byte but use 'int' math for speed -------------------------- */
@@ -82,6 +84,40 @@ static void BitSet2R(                  // Returns nothing
   const IntType itSrcPos)              // Destination BIT (not BYTE) position
 { ptDst[BitToByte(itDstPos)] |=
     BitReverseByte<PtrType>(ptSrc[BitToByte(itSrcPos)]); }
+/* -- Read up to 64 bits from BIT position 'stPos' in 'ucpSrc' ------------- */
+static uint64_t BitRead64(             // Returns bits (first bit is LSB)
+  const unsigned char*const ucpSrc,    // Source buffer
+  const size_t stBytes,                // Size of source buffer in BYTES
+  const size_t stPos,                  // Source BIT (not BYTE) position
+  const size_t stCount)                // Number of bits to read (max 64)
+{ // Calculate byte position and bit shift inside the first byte
+  const size_t stByte = BitToByte(stPos), stShift = stPos % CHAR_BIT;
+  // Bail if nothing to read or reading out of bounds
+  if(!stCount || stByte >= stBytes) return 0;
+  // Value to return
+  uint64_t ullValue;
+  // If we can read eight whole bytes from the buffer?
+  if(stByte + sizeof(ullValue) <= stBytes)
+  { // Read the eight bytes in one go and move them into position
+    StdMemCopy(&ullValue, ucpSrc + stByte, sizeof(ullValue));
+    ullValue = EndianTo64LE(ullValue) >> stShift;
+    // Get the remaining bits from the ninth byte if we need them
+    if(stShift && stCount > 64 - stShift &&
+       stByte + sizeof(ullValue) < stBytes)
+      ullValue |= static_cast<uint64_t>(ucpSrc[stByte + sizeof(ullValue)]) <<
+        (64 - stShift);
+  } // Near the end of the buffer so assemble the remaining bytes
+  else
+  { // Clear the value and add each remaining byte
+    ullValue = 0;
+    for(size_t stIndex = stByte; stIndex < stBytes; ++stIndex)
+      ullValue |= static_cast<uint64_t>(ucpSrc[stIndex]) <<
+        BitFromByte(stIndex - stByte);
+    // Move bits into position
+    ullValue >>= stShift;
+  } // Clear the bits past the requested count
+  return stCount >= 64 ? ullValue : ullValue & ((1ULL << stCount) - 1);
+}
 /* -- Unused --------------------------------------------------------------- */
 // template<typename PtrType, typename IntType>
 //   static bool BitTest2(PtrType*const ptDst, const IntType itDstPos,
@@ -77,24 +77,25 @@ namespace P {                          // Start of public module namespace
 ** ------------------------------------------------------------------------- */
 enum ConCmdEnums : unsigned
 { /* ----------------------------------------------------------------------- */
-  CC_ARCHIVES, CC_ARESET,   CC_ASSETS,    CC_AUDINS,  CC_AUDIO,
-  CC_AUDOUTS,  CC_BINS,     CC_CERTS,     CC_CLA,     CC_CLH,
-  CC_CLS,      CC_CMDS,     CC_CON,       CC_CONLOG,  CC_CPU,
-  CC_CRASH,    CC_CREDITS,  CC_CRESET,    CC_CVARS,   CC_CVCLR,
-  CC_CVI,      CC_CVLOAD,   CC_CVNPK,     CC_CVPEND,  CC_CVSAVE,
-  CC_DIR,      CC_ENV,      CC_EVENTS,    CC_FBOS,    CC_FILES,
-  CC_FIND,     CC_FONTS,    CC_FTFS,      CC_GPU,     CC_GRESET,
-  CC_IMAGES,   CC_IMGFMTS,  CC_INPUT,     CC_JSONS,   CC_LCALC,
-  CC_LCMDS,    CC_LEND,     CC_LEXEC,     CC_LFUNCS,  CC_LG,
-  CC_LGC,      CC_LOG,      CC_LOGCLR,    CC_LPAUSE,  CC_LRESET,
-  CC_LRESUME,  CC_LSTACK,   CC_LVARS,     CC_MASKS,   CC_MEM,
-  CC_MLIST,    CC_MODS,     CC_OBJS,      CC_OGLEXT,  CC_OGLFUNC,
-  CC_PALETTES, CC_PCMFMTS,  CC_PCMS,      CC_QUIT,    CC_RESTART,
-  CC_SAMPLES,  CC_SHADERS,  CC_SHOT,      CC_SOCKETS, CC_SOCKRESET,
-  CC_SOURCES,  CC_SQLCHECK, CC_SQLDEFRAG, CC_SQLEND,  CC_SQLEXEC,
-  CC_SQLS,     CC_STATS,    CC_STOPALL,   CC_STREAMS, CC_SYSTEM,
-  CC_TEXTURES, CC_THREADS,  CC_TIME,      CC_URLS,    CC_VERSION,
-  CC_VIDEOS,   CC_VMLIST,   CC_VRESET,    CC_WRESET,
+  CC_ARCHIVES, CC_ARESET,    CC_ASSETS,  CC_AUDINS,    CC_AUDIO,
+  CC_AUDOUTS,  CC_BINS,      CC_CERTS,   CC_CLA,       CC_CLH,
+  CC_CLS,      CC_CMDS,      CC_CON,     CC_CONLOG,    CC_CPU,
+  CC_CRASH,    CC_CREDITS,   CC_CRESET,  CC_CVARS,     CC_CVCLR,
+  CC_CVI,      CC_CVLOAD,    CC_CVNPK,   CC_CVPEND,    CC_CVSAVE,
+  CC_DIR,      CC_ENV,       CC_EVENTS,  CC_FBOS,      CC_FILES,
+  CC_FIND,     CC_FMTBENCH,  CC_FONTS,   CC_FTFS,      CC_GPU,
+  CC_GRESET,   CC_IMAGES,    CC_IMGFMTS, CC_INPUT,     CC_JOBS,
+  CC_JSONS,    CC_LCALC,     CC_LCMDS,   CC_LEND,      CC_LEXEC,
+  CC_LFUNCS,   CC_LG,        CC_LGC,     CC_LOG,       CC_LOGCLR,
+  CC_LPAUSE,   CC_LPROF,     CC_LRESET,  CC_LRESUME,   CC_LSTACK,
+  CC_LVARS,    CC_MASKS,     CC_MEM,     CC_MLIST,     CC_MODS,
+  CC_OBJS,     CC_OGLEXT,    CC_OGLFUNC, CC_PALETTES,  CC_PCMFMTS,
+  CC_PCMS,     CC_PROF,      CC_QUIT,    CC_RESTART,   CC_SAMPLES,
+  CC_SHADERS,  CC_SHOT,      CC_SOCKETS, CC_SOCKRESET, CC_SOURCES,
+  CC_SQLCHECK, CC_SQLDEFRAG, CC_SQLEND,  CC_SQLEXEC,   CC_SQLS,
+  CC_STATS,    CC_STOPALL,   CC_STREAMS, CC_SYSTEM,    CC_TEXTURES,
+  CC_THREADS,  CC_TIME,      CC_URLS,    CC_VERSION,   CC_VIDEOS,
+  CC_VMLIST,   CC_VRESET,    CC_WRESET,
   /* ----------------------------------------------------------------------- */
   MAX_CONCMD                           // Maximum console commands
 };/* ======================================================================= */
@@ -18,10 +18,11 @@ using namespace IFboCore::P;           using namespace IFont::P;
 using namespace IFtf::P;               using namespace IGlFW::P;
 using namespace IHelper::P;            using namespace IImage::P;
 using namespace IImageDef::P;          using namespace ILog::P;
-using namespace IOgl::P;               using namespace IStd::P;
-using namespace IString::P;            using namespace ISystem::P;
-using namespace ISysUtil::P;           using namespace ITexture::P;
-using namespace IUtf::P;               using namespace Lib::OS::GlFW::Types;
+using namespace IOgl::P;               using namespace IProfile::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISystem::P;            using namespace ISysUtil::P;
+using namespace ITexture::P;           using namespace IUtf::P;
+using namespace Lib::OS::GlFW::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public namespace
 /* ========================================================================= */
@@ -213,7 +214,9 @@ class ConGfx :                         // Members initially private
   }
   /* -- Redraw the console FBO if the console contents changed ------------- */
   void ConGfxRender()
-  { // Shift queued console lines
+  { // Record time spent redrawing the console
+    const ProfileZone pzZone{ "ConGfxRender" };
+    // Shift queued console lines
     cConsole->MoveQueuedLines();
     // Return if console is not visible
     if(cConsole->IsNotVisible()) return;
@@ -28,7 +28,7 @@ const LockGuard lgAssetsSync{ cArchives->MutexGet() };
 // Text table class to help us write neat output
 Statistic sTable;
 sTable.Header("ID").Header("F").Header("D").Header("T").Header("U")
-      .Header("FILENAME", false).Reserve(cArchives->size());
+      .Header("R").Header("FILENAME", false).Reserve(cArchives->size());
 // Total resources
 uint64_t ullResources = 0;
 // Walk through archives
@@ -37,13 +37,23 @@ for(const Archive*const aPtr : *cArchives)
   const Archive &aRef = *aPtr;
   sTable.DataN(aRef.Serial()).DataN(aRef.ArchiveGetNumFiles())
         .DataN(aRef.ArchiveGetNumDirs()).DataN(aRef.ArchiveGetTotal())
-        .DataN(aRef.ArchiveGetInUse()).Data(aRef.NameGet());
+        .DataN(aRef.ArchiveGetInUse()).DataN(aRef.ArchiveGetReaders())
+        .Data(aRef.NameGet());
   // Add to resources total
   ullResources += aRef.ArchiveGetFileList().size();
 } // Show count
 cConsole->ConsoleAddLineF("$$ and $.", sTable.Finish(),
   StrPluraliseNum(cArchives->size(), "archive", "archives"),
   StrPluraliseNum(ullResources, "resource", "resources"));
+// Show block cache status
+ArchiveCache &acBlocks = cArchives->acBlocks;
+cConsole->ConsoleAddLineF("Block cache has $ using $ of $ ($ hits, $ misses, "
+  "$ evicted).",
+  StrPluraliseNum(acBlocks.ArchiveCacheGetBlocks(), "block", "blocks"),
+  StrToBytes(acBlocks.ArchiveCacheGetBytes()),
+  StrToBytes(acBlocks.ArchiveCacheGetBudget()),
+  acBlocks.ArchiveCacheGetHits(), acBlocks.ArchiveCacheGetMisses(),
+  acBlocks.ArchiveCacheGetEvicted());
 /* ------------------------------------------------------------------------- */
 } },                                   // End of 'archives' function
 /* ========================================================================= */
@@ -663,12 +673,25 @@ cConsole->ConsoleAddLineA(sTable.Finish(), StrPluraliseNum(ssmEnv.size(),
 } },                                   // End of 'env' function
 /* ========================================================================= */
 // ! events
-// ? Shows the current event queue. This should always be empty.
+// ? Shows the current event queues. The depth should always be zero, the
+// ? peak shows the most events that were ever queued and overflow shows how
+// ? many events did not fit in the queue.
 /* ========================================================================= */
 { "events", 1, 1, CFL_BASIC, [](const Args &){
 /* ------------------------------------------------------------------------- */
+// Prepare statistics table
+Statistic sTable;
+sTable.Header("QUEUE", false).Header("DEPTH").Header("PEAK")
+      .Header("CAPACITY").Header("OVERFLOW").Reserve(2);
+// Add engine and window event queues
+sTable.Data("Engine").DataN(cEvtMain->SizeSafe())
+      .DataN(cEvtMain->HighWater()).DataN(cEvtMain->Capacity())
+      .DataN(cEvtMain->Overflowed())
+      .Data("Window").DataN(cEvtWin->SizeSafe())
+      .DataN(cEvtWin->HighWater()).DataN(cEvtWin->Capacity())
+      .DataN(cEvtWin->Overflowed());
 // Log event counts
-cConsole->ConsoleAddLineF("$ and $.",
+cConsole->ConsoleAddLineF("$$ and $.", sTable.Finish(),
   StrPluraliseNum(cEvtMain->SizeSafe(), "engine event", "engine events"),
   StrPluraliseNum(cEvtWin->SizeSafe(), "window event", "window events"));
 /* ------------------------------------------------------------------------- */
@@ -691,7 +714,8 @@ const function ShowFboInfo{ [](const Fbo &fRef, Statistic &sTable,
         .DataN(fRef.gluFbotex)
         .DataE({{ fRef.LockIsSet(),                'L' },
                 { fRef.FboIsTransparencyEnabled(), 'A' },
-                { fRef.FboIsClearEnabled(),        'C' }})
+                { fRef.FboIsClearEnabled(),        'C' },
+                { fRef.FboIsCoalesceEnabled(),     'O' }})
         .DataN(fRef.FboGetFilter()).DataN(fRef.DimGetWidth())
         .DataN(fRef.DimGetHeight())
         .DataN(fRef.FboGetStageConst().CoordsGetX1())
@@ -767,6 +791,65 @@ cConsole->FindText(StrImplode(aArgs, cCommon->CommonSpaceV(), 1));
 /* ------------------------------------------------------------------------- */
 } },                                   // End of 'find' function
 /* ========================================================================= */
+// ! fmtbench
+// ? Times formatting typical log messages with the string stream and with
+// ? the faster direct conversion used by StrFormat and StrAppend. You can
+// ? specify the number of iterations which defaults to 100000.
+/* ========================================================================= */
+{ "fmtbench", 1, 2, CFL_BASIC, [](const Args &aArgs){
+/* ------------------------------------------------------------------------- */
+// Get number of iterations
+const size_t stIterations =
+  aArgs.size() > 1 ? StrToNum<size_t>(aArgs[1]) : 100000;
+if(!stIterations)
+  return cConsole->ConsoleAddLine("Expected non-zero iterations!");
+// Typical values written to the log
+const StdString strName{ "sounds/explosion.ogg" };
+const size_t stFiles = 1234;
+const uint64_t qwBytes = 9876543210;
+const double dPercent = 66.6667;
+// Time the specified function and add its total output size
+size_t stTotal = 0;
+const auto Time{ [stIterations, &stTotal](const auto &fFunc)->uint64_t
+{ const uint64_t qwStart = cmHiRes.GetTimeNS<uint64_t>();
+  for(size_t stIndex = 0; stIndex < stIterations; ++stIndex)
+    stTotal += fFunc().size();
+  return cmHiRes.GetTimeNS<uint64_t>() - qwStart; } };
+// Functions to compare
+const auto FormatStream{ [&]{ return StrFormatStream(
+  "Archive '$' has $ files totalling $ bytes ($%).",
+  strName, stFiles, qwBytes, dPercent); } };
+const auto Format{ [&]{ return StrFormat(
+  "Archive '$' has $ files totalling $ bytes ($%).",
+  strName, stFiles, qwBytes, dPercent); } };
+const auto AppendStream{ [&]{ return StrAppendStream(
+  strName, ':', stFiles, ':', qwBytes, ':', dPercent); } };
+const auto Append{ [&]{ return StrAppend(
+  strName, ':', stFiles, ':', qwBytes, ':', dPercent); } };
+// Make sure both ways give the same result
+if(FormatStream() != Format() || AppendStream() != Append())
+  return cConsole->ConsoleAddLineF("Format mismatch: '$' != '$'!",
+    FormatStream(), Format());
+// Time each function
+const uint64_t qwFormatStream = Time(FormatStream),
+               qwFormat = Time(Format),
+               qwAppendStream = Time(AppendStream),
+               qwAppend = Time(Append);
+// Show results
+const auto Show{ [stIterations](const char*const cpName,
+  const uint64_t qwStream, const uint64_t qwFast)
+{ cConsole->ConsoleAddLineF("$: $ ns stream, $ ns direct per call ($x).",
+    cpName, qwStream / stIterations, qwFast / stIterations,
+    StrFromNum(static_cast<double>(qwStream) /
+      static_cast<double>(UtilMaximum(qwFast, static_cast<uint64_t>(1))),
+      0, 2)); } };
+Show("StrFormat", qwFormatStream, qwFormat);
+Show("StrAppend", qwAppendStream, qwAppend);
+cConsole->ConsoleAddLineF("Built $ in $ iterations.",
+  StrToBytes(stTotal), stIterations);
+/* ------------------------------------------------------------------------- */
+} },                                   // End of 'fmtbench' function
+/* ========================================================================= */
 // ! fonts
 // ? Shows all created OpenGL 'Font' object classes created by LUA including
 // ? classes internally used by the engine.
@@ -783,7 +866,8 @@ const function ShowFontInfo{ [](Statistic &sTable, const Font &fRef)
             { fRef.FlagIsSet(FF_STROKETYPE2),  'A' },
             { fRef.FlagIsSet(FF_FLOORADVANCE), 'F' },
             { fRef.FlagIsSet(FF_CEILADVANCE),  'C' },
-            { fRef.FlagIsSet(FF_ROUNDADVANCE), 'R' }
+            { fRef.FlagIsSet(FF_ROUNDADVANCE), 'R' },
+            { fRef.FlagIsSet(FF_ASYNCGLYPHS),  'G' }
           })
           .DataN(fRef.GetCharScale(), 6)
           .DataN(fRef.GetTexOccupancy(), 6)
@@ -845,6 +929,7 @@ cConsole->ConsoleAddLineF(
   "- Matrix: $x$ ($); Total: $x$ ($).\n"
   "- Stage: $,$,$,$; Fbo: $x$; OFlags: 0x$$.\n"
   "- Triangles: $$/$; Commands: $/$.\n"
+  "- Streamed: $/frame; Buffer: $; Orphaned: $; Indices: $; Packed: $.\n"
   "FPS: $$/s ($/s); Eff: $%; Limit: $.",
   cOgl->GetRenderer(), cDisplay->DisplayGetMonitorName(),
   cOgl->GetVersion(), cOgl->GetVendor(),
@@ -880,6 +965,9 @@ cConsole->ConsoleAddLineF(
     cFboCore->FboCoreGetMain().FboGetTrisReserved(),
     cFboCore->FboCoreGetMain().FboGetCmds(),
     cFboCore->FboCoreGetMain().FboGetCmdsReserved(),
+  StrToBytes(cOgl->StreamGetBytes()), StrToBytes(cOgl->StreamGetSize()),
+    cOgl->StreamGetOrphans(), cOgl->StreamGetQuadIndices(),
+    StrFromBoolTF(cFbos->bPackVerts),
   StdIOSFixed, cFboCore->FboCoreGetFPS(), cDisplay->DisplayGetRefreshRate(),
   UtilMakePercentage(cFboCore->FboCoreGetFPS(),
     cDisplay->DisplayGetRefreshRate()),
@@ -1067,6 +1155,47 @@ cConsole->ConsoleAddLineF("$$ connected ($ supported).\n"
 /* ------------------------------------------------------------------------- */
 } },                                   // End of 'input' function
 /* ========================================================================= */
+// ! jobs
+// ? Shows the status of the worker pool that processes asynchronous loading
+// ? requests. Each row shows a priority queue with the number of jobs that
+// ? are pending, submitted, completed and cancelled, the total time spent
+// ? processing them and the resulting throughput in jobs per second.
+/* ========================================================================= */
+{ "jobs", 1, 1, CFL_BASIC, [](const Args &){
+/* ------------------------------------------------------------------------- */
+// Priority names
+static const StdArray<const char*const, JP_MAX>
+  aNames{ "AUDIO", "IMAGE", "BULK" };
+// Make a table to automatically format our data neatly
+Statistic sTable;
+sTable.Header("PRIORITY", false).Header("PENDING").Header("SUBMIT")
+      .Header("DONE").Header("CANCEL").Header("TIME").Header("AVERAGE")
+      .Header("RATE").Reserve(JP_MAX);
+// For each priority
+for(size_t stIndex = 0; stIndex < JP_MAX; ++stIndex)
+{ // Get queue and calculate time spent processing it
+  const JobQueue &jqQueue =
+    cJobs->JobsGetQueue(static_cast<JobPriority>(stIndex));
+  const size_t stCompleted = jqQueue.JobQueueCompleted();
+  const double dTime =
+    static_cast<double>(jqQueue.JobQueueNanoSeconds()) / 1000000000.0;
+  // Write data to table
+  sTable.Data(aNames[stIndex]).DataN(jqQueue.JobQueueSize())
+        .DataN(jqQueue.JobQueueSubmitted()).DataN(stCompleted)
+        .DataN(jqQueue.JobQueueCancelled()).Data(TimeToShortDuration(dTime))
+        .Data(TimeToShortDuration(stCompleted ?
+           dTime / static_cast<double>(stCompleted) : 0.0))
+        .DataN(dTime > 0.0 ? static_cast<double>(stCompleted) / dTime : 0.0,
+           1);
+} // Show worker status
+cConsole->ConsoleAddLineF("$$ ($ busy) with $ pending (peak $, capacity $).",
+  sTable.Finish(),
+  StrPluraliseNum(cJobs->JobsGetWorkers(), "worker", "workers"),
+  cJobs->JobsGetBusy(), cJobs->JobsGetPending(), cJobs->JobsGetPeak(),
+  JobQueue::JobQueueCapacity());
+/* ------------------------------------------------------------------------- */
+} },                                   // End of 'jobs' function
+/* ========================================================================= */
 // ! jsons
 // ? Shows all created 'Json' object classes created by LUA.
 /* ========================================================================= */
@@ -1328,6 +1457,74 @@ cLua->LuaRequestPause(true);
 /* ------------------------------------------------------------------------- */
 } },                                   // End of 'lpause' function
 /* ========================================================================= */
+// ! lprof
+// ? Shows the status of the Lua call stack sampler. Specify 'on' with the
+// ? optional operations between samples (default 1000), minimum microseconds
+// ? between samples (default 0) and maximum samples (default 65536) to start
+// ? sampling, 'off' to stop, 'top' to show the specified number of hottest
+// ? functions (default 20) or 'dump' to write folded stacks to the specified
+// ? file (default 'lua.folded').
+/* ========================================================================= */
+{ "lprof", 1, 5, CFL_BASIC, [](const Args &aArgs){
+/* ------------------------------------------------------------------------- */
+// No parameters? Show status of the sampler
+if(aArgs.size() == 1)
+  return cConsole->ConsoleAddLineF("Sampler running: $; Samples: $; "
+    "Dropped: $; Functions: $.", StrFromBoolTF(cLua->LuaProfIsSampling()),
+    cLua->LuaProfGetSamples(), cLua->LuaProfGetDropped(),
+    cLua->LuaProfGetFuncs());
+// Get command and start sampling if requested
+const StdString &strCmd = aArgs[1];
+if(strCmd == "on")
+{ // Same limits as Core.SampleStart()
+  cLua->LuaSampleStart(
+    aArgs.size() > 2 ?
+      UtilClamp(StrToNum<int>(aArgs[2]), 1, 1000000000) : 1000,
+    aArgs.size() > 3 ?
+      UtilClamp(StrToNum<uint64_t>(aArgs[3]), 1, 1000000) * 1000 : 0,
+    aArgs.size() > 4 ?
+      UtilClamp(StrToNum<size_t>(aArgs[4]), 1, 16777216) : 65536);
+  return cConsole->ConsoleAddLine("Sampler started."); }
+// Stop sampling if requested
+if(strCmd == "off")
+{ cLua->LuaSampleStop();
+  return cConsole->ConsoleAddLineF("Sampler stopped with $.",
+    StrPluraliseNum(cLua->LuaProfGetSamples(), "sample", "samples")); }
+// Show hottest functions if requested
+if(strCmd == "top")
+{ // Sort functions by exclusive then inclusive samples
+  const auto mFuncs{ cLua->LuaProfStats() };
+  StdVector<decltype(mFuncs)::const_pointer> vFuncs;
+  vFuncs.reserve(mFuncs.size());
+  for(const auto &mFunc : mFuncs) vFuncs.push_back(&mFunc);
+  StdSort(par_unseq, vFuncs.begin(), vFuncs.end(),
+    [](const auto &pLeft, const auto &pRight)
+      { return pLeft->second.second != pRight->second.second ?
+          pLeft->second.second > pRight->second.second :
+          pLeft->second.first > pRight->second.first; });
+  // Write the requested number of functions to a table
+  const size_t stCount = UtilMinimum(vFuncs.size(),
+    aArgs.size() > 2 ? StrToNum<size_t>(aArgs[2]) : 20);
+  Statistic sTable;
+  sTable.Header("EXCL").Header("INCL").Header("FUNCTION", false)
+        .Reserve(stCount);
+  for(size_t stIndex = 0; stIndex < stCount; ++stIndex)
+    sTable.DataN(vFuncs[stIndex]->second.second)
+          .DataN(vFuncs[stIndex]->second.first)
+          .Data(vFuncs[stIndex]->first);
+  return cConsole->ConsoleAddLineF("$$ of $ from $.", sTable.Finish(),
+    stCount, StrPluraliseNum(mFuncs.size(), "function", "functions"),
+    StrPluraliseNum(cLua->LuaProfGetSamples(), "sample", "samples"));
+} // Unknown command?
+if(strCmd != "dump")
+  return cConsole->ConsoleAddLine("Expected 'on', 'off', 'top' or 'dump'!");
+// Write folded stacks
+const StdString strFile{ aArgs.size() > 2 ? aArgs[2] : "lua.folded" };
+cConsole->ConsoleAddLineF("Wrote $ to '$'.", StrPluraliseNum(
+  cLua->LuaProfDump(strFile), "stack", "stacks"), strFile);
+/* ------------------------------------------------------------------------- */
+} },                                   // End of 'lprof' function
+/* ========================================================================= */
 // ! lreset
 // ? Performs an 'lreset' destroying the current sandbox, creates a new one and
 // ? then re-executes the starting script.
@@ -1551,11 +1748,11 @@ using MemoryUsageItems = StdList<MemoryUsageItem>;
 const MemoryUsageItems muiList{ {
   MSS(Archive),  MSS(Asset),   MSSX(Atlas, cAtlases),      MSS(Bin),
   MSS(Clip),     MSS(Command), MSS(Fbo),      MSS(File),   MSS(Font),
-  MSS(Ftf),      MSS(Image),   MSS(ImageLib), MSS(Json),   MSS(LuaFunc),
-  MSS(Mask),     MSS(Palette), MSS(Pcm),      MSS(PcmLib), MSS(Sample),
-  MSS(Shader),   MSS(Socket),  MSS(Source),   MSS(Sql),    MSS(SShot),
-  MSS(Stat),     MSS(Stream),  MSS(Texture),  MSS(Thread), MSS(Url),
-  MSS(Variable), MSS(Video)
+  MSS(Ftf),      MSS(Image),   MSS(ImageLib), MSS(Json),   MSS(Layout),
+  MSS(LuaFunc),  MSS(Mask),    MSS(Palette),  MSS(Pcm),    MSS(PcmLib),
+  MSS(Sample),   MSS(Shader),  MSS(Socket),   MSS(Source), MSS(Sql),
+  MSS(SShot),    MSS(Stat),    MSS(Stmt),     MSS(Stream), MSS(Texture),
+  MSS(Thread),   MSS(Url),     MSS(Variable), MSS(Video)
 } };
 // Done with these macros
 #undef MSS
@@ -1689,6 +1886,36 @@ cConsole->ConsoleAddLineA(sTable.Finish(),
 /* ------------------------------------------------------------------------- */
 } },                                   // End of 'pcms' function
 /* ========================================================================= */
+// ! prof
+// ? Shows the status of the frame profiler. Specify 'on' or 'off' to start or
+// ? stop recording and 'dump' to write the zones recorded in the specified
+// ? number of recent frames (default all) to the specified Chrome trace file
+// ? (default 'profile.json').
+/* ========================================================================= */
+{ "prof", 1, 4, CFL_BASIC, [](const Args &aArgs){
+/* ------------------------------------------------------------------------- */
+// No parameters? Show status of the profiler
+if(aArgs.size() == 1)
+  return cConsole->ConsoleAddLineF("Profiler recording: $; Frames: $; "
+    "Threads: $.", StrFromBoolTF(cProfile->ProfileIsEnabled()),
+    cProfile->ProfileGetFrames(), cProfile->ProfileGetRings());
+// Get command and start or stop recording if requested
+const StdString &strCmd = aArgs[1];
+if(strCmd == "on" || strCmd == "off")
+{ cProfile->ProfileSetEnabled(strCmd == "on");
+  return cConsole->ConsoleAddLineF("Profiler recording $.",
+    cProfile->ProfileIsEnabled() ? "started" : "stopped"); }
+// Unknown command?
+if(strCmd != "dump")
+  return cConsole->ConsoleAddLine("Expected 'on', 'off' or 'dump'!");
+// Get frame count and filename and write the trace
+const size_t stFrames = aArgs.size() > 2 ? StrToNum<size_t>(aArgs[2]) : 0;
+const StdString strFile{ aArgs.size() > 3 ? aArgs[3] : "profile.json" };
+cConsole->ConsoleAddLineF("Wrote $ to '$'.", StrPluraliseNum(
+  cProfile->ProfileDump(stFrames, strFile), "zone", "zones"), strFile);
+/* ------------------------------------------------------------------------- */
+} },                                   // End of 'prof' function
+/* ========================================================================= */
 // ! quit
 // ? Performs an 'lend' command and then asks the engine and process to
 // ? terminate after sandbox destruction.
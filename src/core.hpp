@@ -37,7 +37,8 @@ using namespace IGlFWMonitor::P;       using namespace IGlFWUtil::P;
 using namespace IImage::P;             using namespace IImageData::P;
 using namespace IImageDef::P;          using namespace IImageLib::P;
 using namespace IInput::P;             using namespace IInterval::P;
-using namespace IJson::P;              using namespace ILog::P;
+using namespace IJobs::P;              using namespace IJson::P;
+using namespace ILayout::P;            using namespace ILog::P;
 using namespace ILua::P;               using namespace ILuaBase::P;
 using namespace ILuaCode::P;           using namespace ILuaCommand::P;
 using namespace ILuaFunc::P;           using namespace ILuaUtil::P;
@@ -46,20 +47,20 @@ using namespace IMemory::P;            using namespace IMixer::P;
 using namespace IMutex::P;             using namespace IOal::P;
 using namespace IOgl::P;               using namespace IPSplit::P;
 using namespace IPalette::P;           using namespace IPcm::P;
-using namespace IPcmLib::P;            using namespace ISShot::P;
-using namespace ISample::P;            using namespace IShader::P;
-using namespace IShaders::P;           using namespace ISocket::P;
-using namespace ISource::P;            using namespace ISql::P;
-using namespace IStat::P;              using namespace IStd::P;
-using namespace IStdLib::P;            using namespace IStream::P;
-using namespace IString::P;            using namespace ISysMod::P;
-using namespace ISysUtil::P;           using namespace ISystem::P;
-using namespace ITexture::P;           using namespace IThread::P;
-using namespace ITime::P;              using namespace IToken::P;
-using namespace IUrl::P;               using namespace IUtf::P;
-using namespace IUtil::P;              using namespace IVideo::P;
-using namespace Lib::OS::GlFW::Types;  using namespace Lib::OpenAL::Types;
-using namespace Lib::Sqlite::Types;
+using namespace IPcmLib::P;            using namespace IProfile::P;
+using namespace ISShot::P;             using namespace ISample::P;
+using namespace IShader::P;            using namespace IShaders::P;
+using namespace ISocket::P;            using namespace ISource::P;
+using namespace ISql::P;               using namespace IStat::P;
+using namespace IStd::P;               using namespace IStdLib::P;
+using namespace IStream::P;            using namespace IString::P;
+using namespace ISysMod::P;            using namespace ISysUtil::P;
+using namespace ISystem::P;            using namespace ITexture::P;
+using namespace IThread::P;            using namespace ITime::P;
+using namespace IToken::P;             using namespace IUrl::P;
+using namespace IUtf::P;               using namespace IUtil::P;
+using namespace IVideo::P;             using namespace Lib::OS::GlFW::Types;
+using namespace Lib::OpenAL::Types;    using namespace Lib::Sqlite::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* ------------------------------------------------------------------------- */
@@ -67,10 +68,11 @@ class Core;                            // Core class prototype
 static Core *cCore = nullptr;          // Pointer to static class
 class Core final :                     // Members initially private
   /* -- Base classes (order is critical!) ---------------------------------- */
-  private Stats,      private Threads,            private EvtMain,
-  private System,     private LuaFuncs,           private Archives,
-  private Assets,     private Crypt,              private Urls,
-  private Frame,      private Sqls,               private Sql,
+  private Profile,    private Stats,              private Threads,
+  private Jobs,       private EvtMain,            private System,
+  private LuaFuncs,   private Archives,           private Assets,
+  private Crypt,      private Urls,               private Frame,
+  private Stmts,      private Sqls,               private Sql,
   private Jsons,      private CVarItemStaticList, private CVars,
   private Sockets,    private ConCmdStaticList,   private Console,
   private GlFW,       private Credits,            private FreeType,
@@ -86,8 +88,8 @@ class Core final :                     // Members initially private
   private Input,      private ShaderCore,         private Fbos,
   private FboCore,    private SShots,             private Textures,
   private Palettes,   private Atlases,            private Fonts,
-  private Videos,     private ConGfx,             private Variables,
-  private Commands,   private Lua
+  private Layouts,    private Videos,             private ConGfx,
+  private Variables,  private Commands,           private Lua
 { /* -- Private typedefs to run a function when scope exits ---------------- */
   template<typename FuncType>struct ScopeGuard { FuncType ftFunc;
     explicit ScopeGuard(FuncType &&ftNFunc) : ftFunc(StdMove(ftNFunc)) {}
@@ -115,8 +117,10 @@ class Core final :                     // Members initially private
     // End current SQL transaction, we need to report it if it succeeded.
     if(bLeaving && SqlEnd() != SQLITE_ERROR)
       cLog->LogWarningSafe("Core ended an in-progress SQL transaction!");
-    // Reset all SQL error codes and stored results and records.
+    // Reset all SQL error codes and stored results and records and finalise
+    // cached prepared statements.
     SqlReset();
+    SqlStmtFlush();
     // Clear console status bars. Although this only applies if there is a
     // terminal window, we don't restrict use of the function in graphical only
     // mode so clear it regardless of what the gui mode is.
@@ -153,11 +157,11 @@ class Core final :                     // Members initially private
 #define RSC(x) RSCX(x, 0)
     RSC(Archive); RSC(Asset);    RSC(Atlase); RSC(Bin);     RSC(Clip);
     RSC(Command); RSCX(Fbo, 2);  RSC(File);   RSC(Font);    RSC(Ftf);
-    RSC(Image);   RSC(ImageLib); RSC(Json);   RSC(LuaFunc); RSC(Mask);
-    RSC(Palette); RSC(Pcm);      RSC(PcmLib); RSC(Sample);  RSC(Shader);
-    RSC(Socket);  RSC(Source);   RSC(Sql);    RSC(SShot);   RSC(Stat);
-    RSC(Stream);  RSC(Texture);  RSC(Thread); RSC(Url);     RSC(Variable);
-    RSC(Video);
+    RSC(Image);   RSC(ImageLib); RSC(Json);   RSC(Layout);  RSC(LuaFunc);
+    RSC(Mask);    RSC(Palette);  RSC(Pcm);    RSC(PcmLib);  RSC(Sample);
+    RSC(Shader);  RSC(Socket);   RSC(Source); RSC(Sql);     RSC(SShot);
+    RSC(Stat);    RSC(Stmt);     RSC(Stream); RSC(Texture); RSC(Thread);
+    RSC(Url);     RSC(Variable); RSC(Video);
 #undef RSC
 #undef RSCX
 #undef RSCEX
@@ -178,10 +182,14 @@ class Core final :                     // Members initially private
   void CoreTickNoFrameLimiter()
   { // Update timer
     FrameUpdateBot();
+    // Mark start of frame for the profiler
+    ProfileFrame();
     // Render the console FBO (if update requested)
     ConGfxRender();
     // Render video textures (if any)
     VideoRender();
+    // Commit glyphs rasterised in the background (if any)
+    FontFlushGlyphs();
     // Set main FBO by default on each frame
     FboCoreActivateMain();
     // Poll joysticks
@@ -198,15 +206,21 @@ class Core final :                     // Members initially private
     FboCoreGetMain().FboFinishAndRender();
     // Render all FBO's and copy the main FBO to screen
     FboCoreRender();
+    // Complete and queue screenshot reads
+    SShotsFrame();
   }
   /* -- Graphical core window thread tick with frame limiter --------------- */
   void CoreTickFrameLimiter()
   { // Return if it is not time to execute a game tick
     if(FrameShouldNotTick()) return;
+    // Mark start of frame for the profiler
+    ProfileFrame();
     // Render the console FBO (if update requested)
     ConGfxRender();
     // Render video textures (if any)
     VideoRender();
+    // Commit glyphs rasterised in the background (if any)
+    FontFlushGlyphs();
     // Set main FBO by default on each frame
     Catchup: FboCoreActivateMain();
     // Poll joysticks
@@ -237,6 +251,8 @@ class Core final :                     // Members initially private
         FboCoreGetMain().FboFinishAndRender();
         // Do the render
         FboCoreRender();
+        // Complete and queue screenshot reads
+        SShotsFrame();
         // Done
         break;
       // No redrawing required this frame?
@@ -261,6 +277,8 @@ class Core final :                     // Members initially private
         FboCoreClearDraw();
         // Do the render
         FboCoreRender();
+        // Complete and queue screenshot reads
+        SShotsFrame();
         // Done
         break;
       // Anything else ignore
@@ -299,8 +317,9 @@ class Core final :                     // Members initially private
         // Lua executing was reinitialised?
         case EMC_LUA_REINIT:
           // Commit modified cvars. We know if we get this far, all the
-          // configurations are valid so let's make sure they're saved!
-          CVarsSaveToDatabase();
+          // configurations are valid so let's make sure they're saved! The
+          // writes are queued to the database thread so they don't stall.
+          CVarsSaveToDatabase(true);
           // Fall through to default
           [[fallthrough]];
         // For anything else
@@ -342,6 +361,8 @@ class Core final :                     // Members initially private
         else while(EvtMain::HandleSafe())
         { // Calculate time elapsed in this tick
           FrameUpdateBot();
+          // Mark start of frame for the profiler
+          ProfileFrame();
           // Execute the main tick
           LuaExecuteMain();
           // Process bot console
@@ -359,6 +380,8 @@ class Core final :                     // Members initially private
       else while(EvtMain::HandleSafe())
       { // Calculate time elapsed in this tick
         FrameUpdateBot();
+        // Mark start of frame for the profiler
+        ProfileFrame();
         // Execute the main tick
         LuaExecuteMain();
         // Process bot console
@@ -425,7 +448,9 @@ class Core final :                     // Members initially private
         if(SysIsAudioMode()) AudioDeInit();
         // Done
         break;
-    } // Unload all FBO's (NOT destroy);
+    } // Complete screenshot reads and release their buffers
+    SShotsDeInit();
+    // Unload all FBO's (NOT destroy);
     FboCoreDeInit();
     // De-init core shaders
     ShadersDeInit();
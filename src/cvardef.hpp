@@ -159,20 +159,21 @@ enum CVarEnums : size_t                // CVars list (cvarlib.hpp for bodies)
   SQL_RETRYCOUNT,   SQL_DB,            SQL_LOCKINGMODE,     SQL_TEMPSTORE,
   SQL_SYNCHRONOUS,  SQL_JOURNALMODE,   SQL_AUTOVACUUM,      SQL_FOREIGNKEYS,
   SQL_INCVACUUM,    SQL_DEFAULTS,      SQL_LOADCONFIG,      APP_CFLAGS,
-  LOG_LINES,        LOG_APPEND,        LOG_FILE,            APP_LONGNAME,
-  ERR_INSTANCE,
+  LOG_LINES,        LOG_APPEND,        LOG_ASYNC,           LOG_FILE,
+  APP_LONGNAME,     ERR_INSTANCE,
   /* -- Object cvars ------------------------------------------------------- */
   OBJ_ARCHIVEMAX,   OBJ_ASSETMAX,      OBJ_ATLASMAX,        OBJ_BINMAX,
   OBJ_CLIPMAX,      OBJ_CMDMAX,        OBJ_CVARIMAX,        OBJ_CVARMAX,
   OBJ_FBOMAX,       OBJ_FILEMAX,       OBJ_FONTMAX,         OBJ_FTFMAX,
-  OBJ_FUNCMAX,      OBJ_IMGMAX,        OBJ_JSONMAX,         OBJ_MASKMAX,
-  OBJ_PCMMAX,       OBJ_SAMPLEMAX,     OBJ_SHADERMAX,       OBJ_SOCKETMAX,
-  OBJ_SOURCEMAX,    OBJ_SQLMAX,        OBJ_SSHOTMAX,        OBJ_STATMAX,
-  OBJ_STREAMMAX,    OBJ_TEXTUREMAX,    OBJ_THREADMAX,       OBJ_URLMAX,
-  OBJ_VIDEOMAX,
+  OBJ_FUNCMAX,      OBJ_IMGMAX,        OBJ_JSONMAX,         OBJ_LAYOUTMAX,
+  OBJ_MASKMAX,      OBJ_PCMMAX,        OBJ_SAMPLEMAX,       OBJ_SHADERMAX,
+  OBJ_SOCKETMAX,    OBJ_SOURCEMAX,     OBJ_SQLMAX,          OBJ_SSHOTMAX,
+  OBJ_STATMAX,      OBJ_STMTMAX,       OBJ_STREAMMAX,       OBJ_TEXTUREMAX,
+  OBJ_THREADMAX,    OBJ_URLMAX,        OBJ_VIDEOMAX,
   /* -- Base cvars --------------------------------------------------------- */
   APP_DESCRIPTION,  APP_VERSION,       APP_ICON,            APP_COPYRIGHT,
   APP_WEBSITE,      APP_TICKRATE,      APP_DELAY,           APP_TITLE,
+  APP_WORKERS,      AST_BLOCKCACHE,    SQL_STMTCACHE,       SQL_BATCHWINDOW,
   /* -- Error cvars -------------------------------------------------------- */
   ERR_ADMIN,        ERR_CHECKSUM,      ERR_DEBUGGER,        ERR_MINVRAM,
   ERR_MINRAM,
@@ -184,8 +185,9 @@ enum CVarEnums : size_t                // CVars list (cvarlib.hpp for bodies)
   LUA_TICKTIMEOUT,
   /* -- Audio cvars -------------------------------------------------------- */
   AUD_CHECK,        AUD_DELAY,         AUD_FMVVOL,          AUD_HRTF,
-  AUD_INTERFACE,    AUD_NUMSOURCES,    AUD_SAMVOL,          AUD_STRBUFCOUNT,
-  AUD_STRBUFFER,    AUD_STRVOL,        AUD_VERSION,         AUD_VOL,
+  AUD_INTERFACE,    AUD_NUMSOURCES,    AUD_SAMCOMPRESS,     AUD_SAMVOL,
+  AUD_STRBUFCOUNT,  AUD_STRBUFFER,     AUD_STRVOL,          AUD_VERSION,
+  AUD_VOL,
   /* -- Console cvars ------------------------------------------------------ */
   CON_KEYPRIMARY,   CON_KEYSECONDARY,  CON_AUTOCOMPLETE,    CON_AUTOSCROLL,
   CON_AUTOCOPYCVAR, CON_HEIGHT,        CON_BLOUTPUT,        CON_BLINPUT,
@@ -197,14 +199,15 @@ enum CVarEnums : size_t                // CVars list (cvarlib.hpp for bodies)
   CON_OUTPUTMAX,    CON_PAGELINES,     CON_TMCCOLS,         CON_TMCROWS,
   CON_TMCREFRESH,   CON_TMCNOCLOSE,    CON_TMCTFORMAT,
   /* -- Fmv cvars ---------------------------------------------------------- */
-  FMV_ABUFFER,      FMV_IOBUFFER,      FMV_MAXDRIFT,
+  FMV_ABUFFER,      FMV_IOBUFFER,      FMV_MAXDRIFT,        FMV_PAGES,
   /* -- Input cvars -------------------------------------------------------- */
   INP_CLAMPMOUSE,   INP_JOYDEFFDZ,     INP_JOYDEFRDZ,       INP_FSTOGGLER,
   INP_LOCKKEYMODS,  INP_RAWMOUSE,      INP_STICKYKEY,       INP_STICKYMOUSE,
   /* -- Network cvars ------------------------------------------------------ */
   NET_CBPFLAG1,     NET_CBPFLAG2,      NET_BUFFER,          NET_RTIMEOUT,
   NET_STIMEOUT,     NET_CIPHERTLSv1,   NET_CIPHERTLSv13,    NET_CASTORE,
-  NET_OCSP,         NET_USERAGENT,
+  NET_OCSP,         NET_USERAGENT,     NET_REACTOR,         NET_KEEPALIVE,
+  NET_KEEPALIVEMAX,
   /* -- Video cvars -------------------------------------------------------- */
   VID_API,          VID_CTXMAJOR,      VID_CTXMINOR,        VID_CLEAR,
   VID_CLEARCOLOUR,  VID_DBLBUFF,       VID_DEBUG,           VID_FBALPHA,
@@ -212,11 +215,11 @@ enum CVarEnums : size_t                // CVars list (cvarlib.hpp for bodies)
   VID_FSAA,         VID_FORWARD,       VID_FSMODE,          VID_GAMMA,
   VID_GASWITCH,     VID_HIDPI,         VID_MONITOR,         VID_NOERRORS,
   VID_ORASPMAX,     VID_ORASPMIN,      VID_ORHEIGHT,        VID_ORWIDTH,
-  VID_PROFILE,      VID_QCOMPRESS,     VID_QLINE,           VID_QPOLYGON,
-  VID_QSHADER,      VID_RCMDS,         VID_RDFBO,           VID_RDTEX,
-  VID_RELEASE,      VID_RFBO,          VID_RFLOATS,         VID_ROBUSTNESS,
-  VID_SIMPLEMATRIX, VID_SRGB,          VID_SSTYPE,          VID_STEREO,
-  VID_SUBPIXROUND,  VID_TEXFILTER,     VID_VSYNC,
+  VID_PACKVERTS,    VID_PROFILE,       VID_QCOMPRESS,       VID_QLINE,
+  VID_QPOLYGON,     VID_QSHADER,       VID_RCMDS,           VID_RDFBO,
+  VID_RDTEX,        VID_RELEASE,       VID_RFBO,            VID_RFLOATS,
+  VID_ROBUSTNESS,   VID_SIMPLEMATRIX,  VID_SRGB,            VID_SSTYPE,
+  VID_STEREO,       VID_SUBPIXROUND,   VID_TEXFILTER,       VID_VSYNC,
   /* -- Window cvars ------------------------------------------------------- */
   WIN_ALPHA,        WIN_ASPECT,        WIN_BORDER,          WIN_CLOSEABLE,
   WIN_FLOATING,     WIN_FOCUSED,       WIN_HEIGHT,          WIN_HEIGHTMAX,
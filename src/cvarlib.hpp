@@ -274,6 +274,17 @@ CVarItemStaticList{{
 { CFL_BASIC, "log_append", "0",
   CB(cLog->LogSetFileAppend, size_t), TBOOLEAN|PANY },
 /* ------------------------------------------------------------------------- */
+// ! LOG_ASYNC
+// ? If set to 0 (default) then every log line is written and flushed to the
+// ? log file by the thread that logged it. Otherwise it is the interval in
+// ? milliseconds that a separate writer thread writes and flushes all the
+// ? pending lines in one batch. Warnings and errors are written immediately
+// ? and pending lines are still written when the log closes or the engine
+// ? crashes.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "log_async", "0",
+  CB(cLog->LogSetAsync, unsigned), TUINTEGER|PANY },
+/* ------------------------------------------------------------------------- */
 // ! LOG_FILE
 // ? Specifies a file to log internal engine messages to. It is used to help
 // ? debugging. Leave as blank for no log file. It can be set from command-line
@@ -421,6 +432,14 @@ CVarItemStaticList{{
 { CFL_BASIC, "obj_jsonmax", "1000",
   CB(cJsons->CollectorSetLimit, size_t), TUINTEGER|PNOUI },
 /* ------------------------------------------------------------------------- */
+// ! OBJ_LAYOUTMAX
+// ? Specifies the maximum number of text layout objects allowed to be
+// ? registered by the engine. An exception is generated if more cvars than
+// ? this are allocated.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "obj_layoutmax", "1000",
+  CB(cLayouts->CollectorSetLimit, size_t), TUINTEGER|PNOUI },
+/* ------------------------------------------------------------------------- */
 // ! OBJ_MASKMAX
 // ? Specifies the maximum number of mask objects allowed to be registered by
 // ? the engine. An exception is generated if more cvars than this are
@@ -493,6 +512,14 @@ CVarItemStaticList{{
 { CFL_BASIC, "obj_statmax", "1000",
   CB(cStats->CollectorSetLimit, size_t), TUINTEGER|PNOUI },
 /* ------------------------------------------------------------------------- */
+// ! OBJ_STMTMAX
+// ? Specifies the maximum number of prepared statement objects allowed to be
+// ? registered by the engine. An exception is generated if more objects than
+// ? this are allocated.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "obj_stmtmax", "1000",
+  CB(cStmts->CollectorSetLimit, size_t), TUINTEGER|PNOUI },
+/* ------------------------------------------------------------------------- */
 // ! OBJ_STREAMMAX
 // ? Specifies the maximum number of stream objects allowed to be
 // ? registered by the engine. An exception is generated if more objects than
@@ -602,6 +629,46 @@ CVarItemStaticList{{
 /* ------------------------------------------------------------------------- */
 { CFL_BASIC, "app_title", "",
   CBSTR(cCore->CoreTitleModified), TSTRING|MTRIM|PAPPCFG },
+/* ------------------------------------------------------------------------- */
+// ! APP_WORKERS
+// ? Specifies the number of worker threads used to load assets, images,
+// ? sounds and other objects asynchronously. Each asynchronous load request
+// ? is queued and processed by the first available worker. Audio data is
+// ? processed before image data which is processed before everything else.
+// ? The default is '0' which means use the number of hardware threads the
+// ? system reports (with a minimum of two). The maximum is 256.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "app_workers", "0",
+  CB(cJobs->JobsSetWorkers, size_t), TUINTEGER|PNOUI },
+/* ------------------------------------------------------------------------- */
+// ! AST_BLOCKCACHE
+// ? Specifies the maximum number of bytes of decompressed solid blocks to keep
+// ? in memory. When a file is loaded from a solid block in an archive, the
+// ? whole block needs to be decompressed so keeping it means other files in
+// ? the same block can be loaded without decompressing it again. The least
+// ? recently used blocks are freed first. Specify '0' to disable the cache.
+// ? The default is 16 megabytes.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "ast_blockcache", "16777216",
+  CB(ArchiveSetCacheSize, size_t), TUINTEGER|PANY },
+/* ------------------------------------------------------------------------- */
+// ! SQL_STMTCACHE
+// ? Specifies the maximum number of prepared statements each database keeps
+// ? so repeated queries do not have to be compiled again. The least recently
+// ? used statements are finalised first. Specify '0' to disable the cache.
+// ? The default is 32 statements.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "sql_stmtcache", "32",
+  CB(SqlSetStmtCacheSize, size_t), TUINTEGER|PANY },
+/* ------------------------------------------------------------------------- */
+// ! SQL_BATCHWINDOW
+// ? Specifies the time in milliseconds the database thread waits for more
+// ? queries after one is queued with Sql:ExecAsync() or by a cvar autosave so
+// ? they can all be written in one transaction. Specify '0' to write queries
+// ? as soon as they are queued. The default is 10 milliseconds.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "sql_batchwindow", "10",
+  CB(SqlBatchWindowModified, uint64_t), TUINTEGER|PANY },
 /* == Error cvars ========================================================== */
 // ! ERR_ADMIN
 // ? Throws an error if the user is running the engine with elevated
@@ -907,6 +974,15 @@ CVarItemStaticList{{
 { CFL_AUDIO, "aud_numsources", "0",
   CB(SourceSetCount, size_t), TUINTEGERSAVE|PANY },
 /* ------------------------------------------------------------------------- */
+// ! AUD_SAMCOMPRESS
+// ? Specifies the decoded size (in bytes) at which a Sample loaded from an OGG
+// ? file is kept compressed in memory instead. Compressed samples are decoded
+// ? by the audio thread when played into a few recycled buffers that use the
+// ? same count and size as Stream classes. Zero keeps all samples decoded.
+/* ------------------------------------------------------------------------- */
+{ CFL_AUDIO, "aud_samcompress", "4194304",
+  CB(SampleSetCompress, size_t), TUINTEGERSAVE|PANY },
+/* ------------------------------------------------------------------------- */
 // ! AUD_SAMVOL
 // ? Specifies the volume of Sample classes. 0.0 (mute) to
 // ? 1.0 (maximum volume).
@@ -1235,6 +1311,15 @@ CVarItemStaticList{{
 /* ------------------------------------------------------------------------- */
 { CFL_AUDIOVIDEO, "fmv_maxdrift", "0.25",
   CB(VideoSetMaximumDrift, double), TUFLOATSAVE|PANY },
+/* ------------------------------------------------------------------------- */
+// ! FMV_PAGES
+// ? For each 'Video' class, a separate thread reads and demuxes this many Ogg
+// ? pages ahead of the decoding thread. It must be a power of two. Changing
+// ? this value only takes effect the next time a 'Video' object is
+// ? constructed.
+/* ------------------------------------------------------------------------- */
+{ CFL_AUDIOVIDEO, "fmv_pages", "64",
+  CB(VideoSetPageQueueSize, size_t), TUINTEGERSAVE|CPOW2|PANY },
 /* == Input cvars ========================================================== */
 // ! INP_CLAMPMOUSE
 // ? When enabled (default) the mouse cursor is clamped to the window edge.
@@ -1361,6 +1446,34 @@ CVarItemStaticList{{
 /* ------------------------------------------------------------------------- */
 { CFL_BASIC, "net_useragent", "",
   CBSTR(SocketAgentModified), TSTRING|MTRIM|PNOUI },
+/* ------------------------------------------------------------------------- */
+// ! NET_REACTOR
+// ? Specifies the number of shared event threads that drive sockets and HTTP
+// ? requests with non-blocking I/O. The default of 0 gives every connection
+// ? its own reader and writer threads. A value of 1 to 8 spreads connections
+// ? over that many threads instead which scales much better with many
+// ? connections. WebSocket requests always use their own threads. Not
+// ? supported on Windows yet.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "net_reactor", "0",
+  CB(SocketSetReactors, size_t), TUINTEGER|PANY },
+/* ------------------------------------------------------------------------- */
+// ! NET_KEEPALIVE
+// ? Specifies the number of seconds a HTTP connection is kept open after a
+// ? request completes so the next request to the same server can reuse it
+// ? without connecting and negotiating TLS again. Specify 0 to close every
+// ? connection after its request. Default is 15 seconds.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "net_keepalive", "15",
+  CB(SocketSetKeepAlive, double), TUFLOAT|PANY },
+/* ------------------------------------------------------------------------- */
+// ! NET_KEEPALIVEMAX
+// ? Specifies the maximum number of idle HTTP connections kept open for
+// ? reuse. The connection idle for the longest is closed when the limit is
+// ? reached. Specify 0 to close every connection after its request.
+/* ------------------------------------------------------------------------- */
+{ CFL_BASIC, "net_keepalivemax", "8",
+  CB(SocketSetKeepAliveMax, size_t), TUINTEGER|PANY },
 /* == Video cvars ========================================================== */
 // ! VID_API
 // ? Specifies the API to use. This is only used for troubleshooting purposes
@@ -1589,6 +1702,16 @@ CVarItemStaticList{{
 { CFL_VIDEO, "vid_orwidth", "640",
   CB(cDisplay->DisplaySetMatrixWidth, GLfloat), TUFLOAT|PNOUI },
 /* ------------------------------------------------------------------------- */
+// ! VID_PACKVERTS
+// ? Set to 1 to upload frame buffer vertices in a compact format with 8-bit
+// ? colour components and share the four corners of each quad through an
+// ? index buffer. This cuts the vertex data uploaded per frame by more than
+// ? half in sprite heavy scenes at the cost of some processing before upload.
+// ? Colour intensities are rounded to 1/255th. Default is 0 (disabled).
+/* ------------------------------------------------------------------------- */
+{ CFL_VIDEO, "vid_packverts", "0",
+  CB(FboSetPackedVertices, bool), TBOOLEAN|PANY },
+/* ------------------------------------------------------------------------- */
 // ! VID_PROFILE
 // ? Specifies the type of profile to create the context for. This is only used
 // ? for troubleshooting purposes only and serves no other purpose. Select 0
@@ -406,7 +406,7 @@ struct CVars :                         // Start of vars class
     return astCommitted;
   }
   /* ----------------------------------------------------------------------- */
-  size_t CVarsSaveToDatabase()
+  size_t CVarsSaveToDatabase(const bool bAsync=false)
   { // If there is no database?
     if(!cSql->SqlIsOpened())
     { // Log error silently and return
@@ -414,10 +414,18 @@ struct CVars :                         // Start of vars class
       return StdNPos;
     } // Return if there is no table
     if(cSql->SqlCVarCreateTable() == CTR_FAIL) return StdNPos;
-    // Begin transaction and if failed? Log error silently
-    if(cSql->SqlBegin() == SQLITE_ERROR)
-      cLog->LogWarningExSafe("CVars commit begin transaction failed ($)! $.",
-        cSql->SqlGetError(), cSql->SqlGetErrorAsIdString());
+    // Queue writes to the database thread which writes them in one
+    // transaction so the engine thread does not have to wait for the disk.
+    if(bAsync) cSql->FlagSet(SF_ASYNCCVARS);
+    // Writing now? Wait for queued writes so they don't overwrite these
+    else
+    { // Wait for queued writes
+      cSql->SqlAsyncWait();
+      // Begin transaction and if failed? Log error silently
+      if(cSql->SqlBegin() == SQLITE_ERROR)
+        cLog->LogWarningExSafe("CVars commit begin transaction failed ($)! $.",
+          cSql->SqlGetError(), cSql->SqlGetErrorAsIdString());
+    }
     // Total number of commits attempted which may need to be read and
     // written by multiple threads.
     AtomicSizeT astCommitTotal{0}, astPurgeTotal{0};
@@ -440,8 +448,10 @@ struct CVars :                         // Start of vars class
       astCommitTotal += astCommit;
       astPurgeTotal += astPurge;
     });
+    // Writes were queued? Stop queueing writes
+    if(bAsync) cSql->FlagClear(SF_ASYNCCVARS);
     // End transaction and if failed? Log error silently
-    if(cSql->SqlEnd() == SQLITE_ERROR)
+    else if(cSql->SqlEnd() == SQLITE_ERROR)
       cLog->LogWarningExSafe("CVars commit end transaction failed ($)! $.",
         cSql->SqlGetError(), cSql->SqlGetErrorAsIdString());
     // Get total changes and show a message on total changes
@@ -51,6 +51,7 @@ namespace E {                          // Start of engine namespace
 #include "fstream.hpp"                 // File IO utility header
 #include "mutex.hpp"                   // Mutex helper class
 #include "log.hpp"                     // Logging helper class header
+#include "profile.hpp"                 // Frame profiler header
 #include "ifillcon.hpp"                // Init filled container header
 #include "luadef.hpp"                  // Lua definitions header
 #include "luaident.hpp"                // Lua ident class header
@@ -59,6 +60,7 @@ namespace E {                          // Start of engine namespace
 #include "collect.hpp"                 // Class collector utility header
 #include "stat.hpp"                    // Statistic utility class header
 #include "thread.hpp"                  // Thread helper class header
+#include "jobs.hpp"                    // Worker thread pool header
 #include "evtcore.hpp"                 // Thread-safe event system core header
 #include "evtmain.hpp"                 // Main engine events system header
 #include "glfwutil.hpp"                // GLFW utility class header
@@ -139,6 +141,7 @@ namespace E {                          // Start of engine namespace
 #include "ft.hpp"                      // Freetype base class
 #include "ftf.hpp"                     // Freetype font handling class header
 #include "font.hpp"                    // Font loading and printing header
+#include "layout.hpp"                  // Cached font text layout header
 #include "file.hpp"                    // FStream+FileMap class header
 #include "clip.hpp"                    // Clipboard class header
 #include "congfx.hpp"                  // Console graphics class header
@@ -157,6 +160,7 @@ namespace E {                          // Start of engine namespace
 #include "audio.hpp"                   // Audio base management class header
 #include "luavar.hpp"                  // Lua variable class
 #include "luacmd.hpp"                  // Lua console command class
+#include "luaprof.hpp"                 // Lua call stack sampler header
 #include "lua.hpp"                     // Lua core subsystem header
 #include "core.hpp"                    // Core class header
 #include "lualib.hpp"                  // Lua function API library
@@ -25,7 +25,7 @@ enum EvtArgVarType : unsigned          // EvtArgVar variable types
 };/* ----------------------------------------------------------------------- */
 class EvtArgVar                        // Multi-type helps access event data
 { /* ----------------------------------------------------------------------- */
-  const EvtArgVarType  t;              // Variable type
+  EvtArgVarType        t;              // Variable type
   /* ----------------------------------------------------------------------- */
   union                                // Variables share same memory space
   { /* -- All these use the same memory ------------------------------------ */
@@ -70,6 +70,8 @@ class EvtArgVar                        // Multi-type helps access event data
   /* ----------------------------------------------------------------------- */
   StdString *StrPtr() const { return str; }
   StdString &Str() const { return *StrPtr(); }
+  /* -- Empty argument (only used to fill unused inline storage) ----------- */
+  EvtArgVar() : t(EAVT_MAX), vp(nullptr) {}
   /* ----------------------------------------------------------------------- */
   explicit EvtArgVar(const StdString &strV) :
     t(EAVT_STR), str(const_cast<StdString*>(&strV)) {}
@@ -98,6 +100,82 @@ class EvtArgVar                        // Multi-type helps access event data
   explicit EvtArgVar(const void*const vpP) :
     t(EAVT_PTR), vp(const_cast<void*>(vpP)) {}
 };/* ----------------------------------------------------------------------- */
+/* -- Event arguments list (stored inline so posting does not allocate) ---- */
+class EvtArgList                       // Members initially private
+{ /* -- Private typedefs --------------------------------------------------- */
+  static constexpr size_t stInline = 8; // Arguments stored without allocating
+  /* ----------------------------------------------------------------------- */
+  using Inline = StdArray<EvtArgVar, stInline>; // Inline arguments storage
+  using Spill  = StdVector<EvtArgVar>;          // Large arguments storage
+  /* -- Private variables -------------------------------------------------- */
+  Inline           aInline;            // Arguments when count is small
+  Spill            vSpill;             // Arguments when count is large
+  size_t           stCount;            // Number of arguments stored
+  /* -- Return the storage that is currently in use ------------------------ */
+  const EvtArgVar *Data() const
+    { return stCount > stInline ? vSpill.data() : aInline.data(); }
+  /* -- Return number of arguments --------------------------------- */ public:
+  size_t size() const { return stCount; }
+  bool empty() const { return !stCount; }
+  /* -- Access arguments --------------------------------------------------- */
+  const EvtArgVar *begin() const { return Data(); }
+  const EvtArgVar *end() const { return Data() + stCount; }
+  const EvtArgVar &front() const { return *begin(); }
+  const EvtArgVar &back() const { return end()[-1]; }
+  const EvtArgVar &operator[](const size_t stIndex) const
+    { return Data()[stIndex]; }
+  /* -- Clear arguments (any spilled memory is kept for reuse) ------------- */
+  void clear() { vSpill.clear(); stCount = 0; }
+  /* -- Add an argument ---------------------------------------------------- */
+  void emplace_back(const EvtArgVar &eavArg)
+  { // Still room in the inline storage? Store it there and return
+    if(stCount < stInline) { aInline[stCount++] = eavArg; return; }
+    // Inline storage just filled up? Move it into the spill storage. This
+    // should be very rare as events rarely have this many arguments.
+    if(stCount == stInline)
+      vSpill.assign(aInline.cbegin(), aInline.cend());
+    // Add to spill storage
+    vSpill.emplace_back(eavArg);
+    ++stCount;
+  }
+  /* -- Move assignment operator ------------------------------------------- */
+  EvtArgList &operator=(EvtArgList &&ealOther)
+  { // Copy inline storage and take spilled storage
+    aInline = ealOther.aInline;
+    vSpill = StdMove(ealOther.vSpill);
+    stCount = ealOther.stCount;
+    // Other list is now empty
+    ealOther.stCount = 0;
+    // Return self
+    return *this;
+  }
+  /* -- Copy assignment operator ------------------------------------------- */
+  EvtArgList &operator=(const EvtArgList &ealOther)
+  { // Copy inline storage and copy spilled storage into our own so any
+    // memory we already have is reused.
+    aInline = ealOther.aInline;
+    vSpill.assign(ealOther.vSpill.cbegin(), ealOther.vSpill.cend());
+    stCount = ealOther.stCount;
+    // Return self
+    return *this;
+  }
+  /* -- Move constructor --------------------------------------------------- */
+  EvtArgList(EvtArgList &&ealOther) :
+    /* -- Initialisers ----------------------------------------------------- */
+    aInline{ ealOther.aInline },       // Copy inline arguments
+    vSpill{ StdMove(ealOther.vSpill) },// Move spilled arguments
+    stCount(ealOther.stCount)          // Copy number of arguments
+    /* -- Other list is now empty ------------------------------------------ */
+    { ealOther.stCount = 0; }
+  /* -- Copy constructor --------------------------------------------------- */
+  EvtArgList(const EvtArgList &) = default;
+  /* -- Default constructor ------------------------------------------------ */
+  EvtArgList() :
+    /* -- Initialisers ----------------------------------------------------- */
+    stCount(0)                         // No arguments
+    /* -- No code ---------------------------------------------------------- */
+    {}
+};/* ----------------------------------------------------------------------- */
 /* -- Common events system (since we need to use this twice) --------------- */
 template<typename Cmd,                 // Variable type of command to use
          size_t   EvtMaxEvents,        // Maximum number of events
@@ -106,20 +184,18 @@ template<typename Cmd,                 // Variable type of command to use
 class EvtCore :                        // Start of common event system class
   /* -- Base classes ------------------------------------------------------- */
   public NameStr,                      // Identifier of event list
-  public MutexLock                     // Primary events list mutex
+  public MutexLock                     // Overflow events list mutex
 { /* -- Typedefs --------------------------------------------------- */ public:
   struct Event;                          // (Prototype) Event packet info
   using CbEcFuncT = void(const Event&);  // Event callback type
   using CbEcFunc  = function<CbEcFuncT>; // Actual event callback
   /* ----------------------------------------------------------------------- */
-  using Funcs        = StdArray<CbEcFunc, EvtMaxEvents>; // Reg'd events vector
-  using Queue        = StdList<Event>;                   // Current event queue
-  using QueueConstIt = typename Queue::const_iterator;   // Current event queue
+  using Funcs = StdArray<CbEcFunc, EvtMaxEvents>; // Reg'd events vector
   /* ----------------------------------------------------------------------- */
   using RegPair = StdPair<const Cmd, const CbEcFunc>; // Event cmd and cb func
   using RegVec  = const StdVector<RegPair>;           // Event list
   /* ----------------------------------------------------------------------- */
-  using EvtArgs = StdVector<EvtArgVar>; // Vector of RegPairs
+  using EvtArgs = EvtArgList;          // Event arguments list
   /* ----------------------------------------------------------------------- */
   using ISList = LookupArray<EvtMaxEvents>; // Events as strings
   const ISList &islEventStrings;            // Actual variable
@@ -173,16 +249,66 @@ class EvtCore :                        // Start of common event system class
       eaArgs{ StdMove(cOther.eaArgs) } // Move other parameters
       /* -- No code -------------------------------------------------------- */
       {}
-  };/* -- Private variables --------------------------------------- */ private:
+  };/* --------------------------------------------------------------------- */
+  struct Ticket                        // Identifies a queued event
+  { /* --------------------------------------------------------------------- */
+    size_t         stId;               // Queue position or overflow serial
+    bool           bOverflow;          // Event was queued in overflow list
+    /* -- Compare tickets -------------------------------------------------- */
+    bool operator==(const Ticket &tOther) const
+      { return stId == tOther.stId && bOverflow == tOther.bOverflow; }
+  };/* --------------------------------------------------------------------- */
+  static constexpr const Ticket tNone{ StdMaxSizeT, false }; // Empty ticket
+  /* -- Private typedefs ------------------------------------------ */ private:
+  struct Slot                          // Queued event data
+  { /* --------------------------------------------------------------------- */
+    Cmd            cCmd;               // Command sent
+    const CbEcFunc *cbfpFunc;          // Function to call
+    EvtArgs        eaArgs;             // User parameters
+  };/* --------------------------------------------------------------------- */
+  struct Cell : public Slot            // Ring buffer slot
+  { /* --------------------------------------------------------------------- */
+    AtomicSizeT    astSequence;        // Sequence number of slot
+    AtomicSizeT    astTicket;          // Queue position (StdMaxSizeT=cancel)
+  };/* --------------------------------------------------------------------- */
+  struct Spill : public Slot           // Overflow list item
+  { /* --------------------------------------------------------------------- */
+    size_t         stTicket;           // Overflow serial number
+  };/* --------------------------------------------------------------------- */
+  static constexpr size_t stCapacity = 1024, // Maximum events (power of two)
+                          stMask = stCapacity - 1; // Mask to wrap position
+  /* ----------------------------------------------------------------------- */
+  using Ring     = StdArray<Cell, stCapacity>; // Ring buffer of events
+  using Overflow = StdList<Spill>;             // Events when ring is full
+  /* -- Private variables -------------------------------------------------- */
   const CbEcFunc   cefEmpty;           // Empty function
   Funcs            fFuncs;             // Event callback storage
-  Queue            qlEvents;           // Primary events list
+  Ring             rEvents;            // Primary events ring buffer
+  AtomicSizeT      astEnqueue,         // Next position to write in ring
+                   astDequeue,         // Next position to read in ring
+                   astDepth,           // Number of events queued
+                   astHighWater,       // Highest number of events queued
+                   astOverflowed,      // Events that went to overflow list
+                   astSpilled;         // Events currently in overflow list
+  AtomicBool       abDraining;         // Events are being processed
+  Overflow         oEvents;            // Overflow events list (locked)
+  size_t           stSerial;           // Overflow serial number (locked)
   /* -- Generic event that reports use as warning -------------------------- */
   void WarningFunction(const Event &eEvent)
   { // Log the error
     cLog->LogWarningExSafe("$ ignored unregistered event $<$>.",
       NameGet(), IdToString(eEvent.cCmd), eEvent.cCmd);
   }
+  /* -- Prepare parameters list (finisher) --------------------------------- */
+  static void Params(EvtArgs&) {}
+  /* -- Prepare parameters list (parameters) ------------------------------- */
+  template<typename ...VarArgs, typename AnyType>
+    static void Params(EvtArgs &eaArgs, AnyType atArg,
+      const VarArgs ...vaArgs)
+  { // Place parameter in list and add more parameters or finish
+    eaArgs.emplace_back(EvtArgVar{ atArg });
+    Params(eaArgs, vaArgs...);
+  }
   /* -- Execute specified event NOW (finisher) ----------------------------- */
   void ExecuteParam(const Cmd cCmd, EvtArgs &eaArgs)
   { // Get callback function and execute callback function
@@ -198,127 +324,223 @@ class EvtCore :                        // Start of common event system class
     const VarArgs ...vaArgs)
   { // Insert parameter into list and add more parameters. It only accepts
     // simple integers and pointers, hence why the direct copy on ...vaArgs.
-    eaArgs.push_back(EvtArgVar{ atArg });
+    eaArgs.emplace_back(EvtArgVar{ atArg });
     ExecuteParam(cCmd, eaArgs, vaArgs...);
   }
-  /* -- Add with copy parameter semantics (finisher) ----------------------- */
-  void AddParam(const Cmd cCmd, EvtArgs &eaArgs)
-  { // Event data to add to events list
-    Event eEvent{ cCmd, fFuncs[cCmd], StdMove(eaArgs) };
-    // Try to lock main event list and move cell into event list
-    MutexCall([this, &eEvent](){ qlEvents.emplace_back(StdMove(eEvent)); });
+  /* -- An event was queued ------------------------------------------------ */
+  void Queued()
+  { // Increment queue depth and update high water mark if higher
+    const size_t stDepth = ++astDepth;
+    size_t stHighWater = astHighWater;
+    while(stDepth > stHighWater &&
+      !astHighWater.compare_exchange_weak(stHighWater, stDepth));
   }
-  /* -- Add with copy parameter semantics (parameters) --------------------- */
-  template<typename ...VarArgs, typename AnyType>
-    void AddParam(const Cmd cCmd,      // cppcheck-suppress functionStatic
-      EvtArgs &eaArgs, AnyType atArg,
-      const VarArgs ...vaArgs)
-  { // Place parameter in list and add more parameters or finish
-    eaArgs.emplace_back(EvtArgVar{ atArg });
-    AddParam(cCmd, eaArgs, vaArgs...);
+  /* -- Claim a ring slot to write to (nullptr if full) -------------------- */
+  Cell *RingClaim(size_t &stPos)
+  { // Get current write position and keep trying...
+    stPos = astEnqueue;
+    for(;;)
+    { // Get cell at this position and compare its sequence with the position
+      Cell &cCell = rEvents[stPos & stMask];
+      const int64_t llDiff =
+        static_cast<int64_t>(cCell.astSequence - stPos);
+      // Cell is free? Try to claim it and try again if another thread beat us
+      if(!llDiff)
+      { if(astEnqueue.compare_exchange_weak(stPos, stPos + 1)) return &cCell;
+        continue; }
+      // Ring is full?
+      if(llDiff < 0) return nullptr;
+      // Another thread moved the position so reload it
+      stPos = astEnqueue;
+    }
   }
+  /* -- Take next event from the ring (only called by the drainer) --------- */
+  bool RingPop(Slot &sEvent, bool &bCancelled)
+  { // Get cell at the read position and return if it isn't populated yet.
+    // There is only one consumer so no need to compete for the position.
+    const size_t stPos = astDequeue;
+    Cell &cCell = rEvents[stPos & stMask];
+    if(cCell.astSequence != stPos + 1) return false;
+    // Take the event and check it wasn't cancelled
+    bCancelled = cCell.astTicket.exchange(StdMaxSizeT) != stPos;
+    sEvent.cCmd = cCell.cCmd;
+    sEvent.cbfpFunc = cCell.cbfpFunc;
+    // Copy the arguments rather than moving them so the slot keeps any
+    // spilled storage for the next producer to reuse.
+    sEvent.eaArgs = cCell.eaArgs;
+    // Release the slot to producers
+    astDequeue = stPos + 1;
+    cCell.astSequence = stPos + stCapacity;
+    // Success
+    return true;
+  }
+  /* -- Take next event from overflow list (only called by the drainer) ---- */
+  bool OverflowPop(Slot &sEvent)
+  { // Ignore if there are no overflowed events
+    if(!astSpilled) return false;
+    // Lock the overflow list
+    return MutexCall([this, &sEvent](){
+      // Return if cancelled in the meantime
+      if(oEvents.empty()) return false;
+      // Take the event
+      Spill &sSpill = oEvents.front();
+      sEvent.cCmd = sSpill.cCmd;
+      sEvent.cbfpFunc = sSpill.cbfpFunc;
+      sEvent.eaArgs = StdMove(sSpill.eaArgs);
+      oEvents.pop_front();
+      // Overflow list is smaller
+      --astSpilled;
+      // Success
+      return true;
+    });
+  }
+  /* -- Take next event from any list (only called by the drainer) --------- */
+  bool Pop(Slot &sEvent, bool &bCancelled)
+  { // Ring buffer has the event? Success
+    if(RingPop(sEvent, bCancelled)) return --astDepth, true;
+    // Check overflow list
+    bCancelled = false;
+    if(OverflowPop(sEvent)) return --astDepth, true;
+    // Nothing queued
+    return false;
+  }
+  /* -- Wait for exclusive access to drain the queue ----------------------- */
+  void DrainLock() { while(abDraining.exchange(true)) StdSuspend(); }
+  void DrainUnlock() { abDraining = false; }
   /* -- Lock access to events list and return if queue is empty ---- */ public:
-  bool Empty() { return MutexCall([this](){ return qlEvents.empty(); }); }
+  bool Empty() const { return !astDepth; }
   /* -- Convert event id to string ----------------------------------------- */
   const StdStringView &IdToString(const Cmd cCmd) const
     { return islEventStrings.Get(cCmd); }
-  /* -- Lock access to events list and return number of elements in queue -- */
-  size_t SizeSafe() { return MutexCall([this](){ return qlEvents.size(); }); }
-  /* -- Returns the final iterator ----------------------------------------- */
-  QueueConstIt Last() { return qlEvents.cend(); }
-  /* -- Manage with lock --------------------------------------------------- */
+  /* -- Return number of events in queue ----------------------------------- */
+  size_t SizeSafe() const { return astDepth; }
+  /* -- Return the highest number of events that were queued --------------- */
+  size_t HighWater() const { return astHighWater; }
+  /* -- Return number of events that didn't fit in the ring buffer --------- */
+  size_t Overflowed() const { return astOverflowed; }
+  /* -- Return maximum number of events in the ring buffer ----------------- */
+  static size_t Capacity() { return stCapacity; }
+  /* -- Manage events ------------------------------------------------------ */
   Cmd Manage()
-  { // Try to lock access to events list.
-    return MutexUniqueCall([this](UniqueLock &ulLock){
-      // Since we call this in our engine loop. We are in a time critical
-      // situation so we need to continue executing instead of waiting for
-      // other threads to post events. So just return no event if threads are
-      // busy posting events.
-      if(!ulLock.owns_lock()) return EvtNone;
-      // Until event list is empty
-      while(!qlEvents.empty())
-      { // Copy latest event data and then erase it from list
-        const Event epData{ StdMove(qlEvents.front()) };
-        qlEvents.pop_front();
-        // Log event if loggable
-        if(epData.cCmd < EvtNoLog)
-          cLog->LogDebugExSafe("$ system processing event $<$>.",
-            NameGet(), IdToString(epData.cCmd), epData.cCmd);
-        // No callback? Return command to loop
-        if(!epData.cbfFunc) return epData.cCmd;
-        // Unlock the mutex while we execute the callback. This is so more
-        // events can be appended while this one is being processed.
-        const UniqueRelock urLock{ ulLock };
-        // Execute the event callback
-        epData.cbfFunc(epData);
-      } // Return no significant event
-      return EvtNone;
-    }, try_to_lock);
+  { // Since we call this in our engine loop. We are in a time critical
+    // situation so if events are already being processed by a callback then
+    // just return no event.
+    if(abDraining.exchange(true)) return EvtNone;
+    // Event data taken from the queue
+    Slot sEvent{ EvtNone, nullptr, {} };
+    bool bCancelled;
+    // Until event list is empty
+    while(Pop(sEvent, bCancelled))
+    { // Ignore if the event was cancelled
+      if(bCancelled) continue;
+      // Log event if loggable
+      if(sEvent.cCmd < EvtNoLog)
+        cLog->LogDebugExSafe("$ system processing event $<$>.",
+          NameGet(), IdToString(sEvent.cCmd), sEvent.cCmd);
+      // No callback? Return command to loop
+      if(!*sEvent.cbfpFunc) { DrainUnlock(); return sEvent.cCmd; }
+      // Copy event data
+      const Event epData{ sEvent.cCmd, *sEvent.cbfpFunc,
+        StdMove(sEvent.eaArgs) };
+      // Release the queue while we execute the callback so the callback can
+      // process events too, then take exclusive access again.
+      DrainUnlock();
+      epData.cbfFunc(epData);
+      DrainLock();
+    } // Return no significant event
+    DrainUnlock();
+    return EvtNone;
   }
   /* -- Flush events list -------------------------------------------------- */
   void Flush()
-  { // Lock access to the events list from other threads
-    if(const size_t stCleared = MutexCall([this]()->size_t{
-      // Return if no events to clear
-      if(qlEvents.empty()) return 0;
-      // Store number of events cleared
-      const size_t stCount = qlEvents.size();
-      // Clear the events list
-      qlEvents.clear();
-      // Return events cleared
-      return stCount;
-    })) // Write number of events cleared
+  { // Get exclusive access to drain the queue
+    DrainLock();
+    // Event data taken from the queue
+    Slot sEvent{ EvtNone, nullptr, {} };
+    bool bCancelled;
+    // Discard all the events
+    size_t stCleared = 0;
+    while(Pop(sEvent, bCancelled)) if(!bCancelled) ++stCleared;
+    // Done with the queue
+    DrainUnlock();
+    // Write number of events cleared
+    if(stCleared)
       cLog->LogDebugExSafe("$ cleared $ lingering events.",
         NameGet(), stCleared);
   }
   /* -- Execute specified event NOW (starter) ------------------------------ */
   template<typename ...VarArgs>
     void Execute(const Cmd cCmd, const VarArgs ...vaArgs)
-  { // Reserve memory for parameters
-    StdReserved<EvtArgs> eaArgs{ sizeof...(VarArgs) };
+  { // Arguments list is on the stack so this won't allocate
+    EvtArgs eaArgs;
     // Prepare parameters list and execute
     ExecuteParam(cCmd, eaArgs, vaArgs...);
   }
-  /* -- Add with copy parameter semantics (starter) ------------------------ */
+  /* -- Queue an event and return the ticket of the event copy params ------ */
   template<typename ...VarArgs>
-    void Add(const Cmd cCmd, const VarArgs ...vaArgs)
-  { // Reserve memory for parameters
-    StdReserved<EvtArgs> eaArgs{ sizeof...(VarArgs) };
-    // Prepare parameters list and add a new event
-    AddParam(cCmd, eaArgs, vaArgs...);
-  }
-  /* -- Add to events and return iterator (finisher) ----------------------- */
-  void AddExParam(const Cmd cCmd, QueueConstIt &qciItem, EvtArgs &eaArgs)
-  { // Setup cell to insert
-    Event eEvent{ cCmd, fFuncs[cCmd], StdMove(eaArgs) };
-    // Try to lock event list and push new event whilst move parameters into it
-    MutexCall([this, &qciItem, &eEvent](){
-      qciItem = StdMove(qlEvents.emplace(qlEvents.cend(), StdMove(eEvent)));
+    const Ticket AddEx(const Cmd cCmd, const VarArgs ...vaArgs)
+  { // Get callback function
+    const CbEcFunc*const cbfpFunc = &fFuncs[cCmd];
+    // If there are no events in the overflow list (to keep order) and we can
+    // claim a slot in the ring buffer?
+    size_t stPos;
+    if(Cell*const cpCell = astSpilled ? nullptr : RingClaim(stPos))
+    { // Write event data directly into the slot
+      cpCell->cCmd = cCmd;
+      cpCell->cbfpFunc = cbfpFunc;
+      cpCell->eaArgs.clear();
+      Params(cpCell->eaArgs, vaArgs...);
+      cpCell->astTicket = stPos;
+      // Update counters and publish the slot to the drainer
+      Queued();
+      cpCell->astSequence = stPos + 1;
+      // Return ticket
+      return { stPos, false };
+    } // Ring buffer is full so lock the overflow list
+    return MutexCall([this, cCmd, cbfpFunc, &vaArgs...](){
+      // Add a new event and set its data
+      Spill &sSpill = oEvents.emplace_back();
+      sSpill.cCmd = cCmd;
+      sSpill.cbfpFunc = cbfpFunc;
+      Params(sSpill.eaArgs, vaArgs...);
+      sSpill.stTicket = stSerial++;
+      // Update counters
+      ++astOverflowed;
+      ++astSpilled;
+      Queued();
+      // Return ticket
+      return Ticket{ sSpill.stTicket, true };
     });
   }
-  /* -- Add to events and return iterator (parameters) --------------------- */
-  template<typename ...VarArgs, typename AnyType>
-    void AddExParam(const Cmd cCmd,    // cppcheck-suppress functionStatic
-      QueueConstIt &qciItem, EvtArgs &eaArgs, AnyType atArg,
-      const VarArgs ...vaArgs)
-  { // Place parameter into parameter list and add more parameters or finish
-    eaArgs.emplace_back(EvtArgVar{ atArg });
-    AddExParam(cCmd, qciItem, eaArgs, vaArgs...);
-  }
-  /* -- Queue and event and return the id of the event copy params --------- */
+  /* -- Queue an event with copy parameter semantics ----------------------- */
   template<typename ...VarArgs>
-    const QueueConstIt AddEx(const Cmd cCmd, const VarArgs ...vaArgs)
-  { // Iterator to return
-    QueueConstIt qciItem;
-    // Reserve parameters list
-    StdReserved<EvtArgs> eaArgs{ sizeof...(VarArgs) };
-    // Prepare parameters list and execute
-    AddExParam(cCmd, qciItem, eaArgs, vaArgs...);
-    // Return iterator
-    return qciItem;
+    void Add(const Cmd cCmd, const VarArgs ...vaArgs)
+      { AddEx(cCmd, vaArgs...); }
+  /* -- Cancel a queued event (false if already processed) ----------------- */
+  bool Cancel(const Ticket &tTicket)
+  { // Event in the ring buffer?
+    if(!tTicket.bOverflow)
+    { // Ignore empty tickets
+      if(tTicket.stId == StdMaxSizeT) return false;
+      // Mark the slot as cancelled if the drainer hasn't already taken it
+      size_t stExpect = tTicket.stId;
+      return rEvents[stExpect & stMask].astTicket.
+        compare_exchange_strong(stExpect, StdMaxSizeT);
+    } // Lock the overflow list
+    return MutexCall([this, &tTicket](){
+      // Find the event and return if it was already processed
+      const auto oiIt = StdFindIf(seq, oEvents.cbegin(), oEvents.cend(),
+        [&tTicket](const Spill &sSpill)
+          { return sSpill.stTicket == tTicket.stId; });
+      if(oiIt == oEvents.cend()) return false;
+      // Remove the event
+      oEvents.erase(oiIt);
+      --astSpilled;
+      --astDepth;
+      // Success
+      return true;
+    });
   }
-  /* -- Remove event (lock is caller responsibility) ----------------------- */
-  void RemoveUnsafe(const QueueConstIt &qciIt) { qlEvents.erase(qciIt); }
   /* -- Register single event ---------------------------------------------- */
   void Register(const Cmd cCmd, const CbEcFunc &cbfFunc)
     { fFuncs[cCmd] = cbfFunc; }
@@ -330,9 +552,22 @@ class EvtCore :                        // Start of common event system class
     Name{ strCName },                  // Initialise event system name
     islEventStrings{ islStrings },     // Initialise event id names
     cefEmpty{ bind(&EvtCore::WarningFunction, this, _1) },
-    fFuncs{ FillConGeneric<Funcs>(cefEmpty) }
-    /* -- No code ---------------------------------------------------------- */
-    {}
+    fFuncs{ FillConGeneric<Funcs>(cefEmpty) },
+    astEnqueue{ 0 },                   // Initialise write position
+    astDequeue{ 0 },                   // Initialise read position
+    astDepth{ 0 },                     // Initialise queue depth
+    astHighWater{ 0 },                 // Initialise queue high water mark
+    astOverflowed{ 0 },                // Initialise overflowed events
+    astSpilled{ 0 },                   // Initialise overflow list size
+    abDraining{ false },               // Not processing events
+    stSerial(0)                        // Initialise overflow serial number
+    /* -- Initialise sequence numbers -------------------------------------- */
+    { for(size_t stIndex = 0; stIndex < stCapacity; ++stIndex)
+      { Cell &cCell = rEvents[stIndex];
+        cCell.cCmd = EvtNone;
+        cCell.cbfpFunc = nullptr;
+        cCell.astSequence = stIndex;
+        cCell.astTicket = StdMaxSizeT; } }
 };/* ----------------------------------------------------------------------- */
 }                                      // End of public module namespace
 /* ------------------------------------------------------------------------- */
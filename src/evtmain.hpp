@@ -12,8 +12,9 @@ namespace IEvtMain {                   // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IEvtCore::P;           using namespace IHelper::P;
 using namespace ILog::P;               using namespace ILookupArray::P;
-using namespace IMutex::P;             using namespace IStd::P;
-using namespace ISysUtil::P;           using namespace IThread::P;
+using namespace IMutex::P;             using namespace IProfile::P;
+using namespace IStd::P;               using namespace ISysUtil::P;
+using namespace IThread::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Available engine commands -------------------------------------------- */
@@ -78,12 +79,13 @@ enum EvtMainCmd : size_t               // Engine thread event commands
   EMC_MP_PCM,                          // 46: Pcm async event occured
   EMC_MP_PROCESS,                      // 47: Process async event occured
   EMC_MP_SOCKET,                       // 48: Socket async event occured
-  EMC_MP_STREAM,                       // 49: Stream async event occured
-  EMC_MP_VIDEO,                        // 50: Video async event occured
+  EMC_MP_SQL,                          // 49: Sql async query completed
+  EMC_MP_STREAM,                       // 50: Stream async event occured
+  EMC_MP_VIDEO,                        // 51: Video async event occured
   /* ----------------------------------------------------------------------- */
-  EMC_MAX,                             // 51: Below are just codes
+  EMC_MAX,                             // 52: Below are just codes
   /* ----------------------------------------------------------------------- */
-  EMC_LUA_ERROR,                       // 52: Error in LUA exec (not an event)
+  EMC_LUA_ERROR,                       // 53: Error in LUA exec (not an event)
   /* ----------------------------------------------------------------------- */
 #if defined(ALPHA)                     // Compiling debug version?
   EMC_NOLOG = EMC_MAX                  // Log all events
@@ -202,7 +204,9 @@ class EvtMain :                        // Event list for render thread
   }
   /* -- Handle events from parallel loop ----------------------------------- */
   bool HandleSafe()
-  { // Main thread requested break? Why bother managing events?
+  { // Record time spent handling events
+    const ProfileZone pzZone{ "EvtMain::HandleSafe" };
+    // Main thread requested break? Why bother managing events?
     if(tEngThread.ThreadShouldExit()) return false;
     // Which event?
     switch(Manage())
@@ -271,7 +275,8 @@ class EvtMain :                        // Event list for render thread
       EMC(INP_MOUSEMOVE), EMC(INP_MOUSESCROLL),  EMC(MP_ARCHIVE),
       EMC(MP_ASSET),      EMC(MP_FONT),          EMC(MP_IMAGE),
       EMC(MP_JSON),       EMC(MP_PCM),           EMC(MP_PROCESS),
-      EMC(MP_SOCKET),     EMC(MP_STREAM),        EMC(MP_VIDEO)
+      EMC(MP_SOCKET),     EMC(MP_SQL),           EMC(MP_STREAM),
+      EMC(MP_VIDEO)
 #undef EMC                             // Done with this macro
     }, "EMC_OTHER" },
     EvtCore{ "EvtMain", *this },       // Construct core
@@ -17,11 +17,11 @@ using namespace IFboItem::P;           using namespace IFrame::P;
 using namespace ILockable::P;          using namespace ILog::P;
 using namespace ILuaIdent::P;          using namespace ILuaLib::P;
 using namespace IName::P;              using namespace IOgl::P;
-using namespace ISerial::P;            using namespace IShader::P;
-using namespace IShaderDef::P;         using namespace IShaders::P;
-using namespace IStd::P;               using namespace IString::P;
-using namespace ISysUtil::P;           using namespace IUtil::P;
-using namespace Lib::OS::GlFW::Types;
+using namespace IProfile::P;           using namespace ISerial::P;
+using namespace IShader::P;            using namespace IShaderDef::P;
+using namespace IShaders::P;           using namespace IStd::P;
+using namespace IString::P;            using namespace ISysUtil::P;
+using namespace IUtil::P;              using namespace Lib::OS::GlFW::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* == Fbo collector class for collector data and custom variables ========== */
@@ -29,6 +29,12 @@ CTOR_BEGIN_NOBASE(Fbos, Fbo, CLHelperUnsafe,
  /* ------------------------------------------------------------------------ */
 Fbo               *fboActive;          // Pointer to active Fbo object
 Fbo               *fboMain;            // Pointer to main Fbo object
+FboPackedQuadVec   fpqvPacked;         // Packed quads scratch list
+StdVector<size_t>  stvPackedCmds;      // Packed quads per command
+FboTriVec          ftvCoalesced;       // Coalesced triangles scratch list
+FboCmdVec          fcvCoalesced;       // Coalesced commands scratch list
+StdVector<size_t>  stvCoalesced;       // Command order scratch list
+bool               bPackVerts;         // Upload packed vertices and indices
 );/* ----------------------------------------------------------------------- */
 /* == Fbo base class ======================================================= */
 class FboBase :                        // Fbo base class
@@ -44,11 +50,13 @@ class FboBase :                        // Fbo base class
   public DimGLSizei,                   // Fbo dimensions
   public Lockable                      // Lua lockable class
 { /* --------------------------------------------------------------- */ public:
-  bool             bClear;             // Clear the Fbo?
+  bool             bClear,             // Clear the Fbo?
+                   bCoalesce;          // Reorder commands by state?
   GLenum           glePolyMode;        // Frame buffer polygon mode
   FboCmdVec        fcvActive;          // Commands list
   CoordsGLFloat    cglfStage;          // Stage co-ordinates
   FboTriVec        ftvActive;          // Triangles list
+  StdVector<size_t> stvLayers;         // Command where each layer begins
   GLint            gliMagFilter,       // Frame buffer magnification filter
                    gliMinFilter,       // Frame buffer minification filter
                    gliPixFormat,       // Frame buffer pixel format
@@ -69,15 +77,15 @@ class FboBase :                        // Fbo base class
   explicit FboBase(const GLint iPixFmt, const bool bLockable) :
     /* -- Initialisers ----------------------------------------------------- */
     Lockable{ bLockable },             bClear(true),
-    glePolyMode(GL_FILL),              gliMagFilter(GL_NEAREST),
-    gliMinFilter(GL_NEAREST),          gliPixFormat(iPixFmt),
-    gliWrapMode(GL_CLAMP_TO_EDGE),     ofeFilterId(OF_N_N),
-    stCommandsFrame(0),                stGLArrayOff(0),
-    stTrianglesFrame(0),               stTrianglesLast(0),
-    gluFbo(0),                         gluFbotex(0),
-    gluTextureCache(0),                gluTexUnitCache(0),
-    gluShaderCache(0),                 ullActive(StdMaxUInt64),
-    ullFinish(ullActive)
+    bCoalesce(false),                  glePolyMode(GL_FILL),
+    gliMagFilter(GL_NEAREST),          gliMinFilter(GL_NEAREST),
+    gliPixFormat(iPixFmt),             gliWrapMode(GL_CLAMP_TO_EDGE),
+    ofeFilterId(OF_N_N),               stCommandsFrame(0),
+    stGLArrayOff(0),                   stTrianglesFrame(0),
+    stTrianglesLast(0),                gluFbo(0),
+    gluFbotex(0),                      gluTextureCache(0),
+    gluTexUnitCache(0),                gluShaderCache(0),
+    ullActive(StdMaxUInt64),           ullFinish(ullActive)
     /* --------------------------------------------------------------------- */
     {}
 };/* ----------------------------------------------------------------------- */
@@ -99,7 +107,8 @@ CTOR_MEM_BEGIN_CSLAVE(Fbos, Fbo, ICHelperUnsafe),
   void FboSetWireframe(const bool bWireframe)
     { glePolyMode = bWireframe ? GL_LINE : GL_FILL; }
   /* -- Flush all queues --------------------------------------------------- */
-  void FboClearLists() { ftvActive.clear(); fcvActive.clear(); }
+  void FboClearLists()
+    { ftvActive.clear(); fcvActive.clear(); stvLayers.clear(); }
   /* -- Flush all queues and reset caches----------------------------------- */
   void FboFlush()
   { // Flush the triangle and command list
@@ -173,10 +182,218 @@ CTOR_MEM_BEGIN_CSLAVE(Fbos, Fbo, ICHelperUnsafe),
       static_cast<GLsizei>(FboGetTrisCmd() * stVertexPerTriangle),
     });
   }
+  /* -- Offset a command buffer offset by where the data was streamed ------ */
+  static const GLvoid *FboStreamOffset(const size_t stBase,
+    const GLvoid*const vpOffset)
+  { return reinterpret_cast<const GLvoid*>(stBase +
+      reinterpret_cast<size_t>(vpOffset)); }
+  /* -- Return the first triangle drawn by a command ----------------------- */
+  static size_t FboCmdFirstTri(const FboCmd &fcData)
+    { return (reinterpret_cast<size_t>(fcData.vpTCOffset) -
+        stOffsetTxcData) / sizeof(FboTri); }
+  /* -- Convert a colour intensity to a normalised byte -------------------- */
+  static uint8_t FboPackIntensity(const GLfloat glfValue)
+    { return static_cast<uint8_t>
+        (UtilClamp(glfValue, 0.0f, 1.0f) * 255.0f + 0.5f); }
+  /* -- Convert a vertex to the packed format ------------------------------ */
+  static FboPackedVert FboPackVert(const FboVert &fvSrc)
+    { return { fvSrc.tcCoord, fvSrc.tvVertex, {
+        FboPackIntensity(fvSrc.tiColour[0]),
+        FboPackIntensity(fvSrc.tiColour[1]),
+        FboPackIntensity(fvSrc.tiColour[2]),
+        FboPackIntensity(fvSrc.tiColour[3]) } }; }
+  /* -- Return if two vertices are identical ------------------------------- */
+  static bool FboIsSameVert(const FboVert &fvA, const FboVert &fvB)
+    { return fvA.tcCoord == fvB.tcCoord && fvA.tvVertex == fvB.tvVertex &&
+             fvA.tiColour == fvB.tiColour; }
+  /* -- Upload and draw the triangles list as-is --------------------------- */
+  void FboRenderFloats(const size_t stBytes)
+  { // Stream the vertex data and get where it was written
+    const size_t stBase = cOgl->StreamUpload(stBytes, ftvActive.data());
+    // Enumerate each command in this order...
+    StdForEach(seq, fcvActive.cbegin(),
+      StdNext(fcvActive.cbegin(), UtilIntOrMax<ssize_t>(stCommandsFrame)),
+        [stBase](const FboCmd &fcData)
+    { // Set texture, texture unit and shader program
+      cOgl->ActiveTexture(fcData.gluTUId);
+      cOgl->BindTexture(fcData.gluTexId);
+      cOgl->UseProgram(fcData.gluPrgId);
+      // Prepare data arrays
+      cOgl->VertexAttribPointer(A_COORD, stCompsPerCoord, stBytesPerVertex,
+        FboStreamOffset(stBase, fcData.vpTCOffset));
+      cOgl->VertexAttribPointer(A_VERTEX, stCompsPerPos, stBytesPerVertex,
+        FboStreamOffset(stBase, fcData.vpVOffset));
+      cOgl->VertexAttribPointer(A_COLOUR, stCompsPerColour, stBytesPerVertex,
+        FboStreamOffset(stBase, fcData.vpCOffset));
+      // Draw data arrays
+      cOgl->DrawArraysTriangles(fcData.glsiVertices);
+    });
+  }
+  /* -- Pack the triangles list into indexed quads then upload and draw ---- */
+  void FboRenderPacked()
+  { // Get scratch lists and clear them
+    FboPackedQuadVec &fpqvQuads = cParent->fpqvPacked;
+    StdVector<size_t> &stvCmds = cParent->stvPackedCmds;
+    fpqvQuads.clear();
+    stvCmds.clear();
+    // For each command...
+    const FboCmdVecConstInt fcvciEnd =
+      StdNext(fcvActive.cbegin(), UtilIntOrMax<ssize_t>(stCommandsFrame));
+    for(FboCmdVecConstInt fcvciIt{ fcvActive.cbegin() };
+                          fcvciIt != fcvciEnd;
+                        ++fcvciIt)
+    { // Get the range of triangles this command draws
+      const FboCmd &fcData = *fcvciIt;
+      const size_t stFirst = FboCmdFirstTri(fcData),
+        stLast = stFirst +
+          static_cast<size_t>(fcData.glsiVertices) / stVertexPerTriangle,
+        stQuads = fpqvQuads.size();
+      // For each triangle in the command
+      for(size_t stTri = stFirst; stTri < stLast; ++stTri)
+      { // Get the triangle
+        const FboTri &ftT1 = ftvActive[stTri];
+        // If the next triangle shares our third and second vertices then it
+        // is the other half of a quad so it only costs one more vertex.
+        if(stTri + 1 < stLast &&
+           FboIsSameVert(ftvActive[stTri + 1][1], ftT1[2]) &&
+           FboIsSameVert(ftvActive[stTri + 1][2], ftT1[1]))
+          fpqvQuads.push_back({ FboPackVert(ftT1[0]), FboPackVert(ftT1[1]),
+            FboPackVert(ftT1[2]), FboPackVert(ftvActive[++stTri][0]) });
+        // Lone triangle so repeat the last vertex which leaves the second
+        // triangle of the quad with no area so nothing is drawn for it.
+        else fpqvQuads.push_back({ FboPackVert(ftT1[0]),
+          FboPackVert(ftT1[1]), FboPackVert(ftT1[2]), FboPackVert(ftT1[2]) });
+      } // Record how many quads this command uses
+      stvCmds.push_back(fpqvQuads.size() - stQuads);
+    } // Stream the packed vertices and make sure there are enough indices
+    const size_t stBase = cOgl->StreamUpload(
+      fpqvQuads.size() * sizeof(FboPackedQuad), fpqvQuads.data());
+    cOgl->StreamQuadIndices(fpqvQuads.size());
+    // Every command shares the same vertex layout and the indices select
+    // the quads so the arrays only need to be set up once.
+    cOgl->VertexAttribPointer(A_COORD, stCompsPerCoord,
+      stBytesPerPackedVertex, FboStreamOffset(stBase,
+        reinterpret_cast<GLvoid*>(stOffsetPackedTxcData)));
+    cOgl->VertexAttribPointer(A_VERTEX, stCompsPerPos,
+      stBytesPerPackedVertex, FboStreamOffset(stBase,
+        reinterpret_cast<GLvoid*>(stOffsetPackedPosData)));
+    cOgl->VertexAttribPointerUB(A_COLOUR, stCompsPerColour,
+      stBytesPerPackedVertex, FboStreamOffset(stBase,
+        reinterpret_cast<GLvoid*>(stOffsetPackedIntData)));
+    // Enumerate each command in this order...
+    size_t stQuad = 0;
+    for(size_t stCmd = 0; stCmd < stvCmds.size(); ++stCmd)
+    { // Set texture, texture unit and shader program
+      const FboCmd &fcData = fcvActive[stCmd];
+      cOgl->ActiveTexture(fcData.gluTUId);
+      cOgl->BindTexture(fcData.gluTexId);
+      cOgl->UseProgram(fcData.gluPrgId);
+      // Draw the quads for this command
+      cOgl->DrawQuads(stQuad, stvCmds[stCmd]);
+      stQuad += stvCmds[stCmd];
+    }
+  }
+  /* -- Start a new order-independent layer -------------------------------- */
+  void FboLayer()
+  { // Layers only matter when coalescing
+    if(!bCoalesce) return;
+    // Finish the current command so it doesn't span two layers
+    if(FboGetTrisCmd())
+    { FboFinishQueue();
+      FboResetCache(gluTextureCache, gluTexUnitCache, gluShaderCache); }
+    // Remember where the new layer begins unless it is already recorded
+    const size_t stCmd = FboGetCmdsNow();
+    if(stvLayers.empty() || stvLayers.back() != stCmd)
+      stvLayers.push_back(stCmd);
+  }
+  /* -- Reorder commands inside each layer so same state draws once -------- */
+  void FboCoalesce()
+  { // Get scratch lists and clear them
+    FboTriVec &ftvNew = cParent->ftvCoalesced;
+    FboCmdVec &fcvNew = cParent->fcvCoalesced;
+    StdVector<size_t> &stvOrder = cParent->stvCoalesced;
+    ftvNew.clear();
+    fcvNew.clear();
+    // For each layer (there is always one more than the boundaries)
+    for(size_t stLayer = 0, stBegin = 0;
+               stLayer <= stvLayers.size();
+             ++stLayer)
+    { // Get the command where this layer ends
+      const size_t stEnd = stLayer < stvLayers.size() ?
+        UtilMinimum(stvLayers[stLayer], fcvActive.size()) : fcvActive.size();
+      // Put commands in state order keeping the draw order for equal state
+      stvOrder.resize(stEnd - stBegin);
+      for(size_t stIndex = 0; stIndex < stvOrder.size(); ++stIndex)
+        stvOrder[stIndex] = stBegin + stIndex;
+      StdStableSort(seq, stvOrder.begin(), stvOrder.end(),
+        [this](const size_t stA, const size_t stB)
+      { // Compare state in order of how expensive it is to change
+        const FboCmd &fcA = fcvActive[stA], &fcB = fcvActive[stB];
+        if(fcA.gluPrgId != fcB.gluPrgId) return fcA.gluPrgId < fcB.gluPrgId;
+        if(fcA.gluTUId != fcB.gluTUId) return fcA.gluTUId < fcB.gluTUId;
+        return fcA.gluTexId < fcB.gluTexId;
+      });
+      // Commands in this layer before this one
+      const size_t stLayerCmds = fcvNew.size();
+      // Copy triangles in the new order and merge matching commands
+      for(const size_t stCmd : stvOrder)
+      { // Ignore if command has no triangles
+        const FboCmd &fcData = fcvActive[stCmd];
+        if(!fcData.glsiVertices) continue;
+        // Get triangles of this command
+        const size_t stFirst = FboCmdFirstTri(fcData),
+          stTris = static_cast<size_t>(fcData.glsiVertices) /
+            stVertexPerTriangle;
+        // Get where the triangles will be copied to and copy them
+        const size_t stOffset = ftvNew.size() * sizeof(FboTri);
+        ftvNew.insert(ftvNew.cend(),
+          StdNext(ftvActive.cbegin(), static_cast<ssize_t>(stFirst)),
+          StdNext(ftvActive.cbegin(),
+            static_cast<ssize_t>(stFirst + stTris)));
+        // Same state as the last command in this layer? Replace it with one
+        // that covers both because the triangles are now contiguous.
+        if(fcvNew.size() > stLayerCmds)
+        { const FboCmd &fcLast = fcvNew.back();
+          if(fcLast.gluPrgId == fcData.gluPrgId &&
+             fcLast.gluTUId == fcData.gluTUId &&
+             fcLast.gluTexId == fcData.gluTexId)
+          { const FboCmd fcMerged{ fcLast.gluTUId, fcLast.gluTexId,
+              fcLast.gluPrgId, fcLast.vpTCOffset, fcLast.vpVOffset,
+              fcLast.vpCOffset, fcLast.glsiVertices + fcData.glsiVertices };
+            fcvNew.pop_back();
+            fcvNew.push_back(fcMerged);
+            continue;
+          }
+        } // Add a new command for these triangles
+        fcvNew.push_back({ fcData.gluTUId, fcData.gluTexId, fcData.gluPrgId,
+          reinterpret_cast<GLvoid*>(stOffset + stOffsetTxcData),
+          reinterpret_cast<GLvoid*>(stOffset + stOffsetPosData),
+          reinterpret_cast<GLvoid*>(stOffset + stOffsetIntData),
+          fcData.glsiVertices });
+      } // Next layer begins where this one ended and the boundary now
+      // refers to the new command list in case we are rendered again.
+      stBegin = stEnd;
+      if(stLayer < stvLayers.size()) stvLayers[stLayer] = fcvNew.size();
+    } // Use the new lists and keep the old ones as scratch for next time
+    ftvActive.swap(ftvNew);
+    fcvActive.swap(fcvNew);
+    // Make the caches describe the last command again
+    if(fcvActive.empty()) FboResetCache(0, 0, 0);
+    else
+    { const FboCmd &fcLast = fcvActive.back();
+      FboResetCache(fcLast.gluTexId, fcLast.gluTUId, fcLast.gluPrgId);
+      stTrianglesLast = FboCmdFirstTri(fcLast);
+      stGLArrayOff = stTrianglesLast * sizeof(FboTri);
+    }
+  }
   /* -- Finish and render the graphics without tick check ------------------ */
   void FboFinishAndRenderUnsafe()
-  { // Finish writing to the arrays
+  { // Record time spent finishing the Fbo
+    const ProfileZone pzZone{ "FboFinishAndRenderUnsafe" };
+    // Finish writing to the arrays
     FboFinishQueue();
+    // Group commands with the same state together if requested
+    if(bCoalesce) FboCoalesce();
     // Set current triangle and frame count
     stTrianglesFrame = FboGetTrisNow();
     stCommandsFrame = FboGetCmdsNow();
@@ -197,26 +414,9 @@ CTOR_MEM_BEGIN_CSLAVE(Fbos, Fbo, ICHelperUnsafe),
     // Update matrix on each 2D shader...
     for(const Shader &shBuiltIn : cShaderCore->sh2DBuiltIns)
       shBuiltIn.UpdateMatrix(*this);
-    // Buffer the new vertex data
-    cOgl->BufferStaticData(glsiVertices, ftvActive.data());
-    // Enumerate each command in this order...
-    StdForEach(seq, fcvActive.cbegin(),
-      StdNext(fcvActive.cbegin(), UtilIntOrMax<ssize_t>(stCommandsFrame)),
-        [](const FboCmd &fcData)
-    { // Set texture, texture unit and shader program
-      cOgl->ActiveTexture(fcData.gluTUId);
-      cOgl->BindTexture(fcData.gluTexId);
-      cOgl->UseProgram(fcData.gluPrgId);
-      // Prepare data arrays
-      cOgl->VertexAttribPointer(A_COORD,
-       stCompsPerCoord, stBytesPerVertex, fcData.vpTCOffset);
-      cOgl->VertexAttribPointer(A_VERTEX,
-        stCompsPerPos, stBytesPerVertex, fcData.vpVOffset);
-      cOgl->VertexAttribPointer(A_COLOUR,
-        stCompsPerColour, stBytesPerVertex, fcData.vpCOffset);
-      // Draw data arrays
-      cOgl->DrawArraysTriangles(fcData.glsiVertices);
-    });
+    // Upload and draw the triangles in the requested format
+    if(cParent->bPackVerts) FboRenderPacked();
+    else FboRenderFloats(static_cast<size_t>(glsiVertices));
   }
   /* -- Finish and render the graphics ------------------------------------- */
   void FboFinishAndRender()
@@ -230,23 +430,13 @@ CTOR_MEM_BEGIN_CSLAVE(Fbos, Fbo, ICHelperUnsafe),
   void FboFinishAndReset(const GLuint gluT, const GLuint gluTU,
     const GLuint gluSC)
   { FboFinishQueue(); FboResetCache(gluT, gluTU, gluSC); }
-  /* -- Blit the specified texture into the Fbo ---------------------------- */
-  void FboBlit(const GLuint gluTex, const TriPosData &tpdV,
-    const TriTexData &tcdC, const TriIntData &tidC, const GLuint gluTexU,
-    const Shader*const shpProgram)
-  { // If this is the first triangle in this command, we just init the cache
-    if(stTrianglesLast == FboGetTrisNow())
-      FboResetCache(gluTex, gluTexU, shpProgram->GetProgram());
-    // Not the first triagnle so finish and reset cache if...
-    else if(gluTex != gluTextureCache ||             // ...texture changed?
-       shpProgram->GetProgram() != gluShaderCache || // ...*or* shader changed?
-       gluTexU != gluTexUnitCache)                   // ...*or* txunit changed?
-      FboFinishAndReset(gluTex, gluTexU, shpProgram->GetProgram());
-    // Structure to insert into our contiguous array buffer. Note that this
+  /* -- Build a triangle from the specified positions, coords and colour --- */
+  static FboTri FboMakeTri(const TriPosData &tpdV,
+    const TriTexData &tcdC, const TriIntData &tidC)
+  { // Structure to insert into our contiguous array buffer. Note that this
     // method produces less assembler output instead of extending the vector
     // and copying the data into the last element and removing push_back.
-    // Add completed triangle to list of arrays
-    ftvActive.push_back({{
+    return {{
       // Vertex 1/3
       { { tcdC[0], tcdC[1] }, { tpdV[0], tpdV[1] },   // Texture, position
         { tidC[0], tidC[1], tidC[ 2], tidC[ 3]   } }, // Colour intensity
@@ -256,7 +446,62 @@ CTOR_MEM_BEGIN_CSLAVE(Fbos, Fbo, ICHelperUnsafe),
       // Vertex 3/3
       { { tcdC[4], tcdC[5] }, { tpdV[4], tpdV[5] },   // Texture, position
         { tidC[8], tidC[9], tidC[10], tidC[11]   } }  // Colour intensity
-    }});
+    }};
+  }
+  /* -- Prepare the cache for triangles with the specified state ----------- */
+  void FboCheckCache(const GLuint gluTex, const GLuint gluTexU,
+    const GLuint gluProgram)
+  { // If this is the first triangle in this command, we just init the cache
+    if(stTrianglesLast == FboGetTrisNow())
+      FboResetCache(gluTex, gluTexU, gluProgram);
+    // Not the first triagnle so finish and reset cache if...
+    else if(gluTex != gluTextureCache ||             // ...texture changed?
+       gluProgram != gluShaderCache ||               // ...*or* shader changed?
+       gluTexU != gluTexUnitCache)                   // ...*or* txunit changed?
+      FboFinishAndReset(gluTex, gluTexU, gluProgram);
+  }
+  /* -- Blit the specified texture into the Fbo ---------------------------- */
+  void FboBlit(const GLuint gluTex, const TriPosData &tpdV,
+    const TriTexData &tcdC, const TriIntData &tidC, const GLuint gluTexU,
+    const Shader*const shpProgram)
+  { // Make sure the current command can take this triangle
+    FboCheckCache(gluTex, gluTexU, shpProgram->GetProgram());
+    // Add completed triangle to list of arrays
+    ftvActive.push_back(FboMakeTri(tpdV, tcdC, tidC));
+  }
+  /* -- Blit a prebuilt run of triangles with an offset and tint ----------- */
+  void FboBlitTris(const GLuint gluTex, const GLuint gluTexU,
+    const Shader*const shpProgram, const FboTriVec &ftvSrc,
+    const StdVector<size_t> &stvNoTint, const GLfloat glfX,
+    const GLfloat glfY, const TriIntensity &tiTint)
+  { // Ignore if there are no triangles
+    if(ftvSrc.empty()) return;
+    // Make sure the current command can take these triangles
+    FboCheckCache(gluTex, gluTexU, shpProgram->GetProgram());
+    // Copy the whole run in one go and remember where it started
+    const size_t stFirst = ftvActive.size();
+    ftvActive.insert(ftvActive.cend(), ftvSrc.cbegin(), ftvSrc.cend());
+    // Only walk the new triangles if they need moving or tinting
+    const bool bMove = glfX != 0.0f || glfY != 0.0f,
+               bTint = tiTint != TriIntensity{ 1.0f, 1.0f, 1.0f, 1.0f };
+    if(!bMove && !bTint) return;
+    // For each triangle we added and the next one that must not be tinted
+    size_t stNoTint = 0;
+    for(size_t stTri = 0; stTri < ftvSrc.size(); ++stTri)
+    { // Tint the triangle unless it is the next one that must not be
+      bool bTintTri = bTint;
+      if(stNoTint < stvNoTint.size() && stvNoTint[stNoTint] == stTri)
+        { bTintTri = false; ++stNoTint; }
+      // For each vertex of the triangle
+      for(FboVert &fvRef : ftvActive[stFirst + stTri])
+      { // Move the vertex if requested
+        if(bMove) { fvRef.tvVertex[0] += glfX; fvRef.tvVertex[1] += glfY; }
+        // Tint the vertex if requested
+        if(bTintTri)
+          for(size_t stComp = 0; stComp < stCompsPerColour; ++stComp)
+            fvRef.tiColour[stComp] *= tiTint[stComp];
+      }
+    }
   }
   /* -- Blit the specified triangle of the specifed Fbo to this Fbo -------- */
   void FboBlitTri(Fbo &fboSrc, const size_t stId)
@@ -317,6 +562,9 @@ CTOR_MEM_BEGIN_CSLAVE(Fbos, Fbo, ICHelperUnsafe),
   /* -- Set clear state ---------------------------------------------------- */
   void FboSetClear(const bool bState) { bClear = bState; }
   bool FboIsClearEnabled() const { return bClear; }
+  /* -- Set reordering of commands by state -------------------------------- */
+  void FboSetCoalesce(const bool bState) { bCoalesce = bState; }
+  bool FboIsCoalesceEnabled() const { return bCoalesce; }
   /* -- Reserve memory for lists ------------------------------------------- */
   void FboReserve(const size_t stTri, const size_t stCmd)
   { // Reserve memory for command list and throw error on failure
@@ -330,6 +578,18 @@ CTOR_MEM_BEGIN_CSLAVE(Fbos, Fbo, ICHelperUnsafe),
         "Name",  NameGet(), "Commands", stTri,
         "Bytes", stTri * sizeof(FboTri));
   }
+  /* -- Reserve room for more triangles ahead of a batch ------------------- */
+  void FboReserveMore(const size_t stTri)
+  { // Done if there is already enough room for the extra triangles
+    const size_t stNeeded = FboGetTrisNow() + stTri;
+    if(stNeeded <= FboGetTrisReserved()) return;
+    // Grow geometrically so consecutive batches do not reallocate each time
+    const size_t stWanted = UtilMaximum(stNeeded, FboGetTrisReserved() * 2);
+    if(!UtilReserveList(ftvActive, stWanted))
+      XC("Failed to reserve memory for Fbo triangles list!",
+        "Name",  NameGet(), "Commands", stWanted,
+        "Bytes", stWanted * sizeof(FboTri));
+  }
   /* -- Set matrix for drawing --------------------------------------------- */
   void FboSetMatrix(const GLfloat glfX1, const GLfloat glfY1,
     const GLfloat glfX2, const GLfloat glfY2)
@@ -458,7 +718,8 @@ CTOR_MEM_BEGIN_CSLAVE(Fbos, Fbo, ICHelperUnsafe),
   /* -- Destructor --------------------------------------------------------- */
   DTORHELPER(~Fbo, FboDeInit())
 };/* ----------------------------------------------------------------------- */
-CTOR_END(Fbos, Fbo, FBO,,,, fboActive(nullptr), fboMain(nullptr))
+CTOR_END(Fbos, Fbo, FBO,,,, fboActive(nullptr), fboMain(nullptr),
+  bPackVerts(false))
 /* == Re-initialise all Fbo's ============================================== */
 static void FboReInit()
 { // Ignore if no Fbo's
@@ -477,6 +738,9 @@ static void FboDeInit()
   for(Fbo*const fCptr : *cFbos) fCptr->FboDeInit();
   cLog->LogInfoExSafe("Fbos de-initialised $ objects.", cFbos->size());
 }
+/* -- Set packed vertex uploads -------------------------------------------- */
+static CVarReturn FboSetPackedVertices(const bool bState)
+  { return CVarSimpleSetInt(cFbos->bPackVerts, bState); }
 /* -- Set Fbo render order reserve ----------------------------------------- */
 static CVarReturn FboSetOrderReserve(const size_t) { return ACCEPT; }
 /* -- Return active fbo ---------------------------------------------------- */
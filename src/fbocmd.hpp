@@ -20,6 +20,8 @@ constexpr static const size_t
   stVertexPerTriangle = 3,             // Vertices used in a triangle (3 ofc!)
   stTwoTriangles      = stVertexPerTriangle * 2,
   stTrisPerQuad       = 2,             // Triangles needed to make a quad
+  stVertsPerQuad      = 4,             // Unique vertices in an indexed quad
+  stIndicesPerQuad    = 6,             // Indices needed to draw a quad
   /* -- Defines for triangle texture co-ordinates data --------------------- */
   // [0]X: The left 2D pixel co-ordinate. Shader converts it to 3D for us.
   // [1]Y: The top 2D pixel co-ordinate. Shader converts it to 3D for us.
@@ -106,6 +108,28 @@ struct FboVert                         // Formatted data for OpenGL
 ** +----------+----------+----------+- C(Vec4)=Colour(RGBA) -+-----+-----+-- */
 using FboTri    = StdArray<FboVert, stVertexPerTriangle>; // All triangles data
 using FboTriVec = StdVector<FboTri>;                   // Render triangles list
+/* -- Packed vertex data (vid_packverts) ----------------------------------- */
+using TriIntensity8 = StdArray<uint8_t,stCompsPerColour>; // Packed intensity
+struct FboPackedVert                   // Compact formatted data for OpenGL
+{ /* -- Public variables --------------------------------------------------- */
+  TriCoord       tcCoord;              // TexCoord specific data send
+  TriVertex      tvVertex;             // Vertex specific data to send
+  TriIntensity8  tiColour;             // Colour (normalised by OpenGL)
+};/* ----------------------------------------------------------------------- */
+/* FboPackedVert.TriCoord      =  8 bytes @ Byte[ 0] - Texcoord              **
+**       "      .TriVertex     =  8 bytes @ Byte[ 8] - Vertex                **
+**       "      .TriIntensity8 =  4 bytes @ Byte[16] - Colour                **
+** A quad is four of these drawn with indices 0,1,2 and 3,2,1 so it takes 80 **
+** bytes to upload instead of the 192 bytes of two FboTri's.                 */
+using FboPackedQuad    = StdArray<FboPackedVert, stVertsPerQuad>;
+using FboPackedQuadVec = StdVector<FboPackedQuad>; // Packed quads list
+/* -- Packed buffer structure ---------------------------------------------- */
+constexpr static const size_t
+  stBytesPerPackedVertex = sizeof(FboPackedVert),
+  stOffsetPackedTxcData  = 0,
+  stOffsetPackedPosData  = stCompsPerCoord * stSizeOfGLfloat,
+  stOffsetPackedIntData  = (stCompsPerCoord + stCompsPerPos) * stSizeOfGLfloat;
+static_assert(stBytesPerPackedVertex == 20);
 /* ------------------------------------------------------------------------- */
 }                                      // End of public module namespace
 /* ------------------------------------------------------------------------- */
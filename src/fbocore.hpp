@@ -19,10 +19,10 @@ using namespace IDim::P;               using namespace IEvtMain::P;
 using namespace IFboBlend::P;          using namespace IFbo::P;
 using namespace IFrame::P;             using namespace IGlFW::P;
 using namespace ILog::P;               using namespace IOgl::P;
-using namespace IShader::P;            using namespace IShaders::P;
-using namespace IStd::P;               using namespace IString::P;
-using namespace ISysUtil::P;           using namespace IUtil::P;
-using namespace Lib::OS::GlFW::Types;
+using namespace IProfile::P;           using namespace IShader::P;
+using namespace IShaders::P;           using namespace IStd::P;
+using namespace IString::P;            using namespace ISysUtil::P;
+using namespace IUtil::P;              using namespace Lib::OS::GlFW::Types;
 /* ------------------------------------------------------------------------- */
 using FboDouble = StdArray<Fbo, 2>;    // Main and console Fbo typedef
 /* ------------------------------------------------------------------------- */
@@ -60,7 +60,9 @@ class FboCore :                        // The main Fbo operations manager
   void FboCoreActivateMain() { fboMain.FboSetActive(); }
   /* -- Render the main Fbo from the engine thread ------------------------- */
   void FboCoreRender()
-  { // Unbind current Fbo so we select the back buffer to draw to
+  { // Record time spent rendering the main Fbo
+    const ProfileZone pzZone{ "FboCoreRender" };
+    // Unbind current Fbo so we select the back buffer to draw to
     cOgl->BindFbo();
     // Set the first active texture unit
     cOgl->ActiveTexture();
@@ -16,12 +16,14 @@ namespace IFont {                      // Start of private namespace
 using namespace IAsset::P;             using namespace IAtlas::P;
 using namespace ICollector::P;         using namespace ICoords::P;
 using namespace IDim::P;               using namespace IError::P;
+using namespace IFbo::P;               using namespace IFboCmd::P;
 using namespace IFileMap::P;           using namespace IFlags::P;
 using namespace IFormat::P;            using namespace IFreeType::P;
 using namespace IFtf::P;               using namespace IImageDef::P;
-using namespace IJson::P;              using namespace ILog::P;
-using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace IMemory::P;            using namespace IOgl::P;
+using namespace IJobs::P;              using namespace IJson::P;
+using namespace ILog::P;               using namespace ILuaIdent::P;
+using namespace ILuaLib::P;            using namespace IMemory::P;
+using namespace IMutex::P;             using namespace IOgl::P;
 using namespace IStd::P;               using namespace ISystem::P;
 using namespace ISysUtil::P;           using namespace ITexDef::P;
 using namespace ITexture::P;           using namespace IUtf::P;
@@ -30,7 +32,19 @@ using namespace Lib::OS::GlFW::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public namespace
 /* == Font collector class for collector data and custom variables ========= */
-CTOR_BEGIN_NOBB(Fonts, Font, CLHelperUnsafe)
+CTOR_BEGIN(Fonts, Font, CLHelperUnsafe,
+  /* -- Collector variables ------------------------------------------------ */
+  uint64_t         ullLayoutStamp;     // Last layout stamp given to a font
+)
+/* -- Layout alignment ----------------------------------------------------- */
+enum FontAlign : unsigned              // Alignment of a text layout
+{ /* ----------------------------------------------------------------------- */
+  FA_LEFT,                             // Left aligned (can wrap)
+  FA_CENTRE,                           // Centre aligned
+  FA_RIGHT,                            // Right aligned
+  /* ----------------------------------------------------------------------- */
+  FA_MAX                               // Maximum number of alignments
+};/* ----------------------------------------------------------------------- */
 /* == Font Variables Class ================================================= */
 // Only put vars used in the Font class in here. This is an optimisation so
 // we do not have to initialise all these variables more than once as we have
@@ -45,7 +59,8 @@ class FontBase :                       // Members initially private
     public DimGLFloat,                 // Dimension of floats
     public CoordsGLFloat               // Glyph bounding co-ordinates
   { /* -- Private variables ------------------------------------------------ */
-    bool           bLoaded;            // 0=ft unloaded or 1=ft loaded
+    bool           bLoaded,            // 0=ft unloaded or 1=ft loaded
+                   bPending;           // Being rasterised in background
     GLfloat        glfAdvance;         // Width, height and advance of glyph
     /* -- Returns character advance -------------------------------- */ public:
     GLfloat GlyphGetAdvance() const { return glfAdvance; }
@@ -56,6 +71,10 @@ class FontBase :                       // Members initially private
     bool GlyphIsLoaded() const { return bLoaded; }
     /* -- Set glyph as loaded ---------------------------------------------- */
     void GlyphSetLoaded() { bLoaded = true; }
+    /* -- Returns if this glyph is being rasterised in the background ------ */
+    bool GlyphIsPending() const { return bPending; }
+    /* -- Set glyph as being rasterised in the background ------------------ */
+    void GlyphSetPending() { bPending = true; }
     /* -- Constructor that initialises all members ------------------------- */
     Glyph(const GLfloat glfWidth,      // Width of glyph in pixels for opengl
           const GLfloat glfHeight,     // Height of glyph in pixels for opengl
@@ -71,6 +90,7 @@ class FontBase :                       // Members initially private
       CoordsGLFloat{ glfX1, glfY1,     // Init adjustment src co-ordinates
                      glfX2, glfY2 },   // Init adjustment dest co-ordinates
       bLoaded(bNLoaded),               // Init specified loaded value
+      bPending(false),                 // Init not rasterising
       glfAdvance(glfNAdvance)          // Init specified advance value
       /* -- No code -------------------------------------------------------- */
       {}
@@ -78,12 +98,29 @@ class FontBase :                       // Members initially private
     Glyph() :                          // No arguments
       /* -- Initialisers --------------------------------------------------- */
       bLoaded(false),                  // Character not loaded yet
+      bPending(false),                 // Character not rasterising yet
       glfAdvance(0.0f)                 // Character advance value
       /* -- No code -------------------------------------------------------- */
       {}
   };/* -- Variables -------------------------------------------------------- */
   using GlyphVector   = StdVector<Glyph>;      // Vector of Glyphs
   using GlyphVectorIt = GlyphVector::iterator; // Iterator to GlyphVector
+  /* -- Bitmap of a glyph rasterised in the background --------------------- */
+  struct GlyphBitmap                   // Members initially public
+  { /* --------------------------------------------------------------------- */
+    Memory         mData;              // Gray pixels (width * rows)
+    unsigned       uWidth, uRows;      // Dimensions of bitmap in pixels
+    FT_BBox        bbData;             // Bounds of bitmap in pixels
+  };/* -- Glyph rasterised in the background ------------------------------- */
+  struct GlyphRaster                   // Members initially public
+  { /* --------------------------------------------------------------------- */
+    Codepoint      coChar;             // Character that was rasterised
+    GLfloat        glfAdvance;         // Advance of character
+    size_t         stBitmaps;          // Bitmaps rendered (0 = not in font)
+    StdArray<GlyphBitmap,2> gbData;    // Normal and outline bitmaps
+  };/* --------------------------------------------------------------------- */
+  using GlyphChars   = StdVector<Codepoint>;   // Characters to rasterise
+  using GlyphRasters = StdVector<GlyphRaster>; // Rasterised characters
   /* --------------------------------------------------------------- */ public:
   GlyphVector      gvData;             // Glyph and outline data
   DimGLFloat       gldfScale,          // Scaled font width and height
@@ -99,6 +136,15 @@ class FontBase :                       // Members initially private
                    glfGPadScaled;      // Glyph position adjustment scaled
   Texture         *tGlyphs;            // Texture for print calls only
   FboItem          fiOutline;          // Outline colour
+  StdVector<size_t> *stvpCaptureOutline; // Record outline triangles if set
+  uint64_t         ullLayout;          // Stamp of current layout metrics
+  /* -- Background glyph rasterisation ------------------------------------- */
+  MutexLock        mGlyphFace,         // Serialise access to FreeType face
+                   mGlyphQueue;        // Serialise access to glyph lists
+  GlyphChars       gcStage,            // Characters to send to the worker
+                   gcQueue;            // Characters waiting for the worker
+  GlyphRasters     grDone;             // Rasterised characters to commit
+  size_t           stGlyphsPending;    // Characters not committed yet
   /* -- Freetype handles --------------------------------------------------- */
   Ftf              ftfData;            // FT font data
   FT_ULong         fulDefaultChar;     // Default fallback character
@@ -111,7 +157,8 @@ class FontBase :                       // Members initially private
     glfGlyphSize(0.0f),                glfScale(0.0f),
     glfGPad(0.0f),                     glfGPadScaled(0.0f),
     tGlyphs(nullptr),                  fiOutline{ 0xFF000000 },
-    fulDefaultChar('?')
+    stvpCaptureOutline(nullptr),       ullLayout(0),
+    stGlyphsPending(0),                fulDefaultChar('?')
     /* --------------------------------------------------------------------- */
     {}
 };/* ----------------------------------------------------------------------- */
@@ -119,19 +166,27 @@ class FontBase :                       // Members initially private
 CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
   /* -- Base classes ------------------------------------------------------- */
   public FontBase                      // Font variables class
-{ /* -- Stroker functors for DoInitFTChar() -------------------------------- */
+{ /* -- Private variables -------------------------------------------------- */
+  Job              jGlyphs;            // Background glyph rasteriser job
+  /* -- Stroker functors for DoInitFTChar() -------------------------------- */
 #include "fontglph.hpp"                // Include glyph loading members inline
 #include "fontblit.hpp"                // Include glyph blitting members inline
+  /* -- Give the font a new layout stamp so cached layouts are rebuilt ----- */
+  void LayoutInvalidate() { ullLayout = ++cFonts->ullLayoutStamp; }
   /* -- Recalculate line spacing ------------------------------------------- */
   GLfloat GetLineSpacingHeight() const { return glfLSpacingHeight; }
   void UpdateHeightPlusLineSpacing()
-    { glfLSpacingHeight = GetLineSpacing() + gldfScale.DimGetHeight(); }
+  { glfLSpacingHeight = GetLineSpacing() + gldfScale.DimGetHeight();
+    LayoutInvalidate(); }
   /* -- Update character spacing of the font ------------------------------- */
   GLfloat GetCharSpacingScale() const { return glfCSpacingScale; }
   void UpdateCharSpacingTimesScale()
-    { glfCSpacingScale = GetCharSpacing() * glfScale; }
+  { glfCSpacingScale = GetCharSpacing() * glfScale; LayoutInvalidate(); }
   /* -- Return text height plus line spacing ------------------------------- */
-  void UpdateGlyphPaddingTimesScale() { glfGPadScaled = glfGPad * glfScale; }
+  void UpdateGlyphPaddingTimesScale()
+    { glfGPadScaled = glfGPad * glfScale; LayoutInvalidate(); }
+  /* -- Return current layout stamp -------------------------------- */ public:
+  uint64_t LayoutGetStamp() const { return ullLayout; }
   /* -- Set glyph size --------------------------------------------- */ public:
   void SetGlyphSize(const GLfloat glfSize)
     { glfGlyphSize = glfSize; UpdateGlyphPaddingTimesScale(); }
@@ -187,6 +242,45 @@ CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
       "Font '$' finished pre-caching character range $ to $.",
       NameGet(), cStart, cEnd);
   }
+  /* -- Commit glyphs rasterised in the background ------------------------- */
+  void GlyphFlush()
+  { // Ignore if nothing is being rasterised
+    if(!stGlyphsPending) return;
+    // Take all the rasterised characters
+    GlyphRasters grWork;
+    mGlyphQueue.MutexCall([this, &grWork](){ grWork.swap(grDone); });
+    // Anything rasterised?
+    if(!grWork.empty())
+    { // No longer pending
+      stGlyphsPending -= grWork.size();
+      // Add them all to the atlas and upload the changes only once
+      for(const GlyphRaster &grRef : grWork) GlyphCommit(grRef);
+      AtlasCheckReloadTexture();
+      // Cached layouts may have been built with the fall-back character
+      LayoutInvalidate();
+    } // Restart the worker if it finished before the last characters arrived
+    GlyphStart();
+  }
+  /* -- Return number of characters still being rasterised ----------------- */
+  size_t GlyphGetPending() const { return stGlyphsPending; }
+  /* -- Rasterise specified freetype character range in background --------- */
+  void GlyphPrewarmRange(const Codepoint cStart, const Codepoint cEnd)
+  { // Ignore if not a freetype font.
+    if(!ftfData.IsLoaded()) return;
+    // Queue the specified character range and start the worker
+    for(Codepoint cIndex = cStart; cIndex < cEnd; ++cIndex)
+      GlyphQueue(cIndex);
+    GlyphStart();
+  }
+  /* -- Rasterise freetype characters in specified string in background ---- */
+  void GlyphPrewarmString(const StdStringView ssvString)
+  { // Ignore if string not valid or font not loaded
+    if(ssvString.empty() || !ftfData.IsLoaded()) return;
+    // Queue the string characters and start the worker
+    UtfDecoder udRef{ ssvString };
+    while(const Codepoint coChar = udRef.UtfNext()) GlyphQueue(coChar);
+    GlyphStart();
+  }
   /* -- Do initialise all freetype characters in specified string ---------- */
   void InitFTCharString(const StdStringView ssvString)
   { // Ignore if string not valid or font not loaded
@@ -429,18 +523,25 @@ CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
   /* -- Constructor (Initialisation then registration) --------------------- */
   Font() :
     /* -- Initialisers ----------------------------------------------------- */
-    ICHelperFont{ cFonts, this }       // Initially registered
+    ICHelperFont{ cFonts, this },      // Initially registered
+    jGlyphs{ JP_IMAGE,                 // Initialise glyph job with priority
+      bind(&Font::GlyphJobMain, this, _1) } // ...and rasteriser function
     /* -- No code ---------------------------------------------------------- */
     {}
   /* -- Constructor (without registration) --------------------------------- */
   explicit Font(const ImageFlagsConst ifcPurpose) :
     /* -- Initialisers ----------------------------------------------------- */
     ICHelperFont{ cFonts },            // Initially unregistered
-    FontBase{ ifcPurpose }             // Set purpose
+    FontBase{ ifcPurpose },            // Set purpose
+    jGlyphs{ JP_IMAGE,                 // Initialise glyph job with priority
+      bind(&Font::GlyphJobMain, this, _1) } // ...and rasteriser function
     /* -- No code ---------------------------------------------------------- */
     {}
+  /* -- Destructor --------------------------------------------------------- */
+  DTORHELPER(~Font, if(jGlyphs.JobIsBusy()) cJobs->JobsStop(jGlyphs))
 };/* ----------------------------------------------------------------------- */
-CTOR_END_NOINITS(Fonts, Font, FONT)    // End of collector class
+CTOR_END(Fonts, Font, FONT,,,,        // End of collector class
+  ullLayoutStamp(0))                   // No layout stamps given yet
 /* -- DeInit Font Textures ------------------------------------------------- */
 static void FontDeInitTextures()
 { // Ignore if no fonts
@@ -450,6 +551,9 @@ static void FontDeInitTextures()
   for(Font*const fCptr : *cFonts) fCptr->DeInit();
   cLog->LogInfoExSafe("Fonts de-initialising $ objects.", cFonts->size());
 }
+/* -- Commit glyphs rasterised in the background for all fonts ------------- */
+static void FontFlushGlyphs()
+  { for(Font*const fCptr : *cFonts) fCptr->GlyphFlush(); }
 /* -- Reload Font Textures ------------------------------------------------- */
 static void FontReInitTextures()
 { // Ignore if no fonts
@@ -119,12 +119,18 @@ void PrintDraw(GLfloat &glfX, const GLfloat glfY, const size_t stPos)
   if(ftfData.IsStrokerLoaded())
   { // Get outline character info and print the outline glyph
     const Glyph &gOData = gvData[stPos + 1];
+    const size_t stFirst = ftvpCapture ? ftvpCapture->size() : 0;
     BlitLTRBC(0, stPos + 1,
       glfX + gOData.CoordsGetX1() * glfScale,
       glfY + gOData.CoordsGetY1() * glfScale,
       glfX + gOData.CoordsGetX2() * glfScale,
       glfY + gOData.CoordsGetY2() * glfScale,
       fiOutline.FboItemGetCData());
+    // Remember which captured triangles are the outline so a layout does
+    // not tint them with the font colour.
+    if(stvpCaptureOutline)
+      for(size_t stTri = stFirst; stTri < ftvpCapture->size(); ++stTri)
+        stvpCaptureOutline->push_back(stTri);
   } // Get character info and print the opaque glyph
   const Glyph &gData = gvData[stPos];
     BlitLTRB(0, stPos,
@@ -852,4 +858,62 @@ void PrintM(const GLfloat glfX, const GLfloat glfY, const GLfloat glfL,
   // Check if texture needs reloading
   AtlasCheckReloadTexture();
 }
+/* -- Lay out a string into a list of triangles to draw later -------------- */
+template<typename StrType>
+  requires StdIsPointer<StrType> || StdIsString<StrType>
+void LayoutBuild(FboTriVec &ftvDst, StdVector<size_t> &stvOutline,
+  const StrType &strStr, const GLfloat glfW, const FontAlign faAlign)
+{ // Layouts are built in white at the origin and tinted and moved when drawn
+  const QuadIntData qidSaved{ FboItemGetCData() };
+  // Send triangles to the specified list instead of the active fbo and
+  // record which of them are the outline.
+  ftvpCapture = &ftvDst;
+  stvpCaptureOutline = &stvOutline;
+  // Capture the string
+  try
+  { // Loading new glyphs can enlarge the atlas which rescales the texture
+    // co-ordinates of glyphs we already captured so repeat if that happens.
+    for(unsigned uAtlasWidth = 0; uAtlasWidth != DimGetWidth(); )
+    { // Record atlas width and start again with an empty list
+      uAtlasWidth = DimGetWidth();
+      ftvDst.clear();
+      stvOutline.clear();
+      // Build a new utfstring class with the string
+      UtfDecoder udRef{ strStr };
+      // Check that texture is a font and the string is valid
+      if(PrintSanityCheck(udRef)) break;
+      // Draw in white so the font colour can tint it later
+      FboItemSetQuadRGBA(1.0f, 1.0f, 1.0f, 1.0f);
+      // Print with the requested alignment. Only left aligned text wraps.
+      switch(faAlign)
+      { case FA_CENTRE: DoPrintC(0.0f, 0.0f, udRef); break;
+        case FA_RIGHT: DoPrintR(0.0f, 0.0f, udRef); break;
+        default: if(glfW > 0.0f) DoPrintW(0.0f, 0.0f, glfW, 0.0f, udRef);
+                 else DoPrint(0.0f, 0.0f, 0.0f, udRef);
+                 break;
+      } // Cleanup enabled flags
+      CleanupProcessing();
+    }
+  } // Exception occured? Stop capturing, restore colour and rethrow
+  catch(const StdException &)
+  { ftvpCapture = nullptr;
+    stvpCaptureOutline = nullptr;
+    FboItemGetCData() = qidSaved;
+    throw;
+  } // Stop capturing and restore font colour
+  ftvpCapture = nullptr;
+  stvpCaptureOutline = nullptr;
+  FboItemGetCData() = qidSaved;
+  // Check if texture needs reloading
+  AtlasCheckReloadTexture();
+}
+/* -- Draw a list of triangles built with LayoutBuild ---------------------- */
+void LayoutBlit(const FboTriVec &ftvSrc, const StdVector<size_t> &stvOutline,
+  const GLfloat glfX, const GLfloat glfY)
+{ // Tint the glyphs of the layout with the current font colour. The outline
+  // was already drawn in the outline colour.
+  const TriIntData &tidClr = FboItemGetCData(0);
+  FboActive()->FboBlitTris(GetSubName(), 0, shpProgram, ftvSrc, stvOutline,
+    glfX, glfY, { tidClr[0], tidClr[1], tidClr[2], tidClr[3] });
+}
 /* == EoF =========================================================== EoF == */
@@ -152,10 +152,10 @@ struct HandleGlyphFunc                 // Members initially public
     { return foP->DoHandleStaticGlyph(coChar, coCharOutline); }
   };/* --------------------------------------------------------------------- */
 };                                     // End of HandleGlyphFunc
-/* -- Do load character function ------------------------------------------- */
-template<class StrokerFuncType>
-  void DoInitFTChar(FT_GlyphSlot &ftgsRef, const Codepoint coCharOutline,
-    const Codepoint coChar, const GLfloat glfAdvance)
+/* -- Render a character and send the bitmap to the specified callback ----- */
+template<class StrokerFuncType, typename CallbackFuncType>
+  void DoRenderFTChar(FT_GlyphSlot &ftgsRef, const Codepoint coChar,
+    CallbackFuncType &&cftCallback)
 { // Move The Face's Glyph Into A Glyph Object to get outline
   FT_Glyph gData;
   cFreeType->FreeTypeCheckError(FT_Get_Glyph(ftgsRef, &gData),
@@ -177,33 +177,66 @@ template<class StrokerFuncType>
     // unique_ptr dtor knows to destroy the new one.
     gPtr.release();
     gPtr.reset(gData);
-    // Get glyph data class and set advanced and status to loaded
-    Glyph &gRef = gvData[coCharOutline];
-    gRef.GlyphSetLoaded();
-    gRef.GlyphSetAdvance(glfAdvance);
-    // Access image information and if has dimensions?
+    // Access image information and get glyph outline origins if it has
+    // dimensions.
     const FT_Bitmap &bData = reinterpret_cast<FT_BitmapGlyph>(gData)->bitmap;
+    FT_BBox bbData{};
     if(bData.width > 0 && bData.rows > 0)
-    { // Get glyph outline origins
-      FT_BBox bbData;
       FT_Glyph_Get_CBox(gData, FT_GLYPH_BBOX_PIXELS, &bbData);
-      // Set glyph size
-      gRef.DimSet(static_cast<GLfloat>(bData.width),
-                  static_cast<GLfloat>(bData.rows));
-      // Set glyph bounds
-      gRef.CoordsSet(static_cast<GLfloat>(bbData.xMin),
-        -static_cast<GLfloat>(static_cast<int>(bData.rows) + bbData.yMin) +
-           gldfFont.DimGetHeight(),
-         static_cast<GLfloat>(bbData.xMax),
-        -static_cast<GLfloat>(bbData.yMin) + gldfFont.DimGetHeight());
-      // Add the glyph to texture
-      AtlasAddBitmap<ImageTypeGrayAlpha>
-        (coCharOutline, bData.width, bData.rows, bData.buffer);
-    } // Glyph has no dimensions so push default font size
-    else gRef.DimSet(gldfFont);
+    // Send the bitmap to the caller
+    cftCallback(bData, bbData);
   } // Failed to grab pointer to glyph data
   else XC("Failed to get glyph pointer!", "Name", NameGet(), "Glyph", coChar);
 }
+/* -- Set a rendered glyph and add it to the texture ----------------------- */
+void GlyphSet(const size_t stPos, const GLfloat glfAdvance,
+  const unsigned uWidth, const unsigned uRows, const FT_BBox &bbData,
+  const void*const vpData)
+{ // Get glyph data class and set advanced and status to loaded
+  Glyph &gRef = gvData[stPos];
+  gRef.GlyphSetLoaded();
+  gRef.GlyphSetAdvance(glfAdvance);
+  // Glyph has no dimensions so push default font size
+  if(!uWidth || !uRows) return gRef.DimSet(gldfFont);
+  // Set glyph size
+  gRef.DimSet(static_cast<GLfloat>(uWidth), static_cast<GLfloat>(uRows));
+  // Set glyph bounds
+  gRef.CoordsSet(static_cast<GLfloat>(bbData.xMin),
+    -static_cast<GLfloat>(static_cast<int>(uRows) + bbData.yMin) +
+       gldfFont.DimGetHeight(),
+     static_cast<GLfloat>(bbData.xMax),
+    -static_cast<GLfloat>(bbData.yMin) + gldfFont.DimGetHeight());
+  // Add the glyph to texture
+  AtlasAddBitmap<ImageTypeGrayAlpha>(stPos, uWidth, uRows, vpData);
+}
+/* -- Do load character function ------------------------------------------- */
+template<class StrokerFuncType>
+  void DoInitFTChar(FT_GlyphSlot &ftgsRef, const Codepoint coCharOutline,
+    const Codepoint coChar, const GLfloat glfAdvance)
+{ // Render the glyph and add it straight to the texture
+  DoRenderFTChar<StrokerFuncType>(ftgsRef, coChar,
+    [this, coCharOutline, glfAdvance]
+      (const FT_Bitmap &bData, const FT_BBox &bbData)
+        { GlyphSet(coCharOutline, glfAdvance, bData.width, bData.rows,
+            bbData, bData.buffer); });
+}
+/* -- Render a character into a background glyph --------------------------- */
+template<class StrokerFuncType>
+  void DoCopyFTChar(FT_GlyphSlot &ftgsRef, GlyphRaster &grRef)
+{ // Render the glyph and keep a copy of the bitmap for the main thread
+  DoRenderFTChar<StrokerFuncType>(ftgsRef, grRef.coChar,
+    [&grRef](const FT_Bitmap &bData, const FT_BBox &bbData)
+    { // Get next bitmap and set its dimensions and bounds
+      GlyphBitmap &gbRef = grRef.gbData[grRef.stBitmaps++];
+      gbRef.uWidth = bData.width;
+      gbRef.uRows = bData.rows;
+      gbRef.bbData = bbData;
+      // Copy the pixels if there are any
+      if(gbRef.uWidth > 0 && gbRef.uRows > 0)
+        gbRef.mData = Memory{ static_cast<size_t>(gbRef.uWidth) *
+          gbRef.uRows, bData.buffer };
+    });
+}
 /* -- Initialise freetype char and set types ------------------------------- */
 template<class StrokerFuncNormalType, class StrokerFuncOutlineType>
   void DoInitFTCharOutline(FT_GlyphSlot &ftgsRef,
@@ -247,9 +280,13 @@ template<class StrokerCheckFuncType, class RoundCheckFuncType>
     clTiles[0].resize(gvData.size());
   } // Return the position if already loaded
   else if(gvData[coCharOutline].GlyphIsLoaded()) return coCharOutline;
-  // Translate character to glyph and if succeeded?
-  if(const FT_UInt uGl = ftfData.CharToGlyph(static_cast<FT_ULong>(coChar)))
-  { // Load glyph and return glyph on success else throw exception
+  // Translate character to glyph while the background rasteriser is not
+  // using the face and if succeeded then return the position.
+  if(mGlyphFace.MutexCall([this, coChar, coCharOutline](){
+    // Translate character to glyph and return if failed
+    const FT_UInt uGl = ftfData.CharToGlyph(static_cast<FT_ULong>(coChar));
+    if(!uGl) return false;
+    // Load glyph and return glyph on success else throw exception
     cFreeType->FreeTypeCheckError(ftfData.LoadGlyph(uGl),
       "Failed to load glyph!", "Name", NameGet(), "Index", coChar);
     // Get glyph slot handle and get advance width.
@@ -260,9 +297,10 @@ template<class StrokerCheckFuncType, class RoundCheckFuncType>
     // Begin initialisation of char by checking stroker setting. This can
     // either be a pre-calculated or calculated right now.
     StrokerCheckFuncType{ this, ftgsRef, coCharOutline, coChar, glfAdvance };
-    // Return position
-    return coCharOutline;
-  } // Show error if we couldn't load the default character
+    // Success
+    return true;
+  })) return coCharOutline;
+  // Show error if we couldn't load the default character
   if(coChar == fulDefaultChar)
     XC("Default character not available!",
       "Name", NameGet(), "Index", coChar, "Position", coCharOutline);
@@ -400,12 +438,130 @@ template<class HandleGlyphFuncType>
   else DoInitFTCharStringApplyRound<HandleGlyphFuncType,
     StrokerCheckFunc::Manual<InitCharFunc::NoOutline>>(ssvStr);
 }
-/* -- Check if a character needs initialising ------------------------------ */
-size_t CheckGlyph(const Codepoint coChar)
+/* -- Check if a character needs initialising immediately ------------------ */
+size_t CheckGlyphNow(const Codepoint coChar)
 { return DoCheckGlyph<HandleGlyphFunc::Auto,
     StrokerCheckFunc::Auto<InitCharFunc::NoOutline>,
     RoundCheckFunc::Auto<RoundFunc::Straight<GLfloat>>>
       (static_cast<size_t>(coChar)); }
+/* -- Rasterise a character (worker thread with face locked) --------------- */
+void GlyphRasterise(GlyphRaster &grRef)
+{ // Translate character to glyph and return if not in the font
+  const FT_UInt uGl = ftfData.CharToGlyph(static_cast<FT_ULong>(grRef.coChar));
+  if(!uGl) return;
+  // Load glyph and return glyph on success else throw exception
+  cFreeType->FreeTypeCheckError(ftfData.LoadGlyph(uGl),
+    "Failed to load glyph!", "Name", NameGet(), "Index", grRef.coChar);
+  // Get glyph slot handle and get advance width.
+  FT_GlyphSlot ftgsRef = ftfData.GetGlyphData();
+  grRef.glfAdvance = RoundCheckFunc::Auto<RoundFunc::Straight<GLfloat>>(*this,
+    static_cast<GLfloat>(ftgsRef->metrics.horiAdvance) / 64).Result();
+  // No outline? Just render the normal glyph
+  if(!ftfData.IsStrokerLoaded())
+    return DoCopyFTChar<StrokerFunc::NoOutline>(ftgsRef, grRef);
+  // Render the normal glyph with the inside stroked if requested
+  if(FlagIsSet(FF_STROKETYPE2))
+    DoCopyFTChar<StrokerFunc::OutlineInside>(ftgsRef, grRef);
+  else DoCopyFTChar<StrokerFunc::NoOutline>(ftgsRef, grRef);
+  // Render the outline glyph
+  DoCopyFTChar<StrokerFunc::Outline>(ftgsRef, grRef);
+}
+/* -- Background glyph rasteriser job -------------------------------------- */
+void GlyphJobMain(Job &jJob)
+{ // Characters taken from the queue
+  GlyphChars gcWork;
+  // Until we are told to exit
+  while(jJob.JobShouldNotExit())
+  { // Take all the waiting characters and finish if there are none
+    mGlyphQueue.MutexCall([this, &gcWork](){ gcWork.swap(gcQueue); });
+    if(gcWork.empty()) return;
+    // For each character
+    for(const Codepoint coChar : gcWork)
+    { // Abort if we are told to exit
+      if(jJob.JobShouldExit()) return;
+      // Rasterise the character while the main thread is not using the face
+      GlyphRaster grData{ coChar, 0.0f, 0, {} };
+      mGlyphFace.MutexCall([this, &grData](){
+        try { GlyphRasterise(grData); }
+        catch(const StdException &eReason)
+        { // The fall-back character will be used instead
+          grData.stBitmaps = 0;
+          cLog->LogWarningExSafe("Font '$' failed to rasterise glyph $: $",
+            NameGet(), grData.coChar, eReason);
+        }
+      });
+      // Send it to the main thread
+      mGlyphQueue.MutexCall([this, &grData](){
+        grDone.emplace_back(StdMove(grData)); });
+    } // Done with these characters
+    gcWork.clear();
+  }
+}
+/* -- Mark a character to be sent to the background rasteriser ------------- */
+void GlyphQueue(const Codepoint coChar)
+{ // Make room for the character if needed
+  const size_t stPos = static_cast<size_t>(coChar) * stMultiplier;
+  if(stPos >= gvData.size())
+  { // Extend and initialise storage for glyph and gl texture co-ordinates
+    gvData.resize(stPos + stMultiplier, {});
+    clTiles[0].resize(gvData.size());
+  } // Ignore if already loaded or being rasterised
+  Glyph &gRef = gvData[stPos];
+  if(gRef.GlyphIsLoaded() || gRef.GlyphIsPending()) return;
+  // Send it to the worker on the next call to GlyphStart()
+  gRef.GlyphSetPending();
+  gcStage.push_back(coChar);
+  ++stGlyphsPending;
+}
+/* -- Send marked characters to the background rasteriser ------------------ */
+void GlyphStart()
+{ // Move marked characters to the worker queue
+  if(!gcStage.empty())
+  { mGlyphQueue.MutexCall([this](){
+      gcQueue.insert(gcQueue.cend(), gcStage.cbegin(), gcStage.cend()); });
+    gcStage.clear();
+  } // Ignore if nothing to do or the worker is already running
+  if(!stGlyphsPending || jGlyphs.JobIsBusy()) return;
+  // Acknowledge last run and start the worker again
+  cJobs->JobsWait(jGlyphs);
+  cJobs->JobsQueue(jGlyphs);
+}
+/* -- Commit a glyph rasterised in the background -------------------------- */
+void GlyphCommit(const GlyphRaster &grRef)
+{ // Ignore if loaded immediately while it was being rasterised
+  const size_t stPos = static_cast<size_t>(grRef.coChar) * stMultiplier;
+  if(gvData[stPos].GlyphIsLoaded()) return;
+  // Character not in the font?
+  if(!grRef.stBitmaps)
+  { // Use a copy of the fall-back character so we don't ask again
+    const size_t stDefPos =
+      CheckGlyphNow(static_cast<Codepoint>(fulDefaultChar));
+    for(size_t stIndex = 0; stIndex < stMultiplier; ++stIndex)
+    { gvData[stPos + stIndex] = gvData[stDefPos + stIndex];
+      clTiles[0][stPos + stIndex] = clTiles[0][stDefPos + stIndex]; }
+    // Done
+    return;
+  } // Set the glyph and its outline and add them to the texture
+  for(size_t stIndex = 0; stIndex < grRef.stBitmaps; ++stIndex)
+  { const GlyphBitmap &gbRef = grRef.gbData[stIndex];
+    GlyphSet(stPos + stIndex, grRef.glfAdvance, gbRef.uWidth, gbRef.uRows,
+      gbRef.bbData, gbRef.mData.MemPtr()); }
+}
+/* -- Check if a character needs initialising in the background ------------ */
+size_t GlyphCheckAsync(const Codepoint coChar)
+{ // Return the position if already loaded
+  const size_t stPos = static_cast<size_t>(coChar) * stMultiplier;
+  if(stPos < gvData.size() && gvData[stPos].GlyphIsLoaded()) return stPos;
+  // Send the character to the background rasteriser unless it is the
+  // fall-back character which is always loaded immediately.
+  if(coChar != fulDefaultChar) { GlyphQueue(coChar); GlyphStart(); }
+  // Use the fall-back character until the real one is ready
+  return CheckGlyphNow(static_cast<Codepoint>(fulDefaultChar));
+}
+/* -- Check if a character needs initialising ------------------------------ */
+size_t CheckGlyph(const Codepoint coChar)
+  { return FlagIsSet(FF_ASYNCGLYPHS) ?
+      GlyphCheckAsync(coChar) : CheckGlyphNow(coChar); }
 /* -- Get modified character width at specified position ------------------- */
 GLfloat GetCharWidth(const size_t stPos)
   { return (gvData[stPos].GlyphGetAdvance() + GetCharSpacing()) * glfScale; }
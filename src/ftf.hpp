@@ -25,13 +25,13 @@ using namespace IAsset::P;             using namespace IASync::P;
 using namespace ICollector::P;         using namespace IDim::P;
 using namespace IError::P;             using namespace IEvtMain::P;
 using namespace IFileMap::P;           using namespace IFreeType::P;
-using namespace ILockable::P;          using namespace ILog::P;
-using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace ILuaUtil::P;           using namespace IMemory::P;
-using namespace IName::P;              using namespace ISerial::P;
-using namespace IStd::P;               using namespace ISysUtil::P;
-using namespace IUtil::P;              using namespace Lib::OS::GlFW::Types;
-using namespace Lib::FreeType;
+using namespace IJobs::P;              using namespace ILockable::P;
+using namespace ILog::P;               using namespace ILuaIdent::P;
+using namespace ILuaLib::P;            using namespace ILuaUtil::P;
+using namespace IMemory::P;            using namespace IName::P;
+using namespace ISerial::P;            using namespace IStd::P;
+using namespace ISysUtil::P;           using namespace IUtil::P;
+using namespace Lib::OS::GlFW::Types;  using namespace Lib::FreeType;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* == Ftf collector class for collector data and custom variables ========== */
@@ -188,7 +188,7 @@ CTOR_BEGIN_ASYNC_DUO(Ftfs, Ftf, CLHelperUnsafe, ICHelperUnsafe),
     ICHelperFtf{ cFtfs },              // Initially unregistered
     SerialSlave{ cParent->Serial() },  // Initialise identification number
     AsyncLoaderFtf{ this,              // Initialise async loader with class
-      EMC_MP_FONT },                   // " and the event id
+      EMC_MP_FONT, JP_IMAGE },         // " and the event id and priority
     fOutline(0.0f),                    // No outline size yet
     ftfFace(nullptr),                  // No FreeType handle yet
     ftsStroker(nullptr)                // No FreeType stroker handle yet
@@ -15,14 +15,14 @@ using namespace ICollector::P;         using namespace ICommon::P;
 using namespace IDim::P;               using namespace IError::P;
 using namespace IEvtMain::P;           using namespace IFileMap::P;
 using namespace IImageData::P;         using namespace IImageDef::P;
-using namespace IImageLib::P;          using namespace ILockable::P;
-using namespace ILog::P;               using namespace ILookupMap::P;
-using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace IMemory::P;            using namespace IName::P;
-using namespace IOgl::P;               using namespace ISerial::P;
-using namespace IStd::P;               using namespace IString::P;
-using namespace ISysUtil::P;           using namespace ITexDef::P;
-using namespace IUtil::P;
+using namespace IImageLib::P;          using namespace IJobs::P;
+using namespace ILockable::P;          using namespace ILog::P;
+using namespace ILookupMap::P;         using namespace ILuaIdent::P;
+using namespace ILuaLib::P;            using namespace IMemory::P;
+using namespace IName::P;              using namespace IOgl::P;
+using namespace ISerial::P;            using namespace IStd::P;
+using namespace IString::P;            using namespace ISysUtil::P;
+using namespace ITexDef::P;            using namespace IUtil::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* == Image collector and member class ===================================== */
@@ -932,7 +932,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     ICHelperImage{ cImages },          // Initialise collector helper
     SerialSlave{ cParent->Serial() },  // Initialise identification number
     AsyncLoaderImage{ this,            // Initialise async loader
-      EMC_MP_IMAGE }                   // Initialise async event id
+      EMC_MP_IMAGE, JP_IMAGE }         // Initialise async event id/priority
     /* -- No code ---------------------------------------------------------- */
     {}
   /* -- Constructor with purpose ------------------------------------------- */
@@ -943,7 +943,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     ICHelperImage{ cImages },          // Initialise collector helper
     SerialSlave{ cParent->Serial() },  // Initialise identification number
     AsyncLoaderImage{ this,            // Initialise async loader
-      EMC_MP_IMAGE },                  // Initialise async event id
+      EMC_MP_IMAGE, JP_IMAGE },        // Initialise async event id/priority
     ImageData{ ifcPurpose }            // Initialise purpose of image class
     /* -- No code ---------------------------------------------------------- */
     {}
@@ -955,7 +955,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     ICHelperImage{ cImages },          // Initialise collector helper
     SerialSlave{ cParent->Serial() },  // Initialise identification number
     AsyncLoaderImage{ this,            // Initialise async loader
-      EMC_MP_IMAGE }                   // Initialise async event id
+      EMC_MP_IMAGE, JP_IMAGE }         // Initialise async event id/priority
     /* -- Init 1x1 tex with specified colour ------------------------------- */
     { InitColour(ulColour); }
   /* -- Constructor to Initialise from RAW pixel data ---------------------- */
@@ -971,7 +971,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     ICHelperImage{ cImages },          // Initialise collector helper
     SerialSlave{ cParent->Serial() } , // Initialise identification number
     AsyncLoaderImage{ this,            // Initialise async loader
-      EMC_MP_IMAGE }                   // Initialise async event id
+      EMC_MP_IMAGE, JP_IMAGE }         // Initialise async event id/priority
     /* -- Initialise raw image --------------------------------------------- */
     { InitRaw(ssvName, mRval, uWidth, uHeight, bdBits); }
   /* -- Constructor to initialise from known file formats ------------------ */
@@ -985,7 +985,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     ICHelperImage{ cImages },          // Initialise collector helper
     SerialSlave{ cParent->Serial() } , // Initialise identification number
     AsyncLoaderImage{ this,            // Initialise async loader
-      EMC_MP_IMAGE }                   // Initialise async event id
+      EMC_MP_IMAGE, JP_IMAGE }         // Initialise async event id/priority
     /* -- Initialise from array -------------------------------------------- */
     { InitArray(ssvName, mRval, ifFlags); }
   /* -- Constructor to initialise image from file -------------------------- */
@@ -998,7 +998,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     ICHelperImage{ cImages },          // Initialise collector helper
     SerialSlave{ cParent->Serial() } , // Initialise identification number
     AsyncLoaderImage{ this,            // Initialise async loader
-      EMC_MP_IMAGE }                   // Initialise async event id
+      EMC_MP_IMAGE, JP_IMAGE }         // Initialise async event id/priority
     /* -- Code to initialise from file ------------------------------------- */
     { InitFile(ssvName, ifFlags); }
   /* -- MOVE constructor to SWAP with another ------------------------------ */
@@ -1010,7 +1010,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     ICHelperImage{ cImages },          // Initialise collector helper
     SerialSlave{ cParent->Serial() } , // Initialise identification number
     AsyncLoaderImage{ this,            // Initialise async loader
-      EMC_MP_IMAGE }                   // Initialise async event id
+      EMC_MP_IMAGE, JP_IMAGE }         // Initialise async event id/priority
     /* -- Swap image over -------------------------------------------------- */
     { SwapImage(imOtherRval); }
   /* -- Destructor --------------------------------------------------------- */
@@ -36,9 +36,10 @@ BUILD_FLAGS(Image,                     // Shared image flags
   FF_ROUNDADVANCE           {Flag(3)}, // Do round() on advance width?
   FF_FLOORADVANCE           {Flag(4)}, // Do floor() on advance width?
   FF_CEILADVANCE            {Flag(5)}, // Do ceil() on advance width?
+  FF_ASYNCGLYPHS           {Flag(16)}, // Rasterise new glyphs in background?
   /* -- Font loader public mask bits --------------------------------------- */
   FF_MASK{ FF_USEGLYPHSIZE|FF_STROKETYPE2|FF_FLOORADVANCE|FF_CEILADVANCE|
-           FF_ROUNDADVANCE },
+           FF_ROUNDADVANCE|FF_ASYNCGLYPHS },
   /* -- Font types --------------------------------------------------------- */
   FT_FREETYPE               {Flag(6)}, // Font is a freetype font?
   FT_BITMAP                 {Flag(7)}, // Font is a static bitmap font?
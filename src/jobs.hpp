@@ -0,0 +1,390 @@
+/* == JOBS.HPP ============================================================= **
+** ######################################################################### **
+** ## Mhatxotic Engine          (c) Mhatxotic Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## This module manages a persistent pool of worker threads that will   ## **
+** ## process queued jobs in priority order. Jobs are posted to bounded   ## **
+** ## lock-free queues (one per priority) and the workers only sleep when ## **
+** ## all the queues are empty.                                           ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ------------------------------------------------------------------------- */
+namespace IJobs {                      // Start of private module namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IChrono::P;            using namespace ICVarDef::P;
+using namespace IError::P;             using namespace IHelper::P;
+using namespace ILog::P;               using namespace IMutex::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISysUtil::P;           using namespace IThread::P;
+using namespace IUtil::P;
+/* ------------------------------------------------------------------------- */
+namespace P {                          // Start of public module namespace
+/* ------------------------------------------------------------------------- */
+enum JobPriority : size_t              // Job priorities (highest first)
+{ /* ----------------------------------------------------------------------- */
+  JP_AUDIO,                            // [0] Audio data (Pcm, Stream)
+  JP_IMAGE,                            // [1] Image data (Image, Ftf, Video)
+  JP_BULK,                             // [2] Bulk data (Asset, Archive, Json)
+  /* ----------------------------------------------------------------------- */
+  JP_MAX                               // [3] Maximum number of priorities
+};/* ----------------------------------------------------------------------- */
+enum JobState : unsigned               // Job states
+{ /* ----------------------------------------------------------------------- */
+  JS_STANDBY,                          // [0] Job is not queued nor running
+  JS_QUEUED,                           // [1] Job is waiting for a worker
+  JS_RUNNING,                          // [2] Job is executing in a worker
+  JS_FINISHED,                         // [3] Job finished, not acknowledged
+};/* ----------------------------------------------------------------------- */
+class Job;                             // Job class prototype
+using CbJobFunc = function<void(Job&)>; // Job callback function
+/* == Job class ============================================================ */
+class Job                              // Members initially private
+{ /* -- Private variables -------------------------------------------------- */
+  using AtomicJobState = StdAtomic<JobState>;
+  using AtomicThreadPtr = StdAtomic<const Thread*>;
+  /* ----------------------------------------------------------------------- */
+  AtomicJobState   ajsState;           // Current state of the job
+  AtomicBool       abShouldExit;       // Job should abort as soon as possible
+  AtomicThreadPtr  atpWorker;          // Worker thread processing the job
+  const JobPriority jpPriority;        // Priority of the job
+  const CbJobFunc  cjfFunc;            // Job callback function
+  size_t           stSlot;             // Position in the queue when queued
+  /* --------------------------------------------------------------- */ public:
+  JobState JobGetState() const { return ajsState; }
+  void JobSetState(const JobState jsState) { ajsState = jsState; }
+  /* ----------------------------------------------------------------------- */
+  bool JobIsStandby() const { return JobGetState() == JS_STANDBY; }
+  bool JobIsQueued() const { return JobGetState() == JS_QUEUED; }
+  bool JobIsBusy() const
+    { const JobState jsState = JobGetState();
+      return jsState == JS_QUEUED || jsState == JS_RUNNING; }
+  bool JobIsNotBusy() const { return !JobIsBusy(); }
+  /* ----------------------------------------------------------------------- */
+  bool JobShouldExit() const { return abShouldExit; }
+  bool JobShouldNotExit() const { return !JobShouldExit(); }
+  void JobSetExit() { abShouldExit = true; }
+  /* ----------------------------------------------------------------------- */
+  bool JobIsCurrent() const
+    { const Thread*const tWorker = atpWorker;
+      return tWorker && tWorker->ThreadIsCurrent(); }
+  void JobSetWorker(const Thread*const tWorker) { atpWorker = tWorker; }
+  /* ----------------------------------------------------------------------- */
+  JobPriority JobGetPriority() const { return jpPriority; }
+  const CbJobFunc &JobGetCallback() const { return cjfFunc; }
+  /* ----------------------------------------------------------------------- */
+  size_t JobGetSlot() const { return stSlot; }
+  void JobSetSlot(const size_t stNSlot) { stSlot = stNSlot; }
+  /* -- Job acknowledged so reset to standby ------------------------------- */
+  void JobReset()
+    { JobSetWorker(nullptr); abShouldExit = false; JobSetState(JS_STANDBY); }
+  /* -- Constructor -------------------------------------------------------- */
+  Job(const JobPriority jpNPriority,   // Priority of job
+      const CbJobFunc &cjfNFunc) :     // Function to call
+    /* -- Initialisers ----------------------------------------------------- */
+    ajsState{ JS_STANDBY },            // Job not queued
+    abShouldExit{ false },             // Job not aborted
+    atpWorker{ nullptr },              // No worker processing the job
+    jpPriority(jpNPriority),           // Set priority of job
+    cjfFunc{ cjfNFunc },               // Set job callback function
+    stSlot(0)                          // No queue slot
+    /* -- No code ---------------------------------------------------------- */
+    {}
+};/* == Bounded lock-free multiple producer/consumer job queue ============== */
+class JobQueue                         // Members initially private
+{ /* -- Private typedefs --------------------------------------------------- */
+  using AtomicJobPtr = StdAtomic<Job*>;
+  /* ----------------------------------------------------------------------- */
+  struct JobCell                       // Queue slot
+  { /* --------------------------------------------------------------------- */
+    AtomicSizeT    astSequence;        // Sequence number of slot
+    AtomicJobPtr   ajpJob;             // Job in slot (nullptr if cancelled)
+  };/* --------------------------------------------------------------------- */
+  static constexpr size_t stCapacity = 4096, // Maximum jobs (power of two)
+                          stMask = stCapacity - 1; // Mask to wrap position
+  /* -- Private variables -------------------------------------------------- */
+  StdArray<JobCell, stCapacity> aCells; // Queue slots
+  AtomicSizeT      astEnqueue,         // Next position to write
+                   astDequeue,         // Next position to read
+                   astCompleted,       // Number of jobs completed
+                   astCancelled;       // Number of jobs cancelled
+  AtomicUInt64     auNanoSeconds;      // Total time processing jobs
+  /* -- Push job (false if queue is full) -------------------------- */ public:
+  bool JobQueuePush(Job &jJob)
+  { // Get current write position and keep trying...
+    size_t stPos = astEnqueue;
+    for(;;)
+    { // Get cell at this position and compare its sequence with the position
+      JobCell &jcCell = aCells[stPos & stMask];
+      const int64_t llDiff =
+        static_cast<int64_t>(jcCell.astSequence - stPos);
+      // Cell is free? Try to claim it and if we did?
+      if(!llDiff)
+      { // Try to claim it and try again if another thread beat us to it
+        if(!astEnqueue.compare_exchange_weak(stPos, stPos + 1)) continue;
+        // Store the job and publish the slot to consumers
+        jJob.JobSetSlot(stPos);
+        jcCell.ajpJob = &jJob;
+        jcCell.astSequence = stPos + 1;
+        // Success
+        return true;
+      } // Queue is full?
+      if(llDiff < 0) return false;
+      // Another thread moved the position so reload it
+      stPos = astEnqueue;
+    }
+  }
+  /* -- Pop job (false if queue is empty, 'jpJob' is null if cancelled) ---- */
+  bool JobQueuePop(Job *&jpJob)
+  { // Get current read position and keep trying...
+    size_t stPos = astDequeue;
+    for(;;)
+    { // Get cell at this position and compare its sequence with the position
+      JobCell &jcCell = aCells[stPos & stMask];
+      const int64_t llDiff =
+        static_cast<int64_t>(jcCell.astSequence - (stPos + 1));
+      // Cell is populated?
+      if(!llDiff)
+      { // Try to claim it and try again if another thread beat us to it
+        if(!astDequeue.compare_exchange_weak(stPos, stPos + 1)) continue;
+        // Take ownership of the job and release the slot to producers
+        jpJob = jcCell.ajpJob.exchange(nullptr);
+        jcCell.astSequence = stPos + stCapacity;
+        // Success
+        return true;
+      } // Queue is empty?
+      if(llDiff < 0) return false;
+      // Another thread moved the position so reload it
+      stPos = astDequeue;
+    }
+  }
+  /* -- Remove job from its slot if a worker has not already taken it ------ */
+  bool JobQueueCancel(Job &jJob)
+  { // Job we expect to be in the slot
+    Job *jpExpect = &jJob;
+    // Swap it with a nullptr so the worker will skip it
+    if(!aCells[jJob.JobGetSlot() & stMask].ajpJob.
+      compare_exchange_strong(jpExpect, nullptr)) return false;
+    // Job was cancelled
+    ++astCancelled;
+    return true;
+  }
+  /* -- Job completed ------------------------------------------------------ */
+  void JobQueueCompleted(const uint64_t uNanoSeconds)
+    { ++astCompleted; auNanoSeconds += uNanoSeconds; }
+  /* -- Return counters ---------------------------------------------------- */
+  size_t JobQueueSize() const { return astEnqueue - astDequeue; }
+  size_t JobQueueSubmitted() const { return astEnqueue; }
+  size_t JobQueueCompleted() const { return astCompleted; }
+  size_t JobQueueCancelled() const { return astCancelled; }
+  uint64_t JobQueueNanoSeconds() const { return auNanoSeconds; }
+  static size_t JobQueueCapacity() { return stCapacity; }
+  /* -- Constructor -------------------------------------------------------- */
+  JobQueue() :
+    /* -- Initialisers ----------------------------------------------------- */
+    astEnqueue{ 0 },                   // Initialise write position
+    astDequeue{ 0 },                   // Initialise read position
+    astCompleted{ 0 },                 // Initialise completed jobs
+    astCancelled{ 0 },                 // Initialise cancelled jobs
+    auNanoSeconds{ 0 }                 // Initialise processing time
+    /* -- Initialise sequence numbers -------------------------------------- */
+    { for(size_t stIndex = 0; stIndex < stCapacity; ++stIndex)
+      { JobCell &jcCell = aCells[stIndex];
+        jcCell.astSequence = stIndex;
+        jcCell.ajpJob = nullptr; } }
+};/* == Jobs class ========================================================= */
+class Jobs;                            // Class prototype
+static Jobs *cJobs = nullptr;          // Pointer to global class
+class Jobs :                           // Worker pool class
+  /* -- Base classes ------------------------------------------------------- */
+  private InitHelper                   // Initialisation helper class
+{ /* -- Private variables -------------------------------------------------- */
+  using JobQueues = StdArray<JobQueue, JP_MAX>;
+  /* ----------------------------------------------------------------------- */
+  JobQueues        jqQueues;           // Job queues for each priority
+  StdList<Thread>  ltWorkers;          // Worker threads
+  MutexLock        mlJobs;             // Sleeping and waking mutex
+  condition_variable cvQueued,         // Signalled when a job is queued
+                   cvFinished,         // Signalled when a job is finished
+                   cvRoom;             // Signalled when a job is taken
+  AtomicSizeT      astPending,         // Jobs waiting for a worker
+                   astPeak,            // Highest number of pending jobs
+                   astBusy,            // Number of workers processing jobs
+                   astWaiting;         // Threads waiting for a full queue
+  size_t           stWorkers;          // Number of workers requested
+  /* -- Process a job ------------------------------------------------------ */
+  void JobsRun(Job &jJob, JobQueue &jqQueue, const Thread &tWorker)
+  { // Job is now running in this worker
+    jJob.JobSetWorker(&tWorker);
+    jJob.JobSetState(JS_RUNNING);
+    ++astBusy;
+    // Time the job and process it capturing any stray exceptions
+    const Chrono cJob;
+    try { jJob.JobGetCallback()(jJob); }
+    catch(const StdException &eReason)
+    { cLog->LogErrorExSafe("Jobs worker '$' caught exception: $!",
+        tWorker.NameGet(), eReason); }
+    // Update counters
+    jqQueue.JobQueueCompleted(cJob.CCDeltaNS());
+    --astBusy;
+    // Job is finished. The owner can now destroy the job as soon as we unlock
+    // the mutex so we must not touch the job after this.
+    mlJobs.MutexCall([&jJob](){ jJob.JobSetState(JS_FINISHED); });
+    cvFinished.notify_all();
+  }
+  /* -- Process the highest priority job available ------------------------- */
+  bool JobsProcess(const Thread &tWorker)
+  { // For each queue in priority order
+    for(JobQueue &jqQueue : jqQueues)
+    { // Try to take a job from the queue and try the next queue if empty
+      Job *jpJob;
+      if(!jqQueue.JobQueuePop(jpJob)) continue;
+      // One less job pending and wake threads waiting for room if any
+      --astPending;
+      if(astWaiting) mlJobs.MutexCall([this](){ cvRoom.notify_all(); });
+      // Process the job if it was not cancelled
+      if(jpJob) JobsRun(*jpJob, jqQueue, tWorker);
+      // A slot was processed
+      return true;
+    } // Nothing was processed
+    return false;
+  }
+  /* -- Worker thread ------------------------------------------------------ */
+  ThreadStatus JobsThreadMain(Thread &tThread)
+  { // Loop until thread is signalled to exit
+    while(tThread.ThreadShouldNotExit())
+    { // Process the next job and try again if we processed one
+      if(JobsProcess(tThread)) continue;
+      // Nothing to do so sleep until a job is queued or we should exit
+      mlJobs.MutexUniqueCall([this, &tThread](UniqueLock &ulLock){
+        cvQueued.wait(ulLock, [this, &tThread]{
+          return astPending || tThread.ThreadShouldExit(); });
+      });
+    } // Terminate thread
+    return TS_OK;
+  }
+  /* -- Start the workers -------------------------------------------------- */
+  void JobsInit()
+  { // Class initialised
+    IHInitialise();
+    // Log subsystem
+    cLog->LogDebugSafe("Jobs class starting up...");
+    // Get number of workers to start
+    const size_t stCount = JobsGetWorkersTarget();
+    // Create and start the workers
+    for(size_t stIndex = 0; stIndex < stCount; ++stIndex)
+      ltWorkers.emplace_back(StrAppend("job", stIndex), STP_LOW,
+        bind(&Jobs::JobsThreadMain, this, _1)).ThreadStart();
+    // Log status
+    cLog->LogDebugExSafe("Jobs class started $ workers successfully.",
+      ltWorkers.size());
+  }
+  /* -- Stop the workers --------------------------------------------------- */
+  void JobsDeInit()
+  { // Ignore if class already de-initialised
+    if(IHNotDeInitialise()) return;
+    // Log subsystem
+    cLog->LogDebugSafe("Jobs class shutting down...");
+    // Signal all the workers to exit and wake any that are sleeping
+    for(Thread &tWorker : ltWorkers) tWorker.ThreadSetExit();
+    mlJobs.MutexCall([this](){ cvQueued.notify_all(); });
+    // Wait for them to finish and remove them
+    for(Thread &tWorker : ltWorkers) tWorker.ThreadStop();
+    ltWorkers.clear();
+    // Report status
+    cLog->LogDebugExSafe("Jobs class shutdown with $ jobs still pending.",
+      astPending.load());
+  }
+  /* -- Queue a job ------------------------------------------------ */ public:
+  void JobsQueue(Job &jJob)
+  { // Job must not already be queued or running
+    if(!jJob.JobIsStandby())
+      XC("Job is already queued!", "Priority", jJob.JobGetPriority());
+    // Start the workers if this is the first job
+    if(IHIsNotInitialised()) JobsInit();
+    // Job is now queued and pending. Set these before pushing as a worker can
+    // pop it immediately.
+    jJob.JobSetState(JS_QUEUED);
+    mlJobs.MutexCall([this](){
+      if(++astPending > astPeak) astPeak = astPending.load();
+    });
+    // Push the job into the queue for its priority and if it is full then
+    // wait for the workers to make room.
+    JobQueue &jqQueue = jqQueues[jJob.JobGetPriority()];
+    if(!jqQueue.JobQueuePush(jJob))
+    { // Report the stall
+      cLog->LogWarningExSafe("Jobs queue $ is full with $ jobs!",
+        jJob.JobGetPriority(), jqQueue.JobQueueSize());
+      // Sleep until a worker takes a job and there is room. Workers only
+      // signal while we are waiting so register before trying again.
+      mlJobs.MutexUniqueCall([this, &jqQueue, &jJob](UniqueLock &ulLock){
+        ++astWaiting;
+        cvRoom.wait(ulLock, [&jqQueue, &jJob]{
+          return jqQueue.JobQueuePush(jJob); });
+        --astWaiting;
+      });
+    } // Wake a worker
+    cvQueued.notify_one();
+  }
+  /* -- Wait for job to finish and reset it -------------------------------- */
+  void JobsWait(Job &jJob)
+  { // If is the worker running this job then this is a bad idea
+    if(jJob.JobIsCurrent()) XC("Tried to wait for job from the same thread!",
+      "Priority", jJob.JobGetPriority());
+    // Wait for the job to finish if it is queued or running
+    if(jJob.JobIsBusy())
+      mlJobs.MutexUniqueCall([this, &jJob](UniqueLock &ulLock){
+        cvFinished.wait(ulLock, [&jJob]{ return jJob.JobIsNotBusy(); });
+      });
+    // Job acknowledged
+    jJob.JobReset();
+  }
+  /* -- Cancel job if queued or signal it to exit and wait ----------------- */
+  void JobsStop(Job &jJob)
+  { // Ignore if job was never queued
+    if(jJob.JobIsStandby()) return;
+    // Signal the job that it should abort
+    jJob.JobSetExit();
+    // If job is still queued then take it out of the queue so no worker will
+    // pick it up and we're done.
+    if(jJob.JobIsQueued() &&
+       jqQueues[jJob.JobGetPriority()].JobQueueCancel(jJob))
+      return jJob.JobReset();
+    // A worker has it so wait for it to finish
+    JobsWait(jJob);
+  }
+  /* -- Return counters ---------------------------------------------------- */
+  const JobQueue &JobsGetQueue(const JobPriority jpPriority) const
+    { return jqQueues[jpPriority]; }
+  size_t JobsGetWorkers() const { return ltWorkers.size(); }
+  /* -- Return number of workers that will be (or were) started ------------ */
+  size_t JobsGetWorkersTarget() const
+  { // Use the number of hardware threads if not specified and always make
+    // sure there are at least two workers.
+    return stWorkers ? stWorkers : UtilMaximum(StdThreadMax(), 2U);
+  }
+  size_t JobsGetPending() const { return astPending; }
+  size_t JobsGetPeak() const { return astPeak; }
+  size_t JobsGetBusy() const { return astBusy; }
+  /* -- Default constructor ------------------------------------- */ protected:
+  Jobs() :
+    /* -- Initialisers ----------------------------------------------------- */
+    InitHelper{ __FUNCTION__ },        // Initialise class name
+    astPending{ 0 },                   // Initialise pending jobs
+    astPeak{ 0 },                      // Initialise peak pending jobs
+    astBusy{ 0 },                      // Initialise busy workers
+    astWaiting{ 0 },                   // Initialise waiting threads
+    stWorkers(0)                       // Initialise requested workers
+    /* -- Set global pointer to static class ------------------------------- */
+    { cJobs = this; }
+  /* -- Destructor --------------------------------------------------------- */
+  DTORHELPER(~Jobs, JobsDeInit())
+  /* -- Set number of workers -------------------------------------- */ public:
+  CVarReturn JobsSetWorkers(const size_t stCount)
+    { return IHIsInitialised() ? DENY :
+        CVarSimpleSetIntNG(stWorkers, stCount, 256); }
+};/* ----------------------------------------------------------------------- */
+}                                      // End of public module namespace
+/* ------------------------------------------------------------------------- */
+}                                      // End of private module namespace
+/* == EoF =========================================================== EoF == */
@@ -13,13 +13,14 @@ namespace IJson {                      // Start of private module namespace
 using namespace IAsset::P;             using namespace IASync::P;
 using namespace ICollector::P;         using namespace IError::P;
 using namespace IEvtMain::P;           using namespace IFileMap::P;
-using namespace IFStream::P;           using namespace ILockable::P;
-using namespace ILog::P;               using namespace ILuaBase::P;
-using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace ILuaUtil::P;           using namespace IMemory::P;
-using namespace IName::P;              using namespace ISerial::P;
-using namespace IStd::P;               using namespace ISysUtil::P;
-using namespace IUtil::P;              using namespace Lib::RapidJson;
+using namespace IFStream::P;           using namespace IJobs::P;
+using namespace ILockable::P;          using namespace ILog::P;
+using namespace ILuaBase::P;           using namespace ILuaIdent::P;
+using namespace ILuaLib::P;            using namespace ILuaUtil::P;
+using namespace IMemory::P;            using namespace IName::P;
+using namespace ISerial::P;            using namespace IStd::P;
+using namespace ISysUtil::P;           using namespace IUtil::P;
+using namespace Lib::RapidJson;
 /* ------------------------------------------------------------------------- */
 using Lib::RapidJson::Value;
 /* ------------------------------------------------------------------------- */
@@ -427,7 +428,7 @@ CTOR_BEGIN_ASYNC_DUO(Jsons, Json, CLHelperUnsafe, ICHelperUnsafe),
     ICHelperJson{ cJsons },            // Initialise collector
     SerialSlave{ cParent->Serial() },  // Initialise identification number
     AsyncLoaderJson{ this,             // Initialise async loader with this
-      EMC_MP_JSON }                    // ...and the event id
+      EMC_MP_JSON, JP_BULK }           // ...and the event id and priority
     /* -- No code ---------------------------------------------------------- */
     {}
   /* -- Constructor from a filename ---------------------------------------- */
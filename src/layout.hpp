@@ -0,0 +1,106 @@
+/* == LAYOUT.HPP =========================================================== **
+** ######################################################################### **
+** ## Mhatxotic Engine          (c) Mhatxotic Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## Stores the triangles of a string laid out by a font so static text  ## **
+** ## does not have to be decoded, wrapped and measured every frame. The  ## **
+** ## layout is only rebuilt when its text, width or alignment changes or ## **
+** ## when the font metrics or font atlas changes.                        ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ------------------------------------------------------------------------- */
+namespace ILayout {                    // Start of private module namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace ICollector::P;         using namespace IFboCmd::P;
+using namespace IFboItem::P;           using namespace IFont::P;
+using namespace ILockable::P;          using namespace ILog::P;
+using namespace ILuaIdent::P;          using namespace ILuaLib::P;
+using namespace ISerial::P;            using namespace IStd::P;
+using namespace IUtil::P;              using namespace Lib::OS::GlFW::Types;
+/* ------------------------------------------------------------------------- */
+namespace P {                          // Start of public module namespace
+/* == Layout collector and member class ==================================== */
+CTOR_BEGIN_DUO(Layouts, Layout, CLHelperUnsafe, ICHelperUnsafe),
+  /* -- Base classes ------------------------------------------------------- */
+  public Lockable                      // Lua garbage collect instruction
+{ /* -- Private variables -------------------------------------------------- */
+  FboTriVec        ftvData;            // Laid out triangles at the origin
+  StdVector<size_t> stvOutline;        // Outline triangles (not tinted)
+  StdString        strText;            // Text to lay out
+  GLfloat          glfWrap,            // Wrap width (left alignment only)
+                   glfWidth,           // Width of laid out text
+                   glfHeight;          // Height of laid out text
+  FontAlign        faAlign;            // Alignment of the text
+  uint64_t         ullStamp;           // Font layout stamp when built
+  unsigned         uAtlasWidth;        // Font atlas width when built
+  FboItem::QuadIntData qidOutline;     // Font outline colour when built
+  bool             bDirty;             // Layout needs rebuilding
+  /* -- Rebuild the layout if anything it depends on changed --------------- */
+  void LayoutUpdate(Font &fRef)
+  { // Ignore if nothing that affects the triangles changed
+    if(!bDirty && ullStamp == fRef.LayoutGetStamp() &&
+       uAtlasWidth == fRef.DimGetWidth() &&
+       qidOutline == fRef.fiOutline.FboItemGetCData()) return;
+    // Lay out the text again
+    fRef.LayoutBuild(ftvData, stvOutline, strText, glfWrap, faAlign);
+    // Record what the layout was built with
+    ullStamp = fRef.LayoutGetStamp();
+    uAtlasWidth = fRef.DimGetWidth();
+    qidOutline = fRef.fiOutline.FboItemGetCData();
+    bDirty = false;
+    // Nothing laid out? Layout has no size
+    if(ftvData.empty()) { glfWidth = glfHeight = 0.0f; return; }
+    // Find the bounds of all the vertices
+    GLfloat glfL = StdLimits<GLfloat>::max(), glfT = glfL,
+            glfR = StdLimits<GLfloat>::lowest(), glfB = glfR;
+    for(const FboTri &ftRef : ftvData)
+      for(const FboVert &fvRef : ftRef)
+      { glfL = UtilMinimum(glfL, fvRef.tvVertex[0]);
+        glfR = UtilMaximum(glfR, fvRef.tvVertex[0]);
+        glfT = UtilMinimum(glfT, fvRef.tvVertex[1]);
+        glfB = UtilMaximum(glfB, fvRef.tvVertex[1]); }
+    // Set the size of the layout
+    glfWidth = glfR - glfL;
+    glfHeight = glfB - glfT;
+  }
+  /* -- Set text of the layout ------------------------------------- */ public:
+  void LayoutSetText(const StdStringView &ssvText)
+    { if(strText == ssvText) return; strText = ssvText; bDirty = true; }
+  /* -- Set wrap width of the layout --------------------------------------- */
+  void LayoutSetWrap(const GLfloat glfNWrap)
+    { if(glfWrap == glfNWrap) return; glfWrap = glfNWrap; bDirty = true; }
+  /* -- Set alignment of the layout ---------------------------------------- */
+  void LayoutSetAlign(const FontAlign faNAlign)
+    { if(faAlign == faNAlign) return; faAlign = faNAlign; bDirty = true; }
+  /* -- Build the layout with the specified font --------------------------- */
+  void LayoutPrepare(Font &fRef) { LayoutUpdate(fRef); }
+  /* -- Draw the layout with the specified font at the specified position -- */
+  void LayoutDraw(Font &fRef, const GLfloat glfX, const GLfloat glfY)
+    { LayoutUpdate(fRef); fRef.LayoutBlit(ftvData, stvOutline, glfX, glfY); }
+  /* -- Return size and triangle count of the layout ----------------------- */
+  GLfloat LayoutGetWidth() const { return glfWidth; }
+  GLfloat LayoutGetHeight() const { return glfHeight; }
+  size_t LayoutGetTris() const { return ftvData.size(); }
+  /* -- Constructor -------------------------------------------------------- */
+  Layout() :
+    /* -- Initialisers ----------------------------------------------------- */
+    ICHelperLayout{ cLayouts, this },  // Automatic (de)registration
+    SerialSlave{ cParent->Serial() },  // Initialise identification number
+    glfWrap(0.0f),                     // No wrapping
+    glfWidth(0.0f),                    // No width yet
+    glfHeight(0.0f),                   // No height yet
+    faAlign(FA_LEFT),                  // Left aligned
+    ullStamp(0),                       // Not built with any font yet
+    uAtlasWidth(0),                    // No atlas width yet
+    qidOutline{},                      // No outline colour yet
+    bDirty(true)                       // Needs building
+    /* -- No code ---------------------------------------------------------- */
+    {}
+};/* ----------------------------------------------------------------------- */
+CTOR_END_NOINITS(Layouts, Layout, LAYOUT) // End of layout objects collector
+/* ------------------------------------------------------------------------- */
+}                                      // End of public module namespace
+/* ------------------------------------------------------------------------- */
+}                                      // End of private module namespace
+/* == EoF =========================================================== EoF == */
@@ -183,6 +183,15 @@ using IFbo::P::cFbos;
 struct AgFbo : public ArClass<Fbo>
   { explicit AgFbo(lua_State*const lS, const int iArg) :
       ArClass{LuaUtilGetClassRef<Fbo>(lS, iArg, cFbos)}{} };
+/* -- Get Layout object ---------------------------------------------------- */
+using ILayout::P::Layout;
+using ILayout::P::cLayouts;
+struct AgLayout : public ArClass<Layout>
+  { explicit AgLayout(lua_State*const lS, const int iArg) :
+      ArClass{LuaUtilGetClassRef<Layout>(lS, iArg, cLayouts)}{} };
+struct AcLayout : public ArClass<Layout>
+  { explicit AcLayout(lua_State*const lS) :
+      ArClass{LuaUtilClassCreateRef<Layout>(lS, cLayouts)}{} };
 /* -- Get Pcm object ------------------------------------------------------- */
 using IPcm::P::Pcm;
 using IPcm::P::cPcms;
@@ -218,6 +227,10 @@ struct AgVolume : public AgALfloatLG {
 struct AgFilterId : public AgIntegerLGE<IOgl::P::OglFilterEnum> {
   explicit AgFilterId(lua_State*const lS, const int iArg) :
     AgIntegerLGE{lS, iArg, IOgl::P::OF_N_N, IOgl::P::OF_MAX}{} };
+/* -- Read a font layout alignment ----------------------------------------- */
+struct AgFontAlign : public AgIntegerLGE<IFont::P::FontAlign> {
+  explicit AgFontAlign(lua_State*const lS, const int iArg) :
+    AgIntegerLGE{lS, iArg, IFont::P::FA_LEFT, IFont::P::FA_MAX}{} };
 /* -- Other types ---------------------------------------------------------- */
 struct AgTextureDimension : public AgIntegerLG<GLsizei>
   { explicit AgTextureDimension(lua_State*const lS, const int iArg) :
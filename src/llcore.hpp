@@ -23,8 +23,9 @@ using namespace IConDef::P;            using namespace IConsole::P;
 using namespace ICore::P;              using namespace IDisplay::P;
 using namespace IEvtMain::P;           using namespace IFrame::P;
 using namespace ILog::P;               using namespace ILua::P;
-using namespace IStd::P;               using namespace IString::P;
-using namespace ISystem::P;            using namespace IUtil::P;
+using namespace IProfile::P;           using namespace IStd::P;
+using namespace IString::P;            using namespace ISystem::P;
+using namespace IUtil::P;
 /* ========================================================================= **
 ** ######################################################################### **
 ** ## Core common helper classes                                          ## **
@@ -370,6 +371,52 @@ LLFUNC(Pause, 0, cEvtMain->Add(EMC_LUA_PAUSE))
 LLFUNC(PidRunning, 1, const AgPid aPid{lS, 1};
   LuaUtilPushVar(lS, cSystem->IsPidRunning(aPid)))
 /* ========================================================================= */
+// $ Core.Profile
+// > State:boolean=Start or stop recording.
+// ? Starts or stops recording the time spent in engine zones such as the
+// ? main tick, event handling, rendering, async loading and the audio thread.
+// ? Recording costs almost nothing when stopped.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Profile, 0, cProfile->ProfileSetEnabled(AgBoolean{lS, 1}))
+/* ========================================================================= */
+// $ Core.ProfileDump
+// > Frames:integer=Number of recent frames to write or zero for everything.
+// > File:string=The filename of the trace to write.
+// < Zones:integer=Number of zones written.
+// ? Writes the zones recorded in the specified number of recent frames as a
+// ? Chrome trace event JSON file which can be opened in a trace viewer.
+/* ------------------------------------------------------------------------- */
+LLFUNC(ProfileDump, 1,
+  const AgSizeT aFrames{lS, 1};
+  const AgFilename aFile{lS, 2};
+  LuaUtilPushVar(lS, cProfile->ProfileDump(aFrames, aFile)))
+/* ========================================================================= */
+// $ Core.ProfileStats
+// > Frames:integer=Number of recent frames to total or zero for everything.
+// < Times:table=Total seconds spent in each zone keyed by zone name.
+// < Calls:table=Number of times each zone was entered keyed by zone name.
+// ? Totals the zones recorded in the specified number of recent frames.
+/* ------------------------------------------------------------------------- */
+LLFUNC(ProfileStats, 2,
+  const AgSizeT aFrames{lS, 1};
+  const auto mZones{ cProfile->ProfileStats(aFrames) };
+  LuaUtilPushObject(lS, mZones.size());
+  const int iTimes = LuaBaseGetTop(lS);
+  for(const auto &mZone : mZones)
+  { LuaUtilPushVar(lS, static_cast<double>(mZone.second.first) / 1e9);
+    LuaBaseSetField(lS, iTimes, mZone.first.data()); }
+  LuaUtilPushObject(lS, mZones.size());
+  const int iCalls = LuaBaseGetTop(lS);
+  for(const auto &mZone : mZones)
+  { LuaUtilPushVar(lS, mZone.second.second);
+    LuaBaseSetField(lS, iCalls, mZone.first.data()); })
+/* ========================================================================= */
+// $ Core.Profiling
+// < State:boolean=The profiler is recording.
+// ? Returns if the profiler is recording.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Profiling, 1, LuaUtilPushVar(lS, cProfile->ProfileIsEnabled()))
+/* ========================================================================= */
 // $ Core.Quit
 // ? Terminates the engine process cleanly.
 /* ------------------------------------------------------------------------- */
@@ -411,6 +458,67 @@ LLFUNC(RestartNP, 0, cEvtMain->Add(EMC_QUIT_RESTARTNP))
 /* ------------------------------------------------------------------------- */
 LLFUNC(RestoreDelay, 0, cFrame->FrameRestoreDelay())
 /* ========================================================================= */
+// $ Core.SampleDump
+// > File:string=The filename of the folded stacks to write.
+// < Stacks:integer=Number of unique call stacks written.
+// ? Writes the call stacks recorded by the Lua sampler as folded stacks, one
+// ? 'outer;inner;leaf count' line per unique stack, which can be turned into
+// ? a flame graph by tools such as 'flamegraph.pl' or 'speedscope'.
+/* ------------------------------------------------------------------------- */
+LLFUNC(SampleDump, 1,
+  LuaUtilPushVar(lS, cLua->LuaProfDump(AgFilename{lS, 1})))
+/* ========================================================================= */
+// $ Core.SampleStart
+// > Operations:integer=Lua operations between each sample.
+// > Interval:integer=Minimum microseconds between each sample or zero.
+// > Samples:integer=Maximum number of samples to record.
+// ? Starts recording the Lua call stack every specified number of operations
+// ? and no more often than the specified interval. All memory is allocated
+// ? up front and samples are dropped when the buffer is full. Any samples
+// ? from a previous session are discarded.
+/* ------------------------------------------------------------------------- */
+LLFUNC(SampleStart, 0,
+  const AgIntLG aOperations{lS, 1, 1, 1000000000};
+  const AgUIntLG aInterval{lS, 2, 0, 1000000};
+  const AgSizeTLG aSamples{lS, 3, 1, 16777216};
+  cLua->LuaSampleStart(aOperations,
+    static_cast<uint64_t>(aInterval()) * 1000, aSamples))
+/* ========================================================================= */
+// $ Core.SampleStats
+// < Inclusive:table=Samples each function was on the stack for by name.
+// < Exclusive:table=Samples each function was running in by name.
+// ? Totals the call stacks recorded by the Lua sampler per function. Names
+// ? include the source and line the function was defined on.
+/* ------------------------------------------------------------------------- */
+LLFUNC(SampleStats, 2,
+  const auto mFuncs{ cLua->LuaProfStats() };
+  LuaUtilPushObject(lS, mFuncs.size());
+  const int iInclusive = LuaBaseGetTop(lS);
+  for(const auto &mFunc : mFuncs)
+  { LuaUtilPushVar(lS, mFunc.second.first);
+    LuaBaseSetField(lS, iInclusive, mFunc.first.data()); }
+  LuaUtilPushObject(lS, mFuncs.size());
+  const int iExclusive = LuaBaseGetTop(lS);
+  for(const auto &mFunc : mFuncs)
+  { LuaUtilPushVar(lS, mFunc.second.second);
+    LuaBaseSetField(lS, iExclusive, mFunc.first.data()); })
+/* ========================================================================= */
+// $ Core.SampleStop
+// ? Stops the Lua sampler. The recorded samples are kept until the sampler is
+// ? started again.
+/* ------------------------------------------------------------------------- */
+LLFUNC(SampleStop, 0, cLua->LuaSampleStop())
+/* ========================================================================= */
+// $ Core.Sampling
+// < State:boolean=The Lua sampler is running.
+// < Samples:integer=Number of samples recorded.
+// < Dropped:integer=Number of samples dropped because the buffer was full.
+// ? Returns the state of the Lua sampler.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Sampling, 3,
+  LuaUtilPushVar(lS, cLua->LuaProfIsSampling(), cLua->LuaProfGetSamples(),
+    cLua->LuaProfGetDropped()))
+/* ========================================================================= */
 // $ Core.ScrollDown
 // ? Scrolls the console up one line.
 /* ------------------------------------------------------------------------- */
@@ -556,8 +664,11 @@ LLRSBEGIN                              // Core.* namespace functions begin
   LLRSFUNC(OnTick),       LLRSFUNC(OS),           LLRSFUNC(OSMicroTime),
   LLRSFUNC(OSMilliTime),  LLRSFUNC(OSNanoTime),   LLRSFUNC(OSNumTime),
   LLRSFUNC(OSTime),       LLRSFUNC(Pause),        LLRSFUNC(PidRunning),
-  LLRSFUNC(Quit),         LLRSFUNC(RAM),          LLRSFUNC(Reset),
-  LLRSFUNC(Restart),      LLRSFUNC(RestartNP),    LLRSFUNC(RestoreDelay),
+  LLRSFUNC(Profile),      LLRSFUNC(ProfileDump),  LLRSFUNC(ProfileStats),
+  LLRSFUNC(Profiling),    LLRSFUNC(Quit),         LLRSFUNC(RAM),
+  LLRSFUNC(Reset),        LLRSFUNC(Restart),      LLRSFUNC(RestartNP),
+  LLRSFUNC(RestoreDelay), LLRSFUNC(SampleDump),   LLRSFUNC(SampleStart),
+  LLRSFUNC(SampleStats),  LLRSFUNC(SampleStop),   LLRSFUNC(Sampling),
   LLRSFUNC(ScrollDown),   LLRSFUNC(ScrollUp),     LLRSFUNC(SetDelay),
   LLRSFUNC(SetIcon),      LLRSFUNC(Stack),        LLRSFUNC(StatusLeft),
   LLRSFUNC(StatusRight),  LLRSFUNC(Suspend),      LLRSFUNC(Ticks),
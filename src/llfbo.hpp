@@ -142,6 +142,13 @@ LLFUNC(GetMatrix, 6,
 /* ------------------------------------------------------------------------- */
 LLFUNC(GetName, 1, LuaUtilPushVar(lS, AgFbo{lS, 1}().NameGet()))
 /* ========================================================================= */
+// $ Fbo:Layer
+// ? Starts a new layer when command coalescing is enabled with
+// ? Fbo:SetCoalesce(). Everything drawn in the previous layer is drawn before
+// ? anything in the new layer. Does nothing if coalescing is disabled.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Layer, 0, AgFbo{lS, 1}().FboLayer())
+/* ========================================================================= */
 // $ Fbo:Reserve
 // > Triangles:integer=How many triangles to reserve in GPU float list
 // > Commands:integer=How many structs to reserve in GPU commands list
@@ -202,6 +209,17 @@ LLFUNC(SetClearColour, 0,
                   aAlpha{lS, 5};
   aFbo().ColourSet(aRed, aGreen, aBlue, aAlpha))
 /* ========================================================================= */
+// $ Fbo:SetCoalesce
+// > State:boolean=Reorder draw commands by state.
+// ? When enabled, the commands drawn into the Fbo are grouped by shader,
+// ? texture unit and texture before rendering so interleaved drawing such as
+// ? text, sprites and more text takes a fraction of the draw calls. Drawing
+// ? order is only kept between layers so use Fbo:Layer() wherever something
+// ? must be drawn over what came before it, e.g. overlapping translucent
+// ? sprites. Default is disabled.
+/* ------------------------------------------------------------------------- */
+LLFUNC(SetCoalesce, 0, AgFbo{lS, 1}().FboSetCoalesce(AgBoolean{lS, 2}))
+/* ========================================================================= */
 // $ Fbo:SetCRGBA
 // > Red:number=The entire FBO texture red colour intensity (0 to 1).
 // > Green:number=The entire FBO texture green colour intensity (0 to 1).
@@ -394,16 +412,16 @@ LLFUNC(SetWireframe, 0, AgFbo{lS, 1}().FboSetWireframe(AgBoolean{lS, 2}))
 ** ######################################################################### **
 ** ========================================================================= */
 LLRSMFBEGIN                            // Fbo:* member functions begin
-  LLRSFUNC(Activate),       LLRSFUNC(Blit),          LLRSFUNC(BlitT),
-  LLRSFUNC(Destroy),        LLRSFUNC(Destroyed),     LLRSFUNC(Finish),
-  LLRSFUNC(Flush),          LLRSFUNC(GetFloatCount), LLRSFUNC(GetId),
-  LLRSFUNC(GetLFloatCount), LLRSFUNC(GetMatrix),     LLRSFUNC(GetName),
-  LLRSFUNC(Reserve),        LLRSFUNC(SetBlend),      LLRSFUNC(SetClear),
-  LLRSFUNC(SetClearColour), LLRSFUNC(SetCRGBA),      LLRSFUNC(SetCX),
-  LLRSFUNC(SetFilter),      LLRSFUNC(SetMatrix),     LLRSFUNC(SetTCLTRB),
-  LLRSFUNC(SetTCLTWH),      LLRSFUNC(SetTCX),        LLRSFUNC(SetVLTRB),
-  LLRSFUNC(SetVLTWH),       LLRSFUNC(SetVLTWHA),     LLRSFUNC(SetVX),
-  LLRSFUNC(SetWireframe),
+  LLRSFUNC(Activate),       LLRSFUNC(Blit),           LLRSFUNC(BlitT),
+  LLRSFUNC(Destroy),        LLRSFUNC(Destroyed),      LLRSFUNC(Finish),
+  LLRSFUNC(Flush),          LLRSFUNC(GetFloatCount),  LLRSFUNC(GetId),
+  LLRSFUNC(GetLFloatCount), LLRSFUNC(GetMatrix),      LLRSFUNC(GetName),
+  LLRSFUNC(Layer),          LLRSFUNC(Reserve),        LLRSFUNC(SetBlend),
+  LLRSFUNC(SetClear),       LLRSFUNC(SetClearColour), LLRSFUNC(SetCoalesce),
+  LLRSFUNC(SetCRGBA),       LLRSFUNC(SetCX),          LLRSFUNC(SetFilter),
+  LLRSFUNC(SetMatrix),      LLRSFUNC(SetTCLTRB),      LLRSFUNC(SetTCLTWH),
+  LLRSFUNC(SetTCX),         LLRSFUNC(SetVLTRB),       LLRSFUNC(SetVLTWH),
+  LLRSFUNC(SetVLTWHA),      LLRSFUNC(SetVX),          LLRSFUNC(SetWireframe),
 LLRSEND                                // Fbo:* member functions end
 /* ========================================================================= **
 ** ######################################################################### **
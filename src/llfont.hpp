@@ -108,6 +108,14 @@ LLFUNC(GetId, 1, LuaUtilPushVar(lS, AgFont{lS, 1}().Serial()))
 /* ------------------------------------------------------------------------- */
 LLFUNC(GetName, 1, LuaUtilPushVar(lS, AgFont{lS, 1}().NameGet()))
 /* ========================================================================= */
+// $ Font:GetPending
+// < Count:integer=Number of characters still being rasterised.
+// ? Returns the number of characters that are still being rasterised in the
+// ? background. Use this to wait for Font:Prewarm() or Font:PrewarmRange()
+// ? to finish on a loading screen.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetPending, 1, LuaUtilPushVar(lS, AgFont{lS, 1}().GlyphGetPending()))
+/* ========================================================================= */
 // $ Font:GetWidth
 // < Width:integer=The tile width of the font.
 // ? Returns width of the font tile. If this font is a free-type font, this
@@ -115,6 +123,27 @@ LLFUNC(GetName, 1, LuaUtilPushVar(lS, AgFont{lS, 1}().NameGet()))
 /* ------------------------------------------------------------------------- */
 LLFUNC(GetWidth, 1, LuaUtilPushVar(lS, AgFont{lS, 1}().dgluTile.DimGetWidth()))
 /* ========================================================================= */
+// $ Font:Layout
+// > Text:string=The string to lay out.
+// > Width:number=The width to wrap left aligned text at or zero for none.
+// > Align:integer=The alignment from the Layout.Align table.
+// < Handle:Layout=A handle to the newly created layout.
+// ? Lays out the specified string once and returns an object that can be
+// ? drawn every frame with Font:PrintLayout() without decoding, wrapping and
+// ? measuring the string again. The layout is rebuilt automatically when its
+// ? text, width or alignment is changed or when the size, spacing or outline
+// ? colour of the font that draws it is changed.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Layout, 1,
+  const AgFont aFont{lS, 1};
+  const AgString aText{lS, 2};
+  const AgPositive aWidth{lS, 3};
+  const AgFontAlign aAlign{lS, 4};
+  const AcLayout aLayout{lS};
+  aLayout().LayoutSetText(aText());
+  aLayout().LayoutSetWrap(aWidth);
+  aLayout().LayoutSetAlign(aAlign);
+  aLayout().LayoutPrepare(aFont))
 // $ Font:LoadChars
 // > Characters:string=A utf-8 string of characters you want to pre-cache.
 // ? Caches all the characters in the specified utf-8 character range to the
@@ -181,6 +210,20 @@ LLFUNC(PrintCT, 0,
   const AgTexture aTexture{lS, 5};
   aFont().PrintCT(aX, aY, aString(), aTexture))
 /* ========================================================================= */
+// $ Font:PrintLayout
+// > Layout:Layout=The layout to draw.
+// > X:number=The X screen position to draw the layout at.
+// > Y:number=The Y screen position to draw the layout at.
+// ? Draws a layout created with Font:Layout() at the specified position. The
+// ? prebuilt triangles are copied in one go and tinted with the current font
+// ? colour. The layout is rebuilt first if anything it depends on changed.
+/* ------------------------------------------------------------------------- */
+LLFUNC(PrintLayout, 0,
+  const AgFont aFont{lS, 1};
+  const AgLayout aLayout{lS, 2};
+  const AgGLfloat aX{lS, 3},
+                  aY{lS, 4};
+  aLayout().LayoutDraw(aFont, aX, aY))
 // $ Font:PrintM
 // > X:number=The X position of where to draw the string.
 // > Y:number=The Y position of where to draw the string.
@@ -501,6 +544,30 @@ LLFUNC(PrintWUT, 0,
   const AgTexture aTexture{lS, 7};
   aFont().PrintWUT(aX, aY, aWidth, aIndent, aString(), aTexture))
 /* ========================================================================= */
+// $ Font:Prewarm
+// > Characters:string=A utf-8 string of characters you want to pre-cache.
+// ? Same as Font:LoadChars() but the characters are rasterised by a worker
+// ? thread and added to the texture at the start of each frame so the game
+// ? does not stall while a lot of characters are cached.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Prewarm, 0,
+  const AgFont aFont{lS, 1};
+  const AgString aString{lS, 2};
+  aFont().GlyphPrewarmString(aString()))
+/* ========================================================================= */
+// $ Font:PrewarmRange
+// > Start:integer=The starting UNICODE character index.
+// > End:integer=The ending UNICODE character index.
+// ? Same as Font:LoadRange() but the characters are rasterised by a worker
+// ? thread and added to the texture at the start of each frame so the game
+// ? does not stall while a lot of characters are cached.
+/* ------------------------------------------------------------------------- */
+LLFUNC(PrewarmRange, 0,
+  const AgFont aFont{lS, 1};
+  const AgSizeT aStart{lS, 2},
+                aEnd{lS, 3};
+  aFont().GlyphPrewarmRange(aStart, aEnd))
+/* ========================================================================= */
 // $ Font:SetCA
 // > Alpha:number=The transparency of the texture (0-1).
 // ? Sets the colour transparency of the texture. The change affects all
@@ -714,21 +781,23 @@ LLFUNC(SetSpacing, 0,
 LLRSMFBEGIN                            // Font:* member functions begin
   LLRSFUNC(Destroy),     LLRSFUNC(Destroyed), LLRSFUNC(Dump),
   LLRSFUNC(GetHeight),   LLRSFUNC(GetFlags),  LLRSFUNC(GetId),
-  LLRSFUNC(GetName),     LLRSFUNC(GetWidth),  LLRSFUNC(LoadChars),
-  LLRSFUNC(LoadRange),   LLRSFUNC(Print),     LLRSFUNC(PrintC),
-  LLRSFUNC(PrintCT),     LLRSFUNC(PrintM),    LLRSFUNC(PrintMT),
+  LLRSFUNC(GetName),     LLRSFUNC(GetPending),LLRSFUNC(GetWidth),
+  LLRSFUNC(Layout),      LLRSFUNC(LoadChars), LLRSFUNC(LoadRange),
+  LLRSFUNC(Print),       LLRSFUNC(PrintC),    LLRSFUNC(PrintCT),
+  LLRSFUNC(PrintLayout), LLRSFUNC(PrintM),    LLRSFUNC(PrintMT),
   LLRSFUNC(PrintR),      LLRSFUNC(PrintRT),   LLRSFUNC(PrintS),
   LLRSFUNC(PrintT),      LLRSFUNC(PrintTS),   LLRSFUNC(PrintU),
   LLRSFUNC(PrintUC),     LLRSFUNC(PrintUCT),  LLRSFUNC(PrintUR),
   LLRSFUNC(PrintURT),    LLRSFUNC(PrintUS),   LLRSFUNC(PrintW),
   LLRSFUNC(PrintWS),     LLRSFUNC(PrintWT),   LLRSFUNC(PrintWTS),
-  LLRSFUNC(PrintWU),     LLRSFUNC(PrintWUT),  LLRSFUNC(SetCA),
-  LLRSFUNC(SetCB),       LLRSFUNC(SetCG),     LLRSFUNC(SetCOA),
-  LLRSFUNC(SetCOB),      LLRSFUNC(SetCOG),    LLRSFUNC(SetCOR),
-  LLRSFUNC(SetCORGB),    LLRSFUNC(SetCORGBA), LLRSFUNC(SetCORGBAI),
-  LLRSFUNC(SetCR),       LLRSFUNC(SetCRGBAI), LLRSFUNC(SetCRGB),
-  LLRSFUNC(SetCRGBA),    LLRSFUNC(SetGPad),   LLRSFUNC(SetGSize),
-  LLRSFUNC(SetLSpacing), LLRSFUNC(SetSize),   LLRSFUNC(SetSpacing),
+  LLRSFUNC(PrintWU),     LLRSFUNC(PrintWUT),  LLRSFUNC(Prewarm),
+  LLRSFUNC(PrewarmRange),LLRSFUNC(SetCA),     LLRSFUNC(SetCB),
+  LLRSFUNC(SetCG),       LLRSFUNC(SetCOA),    LLRSFUNC(SetCOB),
+  LLRSFUNC(SetCOG),      LLRSFUNC(SetCOR),    LLRSFUNC(SetCORGB),
+  LLRSFUNC(SetCORGBA),   LLRSFUNC(SetCORGBAI),LLRSFUNC(SetCR),
+  LLRSFUNC(SetCRGBAI),   LLRSFUNC(SetCRGB),   LLRSFUNC(SetCRGBA),
+  LLRSFUNC(SetGPad),     LLRSFUNC(SetGSize),  LLRSFUNC(SetLSpacing),
+  LLRSFUNC(SetSize),     LLRSFUNC(SetSpacing),
 LLRSEND                                // Font:* member functions end
 /* ========================================================================= **
 ** ######################################################################### **
@@ -842,6 +911,7 @@ LLRSKTBEGIN(Flags)                     // Beginning of ft font loading flags
   LLRSKTITEM(IL_,NONE),                LLRSKTITEM(FF_,USEGLYPHSIZE),
   LLRSKTITEM(FF_,FLOORADVANCE),        LLRSKTITEM(FF_,CEILADVANCE),
   LLRSKTITEM(FF_,ROUNDADVANCE),        LLRSKTITEM(FF_,STROKETYPE2),
+  LLRSKTITEM(FF_,ASYNCGLYPHS),
 LLRSKTEND                              // End of ft font loading flags
 /* ========================================================================= **
 ** ######################################################################### **
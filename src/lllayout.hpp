@@ -0,0 +1,148 @@
+/* == LLLAYOUT.HPP ========================================================= **
+** ######################################################################### **
+** ## Mhatxotic Engine          (c) Mhatxotic Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## Defines the 'Layout' namespace and methods for the guest to use in  ## **
+** ## Lua. This file is invoked by 'lualib.hpp'.                          ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ========================================================================= **
+** ######################################################################### **
+** ========================================================================= */
+// % Layout
+/* ------------------------------------------------------------------------- */
+// ! A layout stores a string that has already been laid out by a font so it
+// ! can be drawn every frame without decoding, wrapping and measuring the
+// ! text again. Create one with Font:Layout() and draw it with
+// ! Font:PrintLayout().
+/* ========================================================================= */
+namespace LLLayout {                   // Layout namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IFont::P;              using namespace ILayout::P;
+using namespace Common;
+/* ========================================================================= **
+** ######################################################################### **
+** ## Layout:* member functions                                           ## **
+** ######################################################################### **
+** ========================================================================= */
+// $ Layout:Destroy
+// ? Destroys the layout and frees all the memory associated with it. The
+// ? object will no longer be useable after this call and an error will be
+// ? generated if accessed.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Destroy, 0, LuaUtilClassDestroy<Layout>(lS, cLayouts))
+/* ========================================================================= */
+// $ Layout:Destroyed
+// < Destroyed:boolean=If the Layout class is destroyed
+// ? Returns if the Layout class is destroyed.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Destroyed, 1,
+  LuaUtilPushVar(lS, LuaUtilIsClassDestroyed(lS, cLayouts)))
+/* ========================================================================= */
+// $ Layout:GetHeight
+// < Height:number=The height of the laid out text.
+// ? Returns the height of the text as of the last time it was laid out.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetHeight, 1, LuaUtilPushVar(lS, AgLayout{lS, 1}().LayoutGetHeight()))
+/* ========================================================================= */
+// $ Layout:GetId
+// < Id:integer=The id number of the Layout object.
+// ? Returns the unique id of the Layout object.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetId, 1, LuaUtilPushVar(lS, AgLayout{lS, 1}().Serial()))
+/* ========================================================================= */
+// $ Layout:GetTris
+// < Count:integer=The number of triangles in the layout.
+// ? Returns the number of triangles that will be drawn by the layout.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetTris, 1, LuaUtilPushVar(lS, AgLayout{lS, 1}().LayoutGetTris()))
+/* ========================================================================= */
+// $ Layout:GetWidth
+// < Width:number=The width of the laid out text.
+// ? Returns the width of the text as of the last time it was laid out.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetWidth, 1, LuaUtilPushVar(lS, AgLayout{lS, 1}().LayoutGetWidth()))
+/* ========================================================================= */
+// $ Layout:SetAlign
+// > Align:integer=The new alignment from the Layout.Align table.
+// ? Changes the alignment of the text. The text is laid out again the next
+// ? time it is drawn.
+/* ------------------------------------------------------------------------- */
+LLFUNC(SetAlign, 0,
+  const AgLayout aLayout{lS, 1};
+  const AgFontAlign aAlign{lS, 2};
+  aLayout().LayoutSetAlign(aAlign))
+/* ========================================================================= */
+// $ Layout:SetText
+// > Text:string=The new text to lay out.
+// ? Changes the text of the layout. The text is laid out again the next time
+// ? it is drawn and only if the text actually changed.
+/* ------------------------------------------------------------------------- */
+LLFUNC(SetText, 0,
+  const AgLayout aLayout{lS, 1};
+  const AgString aText{lS, 2};
+  aLayout().LayoutSetText(aText()))
+/* ========================================================================= */
+// $ Layout:SetWidth
+// > Width:number=The new wrap width or zero for no wrapping.
+// ? Changes the width that left aligned text wraps at. The text is laid out
+// ? again the next time it is drawn.
+/* ------------------------------------------------------------------------- */
+LLFUNC(SetWidth, 0,
+  const AgLayout aLayout{lS, 1};
+  const AgNumberL<GLfloat> aWidth{lS, 2, 0.0f};
+  aLayout().LayoutSetWrap(aWidth))
+/* ========================================================================= **
+** ######################################################################### **
+** ## Layout:* member functions structure                                 ## **
+** ######################################################################### **
+** ========================================================================= */
+LLRSMFBEGIN                            // Layout:* member functions begin
+  LLRSFUNC(Destroy),  LLRSFUNC(Destroyed), LLRSFUNC(GetHeight),
+  LLRSFUNC(GetId),    LLRSFUNC(GetTris),   LLRSFUNC(GetWidth),
+  LLRSFUNC(SetAlign), LLRSFUNC(SetText),   LLRSFUNC(SetWidth),
+LLRSEND                                // Layout:* member functions end
+/* ========================================================================= **
+** ######################################################################### **
+** ## Layout.* namespace functions                                        ## **
+** ######################################################################### **
+** ========================================================================= */
+// $ Layout.Count
+// < Count:integer=Total number of layouts created.
+// ? Returns the total number of layout classes currently active.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Count, 1, LuaUtilPushVar(lS, cLayouts->CollectorCount()))
+/* ========================================================================= **
+** ######################################################################### **
+** ## Layout.* namespace functions structure                              ## **
+** ######################################################################### **
+** ========================================================================= */
+LLRSBEGIN                              // Layout.* namespace functions begin
+  LLRSFUNC(Count),
+LLRSEND                                // Layout.* namespace functions end
+/* ========================================================================= **
+** ######################################################################### **
+** ## Layout.* namespace constants                                        ## **
+** ######################################################################### **
+** ========================================================================= */
+// @ Layout.Align
+// < Codes:table=The table of key/value pairs of available alignments.
+// ? Alignments for use with Font:Layout() and Layout:SetAlign(). Only left
+// ? aligned text wraps.
+/* ------------------------------------------------------------------------- */
+LLRSKTBEGIN(Align)                     // Beginning of layout alignments
+  LLRSKTITEM(FA_,LEFT),                LLRSKTITEM(FA_,CENTRE),
+  LLRSKTITEM(FA_,RIGHT),
+LLRSKTEND                              // End of layout alignments
+/* ========================================================================= **
+** ######################################################################### **
+** ## Layout.* namespace constants structure                              ## **
+** ######################################################################### **
+** ========================================================================= */
+LLRSCONSTBEGIN                         // Layout.* namespace consts begin
+  LLRSCONST(Align),
+LLRSCONSTEND                           // Layout.* namespace consts end
+/* ========================================================================= */
+}                                      // End of Layout namespace
+/* == EoF =========================================================== EoF == */
@@ -95,6 +95,8 @@ LLFUNC(Play, 0,
 // ? Plays the specified sample at the specified gain and pitch with the
 // ? specified 2D panning position. The source that this sample spawns is
 // ? managed internally. See PlayEx() if you need to manage the source.
+// ? Samples kept compressed (see 'aud_samcompress') are always managed
+// ? internally and return no sources.
 /* ------------------------------------------------------------------------- */
 LLFUNCBEGIN(PlayEx)
   const AgSample aSample{lS, 1};
@@ -106,11 +108,31 @@ LLFUNCBEGIN(PlayEx)
     static_cast<int>(aSample().Play(lS, aGain, aPan, aPitch, aLooping));
 LLFUNCENDEX(iReturn)
 /* ========================================================================= */
+// $ Sample:PlayPriority
+// > Gain:number=Volume of sample to play at.
+// > Pan:integer=Current 2D position.
+// > Pitch:integer=Pitch of played sample.
+// > Loop:boolean=Loop the sample?
+// > Priority:integer=Importance of the sample.
+// ? Same as Play() but with the specified priority. When all sources are in
+// ? use, the least audible sample source with the same or a lower priority
+// ? is stopped and used instead. Play() uses the lowest priority of zero.
+/* ------------------------------------------------------------------------- */
+LLFUNC(PlayPriority, 0,
+  const AgSample aSample{lS, 1};
+  const AgALfloatLG aGain{lS, 2, 0.0f, 1.0f},
+                    aPan{lS, 3, -1.0f, 1.0f};
+  const AgALfloat aPitch{lS, 4};
+  const AgBoolean aLooping{lS, 5};
+  const AgUInt aPriority{lS, 6};
+  aSample().Play(aGain, aPan, aPitch, aLooping, aPriority))
+/* ========================================================================= */
 // $ Sample:Spawn
 // < Class:Source=The source created from the sample or left channel source.
 // < Class:Source=(Optional) If in stereo, the right channel source.
 // ? Spawns a new source from the sample. It is initially stopped and
-// ? uninitialised in a 3-D state.
+// ? uninitialised in a 3-D state. Samples kept compressed (see
+// ? 'aud_samcompress') cannot spawn sources and return nothing.
 /* ------------------------------------------------------------------------- */
 LLFUNCBEGIN(Spawn)
   const int iReturn = static_cast<int>(AgSample{lS, 1}().Spawn(lS));
@@ -128,8 +150,8 @@ LLFUNC(Stop, 1, LuaUtilPushVar(lS, AgSample{lS, 1}().Stop()))
 ** ========================================================================= */
 LLRSMFBEGIN                            // Sample:* member functions begin
   LLRSFUNC(Destroy), LLRSFUNC(Destroyed), LLRSFUNC(Duration), LLRSFUNC(Id),
-  LLRSFUNC(Name),    LLRSFUNC(Play),      LLRSFUNC(PlayEx),   LLRSFUNC(Spawn),
-  LLRSFUNC(Stop),
+  LLRSFUNC(Name),    LLRSFUNC(Play),      LLRSFUNC(PlayEx),
+  LLRSFUNC(PlayPriority), LLRSFUNC(Spawn), LLRSFUNC(Stop),
 LLRSEND                                // Sample:* member functions end
 /* ========================================================================= **
 ** ######################################################################### **
@@ -386,7 +386,10 @@ LLFUNC(Create, 0,
 // > Success:function=Function to call when any other event occurs
 // ? This is a minimalist implementation of a HTTP request and will support
 // ? most (if not all) operations one would need. The function returns
-// ? immediately. The worker thread uses blocking socket operations.
+// ? immediately. The worker thread uses blocking socket operations. Chunked
+// ? responses are decoded and gzip or deflate compressed responses are
+// ? decompressed as they arrive unless you specify an 'Accept-Encoding'
+// ? header yourself.
 /* ------------------------------------------------------------------------- */
 LLFUNC(CreateHTTP, 0,
   LuaUtilCheckParams(lS, 9);
@@ -400,7 +403,39 @@ LLFUNC(CreateHTTP, 0,
   const AgString strBody{ lS, 8 };
   LuaUtilCheckFunc(lS, 9);
   AcSocket{lS}().HTTPRequest(lS, strName, strCipher(), strAddress(), uPort,
-    strRequest(), strMethod(), strHeaders(), strBody()))
+    strRequest(), strMethod(), strHeaders(), strBody(), {}))
+/* ========================================================================= */
+// $ Socket.CreateHTTPFile
+// > Name:string=Name to identify the socket.
+// > Cipher:string=Make SSL connection and try this cipher.
+// > Address:string=The network destination address to connect to.
+// > Port:integer=The port to connect to (1-65535).
+// > Request:string=The HTTP URI request resource.
+// > Scheme:string=The HTTP scheme (GET, POST, PUT, DELETE, etc.).
+// > Headers:string=A carriage return separated list of headers.
+// > Body:string=A body of text to send with the request.
+// > Filename:string=The file to write the response body to.
+// > Success:function=Function to call when any other event occurs
+// ? Same as Socket.CreateHTTP() but the response body is written to the
+// ? specified file as it arrives instead of being kept in memory so large
+// ? downloads do not need their entire size in memory. The file is created
+// ? or truncated immediately and closed before the disconnect event is sent.
+// ? Compressed and chunked responses are decoded before being written.
+/* ------------------------------------------------------------------------- */
+LLFUNC(CreateHTTPFile, 0,
+  LuaUtilCheckParams(lS, 10);
+  const AgNeString strName{ lS, 1 };
+  const AgString strCipher{ lS, 2 };
+  AgAddress strAddress{ lS, 3 };
+  const AgPort uPort{ lS, 4 };
+  const AgNeString strRequest{ lS, 5 };
+  AgMethod strMethod{ lS, 6 };
+  const AgString strHeaders{ lS, 7 };
+  const AgString strBody{ lS, 8 };
+  const AgFilename aFilename{ lS, 9 };
+  LuaUtilCheckFunc(lS, 10);
+  AcSocket{lS}().HTTPRequest(lS, strName, strCipher(), strAddress(), uPort,
+    strRequest(), strMethod(), strHeaders(), strBody(), aFilename()))
 /* ========================================================================= */
 // $ Socket.Flush
 // < Count:integer=Total number of sockets disconnected.
@@ -443,10 +478,10 @@ LLFUNC(WaitAsync, 1, LuaUtilPushVar(lS, SocketWaitAsync()))
 ** ######################################################################### **
 ** ========================================================================= */
 LLRSBEGIN                              // Socket.* namespace functions begin
-  LLRSFUNC(Create),         LLRSFUNC(CreateHTTP),     LLRSFUNC(Count),
-  LLRSFUNC(Connected),      LLRSFUNC(Flush),          LLRSFUNC(TotalRXBytes),
-  LLRSFUNC(TotalTXBytes),   LLRSFUNC(TotalRXPackets), LLRSFUNC(TotalTXPackets),
-  LLRSFUNC(WaitAsync),
+  LLRSFUNC(Create),         LLRSFUNC(CreateHTTP),     LLRSFUNC(CreateHTTPFile),
+  LLRSFUNC(Count),          LLRSFUNC(Connected),      LLRSFUNC(Flush),
+  LLRSFUNC(TotalRXBytes),   LLRSFUNC(TotalTXBytes),   LLRSFUNC(TotalRXPackets),
+  LLRSFUNC(TotalTXPackets), LLRSFUNC(WaitAsync),
 LLRSEND                                // Socket.* namespace functions end
 /* ========================================================================= **
 ** ######################################################################### **
@@ -67,6 +67,21 @@ LLFUNC(Reason, 1, LuaUtilPushVar(lS, AgSql{lS, 1}().SqlGetErrorStr()))
 /* ------------------------------------------------------------------------- */
 LLFUNC(Records, 1, AgSql{lS, 1}().RecordsToLuaTable(lS))
 /* ========================================================================= */
+// $ Sql:Columns
+// > Code:string=The SQLlite code to execute.
+// > Data:Any=The arguments used in place of '?'
+// < Columns:table=The columns of the result keyed by column name.
+// < Rows:integer=The number of rows read.
+// ? Executes the specified SQLlite statement and returns the whole result as
+// ? one value per column instead of one table per row like Sql:Records()
+// ? does. See Stmt:Columns() for the format of the columns. The last result
+// ? and records of the database object are not changed.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Columns, 2,
+  const AgSql aSql{lS, 1};
+  const AgString aCode{lS, 2};
+  LuaUtilPushVar(lS, aSql().SqlColumnsFromLua(lS, aCode())))
+/* ========================================================================= */
 // $ Sql:Exec
 // > Code:string=The SQLlite code to execute.
 // > Data:Any=The arguments used in place of '?'
@@ -77,6 +92,25 @@ LLFUNC(Records, 1, AgSql{lS, 1}().RecordsToLuaTable(lS))
 LLFUNC(Exec, 1,
   LuaUtilPushVar(lS, AgSql{lS, 1}().SqlExecuteFromLua(lS, AgString{lS, 2}())))
 /* ========================================================================= */
+// $ Sql:ExecAsync
+// > Code:string=The SQLlite code to execute.
+// > Data:table=The arguments used in place of '?' (can be empty).
+// > Callback:function=The function to call when the query completes.
+// ? Queues the specified SQLlite statement to be executed on the database
+// ? thread. Queries queued close together are written in one transaction.
+// ? The callback is called on the engine thread with the result code, a
+// ? table of records in the same format as Sql:Records() and the number of
+// ? rows changed by the query. The last result, error and records of the
+// ? database object are not changed.
+/* ------------------------------------------------------------------------- */
+LLFUNC(ExecAsync, 0,
+  LuaUtilCheckParams(lS, 4);
+  const AgSql aSql{lS, 1};
+  const AgString aCode{lS, 2};
+  LuaUtilCheckTable(lS, 3);
+  LuaUtilCheckFunc(lS, 4);
+  aSql().SqlExecAsyncFromLua(lS, aCode()))
+/* ========================================================================= */
 // $ Sql:Reset
 // ? Cleans up the last result, error and response.
 /* ------------------------------------------------------------------------- */
@@ -114,6 +148,29 @@ LLFUNC(Begin, 1, LuaUtilPushVar(lS, AgSql{lS, 1}().SqlBegin()))
 // ? fails.
 /* ------------------------------------------------------------------------- */
 LLFUNC(End, 1, LuaUtilPushVar(lS, AgSql{lS, 1}().SqlEnd()))
+/* ========================================================================= */
+// $ Sql:Prepare
+// > Code:string=The SQLlite code to prepare.
+// < Handle:Stmt=The prepared statement handle.
+// ? Compiles the specified SQLlite statement once and returns a handle that
+// ? can be executed many times with different arguments using Stmt:Exec().
+// ? An exception is raised if the statement could not be compiled.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Prepare, 1,
+  const AgSql aSql{lS, 1};
+  const AgString aCode{lS, 2};
+  LuaUtilClassCreate<Stmt>(lS, cStmts)->StmtInit(aSql, aCode))
+/* ========================================================================= */
+// $ Sql:Cache
+// < Hits:integer=Queries that reused a cached prepared statement.
+// < Misses:integer=Queries that had to be compiled.
+// < Cached:integer=Number of prepared statements currently cached.
+// ? Returns statistics of the prepared statement cache that Sql:Exec() uses.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Cache, 3,
+  const AgSql aSql{lS, 1};
+  LuaUtilPushVar(lS, aSql().SqlStmtGetHits(), aSql().SqlStmtGetMisses(),
+    aSql().SqlStmtGetCached()))
 /* ========================================================================= **
 ** ######################################################################### **
 ** ## Sql:* member functions structure                                    ## **
@@ -121,10 +178,11 @@ LLFUNC(End, 1, LuaUtilPushVar(lS, AgSql{lS, 1}().SqlEnd()))
 ** ========================================================================= */
 LLRSMFBEGIN                            // Sql:* member functions begin
   LLRSFUNC(Active),   LLRSFUNC(Affected),  LLRSFUNC(Begin),
-  LLRSFUNC(Destroy),  LLRSFUNC(End),       LLRSFUNC(Error),
-  LLRSFUNC(ErrorStr), LLRSFUNC(Exec),      LLRSFUNC(Reason),
-  LLRSFUNC(Records),  LLRSFUNC(Reset),     LLRSFUNC(Size),
-  LLRSFUNC(Time),
+  LLRSFUNC(Cache),    LLRSFUNC(Columns),   LLRSFUNC(Destroy),
+  LLRSFUNC(End),      LLRSFUNC(Error),     LLRSFUNC(ErrorStr),
+  LLRSFUNC(Exec),     LLRSFUNC(ExecAsync), LLRSFUNC(Prepare),
+  LLRSFUNC(Reason),   LLRSFUNC(Records),   LLRSFUNC(Reset),
+  LLRSFUNC(Size),     LLRSFUNC(Time),
 LLRSEND                                // Sql:* member functions end
 /* ========================================================================= **
 ** ######################################################################### **
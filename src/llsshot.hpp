@@ -46,6 +46,26 @@ LLFUNC(Destroy, 0, LuaUtilClassDestroy<SShot>(lS, cSShots))
 /* ------------------------------------------------------------------------- */
 LLFUNC(Destroyed, 1, LuaUtilPushVar(lS, LuaUtilIsClassDestroyed(lS, cSShots)))
 /* ========================================================================= */
+// $ SShot:Capturing
+// < State:boolean=If the SShot object is capturing a sequence.
+// ? Returns if the SShot object was created with SShot.Capture() and has not
+// ? been stopped yet.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Capturing, 1, LuaUtilPushVar(lS, AgSShot{lS, 1}().DumpIsCapturing()))
+/* ========================================================================= */
+// $ SShot:Dropped
+// < Count:integer=Number of frames dropped.
+// ? Returns the number of frames that were not written because the writer
+// ? queue was full or the gpu had not finished with previous frames.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Dropped, 1, LuaUtilPushVar(lS, AgSShot{lS, 1}().DumpGetDropped()))
+/* ========================================================================= */
+// $ SShot:Frames
+// < Count:integer=Number of frames captured.
+// ? Returns the number of frames captured so far including dropped ones.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Frames, 1, LuaUtilPushVar(lS, AgSShot{lS, 1}().DumpGetFrames()))
+/* ========================================================================= */
 // $ SShot:Id
 // < Id:integer=The id number of the SShot object.
 // ? Returns the unique id of the SShot object.
@@ -57,13 +77,21 @@ LLFUNC(Id, 1, LuaUtilPushVar(lS, AgSShot{lS, 1}().Serial()))
 // ? Returns the filename generated on this screenshot object.
 /* ------------------------------------------------------------------------- */
 LLFUNC(Name, 1, LuaUtilPushVar(lS, AgSShot{lS, 1}().NameGet()))
+/* ========================================================================= */
+// $ SShot:Stop
+// ? Stops capturing a sequence. Frames still being read or waiting to be
+// ? written are written before this call returns.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Stop, 0, AgSShot{lS, 1}().DumpStop())
 /* ========================================================================= **
 ** ######################################################################### **
 ** ## SShot:* member functions structure                                  ## **
 ** ######################################################################### **
 ** ========================================================================= */
 LLRSMFBEGIN                            // SShot:* member functions begin
-  LLRSFUNC(Destroy), LLRSFUNC(Destroyed), LLRSFUNC(Id), LLRSFUNC(Name),
+  LLRSFUNC(Capturing), LLRSFUNC(Destroy), LLRSFUNC(Destroyed),
+  LLRSFUNC(Dropped),   LLRSFUNC(Frames),  LLRSFUNC(Id),
+  LLRSFUNC(Name),      LLRSFUNC(Stop),
 LLRSEND                                // SShot:* member functions end
 /* ========================================================================= **
 ** ######################################################################### **
@@ -76,6 +104,25 @@ LLRSEND                                // SShot:* member functions end
 /* ------------------------------------------------------------------------- */
 LLFUNC(Count, 1, LuaUtilPushVar(lS, cSShots->CollectorCount()))
 /* ========================================================================= */
+// $ SShot.Capture
+// > Interval:integer=Capture every this many rendered frames.
+// > Queue:integer=Maximum frames waiting to be written.
+// > Prefix:string=(Optional) Filename prefix of each frame.
+// < Object:SShot=The screenshot object created.
+// ? Captures every 'Interval' frame of the screen to a numbered sequence of
+// ? files in the format set by the 'vid_sstype' cvar until SShot:Stop() is
+// ? called or the object is destroyed. The pixels are read back a frame or
+// ? two later so rendering is not stalled and frames are written by a
+// ? background thread. If more than 'Queue' frames are waiting to be
+// ? written then new frames are dropped. You must completely omit the
+// ? 'prefix' parameter to use an engine generated prefix.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Capture, 1,
+  const AgUIntLG aInterval{lS, 1, 1, 3600};
+  const AgSizeTLG aQueue{lS, 2, 1, 1024};
+  AcSShot{lS}().DumpCapture(aInterval, aQueue,
+    LuaBaseGetTop(lS) < 4 ? cCommon->CommonBlankV() : AgFilename{lS,3}()))
+/* ========================================================================= */
 // $ SShot.Screen
 // < Object:SShot=The screenshot object created.
 // ? Takes a screenshot of the screen.
@@ -99,7 +146,7 @@ LLFUNC(Fbo, 1,
 ** ######################################################################### **
 ** ========================================================================= */
 LLRSBEGIN                              // SShot.* namespace functions begin
-  LLRSFUNC(Count), LLRSFUNC(Fbo), LLRSFUNC(Screen),
+  LLRSFUNC(Capture), LLRSFUNC(Count), LLRSFUNC(Fbo), LLRSFUNC(Screen),
 LLRSEND                                // SShot.* namespace functions end
 /* ========================================================================= */
 }                                      // End of Util namespace
@@ -0,0 +1,151 @@
+/* == LLSTMT.HPP =========================================================== **
+** ######################################################################### **
+** ## Mhatxotic Engine          (c) Mhatxotic Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## Defines the 'Stmt' namespace and methods for the guest to use in    ## **
+** ## Lua. This file is invoked by 'lualib.hpp'.                          ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ========================================================================= **
+** ######################################################################### **
+** ========================================================================= */
+// % Stmt
+/* ------------------------------------------------------------------------- */
+// ! A stmt is a SQLlite statement that has been compiled once by Sql:Prepare()
+// ! so it can be executed many times with different arguments without being
+// ! compiled again. The results are read from the database it was prepared
+// ! on with Sql:Records(). The statement can no longer be used when the
+// ! database it was prepared on is closed. A statement can also be used as a
+// ! cursor with Stmt:Bind() and Stmt:Step() which reads one row at a time
+// ! without storing the whole result, or with Stmt:Columns() which returns
+// ! the whole result as one array per column.
+/* ========================================================================= */
+namespace LLStmt {                     // Stmt namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace ISql::P;               using namespace Common;
+/* ========================================================================= **
+** ######################################################################### **
+** ## Stmt common helper classes                                          ## **
+** ######################################################################### **
+** -- Get Stmt class argument ---------------------------------------------- */
+struct AgStmt : public ArClass<Stmt>
+  { explicit AgStmt(lua_State*const lS, const int iArg) :
+      ArClass{LuaUtilGetClassRef<Stmt>(lS, iArg, cStmts)}{} };
+/* ========================================================================= **
+** ######################################################################### **
+** ## Stmt:* member functions                                             ## **
+** ######################################################################### **
+** ========================================================================= */
+// $ Stmt:Bind
+// > Data:Any=The arguments used in place of '?'
+// ? Rewinds the statement and binds the specified arguments so the rows can
+// ? be read one at a time with Stmt:Step(). All the arguments the statement
+// ? takes must be specified.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Bind, 0, AgStmt{lS, 1}().StmtBindFromLua(lS, 2))
+/* ========================================================================= */
+// $ Stmt:Columns
+// > Data:Any=The arguments used in place of '?'
+// < Columns:table=The columns of the result keyed by column name.
+// < Rows:integer=The number of rows read.
+// ? Binds the specified arguments, executes the statement and returns the
+// ? whole result as one value per column instead of one table per row. The
+// ? type of each column is taken from the first row. Integer columns are
+// ? returned as an Asset of 64-bit signed integers and float columns as an
+// ? Asset of 64-bit IEEE754 numbers in native byte order which can be read
+// ? with Asset:RI64() and Asset:RF64(). Other columns are returned as an
+// ? array of values with 'false' in place of NULL values. Reading large
+// ? results this way uses much less memory than Sql:Records().
+/* ------------------------------------------------------------------------- */
+LLFUNC(Columns, 2,
+  LuaUtilPushVar(lS, AgStmt{lS, 1}().StmtColumnsFromLua(lS, 2)))
+/* ========================================================================= */
+// $ Stmt:Destroy
+// ? Destroys the statement and frees all the memory associated with it. The
+// ? object will no longer be useable after this call and an error will be
+// ? generated if accessed.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Destroy, 0, LuaUtilClassDestroy<Stmt>(lS, cStmts))
+/* ========================================================================= */
+// $ Stmt:Destroyed
+// < Destroyed:boolean=If the Stmt class is destroyed
+// ? Returns if the Stmt class is destroyed.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Destroyed, 1, LuaUtilPushVar(lS, LuaUtilIsClassDestroyed(lS, cStmts)))
+/* ========================================================================= */
+// $ Stmt:Exec
+// > Data:Any=The arguments used in place of '?'
+// < Result:integer=The result of the operation
+// ? Binds the specified arguments and executes the statement on the database
+// ? it was prepared on. The results can be read with Sql:Records() on that
+// ? database.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Exec, 1,
+  LuaUtilPushVar(lS, AgStmt{lS, 1}().StmtExecuteFromLua(lS, 2)))
+/* ========================================================================= */
+// $ Stmt:GetId
+// < Id:integer=The id number of the Stmt object.
+// ? Returns the unique id of the Stmt object.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetId, 1, LuaUtilPushVar(lS, AgStmt{lS, 1}().Serial()))
+/* ========================================================================= */
+// $ Stmt:GetParams
+// < Count:integer=Number of arguments the statement takes.
+// ? Returns the number of '?' parameters in the statement.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetParams, 1, LuaUtilPushVar(lS, AgStmt{lS, 1}().StmtGetParams()))
+/* ========================================================================= */
+// $ Stmt:GetQuery
+// < Code:string=The SQLlite code of the statement.
+// ? Returns the SQLlite code the statement was prepared from.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetQuery, 1, LuaUtilPushVar(lS, AgStmt{lS, 1}().StmtGetQuery()))
+/* ========================================================================= */
+// $ Stmt:Reset
+// ? Rewinds the statement and clears the arguments bound with Stmt:Bind().
+/* ------------------------------------------------------------------------- */
+LLFUNC(Reset, 0, AgStmt{lS, 1}().StmtRewind())
+/* ========================================================================= */
+// $ Stmt:Step
+// < Row:table=The next row or nil if there are no more rows.
+// ? Reads the next row of the statement bound with Stmt:Bind() as a table of
+// ? key/value pairs in the same format as a row from Sql:Records(). The row
+// ? is read straight from the database and not stored anywhere else. Returns
+// ? nil when there are no more rows, after which the next call starts from
+// ? the first row again.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Step, 1,
+  if(!AgStmt{lS, 1}().StmtStepToLua(lS)) LuaBasePushNil(lS))
+/* ========================================================================= **
+** ######################################################################### **
+** ## Stmt:* member functions structure                                   ## **
+** ######################################################################### **
+** ========================================================================= */
+LLRSMFBEGIN                            // Stmt:* member functions begin
+  LLRSFUNC(Bind),     LLRSFUNC(Columns),   LLRSFUNC(Destroy),
+  LLRSFUNC(Destroyed),LLRSFUNC(Exec),      LLRSFUNC(GetId),
+  LLRSFUNC(GetParams),LLRSFUNC(GetQuery),  LLRSFUNC(Reset),
+  LLRSFUNC(Step),
+LLRSEND                                // Stmt:* member functions end
+/* ========================================================================= **
+** ######################################################################### **
+** ## Stmt.* namespace functions                                          ## **
+** ######################################################################### **
+** ========================================================================= */
+// $ Stmt.Count
+// < Count:integer=Total number of statements created.
+// ? Returns the total number of statement classes currently active.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Count, 1, LuaUtilPushVar(lS, cStmts->CollectorCount()))
+/* ========================================================================= **
+** ######################################################################### **
+** ## Stmt.* namespace functions structure                                ## **
+** ######################################################################### **
+** ========================================================================= */
+LLRSBEGIN                              // Stmt.* namespace functions begin
+  LLRSFUNC(Count),
+LLRSEND                                // Stmt.* namespace functions end
+/* ========================================================================= */
+}                                      // End of Stmt namespace
+/* == EoF =========================================================== EoF == */
@@ -17,10 +17,10 @@
 /* ========================================================================= */
 namespace LLTexture {                  // Texture namespace
 /* -- Dependencies --------------------------------------------------------- */
-using namespace IConGraph::P;          using namespace IConsole::P;
-using namespace IFbo::P;               using namespace IImage::P;
-using namespace IOgl::P;               using namespace ITexture::P;
-using namespace Common;
+using namespace IAsset::P;             using namespace IConGraph::P;
+using namespace IConsole::P;           using namespace IFbo::P;
+using namespace IImage::P;             using namespace IOgl::P;
+using namespace ITexture::P;           using namespace Common;
 /* ========================================================================= **
 ** ######################################################################### **
 ** ## Texture common helper classes                                       ## **
@@ -54,6 +54,24 @@ template<class VectorValueType, class VectorType = StdVector<VectorValueType>>
 /* ------------------------------------------------------------------------- */
 LLFUNC(Blit, 0, AgTexture{lS, 1}().Blit(0))
 /* ========================================================================= */
+// $ Texture:BlitBatch
+// > TexIndex:integer=The texture index to use.
+// > Data:Asset=The packed sprite records to draw.
+// < Count:integer=The number of sprites drawn.
+// ? Draws every sprite record in the specified asset in one call which is far
+// ? cheaper than calling the other Blit* functions for each sprite. Each
+// ? record is 28 bytes in native byte order consisting of a 32-bit unsigned
+// ? tile index, five 32-bit floats for left, top, width, height and angle
+// ? (0 skips rotation) and a 32-bit unsigned 0xAARRGGBB colour. The stored
+// ? colour (SetC*) is preserved but the stored vertex (SetV*) is overwritten.
+// ? All tile indexes are checked first so an invalid record draws nothing.
+/* ------------------------------------------------------------------------- */
+LLFUNC(BlitBatch, 1,
+  const AgTexture aTexture{lS, 1};
+  const AgTextureId aTexId{lS, 2, aTexture};
+  const AgAsset aAsset{lS, 3};
+  LuaUtilPushVar(lS, aTexture().BlitBatch(aTexId, aAsset)))
+/* ========================================================================= */
 // $ Texture:BlitILT
 // > TexIndex:integer=The texture index to use.
 // > Left:number=The starting column to draw from.
@@ -958,27 +976,28 @@ LLFUNC(UploadEx, 0,
 ** ######################################################################### **
 ** ========================================================================= */
 LLRSMFBEGIN                            // Texture:* member functions begin
-  LLRSFUNC(Blit),        LLRSFUNC(BlitILT),     LLRSFUNC(BlitILTA),
-  LLRSFUNC(BlitILTRB),   LLRSFUNC(BlitILTWH),   LLRSFUNC(BlitILTWHA),
-  LLRSFUNC(BlitISLT),    LLRSFUNC(BlitISLTA),   LLRSFUNC(BlitISLTRB),
-  LLRSFUNC(BlitISLTWH),  LLRSFUNC(BlitISLTWHA), LLRSFUNC(BlitLT),
-  LLRSFUNC(BlitLTA),     LLRSFUNC(BlitLTRB),    LLRSFUNC(BlitLTWH),
-  LLRSFUNC(BlitLTWHA),   LLRSFUNC(BlitM),       LLRSFUNC(BlitSLT),
-  LLRSFUNC(BlitSLTA),    LLRSFUNC(BlitSLTRB),   LLRSFUNC(BlitSLTWH),
-  LLRSFUNC(BlitSLTWHA),  LLRSFUNC(Destroy),     LLRSFUNC(Destroyed),
-  LLRSFUNC(Download),    LLRSFUNC(Dump),        LLRSFUNC(GetFlags),
-  LLRSFUNC(GetHeight),   LLRSFUNC(GetId),       LLRSFUNC(GetName),
-  LLRSFUNC(GetSubCount), LLRSFUNC(GetWidth),    LLRSFUNC(PopColour),
-  LLRSFUNC(PushColour),  LLRSFUNC(SetCA),       LLRSFUNC(SetCB),
-  LLRSFUNC(SetCG),       LLRSFUNC(SetCR),       LLRSFUNC(SetCRGB),
-  LLRSFUNC(SetCRGBA),    LLRSFUNC(SetCRGBAI),   LLRSFUNC(SetCX),
-  LLRSFUNC(SetTCLTRB),   LLRSFUNC(SetTCLTWH),   LLRSFUNC(SetTCX),
-  LLRSFUNC(SetVLTRB),    LLRSFUNC(SetVLTWH),    LLRSFUNC(SetVLTWHA),
-  LLRSFUNC(SetVX),       LLRSFUNC(TileA),       LLRSFUNC(TileAD),
-  LLRSFUNC(TileAS),      LLRSFUNC(TileASD),     LLRSFUNC(TileGSTC),
-  LLRSFUNC(TileGTC),     LLRSFUNC(TileS),       LLRSFUNC(TileSD),
-  LLRSFUNC(TileSS),      LLRSFUNC(TileSSD),     LLRSFUNC(TileSSTC),
-  LLRSFUNC(TileSTC),     LLRSFUNC(Upload),      LLRSFUNC(UploadEx),
+  LLRSFUNC(Blit),        LLRSFUNC(BlitBatch),   LLRSFUNC(BlitILT),
+  LLRSFUNC(BlitILTA),    LLRSFUNC(BlitILTRB),   LLRSFUNC(BlitILTWH),
+  LLRSFUNC(BlitILTWHA),  LLRSFUNC(BlitISLT),    LLRSFUNC(BlitISLTA),
+  LLRSFUNC(BlitISLTRB),  LLRSFUNC(BlitISLTWH),  LLRSFUNC(BlitISLTWHA),
+  LLRSFUNC(BlitLT),      LLRSFUNC(BlitLTA),     LLRSFUNC(BlitLTRB),
+  LLRSFUNC(BlitLTWH),    LLRSFUNC(BlitLTWHA),   LLRSFUNC(BlitM),
+  LLRSFUNC(BlitSLT),     LLRSFUNC(BlitSLTA),    LLRSFUNC(BlitSLTRB),
+  LLRSFUNC(BlitSLTWH),   LLRSFUNC(BlitSLTWHA),  LLRSFUNC(Destroy),
+  LLRSFUNC(Destroyed),   LLRSFUNC(Download),    LLRSFUNC(Dump),
+  LLRSFUNC(GetFlags),    LLRSFUNC(GetHeight),   LLRSFUNC(GetId),
+  LLRSFUNC(GetName),     LLRSFUNC(GetSubCount), LLRSFUNC(GetWidth),
+  LLRSFUNC(PopColour),   LLRSFUNC(PushColour),  LLRSFUNC(SetCA),
+  LLRSFUNC(SetCB),       LLRSFUNC(SetCG),       LLRSFUNC(SetCR),
+  LLRSFUNC(SetCRGB),     LLRSFUNC(SetCRGBA),    LLRSFUNC(SetCRGBAI),
+  LLRSFUNC(SetCX),       LLRSFUNC(SetTCLTRB),   LLRSFUNC(SetTCLTWH),
+  LLRSFUNC(SetTCX),      LLRSFUNC(SetVLTRB),    LLRSFUNC(SetVLTWH),
+  LLRSFUNC(SetVLTWHA),   LLRSFUNC(SetVX),       LLRSFUNC(TileA),
+  LLRSFUNC(TileAD),      LLRSFUNC(TileAS),      LLRSFUNC(TileASD),
+  LLRSFUNC(TileGSTC),    LLRSFUNC(TileGTC),     LLRSFUNC(TileS),
+  LLRSFUNC(TileSD),      LLRSFUNC(TileSS),      LLRSFUNC(TileSSD),
+  LLRSFUNC(TileSSTC),    LLRSFUNC(TileSTC),     LLRSFUNC(Upload),
+  LLRSFUNC(UploadEx),
 LLRSEND                                // Texture:* member functions end
 /* ========================================================================= **
 ** ######################################################################### **
@@ -201,9 +201,10 @@ LLFUNC(Exists, 1, LuaUtilPushVar(lS, cCVars->VarExists(AgNeString{lS, 1})))
 // $ Variable.Save
 // < Count:number=Number of items saved
 // ? Commits all modified variables to database. Returns number of items
-// ? written.
+// ? written. The writes are queued to the database thread and written in
+// ? one transaction so the call does not wait for the disk.
 /* ------------------------------------------------------------------------- */
-LLFUNC(Save, 1, LuaUtilPushVar(lS, cCVars->CVarsSaveToDatabase()))
+LLFUNC(Save, 1, LuaUtilPushVar(lS, cCVars->CVarsSaveToDatabase(true)))
 /* ========================================================================= */
 // $ Variable.Valid
 // > Var:string=Cvar name to test.
@@ -187,6 +187,20 @@ LLFUNC(Play, 1, LuaUtilPushVar(lS, AgVideo{lS, 1}().Play()))
 /* ------------------------------------------------------------------------- */
 LLFUNC(Rewind, 0, AgVideo{lS, 1}().Rewind())
 /* ========================================================================= */
+// $ Video:Seek
+// > Seconds:number=The time in seconds to seek to.
+// < Success:boolean=Did the video seek?
+// ? Seeks the specified video to the specified time. Decoding restarts from
+// ? the nearest keyframe at or before the specified time and the frames and
+// ? audio before the specified time are skipped. The keyframes are indexed
+// ? when the video is loaded so this does not need to decode the video from
+// ? the start. Playback resumes if the video was playing.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Seek, 1,
+  const AgVideo aVideo{lS, 1};
+  const AgNumberL<double> aSeconds{lS, 2, 0.0};
+  LuaUtilPushVar(lS, aVideo().Seek(aSeconds)))
+/* ========================================================================= */
 // $ Video:SetKeyed
 // < Keyed:boolean=Video should be keyed with the set colour
 // ? Enabling this allowed the video to be chroma keyed. This also disables
@@ -428,13 +442,13 @@ LLRSMFBEGIN                            // Video:* member functions begin
   LLRSFUNC(GetHeight),    LLRSFUNC(GetId),      LLRSFUNC(GetLoop),
   LLRSFUNC(GetName),      LLRSFUNC(GetPlaying), LLRSFUNC(GetTime),
   LLRSFUNC(GetWidth),     LLRSFUNC(OnEvent),    LLRSFUNC(Pause),
-  LLRSFUNC(Play),         LLRSFUNC(Rewind),     LLRSFUNC(SetCRGBA),
-  LLRSFUNC(SetCX),        LLRSFUNC(SetFDR),     LLRSFUNC(SetFilter),
-  LLRSFUNC(SetKeyColour), LLRSFUNC(SetKeyed),   LLRSFUNC(SetLoop),
-  LLRSFUNC(SetRec709),    LLRSFUNC(SetTCLTRB),  LLRSFUNC(SetTCLTWH),
-  LLRSFUNC(SetTCX),       LLRSFUNC(SetVLTRB),   LLRSFUNC(SetVLTWH),
-  LLRSFUNC(SetVLTWHA),    LLRSFUNC(SetVX),      LLRSFUNC(SetVolume),
-  LLRSFUNC(Stop),
+  LLRSFUNC(Play),         LLRSFUNC(Rewind),     LLRSFUNC(Seek),
+  LLRSFUNC(SetCRGBA),     LLRSFUNC(SetCX),      LLRSFUNC(SetFDR),
+  LLRSFUNC(SetFilter),    LLRSFUNC(SetKeyColour), LLRSFUNC(SetKeyed),
+  LLRSFUNC(SetLoop),      LLRSFUNC(SetRec709),  LLRSFUNC(SetTCLTRB),
+  LLRSFUNC(SetTCLTWH),    LLRSFUNC(SetTCX),     LLRSFUNC(SetVLTRB),
+  LLRSFUNC(SetVLTWH),     LLRSFUNC(SetVLTWHA),  LLRSFUNC(SetVX),
+  LLRSFUNC(SetVolume),    LLRSFUNC(Stop),
 LLRSEND                                // Video:* member functions end
 /* ========================================================================= **
 ** ######################################################################### **
@@ -16,6 +16,7 @@ using namespace IFStream::P;           using namespace ILookupArray::P;
 using namespace IMutex::P;             using namespace IName::P;
 using namespace IStd::P;               using namespace IString::P;
 using namespace ISysUtil::P;           using namespace IToken::P;
+using ::std::chrono::milliseconds;     using ::std::thread;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Log levels ----------------------------------------------------------- */
@@ -52,7 +53,8 @@ class Log :                            // The actual class body
   public LogLines,                     // Holds info about every log line
   public FStream,                      // Output log file if needed
   public Chrono,                       // Holds the current log time
-  public MutexLock                     // Because logger needs thread safe
+  public MutexLock,                    // Because logger needs thread safe
+  private condition_variable           // Wakes the writer thread
 { /* -- Destructor logging helper ------------------------------------------ */
 #define DTORHELPER(c,...) c() noexcept(false) { \
   try { __VA_ARGS__; } catch(const StdException &eReason) \
@@ -70,6 +72,14 @@ class Log :                            // The actual class body
   SafeLHLevel      slhlLevel;          // Log helper level for this instance
   size_t           stMaximum;          // Maximum log lines
   FStreamMode      fsmMode;            // Logging mode (append or truncate)
+  thread           tWriter;            // Writer thread for async mode
+  unsigned         uWriterInterval;    // Writer interval in milliseconds
+  LogLines         llWriting;          // Lines the writer thread is writing
+  size_t           stWritingDone;      // Lines of them already written
+  size_t           stDropped;          // Pending lines dropped over the cap
+  bool             bAsync,             // Lines are left for writer thread
+                   bWriterExit,        // Writer thread should exit
+                   bWriterWake;        // Writer thread should write now
   /* -- Reserve a certain amount of log lines ------------------------------ */
   void LogReserveLines(const size_t stlLines)
   { // Calculate total liens
@@ -83,69 +93,206 @@ class Log :                            // The actual class body
     erase(begin(),
       StdNext(begin(), static_cast<ssize_t>(stTotal - stMaximum)));
   }
+  /* -- Drop the oldest pending lines over the hard cap (async mode) ------- */
+  void LogCapPending(const size_t stlLines)
+  { // Lines are kept for the writer thread until they are written but if it
+    // cannot write them (i.e. disk full) they must not grow without limit.
+    const size_t stCap = stMaximum * 4, stTotal = size() + stlLines;
+    if(stTotal <= stCap) return;
+    // If too many lines would be added? Drop all of the pending lines
+    if(stlLines >= stCap) { stDropped += size(); return clear(); }
+    // Drop enough of the oldest lines for the new ones to fit
+    const size_t stDrop = stTotal - stCap;
+    erase(begin(), StdNext(begin(), static_cast<ssize_t>(stDrop)));
+    stDropped += stDrop;
+  }
   /* -- Return log level --------------------------------------------------- */
   LHLevel LogGetLevel() const { return slhlLevel; }
   /* -- Write lines to log ------------------------------------------------- */
   void LogWriteLines(const LHLevel lhRequire, const TokenList &tlLines)
   { // Ignore if no lines
     if(tlLines.empty()) return;
-    // Prune log to fit this many lines
-    LogReserveLines(tlLines.size());
+    // Prune log to fit this many lines unless the lines are still waiting
+    // for the writer thread in which case only drop them over the hard cap.
+    if(!bAsync || FStreamClosed()) LogReserveLines(tlLines.size());
+    else LogCapPending(tlLines.size());
     // For each line, print to log. Note that I tried using string
     // appending for this and it turned out to be almost twice as slow as
     // using formatstring due to the fact that less memory management
     // is required!
     for(const StdStringView &ssvLine : tlLines)
       push_back({ CCDeltaToDouble(), lhRequire, StdString{ ssvLine } });
-    // Ignore if file not opened
-    if(FStreamClosed()) return;
-    // Get start of log
-    LogLinesConstIt llciItem{ cbegin() };
-    // Repeat...
-    do
-    { // Get reference to line and format the string to write to log
-      const LogLine &llLine = *llciItem;
-      const StdString strLine{ StrFormat("[$$$]<$> $\n", StdIOSFixed,
-        StdIOSSetPrecision(6), llLine.dTime,
-        LogLevelToString(llLine.lhlLevel).front(),llLine.strLine) };
-      // Write stored line and write number of bytes written, and if we did?
-      if(const size_t stWritten = FStreamWriteString(strLine)) [[likely]]
-      { // Correct number of bytes
-        if(stWritten == strLine.size()) [[likely]]
-        { // Flush success?
-          if(FStreamFlush()) [[likely]]
-          { // Remove the items we wrote and write the next line
-            erase(cbegin(), llciItem);
-            continue;
-          } // If no disk space then return to try again later
-          if(StdIsNoDiskSpace()) return;
-          LogWarningExSafe("Log file flush $ bytes failure: $!",
-            strLine.size(), StrFromErrNo());
-        } // Incorrect number of bytes? Log the error
-        else
-        { // If no disk space then return to try again later
-          if(StdIsNoDiskSpace()) return;
-          LogWarningExSafe("Log file wrote only $ of $ bytes: $!",
-            stWritten, strLine.size(), StrFromErrNo());
-        } // Proceed to try and reopen the file
-      } // Write failure?
+    // Writer thread running? Leave the lines for it and only wake it up now
+    // for warnings and errors or if enough lines are waiting to be written.
+    if(bAsync)
+    { if(FStreamClosed() || (lhRequire > LH_WARNING && size() < stMaximum))
+        return;
+      bWriterWake = true;
+      return notify_one(); }
+    // Write the lines now
+    LogWritePending();
+  }
+  /* -- Add a line without writing it (i.e. when writing failed) ----------- */
+  void LogPushLine(const LHLevel lhLevel, StdString &&strLine)
+  { // Ignore if we don't have this level
+    if(LogNotHasLevel(lhLevel)) return;
+    // Prune log to fit the line unless lines are waiting for the writer
+    if(!bAsync || FStreamClosed()) LogReserveLines(1);
+    else LogCapPending(1);
+    // Add the line
+    push_back({ CCDeltaToDouble(), lhLevel, StdMove(strLine) });
+  }
+  /* -- Report a write failure and reopen the log file --------------------- */
+  void LogWriteFailed(StdString &&strReason)
+  { // Log the reason. This can't write to the log so it will be written
+    // with the next lines.
+    LogPushLine(LH_WARNING, StdMove(strReason));
+    // Reinitialise the log and if failed? Log complete and utter failure
+    const StdString strName{ NameGet() };
+    if(FStreamOpen(strName, fsmMode))
+      LogPushLine(LH_ERROR, StrFormat("Log file cannot be reopened: $!",
+        StrFromErrNo()));
+  }
+  /* -- Append a line as it is written to the log file --------------------- */
+  void LogFormatLine(StdString &strOut, const LogLine &llLine)
+  { // Split the time into seconds and microseconds so it is written with six
+    // decimals without needing a string stream.
+    const uint64_t qwTime =
+      static_cast<uint64_t>(llLine.dTime * 1000000.0 + 0.5);
+    uint64_t qwMicros = qwTime % 1000000;
+    char caMicros[6];
+    for(size_t stIndex = sizeof(caMicros); stIndex--; qwMicros /= 10)
+      caMicros[stIndex] = static_cast<char>('0' + qwMicros % 10);
+    // Append the line
+    StrFormatTo(strOut, "[$.$]<$> $\n", qwTime / 1000000,
+      StdStringView{ caMicros, sizeof(caMicros) },
+      LogLevelToString(llLine.lhlLevel).front(), llLine.strLine);
+  }
+  /* -- Write a line and return if it was written -------------------------- */
+  bool LogWriteLine(const LogLine &llLine)
+  { // Format the string to write to log
+    StdString strLine;
+    LogFormatLine(strLine, llLine);
+    // Write stored line and write number of bytes written, and if we did?
+    if(const size_t stWritten = FStreamWriteString(strLine)) [[likely]]
+    { // Correct number of bytes
+      if(stWritten == strLine.size()) [[likely]]
+      { // Flush success? Line written
+        if(FStreamFlush()) [[likely]] return true;
+        // If no disk space then return to try again later
+        if(StdIsNoDiskSpace()) return false;
+        LogWriteFailed(StrFormat("Log file flush $ bytes failure: $!",
+          strLine.size(), StrFromErrNo()));
+      } // Incorrect number of bytes? Log the error
       else
-      { // If no disk space then return to try again later else reopen
-        if(StdIsNoDiskSpace()) return;
-        LogWarningExSafe("Log file write $ bytes error: $!",
-          strLine.size(), StrFromErrNo());
-      } // Reinitialise the log and if failed? Log complete and utter failure
-      if(!LogInit(NameGet())) [[unlikely]] return;
-        LogErrorExSafe("Log file cannot be reopened: $!", StrFromErrNo());
-      // Return failure and don't remove stored message. Next time another
-      // log event occurs, fwrite will fail and retry again. Note that the
-      // output buffer will just continue fill up until we can write again and
-      // excess output lines will be purged as normal.
-      return;
-    } // ... until all lines written
-    while(++llciItem != cend());
-    // We wrote all the lines
-    clear();
+      { // If no disk space then return to try again later
+        if(StdIsNoDiskSpace()) return false;
+        LogWriteFailed(StrFormat("Log file wrote only $ of $ bytes: $!",
+          stWritten, strLine.size(), StrFromErrNo()));
+      }
+    } // Write failure?
+    else
+    { // If no disk space then return to try again later else reopen
+      if(StdIsNoDiskSpace()) return false;
+      LogWriteFailed(StrFormat("Log file write $ bytes error: $!",
+        strLine.size(), StrFromErrNo()));
+    } // Return failure and don't remove stored message. Next time another
+    // log event occurs, fwrite will fail and retry again. Note that the
+    // output buffer will just continue fill up until we can write again and
+    // excess output lines will be purged as normal.
+    return false;
+  }
+  /* -- Write all pending lines one line at a time ------------------------- */
+  void LogWritePending()
+  { // Ignore if file not opened
+    if(FStreamClosed()) return;
+    // Write the lines the writer thread took and has not written yet. It may
+    // still be reading them so count them instead of removing them.
+    for(LogLinesConstIt llciItem{ StdNext(llWriting.cbegin(),
+          static_cast<ssize_t>(stWritingDone)) };
+        llciItem != llWriting.cend(); ++llciItem, ++stWritingDone)
+      if(!LogWriteLine(*llciItem)) return;
+    // Write and remove each line until there are none left or one failed
+    while(!empty()) if(LogWriteLine(front())) pop_front(); else return;
+  }
+  /* -- Write all pending lines in one batch (writer thread, lock held) ---- */
+  void LogWriteBatch(UniqueLock &ulLock)
+  { // Ignore if no lines or file not opened
+    if(empty() || FStreamClosed()) return;
+    // Take all the pending lines so other threads can keep logging. The crash
+    // handler can still read them and LogWritePending() counts the ones it
+    // writes meanwhile so they are not written twice.
+    llWriting.splice(llWriting.cend(), *this);
+    stWritingDone = 0;
+    // Format the lines without the lock held and remember where each ends
+    StdString strBatch;
+    StdVector<size_t> stvEnds;
+    { const UniqueRelock urUnlock{ ulLock };
+      stvEnds.reserve(llWriting.size());
+      for(const LogLine &llLine : llWriting)
+      { LogFormatLine(strBatch, llLine);
+        stvEnds.push_back(strBatch.size()); } }
+    // Write and flush the lines that were not written meanwhile. The file
+    // may have been closed while the lock was released.
+    size_t stLine = stWritingDone, stBytes = 0, stWritten = 0;
+    bool bWritten = true;
+    if(stLine < stvEnds.size() && FStreamOpened())
+    { // Write from the end of the last line written
+      const size_t stStart = stLine ? stvEnds[stLine - 1] : 0;
+      stBytes = strBatch.size() - stStart;
+      stWritten = FStreamWrite(strBatch.data() + stStart, stBytes);
+      bWritten = stWritten == stBytes && FStreamFlush();
+      // Count the lines written completely so they are not written again
+      while(stLine < stvEnds.size() && stvEnds[stLine] <= stStart + stWritten)
+        ++stLine;
+    } // Forget the lines written and put the rest back to try again later
+    llWriting.erase(llWriting.cbegin(),
+      StdNext(llWriting.cbegin(), static_cast<ssize_t>(stLine)));
+    splice(cbegin(), llWriting);
+    // If written, report lines that were dropped while writing was failing
+    if(bWritten)
+    { if(!stDropped) return;
+      const size_t stLost = stDropped;
+      stDropped = 0;
+      return LogPushLine(LH_WARNING, StrFormat("Log dropped $ lines that "
+        "could not be written!", stLost));
+    } // Drop the oldest lines over the hard cap as they failed to write
+    LogCapPending(0);
+    // Done if there is no disk space to try again later
+    if(StdIsNoDiskSpace()) return;
+    // Log the error and reopen the file
+    if(!stWritten)
+      LogWriteFailed(StrFormat("Log file write $ bytes error: $!",
+        stBytes, StrFromErrNo()));
+    else if(stWritten != stBytes)
+      LogWriteFailed(StrFormat("Log file wrote only $ of $ bytes: $!",
+        stWritten, stBytes, StrFromErrNo()));
+    else LogWriteFailed(StrFormat("Log file flush $ bytes failure: $!",
+      stBytes, StrFromErrNo()));
+  }
+  /* -- Writer thread ------------------------------------------------------ */
+  void LogWriterMain()
+  { // Lock the log until waiting
+    UniqueLock ulLock{ MutexGet() };
+    // Loop until told to exit
+    while(!bWriterExit)
+    { // Wait for the interval or to be woken up
+      wait_for(ulLock, milliseconds{ uWriterInterval },
+        [this]{ return bWriterExit || bWriterWake; });
+      bWriterWake = false;
+      // Write what is pending
+      LogWriteBatch(ulLock);
+    }
+  }
+  /* -- Stop the writer thread (lock must not be held) --------------------- */
+  void LogWriterStop()
+  { // Ignore if not running
+    if(!tWriter.joinable()) return;
+    // Leave no more lines for the writer, tell it to exit and wait for it
+    MutexCall([this](){ bAsync = false; bWriterExit = true; notify_one(); });
+    tWriter.join();
+    // Write anything the writer did not get to synchronously
+    MutexCall([this](){ bWriterExit = false; LogWritePending(); });
   }
   /* -- Write string to log. Line feed creates multiple lines -------------- */
   void LogWriteString(const LHLevel lhL, const StdString &strLine)
@@ -162,8 +309,9 @@ class Log :                            // The actual class body
   void LogDeInit()
   { // Bail if initialised
     if(FStreamClosed()) return;
-    // Log file closure
+    // Log file closure and write anything the writer thread has not yet
     LogWriteString(StrFormat("Log file closed at $.", cmSys.FormatTime()));
+    LogWritePending();
     // Done so close the file
     FStreamClose();
   }
@@ -189,7 +337,10 @@ class Log :                            // The actual class body
   bool LogIsRedirectedToDevice()
     { return MutexCall([this](){ return FStreamIsHandleStd(); }); }
   /* -- Safe async call to close file -------------------------------------- */
-  void LogDeInitSafe() { MutexCall([this](){ LogDeInit(); }); }
+  void LogDeInitSafe()
+    { LogWriterStop(); MutexCall([this](){ LogDeInit(); }); }
+  /* -- Safe call to write pending lines now (i.e. when crashing) ---------- */
+  void LogFlushSafe() { MutexCall([this](){ LogWritePending(); }); }
   /* -- Safe async call to get log filename from Ident base class ---------- */
   StdString LogGetNameSafe()
     { return MutexCall([this](){ return NameGet(); }); }
@@ -279,10 +430,13 @@ class Log :                            // The actual class body
   void LogGetBufferLines(StdOStringStream &osS)
   { // Gain exclusive access to log lines
     MutexCall([this, &osS](){
-      // For each log entry, write the line to the buffer
-      for(const LogLine &llLine : *this) osS
+      // For each log entry, write the line to the buffer. The lines the
+      // writer thread is writing come first.
+      const auto fWrite = [&osS](const LogLine &llLine){ osS
         << '[' << StdIOSFixed << StdIOSSetPrecision(6) << llLine.dTime << "] "
-        << llLine.strLine << '\n';
+        << llLine.strLine << '\n'; };
+      for(const LogLine &llLine : llWriting) fWrite(llLine);
+      for(const LogLine &llLine : *this) fWrite(llLine);
     });
   }
   /* -- Initialise log to built-in standard output ------------------------- */
@@ -313,7 +467,13 @@ class Log :                            // The actual class body
     ssvStdErr{ "/dev/stderr" },        // Initialise display label for stderr
     slhlLevel{ LH_DEBUG },             // Initialise default level
     stMaximum(1000),                   // Initialise maximum output lines
-    fsmMode(FM_MAX)                    // File mode initialised by cvar
+    fsmMode(FM_MAX),                   // File mode initialised by cvar
+    uWriterInterval(0),                // Writer thread initialised by cvar
+    stWritingDone(0),                  // No lines being written
+    stDropped(0),                      // No lines dropped
+    bAsync(false),                     // Writing lines synchronously
+    bWriterExit(false),                // Writer thread not exiting
+    bWriterWake(false)                 // Writer thread not woken
     /* -- Set global pointer to static class ------------------------------- */
     { cLog = this; }
   /* -- Destructor --------------------------------------------------------- */
@@ -321,6 +481,20 @@ class Log :                            // The actual class body
   /* -- Set file mode ---------------------------------------------- */ public:
   CVarReturn LogSetFileAppend(const bool bAppend)
     { return CVarSimpleSetInt(fsmMode, bAppend ? FM_A_P_T : FM_W_T); }
+  /* -- Set writer thread interval ----------------------------------------- */
+  CVarReturn LogSetAsync(const unsigned uInterval)
+  { // Deny if interval is too long
+    if(uInterval > 60000) return DENY;
+    // Stop the current writer thread and set the new interval
+    LogWriterStop();
+    uWriterInterval = uInterval;
+    // Start a new writer thread if asked to and leave lines for it
+    if(uWriterInterval)
+    { tWriter = thread{ [this](){ LogWriterMain(); } };
+      MutexCall([this](){ bAsync = true; }); }
+    // Success
+    return ACCEPT;
+  }
   /* -- Safe access to members --------------------------------------------- */
   CVarReturn LogSetLevel(const LHLevel lhlNewLevel)
   { // Deny if invalid level
@@ -376,11 +550,14 @@ class Log :                            // The actual class body
     // Prevent use of variables off the main thread
     return MutexCall([this, stL](){
       // Current size is over the new maximum? Trim the oldest entries out
-      if(size() > stMaximum)
+      // unless they are still waiting for the writer thread.
+      if((!bAsync || FStreamClosed()) && size() > stMaximum)
         erase(begin(),
           StdNext(begin(), static_cast<ssize_t>(size() - stMaximum)));
-      // Set new maximum and return success
+      // Set new maximum and make pending lines fit the new hard cap
       stMaximum = stL;
+      if(bAsync && FStreamOpened()) LogCapPending(0);
+      // Success
       return ACCEPT;
     });
   }
@@ -22,11 +22,13 @@ using namespace IEvtMain::P;           using namespace IFlags::P;
 using namespace IFrame::P;             using namespace ILog::P;
 using namespace ILuaBase::P;           using namespace ILuaCode::P;
 using namespace ILuaDef::P;            using namespace ILuaFunc::P;
-using namespace ILuaLib::P;            using namespace ILuaUtil::P;
-using namespace ILuaVariable::P;       using namespace IStd::P;
-using namespace IString::P;            using namespace ISystem::P;
-using namespace ISysUtil::P;           using namespace ITime::P;
-using namespace IUtil::P;              using namespace Lib::Sqlite::Types;
+using namespace ILuaLib::P;            using namespace ILuaProf::P;
+using namespace ILuaUtil::P;           using namespace ILuaVariable::P;
+using namespace IProfile::P;           using namespace ISql::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISystem::P;            using namespace ISysUtil::P;
+using namespace ITime::P;              using namespace IUtil::P;
+using namespace Lib::Sqlite::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* ------------------------------------------------------------------------- */
@@ -43,7 +45,8 @@ class Lua :                            // Actual class body
   /* -- Base classes ------------------------------------------------------- */
   public Chrono,                       // Runtime clock
   private EvtMainRegAuto,              // Events list to register
-  public LuaFlags                      // Lua flags
+  public LuaFlags,                     // Lua flags
+  public LuaProf                       // Lua call stack sampler
 { /* -- Private typedefs --------------------------------------------------- */
   using LuaPtr = StdUniquePtr<lua_State, function<decltype(lua_close)>>;
   /* -- Private variables -------------------------------------------------- */
@@ -72,6 +75,8 @@ class Lua :                            // Actual class body
     LuaFuncEnableAllRefs();
     // Resumed
     uLuaPaused = 0;
+    // Call async query callbacks that were held back while paused
+    for(Sql*const sPtr : *cSqls) sPtr->SqlAsyncResume();
     // Done
     return true;
   }
@@ -134,14 +139,30 @@ class Lua :                            // Actual class body
     // Write to console
     cConsole->ConsoleAddLine("Execution resumed.");
   }
-  /* -- When lua enters the specified function ----------------------------- */
+  /* -- Instruction count hook for the timeout and the sampler ------------- */
   static void LuaOnInstructionCount(lua_State*const lS, lua_Debug*const)
-  { // Return if timer is not timed out
-    if(cFrame->FrameIsNotTimedOut()) [[likely]] return;
+  { // Sample the call stack if sampling. Send how many operations this
+    // thread runs between calls as coroutines keep the hook count that was
+    // set when they were created.
+    cLua->LuaProfSample(lS, LuaBaseGetHookCount(lS));
+    // Return if the timeout is disabled or the timer is not timed out
+    if(cLua->iOperations <= 0 || cFrame->FrameIsNotTimedOut()) [[likely]]
+      return;
     // Push error message and throw error
     LuaUtilPushExtStr(lS, cCommon->CommonTimeoutV());
     LuaBaseError(lS);
   }
+  /* -- Set the hook for the timeout and sampler or remove it if unused ---- */
+  void LuaSetHook() const
+  { // Call the hook often enough for both the timeout and the sampler
+    int iCount = UtilMaximum(iOperations, 0);
+    if(LuaProfIsSampling())
+      iCount = iCount ? UtilMinimum(iCount, LuaProfGetOps()) :
+        LuaProfGetOps();
+    // Set the hook or remove it if neither are enabled
+    LuaBaseSetHookCb(LuaGetState(),
+      iCount ? LuaOnInstructionCount : nullptr, iCount);
+  }
   /* -- Warning callback --------------------------------------------------- */
   static void LuaOnWarning(void*const, const char*const cpMsg, int)
     { cLog->LogWarningExSafe("(Lua) $", cpMsg); }
@@ -161,7 +182,9 @@ class Lua :                            // Actual class body
   bool LuaIsExiting() const { return FlagIsSet(LUF_EXITING); }
   bool LuaIsNotExiting() const { return FlagIsClear(LUF_EXITING); }
   /* -- Execute main function ---------------------------------------------- */
-  void LuaExecuteMain() const { lrMainTick.LuaFuncPushAndCall(); }
+  void LuaExecuteMain() const
+    { const ProfileZone pzZone{ "LuaExecuteMain" };
+      lrMainTick.LuaFuncPushAndCall(); }
   /* -- Return operations count -------------------------------------------- */
   int LuaGetOpsInterval() const { return iOperations; }
   /* -- Set core event callbacks ------------------------------------------- */
@@ -478,15 +501,12 @@ class Lua :                            // Actual class body
       LuaUtilInitRNGSeed(LuaGetState(), liRandSeed);
       cLog->LogDebugExSafe("Lua generated random seed $ (0x$$)!",
         liRandSeed, StdIOSHex, liRandSeed);
-    } // Use a timeout hook?
+    } // Set the timeout hook and log that it was enabled
+    LuaSetHook();
     if(iOperations > 0)
-    { // Set the hook
-      LuaBaseSetHookCb(LuaGetState(),
-        LuaOnInstructionCount, iOperations);
-      // Log that it was enabled
       cLog->LogDebugExSafe("Lua timeout set to $ sec for every $ operations.",
         TimeToShortDuration(cFrame->FrameGetTimeOut(), 1), iOperations);
-    } // Show a warning to say the timeout hook is disabled
+    // Show a warning to say the timeout hook is disabled
     else cLog->LogWarningSafe("Lua timeout hook disabled so use at own risk!");
     // Resume garbage collector
     LuaStartGC();
@@ -516,8 +536,9 @@ class Lua :                            // Actual class body
     cLog->LogDebugSafe("Lua sandbox de-initialising...");
     // Disable garbage collector
     LuaStopGC();
-    // De-init instruction count hook?
+    // De-init instruction count hook and stop sampling
     LuaBaseSetHookCb(LuaGetState(), nullptr, 0);
+    LuaProfStop();
     // DeInit references
     LuaFuncDeInitRef();
     // Close state and reset var
@@ -530,6 +551,23 @@ class Lua :                            // Actual class body
     // Report progress
     cLog->LogDebugSafe("Lua sandbox successfully deinitialised.");
   }
+  /* -- Start sampling the call stack every specified operations ----------- */
+  void LuaSampleStart(const int iCount, const uint64_t qwInterval,
+    const size_t stCapacity)
+  { // Need a state to hook
+    if(LuaStateIsNotSet()) XC("Lua sandbox not initialised!");
+    // Prepare the sampler and call the hook often enough for it
+    LuaProfStart(stCapacity, qwInterval, iCount);
+    LuaSetHook();
+  }
+  /* -- Stop sampling the call stack --------------------------------------- */
+  void LuaSampleStop()
+  { // Ignore if not sampling
+    if(!LuaProfIsSampling()) return;
+    // Stop the sampler and restore the timeout hook
+    LuaProfStop();
+    if(LuaStateIsSet()) LuaSetHook();
+  }
   /* -- Lua end execution helper ------------------------------------------- */
   bool LuaTryEventOrForce(const EvtMainCmd emcCmd)
   { // If exit event already processing?
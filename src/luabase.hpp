@@ -129,6 +129,8 @@ static int LuaBaseGetMetaTable(lua_State*const lS, const int iIndex)
 /* -- Set hook ------------------------------------------------------------- */
 static void LuaBaseSetHookCb(lua_State*const lS, lua_Hook fcbCb, const int iC)
   { lua_sethook(lS, fcbCb, LUA_MASKCOUNT, iC); }
+static int LuaBaseGetHookCount(lua_State*const lS)
+  { return lua_gethookcount(lS); }
 /* -- Push a table onto the stack of the specified preallocated size ------- */
 template<typename IntType1 = int, typename IntType2 = int>
   requires (StdIsIntegral<IntType1> || StdIsEnum<IntType1>) &&
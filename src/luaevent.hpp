@@ -20,18 +20,18 @@ using namespace IUtf::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Public typedefs ------------------------------------------------------ */
-// We need to collect the event ids of the events we dispatch so we can
-// remove these events when the class is destroyed, or events that reference
+// We need to collect the tickets of the events we dispatch so we can cancel
+// these events when the class is destroyed, or events that reference
 // derived classes which have been destroyed will crash the engine.
-using LuaEvtsList = StdDeque<EvtMain::QueueConstIt> ;
-/* == Class type for storing an event iterator and removing it ============= */
+using LuaEvtsList = StdDeque<EvtMain::Ticket>;
+/* == Class type for storing an event ticket and cancelling it ============= */
 class LuaEvts :
   /* -- Initialisers ------------------------------------------------------- */
-  private LuaEvtsList                  // list of added event iterators
+  private LuaEvtsList                  // list of added event tickets
 { /* -- Private variables -------------------------------------------------- */
   MutexLock        mMutex;             // To serialise access to the list
-  /* -- Remove iterator by id -------------------------------------- */ public:
-  void LuaEvtsRemoveIterator(const size_t stId)
+  /* -- Remove ticket by id ---------------------------------------- */ public:
+  void LuaEvtsRemoveTicket(const size_t stId)
   { // Lock access to the list
     mMutex.MutexCall([this, stId](){
       // Throw error if the id is invalid
@@ -39,34 +39,28 @@ class LuaEvts :
         XC("Invalid event index to remove!",
           "Requested", stId, "Maximum", size());
       // Clear stored event and remove all empty events from the end
-      at(stId) = cEvtMain->Last();
-      while(!empty() && back() == cEvtMain->Last()) pop_back();
+      at(stId) = EvtMain::tNone;
+      while(!empty() && back() == EvtMain::tNone) pop_back();
     });
   }
   /* -- Check if enough parameters ----------------------------------------- */
   template<size_t stMinimum> requires (stMinimum >= 2)
     bool LuaEvtsCheckParams(const EvtMainArgs &emaArgs)
-  { // If we have at least two parameters remove the iterator
-    if(emaArgs.size() >= 2) LuaEvtsRemoveIterator(emaArgs[1].SizeT());
+  { // If we have at least two parameters remove the ticket
+    if(emaArgs.size() >= 2) LuaEvtsRemoveTicket(emaArgs[1].SizeT());
     // Return true if required args is 2 because we've already checked that
     if constexpr(stMinimum == 2) return true;
     // Return success if we have enough parameters (else needed on MSVC)
     else return emaArgs.size() >= stMinimum;
   }
-  /* -- Add a new event and stab iterator ---------------------------------- */
+  /* -- Add a new event and store its ticket ------------------------------- */
   template<typename ...VarArgs>void LuaEvtsDispatch(const EvtMainCmd emcCmd,
     const void*const vpClass, const VarArgs ...vaArgs)
-  { // Reserve memory for current parameters list for event
-    StdReserved<EvtMainArgs> emaArgs{ sizeof...(VarArgs) };
-    // Lock access to the list
-    mMutex.MutexCall([this, &emaArgs, &emcCmd, vpClass, &vaArgs...]{
-      // Iterator to return
-      EvtMain::QueueConstIt qciItem;
-      // Create a new params list with the class and the events list size
-      cEvtMain->AddExParam(emcCmd, qciItem, emaArgs, vpClass, size(),
-        vaArgs...);
-      // Insert the iterator the new event.
-      emplace_back(StdMove(qciItem));
+  { // Lock access to the list
+    mMutex.MutexCall([this, &emcCmd, vpClass, &vaArgs...]{
+      // Queue a new event with the class and the events list size and store
+      // the ticket of the new event.
+      emplace_back(cEvtMain->AddEx(emcCmd, vpClass, size(), vaArgs...));
     });
   }
   /* -- Deinit event store-------------------------------------------------- */
@@ -75,16 +69,12 @@ class LuaEvts :
     mMutex.MutexCall([this](){
       // Return if there are no queued events
       if(empty()) return;
-      // Lock engine thread events list
-      cEvtMain->MutexCall([this](){
-        // Remove any queued events dispatched by this class as if they fire,
-        // the app will crash because the class may have been destroyed.
-        StdForEach(seq, cbegin(), cend(),
-          [](const EvtMain::QueueConstIt &qciIt)
-            { if(qciIt != cEvtMain->Last()) cEvtMain->RemoveUnsafe(qciIt); });
-        // Clear the list
-        clear();
-      });
+      // Cancel any queued events dispatched by this class as if they fire,
+      // the app will crash because the class may have been destroyed.
+      StdForEach(seq, cbegin(), cend(),
+        [](const EvtMain::Ticket &tTicket) { cEvtMain->Cancel(tTicket); });
+      // Clear the list
+      clear();
     });
   }
   /* -- Constructor -------------------------------------------------------- */
@@ -168,7 +158,7 @@ class LuaEvtSlave :
   /* -- Event dispatch --------------------------------------------- */ public:
   void LuaEvtDispatch(auto &&...aArgs)
   { // If no callback is set then insert a new event. We need to store the id
-    // of the iterator too so we can remove it when we process the event in
+    // of the ticket too so we can remove it when we process the event in
     // LuaEvtCallbackParam().
     if(this->LuaRefIsSet())
       LuaEvtsDispatch(emcCmd, reinterpret_cast<void*>(mtPtr),
@@ -184,8 +174,8 @@ class LuaEvtSlave :
       XC("Not enough parameters to generic Lua event callback!",
         "Name",  mtPtr->NameGet(), "Event",   emeEvent.cCmd,
         "Count", emaArgs.size(),   "Maximum", stMandatory);
-    // Remove iterator from our events dispatched list
-    LuaEvtsRemoveIterator(static_cast<size_t>(emaArgs[1].UInt()));
+    // Remove ticket from our events dispatched list
+    LuaEvtsRemoveTicket(static_cast<size_t>(emaArgs[1].UInt()));
     // Lua is paused?
     if(uLuaPaused)
     { // Show error in log and return
@@ -75,6 +75,7 @@ template<typename AnyType, int itSize>
 #include "llimage.hpp"                 // Image members and methods
 #include "llinput.hpp"                 // Input members and methods
 #include "lljson.hpp"                  // Json members and methods
+#include "lllayout.hpp"                // Layout members and methods
 #include "llmask.hpp"                  // Mask members and methods
 #include "llpcm.hpp"                   // Pcm members and methods
 #include "llsource.hpp"                // Source members and methods
@@ -83,6 +84,7 @@ template<typename AnyType, int itSize>
 #include "llsql.hpp"                   // Sql members and methods
 #include "llsshot.hpp"                 // SShot members and methods
 #include "llstat.hpp"                  // Stat members and methods
+#include "llstmt.hpp"                  // Stmt members and methods
 #include "llstream.hpp"                // Stream members and methods
 #include "lltexture.hpp"               // Texture members and methods
 #include "llpalette.hpp"               // Palette members and methods
@@ -167,11 +169,12 @@ const LuaLibStaticArray llsaAPI{{
   LLFMC(File, BASIC, FILE),            LLFMC(Font, VIDEO, FONT),
   LLFMx(Ftf, BASIC, FTF),              LLFMC(Image, BASIC, IMAGE),
   LLFxC(Input, VIDEO),                 LLFMx(Json, BASIC, JSON),
-  LLFMx(Mask, BASIC, MASK),            LLFMx(Palette, VIDEO, PALETTE),
-  LLFMC(Pcm, BASIC, PCM),              LLFMx(Sample, AUDIO, SAMPLE),
-  LLFMC(Socket, BASIC, SOCKET),        LLFMx(Source, AUDIO, SOURCE),
-  LLFMC(Sql, BASIC, SQL),              LLFMx(SShot, VIDEO, SSHOT),
-  LLFMx(Stat, BASIC, STAT),            LLFMC(Stream, AUDIO, STREAM),
+  LLFMC(Layout, VIDEO, LAYOUT),        LLFMx(Mask, BASIC, MASK),
+  LLFMx(Palette, VIDEO, PALETTE),      LLFMC(Pcm, BASIC, PCM),
+  LLFMx(Sample, AUDIO, SAMPLE),        LLFMC(Socket, BASIC, SOCKET),
+  LLFMx(Source, AUDIO, SOURCE),        LLFMC(Sql, BASIC, SQL),
+  LLFMx(SShot, VIDEO, SSHOT),          LLFMx(Stat, BASIC, STAT),
+  LLFMx(Stmt, BASIC, STMT),            LLFMC(Stream, AUDIO, STREAM),
   LLFMx(Texture, VIDEO, TEXTURE),      LLFMC(Url, BASIC, URL),
   LLFxx(Util, BASIC),                  LLFMC(Variable, BASIC, VARIABLE),
   LLFMC(Video, AUDIOVIDEO, VIDEO),
@@ -0,0 +1,242 @@
+/* == LUAPROF.HPP ========================================================== **
+** ######################################################################### **
+** ## Mhatxotic Engine          (c) Mhatxotic Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## Samples the Lua call stack from the instruction count hook into a   ## **
+** ## fixed size buffer so hot guest functions can be found. Nothing is   ## **
+** ## allocated in the hook. Samples are totalled per function or written ## **
+** ## as folded stacks for flame graph tools when sampling has finished.  ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ------------------------------------------------------------------------- */
+namespace ILuaProf {                   // Start of private module namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IClock::P;             using namespace IError::P;
+using namespace IFStream::P;           using namespace ILog::P;
+using namespace ILuaBase::P;           using namespace IStd::P;
+using namespace IString::P;
+/* ------------------------------------------------------------------------- */
+namespace P {                          // Start of public module namespace
+/* ------------------------------------------------------------------------- */
+class LuaProf                          // Members initially private
+{ /* -- Private typedefs --------------------------------------------------- */
+  static constexpr size_t
+    stMaxDepth = 32,                   // Maximum frames stored per sample
+    stMaxFuncs = 4096;                 // Maximum functions (power of two)
+  /* ----------------------------------------------------------------------- */
+  struct ProfFunc                      // A function seen in a sample
+  { const void    *vpKey;              // Address of function (null=unused)
+    int            iLine;              // Line the function was defined on
+    char           cName[48],          // Name of the function
+                   cSource[LUA_IDSIZE]; // Source of the function
+  };/* --------------------------------------------------------------------- */
+  struct ProfStack                     // A sampled call stack
+  { unsigned       uDepth;             // Number of frames in the stack
+    StdArray<uint16_t, stMaxDepth> aFuncs; // Functions from the leaf up
+  };/* --------------------------------------------------------------------- */
+  using ProfFuncs = StdVector<ProfFunc>; // Function table
+  using ProfStacks = StdVector<ProfStack>; // Sample buffer
+  /* -- Private variables -------------------------------------------------- */
+  ProfFuncs        fFuncs;             // Functions seen while sampling
+  ProfStacks       sSamples;           // Sampled call stacks
+  size_t           stFuncs,            // Number of functions seen
+                   stSamples,          // Number of samples taken
+                   stDropped;          // Samples dropped (buffer full)
+  uint64_t         qwInterval,         // Minimum time between samples
+                   qwNext,             // Time of the next sample
+                   qwOps,              // Operations between samples
+                   qwOpsDone;          // Operations since the last sample
+  bool             bSampling;          // Sampler is running
+  /* -- Copy a string into a fixed buffer ---------------------------------- */
+  template<size_t stSize>
+    static void LuaProfCopy(char (&cDst)[stSize], const char *cpSrc)
+  { // Copy as much as fits and terminate
+    size_t stIndex = 0;
+    if(cpSrc) while(stIndex < stSize - 1 && cpSrc[stIndex])
+      { cDst[stIndex] = cpSrc[stIndex]; ++stIndex; }
+    cDst[stIndex] = '\0';
+  }
+  /* -- Return index of function at the specified stack level -------------- */
+  size_t LuaProfFind(lua_State*const lS, lua_Debug &ldData)
+  { // Push the function and get its address
+    if(!lua_getinfo(lS, "f", &ldData)) return StdNPos;
+    const void*const vpKey = LuaBaseToPtr(lS, -1);
+    LuaBaseRemove(lS, -1);
+    // Find it in the table or a free slot for it
+    for(size_t stSlot = (reinterpret_cast<size_t>(vpKey) >> 4) &
+          (stMaxFuncs - 1), stProbe = 0;
+        stProbe < stMaxFuncs;
+        ++stProbe, stSlot = (stSlot + 1) & (stMaxFuncs - 1))
+    { // Found the function? Return it
+      ProfFunc &fRef = fFuncs[stSlot];
+      if(fRef.vpKey == vpKey) return stSlot;
+      if(fRef.vpKey) continue;
+      // New function so record its name and source
+      if(!lua_getinfo(lS, "nS", &ldData)) return StdNPos;
+      fRef.vpKey = vpKey;
+      fRef.iLine = ldData.linedefined;
+      LuaProfCopy(fRef.cName, ldData.name ? ldData.name : "?");
+      LuaProfCopy(fRef.cSource, ldData.short_src);
+      ++stFuncs;
+      return stSlot;
+    } // Table is full
+    return StdNPos;
+  }
+  /* -- Return name of the specified function ------------------------------ */
+  StdString LuaProfGetLabel(const size_t stFunc) const
+  { // Get function and return its name with its source and line
+    const ProfFunc &fRef = fFuncs[stFunc];
+    return fRef.iLine > 0 ?
+      StrFormat("$ ($:$)", fRef.cName, fRef.cSource, fRef.iLine) :
+      StrFormat("$ ($)", fRef.cName, fRef.cSource);
+  }
+  /* -- Send each sample to a callback ------------------------------------- */
+  template<typename FuncType>void LuaProfRead(FuncType &&ftCb) const
+    { for(size_t stIndex = 0; stIndex < stSamples; ++stIndex)
+        ftCb(sSamples[stIndex]); }
+  /* -- Sample the call stack (from the instruction count hook) ---- */ public:
+  void LuaProfSample(lua_State*const lS, const int iStep)
+  { // Ignore if not sampling. Coroutines keep the hook they were created
+    // with so it can still be called after sampling stopped.
+    if(!bSampling) return;
+    // Not enough operations since the last sample yet? The hook may be
+    // called more often than we sample so the timeout can be checked.
+    qwOpsDone += static_cast<uint64_t>(iStep > 0 ? iStep : 1);
+    if(qwOpsDone < qwOps) return;
+    qwOpsDone = 0;
+    // Not time for a sample yet?
+    if(qwInterval)
+    { const uint64_t qwNow = cmHiRes.GetTimeNS<uint64_t>();
+      if(qwNow < qwNext) return;
+      qwNext = qwNow + qwInterval; }
+    // Buffer full?
+    if(stSamples >= sSamples.size()) { ++stDropped; return; }
+    // Record each stack level from the running function up. Stacks deeper
+    // than the sample can hold lose their outermost frames.
+    ProfStack &sRef = sSamples[stSamples];
+    unsigned uDepth = 0;
+    lua_Debug ldData;
+    for(int iLevel = 0;
+        uDepth < stMaxDepth && lua_getstack(lS, iLevel, &ldData);
+        ++iLevel)
+    { // Get the function and stop if the function table is full
+      const size_t stFunc = LuaProfFind(lS, ldData);
+      if(stFunc == StdNPos) break;
+      sRef.aFuncs[uDepth++] = static_cast<uint16_t>(stFunc);
+    } // Keep the sample if anything was recorded
+    if(!uDepth) return;
+    sRef.uDepth = uDepth;
+    ++stSamples;
+  }
+  /* -- Return if sampling and counters ------------------------------------ */
+  bool LuaProfIsSampling() const { return bSampling; }
+  int LuaProfGetOps() const { return static_cast<int>(qwOps); }
+  size_t LuaProfGetSamples() const { return stSamples; }
+  size_t LuaProfGetDropped() const { return stDropped; }
+  size_t LuaProfGetFuncs() const { return stFuncs; }
+  /* -- Start sampling ----------------------------------------------------- */
+  void LuaProfStart(const size_t stCapacity, const uint64_t qwNInterval,
+    const int iOps)
+  { // Allocate the buffers here as the hook must not allocate
+    sSamples.resize(stCapacity);
+    fFuncs.assign(stMaxFuncs, {});
+    // Reset counters and start
+    stFuncs = stSamples = stDropped = 0;
+    qwInterval = qwNInterval;
+    qwNext = 0;
+    qwOps = static_cast<uint64_t>(iOps > 0 ? iOps : 1);
+    qwOpsDone = 0;
+    bSampling = true;
+    // Log it
+    cLog->LogDebugExSafe("Lua sampler started with $ samples every $ ops "
+      "and $ ns.", stCapacity, qwOps, qwInterval);
+  }
+  /* -- Stop sampling and keep the results --------------------------------- */
+  void LuaProfStop()
+  { // Ignore if not sampling
+    if(!bSampling) return;
+    bSampling = false;
+    // Log it
+    cLog->LogDebugExSafe("Lua sampler stopped with $ samples ($ dropped).",
+      stSamples, stDropped);
+  }
+  /* -- Return inclusive and exclusive sample counts of each function ------ */
+  StdMap<StdString, StdPair<size_t, size_t>> LuaProfStats() const
+  { // Functions to return and the last sample each function was counted in
+    // so recursive functions are only counted once per sample.
+    StdMap<StdString, StdPair<size_t, size_t>> mFuncs;
+    StdVector<size_t> svCounted(fFuncs.size(), 0);
+    StdVector<StdString> svLabels(fFuncs.size());
+    size_t stSample = 0;
+    // For each sample
+    LuaProfRead([&](const ProfStack &sRef)
+    { // Count each function in the stack and the leaf function
+      ++stSample;
+      for(unsigned uIndex = 0; uIndex < sRef.uDepth; ++uIndex)
+      { // Ignore if already counted in this sample
+        const size_t stFunc = sRef.aFuncs[uIndex];
+        if(svCounted[stFunc] == stSample) continue;
+        svCounted[stFunc] = stSample;
+        // Get the name of the function once
+        StdString &strLabel = svLabels[stFunc];
+        if(strLabel.empty()) strLabel = LuaProfGetLabel(stFunc);
+        // Add inclusive count and exclusive count if it is the leaf
+        StdPair<size_t, size_t> &pFunc = mFuncs[strLabel];
+        ++pFunc.first;
+        if(!uIndex) ++pFunc.second;
+      }
+    }); // Return functions
+    return mFuncs;
+  }
+  /* -- Write samples as folded stacks ------------------------------------- */
+  size_t LuaProfDump(const StdStringView &ssvFile) const
+  { // Names of functions and count of each unique stack
+    StdVector<StdString> svLabels(fFuncs.size());
+    StdMap<StdString, size_t> mStacks;
+    // For each sample
+    LuaProfRead([&svLabels, &mStacks, this](const ProfStack &sRef)
+    { // Build the stack from the outermost function to the leaf
+      StdString strStack;
+      for(unsigned uIndex = sRef.uDepth; uIndex--;)
+      { // Get the name of the function once
+        const size_t stFunc = sRef.aFuncs[uIndex];
+        StdString &strLabel = svLabels[stFunc];
+        if(strLabel.empty()) strLabel = LuaProfGetLabel(stFunc);
+        // Add the frame
+        if(!strStack.empty()) strStack += ';';
+        strStack += strLabel;
+      } // Count the stack
+      ++mStacks[strStack];
+    }); // Build the folded stacks
+    StdOStringStream osStacks;
+    for(const auto &mStack : mStacks)
+      osStacks << mStack.first << ' ' << mStack.second << '\n';
+    // Write the stacks to disk
+    if(FStream fsStacks{ ssvFile, FM_W_B })
+      fsStacks.FStreamWriteString(osStacks.str());
+    else XC("Failed to create Lua sample file!",
+      "File", ssvFile, "Reason", StrFromErrNo());
+    // Log and return number of stacks written
+    cLog->LogInfoExSafe("Lua sampler wrote $ stacks from $ samples to '$'.",
+      mStacks.size(), stSamples, ssvFile);
+    return mStacks.size();
+  }
+  /* -- Default constructor ------------------------------------- */ protected:
+  LuaProf() :
+    /* -- Initialisers ----------------------------------------------------- */
+    stFuncs(0),                        // No functions seen
+    stSamples(0),                      // No samples taken
+    stDropped(0),                      // No samples dropped
+    qwInterval(0),                     // No minimum interval
+    qwNext(0),                         // Sample immediately
+    qwOps(1),                          // Sample every hook call
+    qwOpsDone(0),                      // No operations counted
+    bSampling(false)                   // Not sampling
+    /* -- No code ---------------------------------------------------------- */
+    {}
+};/* ----------------------------------------------------------------------- */
+}                                      // End of public module namespace
+/* ------------------------------------------------------------------------- */
+}                                      // End of private module namespace
+/* == EoF =========================================================== EoF == */
@@ -21,6 +21,27 @@ using namespace ISysUtil::P;           using namespace ITexDef::P;
 using namespace IUtil::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
+/* -- Occupancy pyramid settings ------------------------------------------- */
+constexpr static const int
+  iMaskCellShift = 3,                  // Finest occupancy cell is 8x8 pixels
+  iMaskCellSize  = 1 << iMaskCellShift; // Size of finest occupancy cell
+/* -- Level of the occupancy pyramid of a mask slot ------------------------ */
+struct MaskLevel                       // Cells are twice the previous level
+{ /* -- Variables ---------------------------------------------------------- */
+  int              iWidth, iHeight;    // Number of cells in the level
+  StdVector<unsigned char> ucvCells;   // Non-zero if cell has any bits set
+};/* ----------------------------------------------------------------------- */
+using MaskLevelVector = StdVector<MaskLevel>;
+/* -- Occupancy summary of a mask slot ------------------------------------- */
+struct MaskOccupancy                   // Built on demand by the mask
+{ /* -- Variables ---------------------------------------------------------- */
+  IntVector        ivMin, ivMax;       // First and last set column per row
+  int              iFirst, iLast;      // First and last occupied row
+  int              iLeft, iRight;      // First and last occupied column
+  MaskLevelVector  mlvLevels;          // Occupancy pyramid (finest first)
+  bool             bDirty = true;      // Summary needs rebuilding
+};/* ----------------------------------------------------------------------- */
+using MaskOccupancyVector = StdVector<MaskOccupancy>;
 /* == Mask collector and member class ====================================== */
 CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
   /* -- Base classes ------------------------------------------------------- */
@@ -29,6 +50,141 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
   public DimInt                        // Size of mask image
 { /* -- Variables ---------------------------------------------------------- */
   size_t           stAlloc;            // Size of all mask bitmaps in array
+  mutable MaskOccupancyVector movSlots; // Occupancy summary for each slot
+  /* -- Mark occupancy summary of specified slot as out of date ------------ */
+  void InvalidateOccupancy(const size_t stId)
+    { if(stId < movSlots.size()) movSlots[stId].bDirty = true; }
+  /* -- Get occupancy summary of specified slot and build it if needed ----- */
+  const MaskOccupancy &GetOccupancy(const size_t stId) const
+  { // Make sure there is a summary for every slot
+    if(movSlots.size() != size()) movSlots.resize(size());
+    // Return the summary if it is still valid
+    MaskOccupancy &moSlot = movSlots[stId];
+    if(!moSlot.bDirty) return moSlot;
+    // Get the bitmask surface for the slot
+    const Memory &mSlot = (*this)[stId];
+    const unsigned char*const cpS = mSlot.MemPtr<unsigned char>();
+    const size_t stBytes = mSlot.MemSize(),
+                 stWidth = DimGetWidth<size_t>();
+    // Reset the summary so every row is empty
+    moSlot.ivMin.assign(DimGetHeight<size_t>(), DimGetWidth());
+    moSlot.ivMax.assign(DimGetHeight<size_t>(), -1);
+    moSlot.iFirst = DimGetHeight();
+    moSlot.iLeft = DimGetWidth();
+    moSlot.iLast = moSlot.iRight = -1;
+    // Reset the finest level of the occupancy pyramid
+    moSlot.mlvLevels.resize(1);
+    MaskLevel &mlFinest = moSlot.mlvLevels.front();
+    mlFinest.iWidth = (DimGetWidth() + iMaskCellSize - 1) >> iMaskCellShift;
+    mlFinest.iHeight = (DimGetHeight() + iMaskCellSize - 1) >> iMaskCellShift;
+    mlFinest.ucvCells.assign(
+      static_cast<size_t>(mlFinest.iWidth * mlFinest.iHeight), 0);
+    // Enumerate each row
+    for(int iY = 0; iY < DimGetHeight(); ++iY)
+    { // Calculate row position and first cell of the row
+      const size_t stRowPos = static_cast<size_t>(iY) * stWidth,
+                   stCellPos = static_cast<size_t>(
+                     (iY >> iMaskCellShift) * mlFinest.iWidth);
+      // Read the row 64 bits at a time and record the first and last bits
+      for(size_t stX = 0; stX < stWidth; stX += 64)
+        if(const uint64_t ullBits = BitRead64(cpS, stBytes, stRowPos + stX,
+             UtilMinimum(stWidth - stX, static_cast<size_t>(64))))
+        { // Set first column if we have not found one yet
+          if(moSlot.ivMin[iY] == DimGetWidth())
+            moSlot.ivMin[iY] = static_cast<int>(stX) + StdCountRZero(ullBits);
+          // Always set last column
+          moSlot.ivMax[iY] = static_cast<int>(stX) + StdBitWidth(ullBits) - 1;
+          // Mark each cell that has a bit set in this word
+          for(size_t stByte = 0; stByte < sizeof(ullBits); ++stByte)
+            if((ullBits >> BitFromByte(stByte)) & 0xFF)
+              mlFinest.ucvCells[stCellPos + (stX >> iMaskCellShift) + stByte]
+                = 1;
+        }
+      // Ignore row if empty
+      if(moSlot.ivMax[iY] < 0) continue;
+      // Update occupied bounds
+      if(moSlot.iFirst > iY) moSlot.iFirst = iY;
+      moSlot.iLast = iY;
+      moSlot.iLeft = UtilMinimum(moSlot.iLeft, moSlot.ivMin[iY]);
+      moSlot.iRight = UtilMaximum(moSlot.iRight, moSlot.ivMax[iY]);
+    } // Build coarser levels until the whole mask fits in one cell
+    while(moSlot.mlvLevels.back().iWidth > 1 ||
+          moSlot.mlvLevels.back().iHeight > 1)
+    { // Add a new level (this may invalidate references to the old level)
+      moSlot.mlvLevels.emplace_back();
+      const MaskLevel &mlFine = moSlot.mlvLevels[moSlot.mlvLevels.size() - 2];
+      MaskLevel &mlCoarse = moSlot.mlvLevels.back();
+      // Each cell covers two by two cells of the finer level
+      mlCoarse.iWidth = (mlFine.iWidth + 1) / 2;
+      mlCoarse.iHeight = (mlFine.iHeight + 1) / 2;
+      mlCoarse.ucvCells.assign(
+        static_cast<size_t>(mlCoarse.iWidth * mlCoarse.iHeight), 0);
+      // Merge the occupied cells of the finer level
+      for(int iY = 0; iY < mlFine.iHeight; ++iY)
+        for(int iX = 0; iX < mlFine.iWidth; ++iX)
+          if(mlFine.ucvCells[static_cast<size_t>(iY * mlFine.iWidth + iX)])
+            mlCoarse.ucvCells[static_cast<size_t>(
+              (iY / 2) * mlCoarse.iWidth + (iX / 2))] = 1;
+    } // Summary is now valid
+    moSlot.bDirty = false;
+    return moSlot;
+  }
+  /* -- Returns if any bits are set in the specified region of a cell ------ */
+  bool IsCellSet(const MaskOccupancy &moSlot, const Memory &mSlot,
+    const size_t stLevel, const int iCX, const int iCY, const int iX1,
+    const int iY1, const int iX2, const int iY2) const
+  { // Get the level and return if the cell is empty
+    const MaskLevel &mlLevel = moSlot.mlvLevels[stLevel];
+    if(!mlLevel.ucvCells[static_cast<size_t>(iCY * mlLevel.iWidth + iCX)])
+      return false;
+    // Calculate the region of the cell that we need to test
+    const int iShift = iMaskCellShift + static_cast<int>(stLevel),
+      iXMin = UtilMaximum(iX1, iCX << iShift),
+      iYMin = UtilMaximum(iY1, iCY << iShift),
+      iXMax = UtilMinimum(iX2, (iCX + 1) << iShift),
+      iYMax = UtilMinimum(iY2, (iCY + 1) << iShift);
+    // Bail if the region does not touch this cell
+    if(iXMax <= iXMin || iYMax <= iYMin) return false;
+    // Finest level so test the bits in the region. The cell is never wider
+    // than 64 pixels so one read per row is enough.
+    if(!stLevel)
+    { // Get bitmask surface
+      const unsigned char*const cpS = mSlot.MemPtr<unsigned char>();
+      // Enumerate each row of the region and return if a bit is set
+      for(int iY = iYMin; iY < iYMax; ++iY)
+        if(BitRead64(cpS, mSlot.MemSize(),
+             static_cast<size_t>(iY * DimGetWidth() + iXMin),
+             static_cast<size_t>(iXMax - iXMin)))
+          return true;
+      // No bits are set
+      return false;
+    } // Get the finer level and test each of the child cells
+    const MaskLevel &mlFine = moSlot.mlvLevels[stLevel - 1];
+    for(int iY = iCY * 2; iY <= iCY * 2 + 1 && iY < mlFine.iHeight; ++iY)
+      for(int iX = iCX * 2; iX <= iCX * 2 + 1 && iX < mlFine.iWidth; ++iX)
+        if(IsCellSet(moSlot, mSlot, stLevel - 1, iX, iY,
+             iXMin, iYMin, iXMax, iYMax))
+          return true;
+    // No bits are set
+    return false;
+  }
+  /* -- Returns if no bits are set in the specified region ----------------- */
+  bool IsRegionClear(const size_t stId, const int iX1, const int iY1,
+    const int iX2, const int iY2) const
+  { // Get the occupancy summary of the slot
+    const MaskOccupancy &moSlot = GetOccupancy(stId);
+    // Clip the region to the occupied bounds of the mask
+    const int
+      iXMin = UtilMaximum(iX1, moSlot.iLeft),
+      iYMin = UtilMaximum(iY1, moSlot.iFirst),
+      iXMax = UtilMinimum(iX2, moSlot.iRight + 1),
+      iYMax = UtilMinimum(iY2, moSlot.iLast + 1);
+    // Region is clear if it is outside the occupied bounds
+    if(iXMax <= iXMin || iYMax <= iYMin) return true;
+    // Walk down the pyramid from the single cell at the top
+    return !IsCellSet(moSlot, (*this)[stId], moSlot.mlvLevels.size() - 1,
+      0, 0, iXMin, iYMin, iXMax, iYMax);
+  }
   /* -- Two masks overlap? ----------------------------------------- */ public:
   bool IsCollide(const size_t stSourceId, const int iSrcX, const int iSrcY,
     const Mask &mCdest, const size_t stDestId, const int iDestX,
@@ -45,23 +201,58 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       iYMax  = UtilMinimum(iYMax1, iYMax2);
     // Bail if out of bounds
     if(iXMax <= iXMin || iYMax <= iYMin) return false;
+    // Get occupancy summaries for both masks
+    const MaskOccupancy &moS = GetOccupancy(stSourceId),
+                        &moD = mCdest.GetOccupancy(stDestId);
+    // Skip the rows where either mask has no bits set
+    const int
+      iYBegin = UtilMaximum(iYMin,
+        UtilMaximum(iSrcY + moS.iFirst, iDestY + moD.iFirst)),
+      iYEnd = UtilMinimum(iYMax,
+        UtilMinimum(iSrcY + moS.iLast + 1, iDestY + moD.iLast + 1));
+    // Bail if either mask has no bits set in the overlapping region
+    if(IsRegionClear(stSourceId, iXMin - iSrcX, iYBegin - iSrcY,
+         iXMax - iSrcX, iYEnd - iSrcY) ||
+       mCdest.IsRegionClear(stDestId, iXMin - iDestX, iYBegin - iDestY,
+         iXMax - iDestX, iYEnd - iDestY))
+      return false;
     // Get bitmask surfaces for both masks
+    const Memory &mS = at(stSourceId), &mD = mCdest[stDestId];
     const unsigned char
-      *const cpS = at(stSourceId).MemPtr<unsigned char>(),
-      *const cpD = mCdest[stDestId].MemPtr<unsigned char>();
-    // Walk through the pixels of the intersection and check the bits and
-    // return if we found a match, else try next pixel
-    for(int iY = iYMin; iY < iYMax; ++iY)
-    { // Pre-calculate source and destination Y
-      const int iSrcYPos = (iY - iSrcY) * DimGetWidth(),
-                iDestYPos = (iY - iDestY) * mCdest.DimGetWidth();
-      // Enumerate X-axis
-      for(int iX = iXMin; iX < iXMax; ++iX)
-        if(BitTest(cpS, iSrcYPos + (iX - iSrcX)) &&
-           BitTest(cpD, iDestYPos + (iX - iDestX)))
+      *const cpS = mS.MemPtr<unsigned char>(),
+      *const cpD = mD.MemPtr<unsigned char>();
+    // Walk through the rows of the intersection
+    for(int iY = iYBegin; iY < iYEnd; ++iY)
+    { // Pre-calculate source and destination row
+      const int iSrcRow = iY - iSrcY, iDestRow = iY - iDestY;
+      // Only test the columns where both rows have bits set. Empty rows have
+      // their first column after their last column so they are skipped too.
+      const int
+        iXBegin = UtilMaximum(iXMin, UtilMaximum(
+          iSrcX + moS.ivMin[static_cast<size_t>(iSrcRow)],
+          iDestX + moD.ivMin[static_cast<size_t>(iDestRow)])),
+        iXEnd = UtilMinimum(iXMax, UtilMinimum(
+          iSrcX + moS.ivMax[static_cast<size_t>(iSrcRow)] + 1,
+          iDestX + moD.ivMax[static_cast<size_t>(iDestRow)] + 1));
+      if(iXEnd <= iXBegin) continue;
+      // Calculate bit positions of the first column in both rows
+      const size_t
+        stSrcPos = static_cast<size_t>(iSrcRow * DimGetWidth() +
+          (iXBegin - iSrcX)),
+        stDestPos = static_cast<size_t>(iDestRow * mCdest.DimGetWidth() +
+          (iXBegin - iDestX)),
+        stColumns = static_cast<size_t>(iXEnd - iXBegin);
+      // Compare 64 columns at a time and return if any bits overlap
+      for(size_t stX = 0; stX < stColumns; stX += 64)
+      { // Number of columns to compare
+        const size_t stCount =
+          UtilMinimum(stColumns - stX, static_cast<size_t>(64));
+        // Return if the masks share a bit
+        if(BitRead64(cpS, mS.MemSize(), stSrcPos + stX, stCount) &
+           BitRead64(cpD, mD.MemSize(), stDestPos + stX, stCount))
           return true;
-    }
-    // No collision
+      }
+    } // No collision
     return false;
   }
   /* -- Two masks overlap with raycasting? --------------------------------- */
@@ -75,17 +266,55 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
                  iN = 1 + iDX + iDY,   iError = iDX - iDY;
     const int iXinc = iToX > iFromX ? 1 : iToX < iFromX ? -1 : 0,
               iYinc = iToY > iFromY ? 1 : iToY < iFromY ? -1 : 0;
+    // Get occupied bounds of destination mask and bail if it is empty
+    const MaskOccupancy &moD = mCdest.GetOccupancy(stDestId);
+    if(moD.iFirst > moD.iLast) return false;
+    // Bail if the source has no bits anywhere along the entire line
+    if(IsRegionClear(stSourceId,
+         UtilMinimum(iFromX, iToX) + moD.iLeft - iSrcX,
+         UtilMinimum(iFromY, iToY) + moD.iFirst - iSrcY,
+         UtilMaximum(iFromX, iToX) + moD.iRight + 1 - iSrcX,
+         UtilMaximum(iFromY, iToY) + moD.iLast + 1 - iSrcY))
+      return false;
+    // Calculate the region of the source mask that the destination bits can
+    // reach within the specified number of steps from the current position
+    const auto IsReachClear = [&](const int iSteps)
+      { return IsRegionClear(stSourceId,
+          iX + moD.iLeft - iSteps - iSrcX, iY + moD.iFirst - iSteps - iSrcY,
+          iX + moD.iRight + 1 + iSteps - iSrcX,
+          iY + moD.iLast + 1 + iSteps - iSrcY); };
     // Make further calculations
     iDX *= 2;
     iDY *= 2;
+    // Move to the next position on the line
+    const auto Step = [&]()
+    { // Check for errors
+      if(iError > 0) { iLX = iX; iX += iXinc; iError -= iDY; }
+      else           { iLY = iY; iY += iYinc; iError += iDX; }
+    };
+    // Number of steps to try and skip over when the area is empty
+    int iSkip = iMaskCellSize;
     // Iterations
-    for(;iN > 0; --iN)
-    { // Check collision and return if found? Set last good position
+    while(iN > 0)
+    { // If the source has no bits that the destination can reach within the
+      // next few steps then walk them without testing and skip further next
+      // time, else skip less next time.
+      const int iSteps = UtilMinimum(iSkip, iN);
+      if(iSteps > 1 && IsReachClear(iSteps))
+      { // Walk the steps
+        for(int iStep = 0; iStep < iSteps; ++iStep) Step();
+        iN -= iSteps;
+        // Try skipping more next time
+        if(iSkip < iN) iSkip *= 2;
+        continue;
+      } // Try skipping less next time
+      iSkip = UtilMaximum(iSkip / 2, 2);
+      // Check collision and return if found? Set last good position
       if(IsCollide(stSourceId, iSrcX, iSrcY, mCdest, stDestId, iX, iY))
         { iToX = iLX; iToY = iLY; return true; }
-      // Check for errors
-      else if(iError > 0) { iLX = iX; iX += iXinc; iError -= iDY; }
-      else                { iLY = iY; iY += iYinc; iError += iDX; }
+      // Move to next position
+      Step();
+      --iN;
     }
     // No collision
     return false;
@@ -103,6 +332,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       iYMax  = UtilMinimum(DimGetHeight(), iYMax2);
     // Bail if out of bounds
     if(iXMax <= iXMin || iYMax <= iYMin) return;
+    // Occupancy summary will need rebuilding
+    InvalidateOccupancy(stDestId);
     // Get bitmask surfaces for both masks
     const unsigned char*const cpS = mCsrc[stSourceId].MemPtr<unsigned char>();
           unsigned char*const cpD = at(stDestId).MemPtr<unsigned char>();
@@ -134,6 +365,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       iYMax  = UtilMinimum(DimGetHeight(), iYMax2);
     // Bail if out of bounds
     if(iXMax <= iXMin || iYMax <= iYMin) return;
+    // Occupancy summary will need rebuilding
+    InvalidateOccupancy(0);
     // Get bitmask surfaces for both masks
     const unsigned char*const cpS = mCsrc[stSourceId].MemPtr<unsigned char>();
           unsigned char*const cpD = front().MemPtr<unsigned char>();
@@ -151,6 +384,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
   void Erase(const size_t stDestId)
   { // Bail if out of bounds
     if(DimGetWidth() <= 0 || DimGetHeight() <= 0) return;
+    // Occupancy summary will need rebuilding
+    InvalidateOccupancy(stDestId);
     // Get bit mask surfaces for both masks
     unsigned char*const cpD = at(stDestId).MemPtr<unsigned char>();
     // Enumerate Y-axis positions
@@ -172,6 +407,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       iYMax  = UtilMinimum(DimGetHeight(), iYMax2);
     // Bail if out of bounds
     if(iXMax <= iXMin || iYMax <= iYMin) return;
+    // Occupancy summary will need rebuilding
+    InvalidateOccupancy(0);
     // Get bitmask surfaces for both masks
     unsigned char*const cpD = front().MemPtr<unsigned char>();
     // Walk through the pixels of the intersection and set each bit
@@ -190,9 +427,11 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       iXMax2 = iDX + iW,               iYMax2 = iDY + iH,
       iXMin  = UtilMaximum(iDX, 0),    iYMin  = UtilMaximum(iDY, 0),
       iXMax  = UtilMinimum(DimGetWidth(), iXMax2),
-      iYMax  = UtilMaximum(DimGetHeight(), iYMax2);
+      iYMax  = UtilMinimum(DimGetHeight(), iYMax2);
     // Bail if out of bounds
     if(iXMax <= iXMin || iYMax <= iYMin) return;
+    // Occupancy summary will need rebuilding
+    InvalidateOccupancy(0);
     // Get bitmask surfaces for both masks
     unsigned char*const cpD = front().MemPtr<unsigned char>();
     // Walk through the pixels of the intersection and set each bit
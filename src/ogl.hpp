@@ -148,7 +148,14 @@ class Ogl :                            // OGL class for OpenGL use simplicity
                   &gluVaoGlobal,       // ovhVao[0]: Vao for global use
                   &gluVboGlobal,       // ovhVbo[0]: Fbo for global use
                   &gluVaoMain,         // ovhVao[1]: Vao to draw back buffer
-                  &gluVboMain;         // ovhVbo[1]: Fbo to draw back buffer
+                  &gluVboMain,         // ovhVbo[1]: Fbo to draw back buffer
+                   gluIboQuads;        // Shared quad index buffer object
+  size_t           stStreamSize,       // Streaming vertex buffer capacity
+                   stStreamPos,        // Streaming vertex buffer write offset
+                   stStreamBytes,      // Bytes streamed so far this frame
+                   stStreamBytesLast,  // Bytes streamed in the last frame
+                   stStreamOrphans,    // Times the stream buffer was orphaned
+                   stQuadIndices;      // Quads covered by the index buffer
   GLenum           glePolyMode;        // Current polygon mode
   GLint            gliUnpackRowLength; // Default unpack row length
   GLuint64         glullMinVRAM,       // Minimum VRAM required
@@ -178,9 +185,11 @@ class Ogl :                            // OGL class for OpenGL use simplicity
     PFNGLBINDVERTEXARRAYPROC           glBindVertexArray;
     PFNGLBLENDFUNCSEPARATEPROC         glBlendFuncSeparate;
     PFNGLBUFFERDATAPROC                glBufferData;
+    PFNGLBUFFERSUBDATAPROC             glBufferSubData;
     PFNGLCHECKFRAMEBUFFERSTATUSPROC    glCheckFramebufferStatus;
     PFNGLCLEARCOLORPROC                glClearColor;
     PFNGLCLEARPROC                     glClear;
+    PFNGLCLIENTWAITSYNCPROC            glClientWaitSync;
     PFNGLCOMPILESHADERPROC             glCompileShader;
     PFNGLCOMPRESSEDTEXIMAGE2DPROC      glCompressedTexImage2D;
     PFNGLCREATEPROGRAMPROC             glCreateProgram;
@@ -189,14 +198,17 @@ class Ogl :                            // OGL class for OpenGL use simplicity
     PFNGLDELETEFRAMEBUFFERSPROC        glDeleteFramebuffers;
     PFNGLDELETEPROGRAMPROC             glDeleteProgram;
     PFNGLDELETESHADERPROC              glDeleteShader;
+    PFNGLDELETESYNCPROC                glDeleteSync;
     PFNGLDELETETEXTURESPROC            glDeleteTextures;
     PFNGLDELETEVERTEXARRAYSPROC        glDeleteVertexArrays;
     PFNGLDETACHSHADERPROC              glDetachShader;
     PFNGLDISABLEPROC                   glDisable;
     PFNGLDISABLEVERTEXATTRIBARRAYPROC  glDisableVertexAttribArray;
     PFNGLDRAWARRAYSPROC                glDrawArrays;
+    PFNGLDRAWELEMENTSPROC              glDrawElements;
     PFNGLENABLEPROC                    glEnable;
     PFNGLENABLEVERTEXATTRIBARRAYPROC   glEnableVertexAttribArray;
+    PFNGLFENCESYNCPROC                 glFenceSync;
     PFNGLFRAMEBUFFERTEXTURE2DPROC      glFramebufferTexture2D;
     PFNGLFINISHPROC                    glFinish;
     PFNGLGENBUFFERSPROC                glGenBuffers;
@@ -218,6 +230,7 @@ class Ogl :                            // OGL class for OpenGL use simplicity
     PFNGLHINTPROC                      glHint;
     PFNGLISENABLEDPROC                 glIsEnabled;
     PFNGLLINKPROGRAMPROC               glLinkProgram;
+    PFNGLMAPBUFFERRANGEPROC            glMapBufferRange;
     PFNGLPIXELSTOREIPROC               glPixelStorei;
     PFNGLPOLYGONMODEPROC               glPolygonMode;
     PFNGLREADBUFFERPROC                glReadBuffer;
@@ -228,6 +241,7 @@ class Ogl :                            // OGL class for OpenGL use simplicity
     PFNGLUNIFORM1IPROC                 glUniform1i;
     PFNGLUNIFORM4FPROC                 glUniform4f;
     PFNGLUNIFORM4FVPROC                glUniform4fv;
+    PFNGLUNMAPBUFFERPROC               glUnmapBuffer;
     PFNGLUSEPROGRAMPROC                glUseProgram;
     PFNGLVERTEXATTRIBPOINTERPROC       glVertexAttribPointer;
     PFNGLVIEWPORTPROC                  glViewport;
@@ -328,6 +342,7 @@ class Ogl :                            // OGL class for OpenGL use simplicity
     GETPTR(glDeleteTextures, PFNGLDELETETEXTURESPROC);
     GETPTR(glDisable, PFNGLDISABLEPROC);
     GETPTR(glDrawArrays, PFNGLDRAWARRAYSPROC);
+    GETPTR(glDrawElements, PFNGLDRAWELEMENTSPROC);
     GETPTR(glEnable, PFNGLENABLEPROC);
     GETPTR(glFinish, PFNGLFINISHPROC);
     GETPTR(glGenerateMipmap, PFNGLGENERATEMIPMAPPROC);
@@ -370,8 +385,15 @@ class Ogl :                            // OGL class for OpenGL use simplicity
     // Vertex Buffer Object (Vbo) functions
     GETPTR(glBindBuffer, PFNGLBINDBUFFERPROC);
     GETPTR(glBufferData, PFNGLBUFFERDATAPROC);
+    GETPTR(glBufferSubData, PFNGLBUFFERSUBDATAPROC);
     GETPTR(glDeleteBuffers, PFNGLDELETEBUFFERSPROC);
     GETPTR(glGenBuffers, PFNGLGENBUFFERSPROC);
+    GETPTR(glMapBufferRange, PFNGLMAPBUFFERRANGEPROC);
+    GETPTR(glUnmapBuffer, PFNGLUNMAPBUFFERPROC);
+    // Sync object functions
+    GETPTR(glClientWaitSync, PFNGLCLIENTWAITSYNCPROC);
+    GETPTR(glDeleteSync, PFNGLDELETESYNCPROC);
+    GETPTR(glFenceSync, PFNGLFENCESYNCPROC);
     // Vertex Memory Object (Vao) functions
     GETPTR(glBindVertexArray, PFNGLBINDVERTEXARRAYPROC);
     GETPTR(glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC);
@@ -412,6 +434,11 @@ class Ogl :                            // OGL class for OpenGL use simplicity
   { sAPI.glVertexAttribPointer(gluAttrib, gliSize, GL_FLOAT, GL_FALSE,
       glsiStride, glvpBuffer); }
   /* ----------------------------------------------------------------------- */
+  void VertexAttribPointerUB(const GLuint gluAttrib, const GLint gliSize,
+    const GLsizei glsiStride, const GLvoid*const glvpBuffer) const
+  { sAPI.glVertexAttribPointer(gluAttrib, gliSize, GL_UNSIGNED_BYTE, GL_TRUE,
+      glsiStride, glvpBuffer); }
+  /* ----------------------------------------------------------------------- */
   void SetPixelStore(const GLenum gleId, const GLint gliValue) const
     { sAPI.glPixelStorei(gleId, gliValue); }
   /* ----------------------------------------------------------------------- */
@@ -778,6 +805,98 @@ class Ogl :                            // OGL class for OpenGL use simplicity
   /* ----------------------------------------------------------------------- */
   void BufferStaticData(const GLsizei glsiSize, const GLvoid*const glvpBuffer)
     { BufferData(GL_ARRAY_BUFFER, glsiSize, glvpBuffer, GL_STREAM_DRAW); }
+  /* ----------------------------------------------------------------------- */
+  void BufferSubData(const GLenum gleTarget, const GLintptr glipOffset,
+    const GLsizeiptr glsipSize, const GLvoid*const glvpBuffer) const
+  { sAPI.glBufferSubData(gleTarget, glipOffset, glsipSize, glvpBuffer); }
+  /* -- Bind pixel pack buffer (not cached as it is only used to read) ----- */
+  void BindPackBuffer(const GLuint gluPbo) const
+    { sAPI.glBindBuffer(GL_PIXEL_PACK_BUFFER, gluPbo); }
+  /* -- Map the bound pixel pack buffer for reading ------------------------ */
+  const GLvoid *MapPackBuffer(const GLsizeiptr glsipSize) const
+    { return sAPI.glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, glsipSize,
+        GL_MAP_READ_BIT); }
+  /* -- Unmap the bound pixel pack buffer ---------------------------------- */
+  bool UnmapPackBuffer() const
+    { return sAPI.glUnmapBuffer(GL_PIXEL_PACK_BUFFER) == GL_TRUE; }
+  /* -- Insert a fence after all the currently queued commands ------------- */
+  GLsync FenceSync() const
+    { return sAPI.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); }
+  /* -- Return if a fence was signalled waiting the specified nanoseconds -- */
+  bool FenceSignalled(const GLsync glsFence,
+    const GLuint64 gluiTimeout = 0) const
+  { // Wait for the fence and return if it was signalled
+    switch(sAPI.glClientWaitSync(glsFence, GL_SYNC_FLUSH_COMMANDS_BIT,
+      gluiTimeout))
+    { // Signalled?
+      case GL_ALREADY_SIGNALED: case GL_CONDITION_SATISFIED: return true;
+      // Timed out or failed
+      default: return false;
+    }
+  }
+  /* -- Delete a fence ----------------------------------------------------- */
+  void DeleteSync(const GLsync glsFence) const
+    { sAPI.glDeleteSync(glsFence); }
+  /* -- Append vertex data to the streaming buffer and return its offset --- */
+  size_t StreamUpload(const size_t stBytes, const GLvoid*const glvpBuffer)
+  { // Data is always streamed into the global vertex buffer
+    BindStaticVertexBuffer(gluVboGlobal);
+    // Keep every block aligned so attribute offsets stay aligned too
+    const size_t stAligned = (stBytes + 63) & ~static_cast<size_t>(63);
+    // Not enough room left at the write position?
+    if(stStreamPos + stAligned > stStreamSize)
+    { // Grow the storage if this block would never fit
+      if(stAligned > stStreamSize)
+        stStreamSize = UtilMaximum(stAligned * 2, static_cast<size_t>(1048576));
+      // Orphan the old storage so the driver does not wait for the GPU to
+      // finish with it and start writing again at the beginning.
+      BufferData(GL_ARRAY_BUFFER, UtilIntOrMax<GLsizei>(stStreamSize),
+        nullptr, GL_STREAM_DRAW);
+      stStreamPos = 0;
+      ++stStreamOrphans;
+    } // Write the data after anything already streamed
+    BufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(stStreamPos),
+      static_cast<GLsizeiptr>(stBytes), glvpBuffer);
+    // Move write position along and return where this data was written
+    const size_t stOffset = stStreamPos;
+    stStreamPos += stAligned;
+    stStreamBytes += stBytes;
+    return stOffset;
+  }
+  /* -- Bind index buffer that covers the specified number of quads -------- */
+  void StreamQuadIndices(const size_t stQuads)
+  { // Create the index buffer if it doesn't exist yet
+    if(!gluIboQuads) GenVertexBuffers(1, &gluIboQuads);
+    // The element buffer binding is vao state so always set it
+    sAPI.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gluIboQuads);
+    // Done if the buffer already covers enough quads
+    if(stQuads <= stQuadIndices) return;
+    // Grow geometrically so this rarely has to happen again
+    const size_t stNew = UtilMaximum(stQuads,
+      UtilMaximum(stQuadIndices * 2, static_cast<size_t>(4096)));
+    // Two triangles per quad sharing the second and third vertices. Both
+    // have the same winding as the non-indexed triangles.
+    GLUIntVector gluvIndices(stNew * stIndicesPerQuad);
+    for(size_t stQuad = 0, stIndex = 0; stQuad < stNew; ++stQuad)
+    { // Calculate first vertex of this quad and write the indices
+      const GLuint gluBase = static_cast<GLuint>(stQuad * stVertsPerQuad);
+      gluvIndices[stIndex++] = gluBase;
+      gluvIndices[stIndex++] = gluBase + 1;
+      gluvIndices[stIndex++] = gluBase + 2;
+      gluvIndices[stIndex++] = gluBase + 3;
+      gluvIndices[stIndex++] = gluBase + 2;
+      gluvIndices[stIndex++] = gluBase + 1;
+    } // Upload the indices which never change after this
+    BufferData(GL_ELEMENT_ARRAY_BUFFER,
+      UtilIntOrMax<GLsizei>(gluvIndices.size() * sizeof(GLuint)),
+      gluvIndices.data(), GL_STATIC_DRAW);
+    stQuadIndices = stNew;
+  }
+  /* -- Streaming buffer statistics ---------------------------------------- */
+  size_t StreamGetBytes() const { return stStreamBytesLast; }
+  size_t StreamGetSize() const { return stStreamSize; }
+  size_t StreamGetOrphans() const { return stStreamOrphans; }
+  size_t StreamGetQuadIndices() const { return stQuadIndices; }
   /* -- Clear bound Fbo or back buffer ------------------------------------- */
   void ClearBuffer() const { sAPI.glClear(GL_COLOR_BUFFER_BIT); }
   /* -- Set specified Vbo and Vao ------------------------------------------ */
@@ -858,9 +977,18 @@ class Ogl :                            // OGL class for OpenGL use simplicity
   /* ----------------------------------------------------------------------- */
   void DrawArraysTriangles(const GLsizei glsiCount) const
     { DrawArrays(GL_TRIANGLES, 0, glsiCount); }
+  /* -- Draw quads from the quad index buffer ------------------------------ */
+  void DrawQuads(const size_t stFirst, const size_t stCount) const
+    { sAPI.glDrawElements(GL_TRIANGLES,
+        static_cast<GLsizei>(stCount * stIndicesPerQuad), GL_UNSIGNED_INT,
+        reinterpret_cast<GLvoid*>(stFirst * stIndicesPerQuad *
+          sizeof(GLuint))); }
   /* -- Delete lingering textures and finish ------------------------------- */
   void OglPostRender()
-  { // Delete texture and Fbo handles
+  { // Roll streamed byte counter over for this frame
+    stStreamBytesLast = stStreamBytes;
+    stStreamBytes = 0;
+    // Delete texture and Fbo handles
     DeleteTexturesAndFboHandles();
     // Flush and wait for GPU to complete
     Finish();
@@ -1340,7 +1468,18 @@ class Ogl :                            // OGL class for OpenGL use simplicity
       StdFill(seq, ovhVbo.begin(), ovhVbo.end(), 0);
       cLog->LogInfoExSafe("OGL deleted $ vertex buffer objects.",
         ovhVbo.size());
-    } // Vertex array object created?
+    } // Quad index buffer object created?
+    if(gluIboQuads)
+    { // Delete quad index buffer object
+      cLog->LogDebugExSafe("OGL deleting quad index buffer object $...",
+        gluIboQuads);
+      IGLL(DeleteVertexBuffers(1, &gluIboQuads),
+        "Failed to delete quad index buffer object!", "Index", gluIboQuads);
+      gluIboQuads = 0;
+      cLog->LogInfoSafe("OGL deleted quad index buffer object.");
+    } // Streamed buffer storage went with the buffer objects
+    stStreamSize = stStreamPos = stQuadIndices = 0;
+    // Vertex array object created?
     if(gluVaoGlobal && gluVaoMain)
     { // Delete vertex array object
       cLog->LogDebugExSafe("OGL deleting $ vertex array objects $ and $...",
@@ -1451,6 +1590,13 @@ class Ogl :                            // OGL class for OpenGL use simplicity
     gluVboGlobal(ovhVbo[0]),           // Set reference to global Vbo
     gluVaoMain(ovhVao[1]),             // Set reference to bb draw Vao
     gluVboMain(ovhVbo[1]),             // Set reference to bb draw Vbo
+    gluIboQuads(0),                    // No quad index buffer yet
+    stStreamSize(0),                   // No streaming buffer storage yet
+    stStreamPos(0),                    // Streaming buffer write offset
+    stStreamBytes(0),                  // No bytes streamed this frame
+    stStreamBytesLast(0),              // No bytes streamed last frame
+    stStreamOrphans(0),                // Streaming buffer never orphaned
+    stQuadIndices(0),                  // Index buffer covers no quads
     glePolyMode(GL_NONE),              // No set polygon mode yet
     gliUnpackRowLength(0),             // No unpack row length
     glullMinVRAM(0),                   // No minimum vram
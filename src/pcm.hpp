@@ -13,13 +13,14 @@ namespace IPcm {                       // Start of private module namespace
 using namespace IAsset::P;             using namespace IASync::P;
 using namespace ICollector::P;         using namespace ICommon::P;
 using namespace IError::P;             using namespace IEvtMain::P;
-using namespace IFileMap::P;           using namespace ILockable::P;
-using namespace ILog::P;               using namespace ILuaIdent::P;
-using namespace ILuaLib::P;            using namespace ILuaUtil::P;
-using namespace IMemory::P;            using namespace IName::P ;
-using namespace IPcmData::P;           using namespace IPcmDef::P;
-using namespace IPcmLib::P;            using namespace ISerial::P;
-using namespace IStd::P;               using namespace IString::P;
+using namespace IFileMap::P;           using namespace IJobs::P;
+using namespace ILockable::P;          using namespace ILog::P;
+using namespace ILuaIdent::P;          using namespace ILuaLib::P;
+using namespace ILuaUtil::P;           using namespace IMemory::P;
+using namespace IName::P ;             using namespace IPcmData::P;
+using namespace IPcmDef::P;            using namespace IPcmLib::P;
+using namespace ISerial::P;            using namespace IStd::P;
+using namespace IString::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* == Pcm collector and member class ======================================= */
@@ -265,7 +266,8 @@ CTOR_BEGIN_ASYNC_DUO(Pcms, Pcm, CLHelperUnsafe, ICHelperUnsafe),
     /* -- Initialisers ----------------------------------------------------- */
     ICHelperPcm{ cPcms },              // Initially unregistered
     SerialSlave{ cParent->Serial() },  // Initialise identification number
-    AsyncLoaderPcm{ this, EMC_MP_PCM } // Setup async loader with this class
+    AsyncLoaderPcm{ this, EMC_MP_PCM,  // Setup async loader with this class
+      JP_AUDIO }                       // " and the job priority
     /* -- No code ---------------------------------------------------------- */
     {}
   /* -- Constructor to MOVE from other object ------------------------------ */
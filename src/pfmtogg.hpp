@@ -20,6 +20,11 @@ using namespace Lib::Ogg;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* ------------------------------------------------------------------------- */
+struct OggMemView                      // Decoder view of shared ogg data
+{ /* ----------------------------------------------------------------------- */
+  const MemConst  *mcData;             // Compressed ogg data being read
+  size_t           stPos;              // Read position in compressed data
+};/* ----------------------------------------------------------------------- */
 class CodecOGG;                        // Class prototype
 static CodecOGG *cCodecOGG = nullptr;  // Pointer to global class
 class CodecOGG :                       // OGG codec object
@@ -27,7 +32,8 @@ class CodecOGG :                       // OGG codec object
   private PcmLib,                      // Pcm format helper class
   private LookupMap<>                  // Ogg error codes
 { /* -- Private variables -------------------------------------------------- */
-  const ov_callbacks ovcCallbacks;     // Vorbis callbacks
+  const ov_callbacks ovcCallbacks,     // Vorbis callbacks
+                     ovcViewCallbacks; // Vorbis shared memory callbacks
   /* -- Vorbis read callback --------------------------------------- */ public:
   static size_t VorbisRead(void*const vpPtr,
     size_t stSize, size_t stCount, void*const vFmClassPtr)
@@ -43,8 +49,49 @@ class CodecOGG :                       // OGG codec object
   static long VorbisTell(void*const vFmClassPtr)
     { return static_cast<long>(reinterpret_cast<FileMap*>(vFmClassPtr)->
         FileMapTell()); }
+  /* -- Vorbis read callback for a shared memory view ---------------------- */
+  static size_t VorbisViewRead(void*const vpPtr,
+    size_t stSize, size_t stCount, void*const vOmvPtr)
+  { // Get view and clamp the bytes requested to what is remaining
+    OggMemView &omvRef = *reinterpret_cast<OggMemView*>(vOmvPtr);
+    const size_t stBytes = UtilMinimum(stSize * stCount,
+      omvRef.mcData->MemSize() - omvRef.stPos);
+    // Copy the data if there is any and move the position onwards
+    if(stBytes)
+      StdMemCopy(vpPtr, omvRef.mcData->MemRead(omvRef.stPos, stBytes),
+        stBytes);
+    omvRef.stPos += stBytes;
+    // Return bytes read
+    return stBytes;
+  }
+  /* -- Vorbis seek callback for a shared memory view ---------------------- */
+  static int VorbisViewSeek(void*const vOmvPtr, ogg_int64_t llOffset,
+    int iLoc)
+  { // Get view and the position to seek relative to
+    OggMemView &omvRef = *reinterpret_cast<OggMemView*>(vOmvPtr);
+    ogg_int64_t llBase;
+    switch(iLoc)
+    { // Seek from start, current position or end of file?
+      case SEEK_SET: llBase = 0; break;
+      case SEEK_CUR: llBase = static_cast<ogg_int64_t>(omvRef.stPos); break;
+      case SEEK_END: llBase = omvRef.mcData->MemSize<ogg_int64_t>(); break;
+      // Anything else is a failure
+      default: return -1;
+    } // Fail if the new position is out of range
+    const ogg_int64_t llPos = llBase + llOffset;
+    if(llPos < 0 || llPos > omvRef.mcData->MemSize<ogg_int64_t>()) return -1;
+    // Set new position and return success
+    omvRef.stPos = static_cast<size_t>(llPos);
+    return 0;
+  }
+  /* -- Vorbis tell callback for a shared memory view ---------------------- */
+  static long VorbisViewTell(void*const vOmvPtr)
+    { return static_cast<long>(reinterpret_cast<OggMemView*>(vOmvPtr)->
+        stPos); }
   /* -- Return generic ogg callback functions ------------------------------ */
   const ov_callbacks &GetCallbacks() { return ovcCallbacks; }
+  /* -- Return shared memory ogg callback functions ------------------------ */
+  const ov_callbacks &GetViewCallbacks() { return ovcViewCallbacks; }
   /* -- Convert vorbis encoded frames to 32-bit floating point PCM audio --- */
   static void F32FromVorbisFrames(const ALfloat*const*const fpFramesIn,
     const size_t stFrames, const size_t stChannels, ALfloat *fpPCMOut)
@@ -152,7 +199,9 @@ class CodecOGG :                       // OGG codec object
       IDMAPSTR(OV_ENOTAUDIO),          IDMAPSTR(OV_EBADPACKET),
       IDMAPSTR(OV_EBADLINK),           IDMAPSTR(OV_ENOSEEK)
     }, "OV_UNKNOWN" },
-    ovcCallbacks{ VorbisRead, VorbisSeek, VorbisClose, VorbisTell }
+    ovcCallbacks{ VorbisRead, VorbisSeek, VorbisClose, VorbisTell },
+    ovcViewCallbacks{ VorbisViewRead, VorbisViewSeek, VorbisClose,
+      VorbisViewTell }
     /* -- Set global pointer to static class ------------------------------- */
     { cCodecOGG = this; }
 };/* ----------------------------------------------------------------------- */
@@ -199,8 +199,9 @@ class SysBase :                        // Safe exception handler namespace
     // Add trace header
     osS << "\nLog trace:-\n"
            "===========\n";
-    // Now add the buffer lines
+    // Now add the buffer lines and write any the log writer has not yet
     cLog->LogGetBufferLines(osS);
+    cLog->LogFlushSafe();
     // Write the output and close the log
     const StdString strMsg{ StrAppend(osS.str(), '\n') };
     // Message box string
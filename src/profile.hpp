@@ -0,0 +1,299 @@
+/* == PROFILE.HPP ========================================================== **
+** ######################################################################### **
+** ## Mhatxotic Engine          (c) Mhatxotic Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## Records scoped timing zones from the engine and worker threads into ## **
+** ## a ring per thread so the time spent in recent frames can be broken  ## **
+** ## down and exported in the Chrome trace event format. Recording a     ## **
+** ## zone is only a pointer and a flag check when the profiler is off.   ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ------------------------------------------------------------------------- */
+namespace IProfile {                   // Start of private module namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IClock::P;             using namespace IError::P;
+using namespace IFStream::P;           using namespace ILog::P;
+using namespace IMutex::P;             using namespace IStd::P;
+using namespace IString::P;            using namespace IUtil::P;
+using ::std::atomic_thread_fence;      using ::std::memory_order_acquire;
+using ::std::memory_order_relaxed;     using ::std::memory_order_release;
+/* ------------------------------------------------------------------------- */
+namespace P {                          // Start of public module namespace
+/* -- Zone recorded by a thread -------------------------------------------- */
+struct ProfileEvent                    // Completed zone
+{ const char      *cpName;             // Static name of the zone
+  uint64_t         qwStart, qwEnd;     // Start and end time in nanoseconds
+  unsigned         uDepth;             // Nesting depth on the thread
+};/* ----------------------------------------------------------------------- */
+class ProfileRing                      // Zones recorded by one thread
+{ /* -- Private typedefs --------------------------------------------------- */
+  struct Slot                          // Completed zone in the ring
+  { AtomicSizeT    astSeq;             // Zone number plus one (0=writing)
+    StdAtomic<const char*> acpName;    // Static name of the zone
+    AtomicUInt64   aqwStart, aqwEnd;   // Start and end time in nanoseconds
+    AtomicUnsigned auDepth;            // Nesting depth on the thread
+  };/* --------------------------------------------------------------------- */
+  using Events = StdArray<Slot, 8192>; // Ring of completed zones
+  /* -- Private variables -------------------------------------------------- */
+  Events           eEvents;            // Completed zones
+  StdAtomic<size_t> atHead;            // Total zones written to the ring
+  AtomicBool       abOwned;            // A thread is writing to the ring
+  unsigned         uDepth;             // Current nesting depth
+  const size_t     stId;               // Id of the ring in the trace
+  StdString        strName;            // Name of the thread
+  /* -- Zone was entered (owner thread only) ----------------------- */ public:
+  uint64_t ProfileRingBegin()
+    { ++uDepth; return cmHiRes.GetTimeNS<uint64_t>(); }
+  /* -- Zone was left (owner thread only) ---------------------------------- */
+  void ProfileRingEnd(const char*const cpName, const uint64_t qwStart)
+  { // Mark the next slot as being written so readers ignore it
+    const size_t stHead = atHead.load(memory_order_relaxed);
+    Slot &sRef = eEvents[stHead % eEvents.size()];
+    sRef.astSeq.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    // Write the zone
+    sRef.acpName.store(cpName, memory_order_relaxed);
+    sRef.aqwStart.store(qwStart, memory_order_relaxed);
+    sRef.aqwEnd.store(cmHiRes.GetTimeNS<uint64_t>(), memory_order_relaxed);
+    sRef.auDepth.store(--uDepth, memory_order_relaxed);
+    // Publish the slot and then the zone count
+    sRef.astSeq.store(stHead + 1, memory_order_release);
+    atHead.store(stHead + 1, memory_order_release);
+  }
+  /* -- Send zones started after the specified time to a callback ---------- */
+  template<typename FuncType>
+    void ProfileRingRead(const uint64_t qwFrom, FuncType &&ftCb) const
+  { // For each zone still in the ring
+    const size_t stHead = atHead.load(memory_order_acquire),
+      stCount = UtilMinimum(stHead, eEvents.size());
+    for(size_t stIndex = stHead - stCount; stIndex < stHead; ++stIndex)
+    { // Ignore the slot if the owner is writing or has overwritten it
+      const Slot &sRef = eEvents[stIndex % eEvents.size()];
+      const size_t stSeq = sRef.astSeq.load(memory_order_acquire);
+      if(stSeq != stIndex + 1) continue;
+      // Copy the zone and ignore it if the owner started writing meanwhile
+      const ProfileEvent peCopy{
+        sRef.acpName.load(memory_order_relaxed),
+        sRef.aqwStart.load(memory_order_relaxed),
+        sRef.aqwEnd.load(memory_order_relaxed),
+        sRef.auDepth.load(memory_order_relaxed) };
+      atomic_thread_fence(memory_order_acquire);
+      if(sRef.astSeq.load(memory_order_relaxed) != stSeq) continue;
+      // Send it if it started in the requested range
+      if(peCopy.qwStart >= qwFrom) ftCb(peCopy);
+    }
+  }
+  /* -- Give the ring to a new thread (profiler lock held) ----------------- */
+  bool ProfileRingAcquire(const StdStringView &ssvName)
+  { // Fail if another thread owns it
+    if(abOwned) return false;
+    // Forget the zones of the previous thread and take ownership
+    atHead = 0;
+    uDepth = 0;
+    strName = ssvName;
+    abOwned = true;
+    // Success
+    return true;
+  }
+  /* -- The owner thread exited -------------------------------------------- */
+  void ProfileRingRelease() { abOwned = false; }
+  /* -- Return id and thread name ------------------------------------------ */
+  size_t ProfileRingGetId() const { return stId; }
+  const StdString &ProfileRingGetName() const { return strName; }
+  /* -- Constructor -------------------------------------------------------- */
+  ProfileRing(const size_t stNId, const StdStringView &ssvName) :
+    /* -- Initialisers ----------------------------------------------------- */
+    eEvents{},                         // No zones in the ring
+    atHead(0),                         // No zones written yet
+    abOwned(true),                     // Owned by the thread creating it
+    uDepth(0),                         // Not in a zone yet
+    stId(stNId),                       // Set id of the ring
+    strName{ ssvName }                 // Set name of the thread
+    /* -- No code ---------------------------------------------------------- */
+    {}
+};/* ----------------------------------------------------------------------- */
+class Profile;                         // Class prototype
+static Profile *cProfile = nullptr;    // Address of global class
+/* -- Profiler data for the current thread --------------------------------- */
+struct ProfileThread                   // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  ProfileRing     *prRing;             // Ring the thread writes to
+  StdString        strName;            // Name of the thread
+  /* -- Give the ring back when the thread exits --------------------------- */
+  ~ProfileThread() { if(prRing && cProfile) prRing->ProfileRingRelease(); }
+};/* ----------------------------------------------------------------------- */
+static thread_local ProfileThread ptThread{ nullptr, "main" };
+/* -- Set the name of the current thread ----------------------------------- */
+static void ProfileSetThreadName(const StdStringView &ssvName)
+  { ptThread.strName = ssvName; }
+/* ------------------------------------------------------------------------- */
+class Profile                          // Members initially private
+{ /* -- Private typedefs --------------------------------------------------- */
+  using Rings = StdList<ProfileRing>;  // Rings (addresses must not change)
+  using Frames = StdArray<uint64_t, 1024>; // Frame start times
+  /* -- Private variables -------------------------------------------------- */
+  MutexLock        mlRings;            // Lock for rings list
+  Rings            rRings;             // Rings for each thread
+  Frames           fFrames;            // Start times of recent frames
+  size_t           stFrames;           // Frames recorded
+  AtomicBool       abEnabled;          // Profiler is recording
+  /* -- Return start time of the oldest of the specified recent frames ----- */
+  uint64_t ProfileGetFrom(const size_t stCount) const
+  { // Everything recorded if no frames were completed or no limit
+    if(stFrames < 2 || !stCount) return 0;
+    // The last frame is still running so clamp to the completed frames we
+    // still know about.
+    const size_t stDone = stFrames - 1,
+      stAvail = UtilMinimum(stDone, fFrames.size() - 1);
+    return fFrames[(stDone - UtilMinimum(stCount, stAvail)) %
+      fFrames.size()];
+  }
+  /* -- Send all zones in the specified recent frames to a callback -------- */
+  template<typename FuncType>
+    void ProfileRead(const size_t stCount, FuncType &&ftCb)
+  { // Time to read from
+    const uint64_t qwFrom = ProfileGetFrom(stCount);
+    // Read each ring
+    mlRings.MutexCall([qwFrom, &ftCb, this](){
+      for(const ProfileRing &prRef : rRings)
+        prRef.ProfileRingRead(qwFrom,
+          [&ftCb, &prRef](const ProfileEvent &peRef)
+            { ftCb(prRef, peRef); });
+    });
+  }
+  /* -- Return if profiler is recording ---------------------------- */ public:
+  bool ProfileIsEnabled() const { return abEnabled; }
+  /* -- Start or stop recording -------------------------------------------- */
+  void ProfileSetEnabled(const bool bState)
+  { // Ignore if not changed
+    if(abEnabled == bState) return;
+    // Set new state and log it
+    abEnabled = bState;
+    cLog->LogDebugExSafe("Profile $.", bState ? "started" : "stopped");
+  }
+  /* -- Return number of frames recorded and rings ------------------------- */
+  size_t ProfileGetFrames() const { return stFrames; }
+  size_t ProfileGetRings()
+    { return mlRings.MutexCall([this](){ return rRings.size(); }); }
+  /* -- A new frame started (engine thread only) --------------------------- */
+  void ProfileFrame()
+  { // Ignore if not recording
+    if(!ProfileIsEnabled()) [[likely]] return;
+    // Record start time of this frame
+    fFrames[stFrames++ % fFrames.size()] = cmHiRes.GetTimeNS<uint64_t>();
+  }
+  /* -- Return a ring for a thread that does not have one yet -------------- */
+  ProfileRing *ProfileAcquire(const StdStringView &ssvName)
+  { // Reuse the ring of a thread that exited or create a new one
+    return mlRings.MutexCall([this, &ssvName](){
+      for(ProfileRing &prRef : rRings)
+        if(prRef.ProfileRingAcquire(ssvName)) return &prRef;
+      return &rRings.emplace_back(rRings.size() + 1, ssvName);
+    });
+  }
+  /* -- Total time and calls of each zone in the specified recent frames --- */
+  StdMap<StdString, StdPair<uint64_t, size_t>>
+    ProfileStats(const size_t stCount)
+  { // Zones to return
+    StdMap<StdString, StdPair<uint64_t, size_t>> mZones;
+    // Add each zone
+    ProfileRead(stCount, [&mZones](const ProfileRing&,
+      const ProfileEvent &peRef)
+    { // Add the time and the call
+      StdPair<uint64_t, size_t> &pZone = mZones[peRef.cpName];
+      pZone.first += peRef.qwEnd - peRef.qwStart;
+      ++pZone.second;
+    }); // Return zones
+    return mZones;
+  }
+  /* -- Write the specified recent frames as a Chrome trace ---------------- */
+  size_t ProfileDump(const size_t stCount, const StdStringView &ssvFile)
+  { // Time to write from
+    const uint64_t qwFrom = ProfileGetFrom(stCount);
+    // Begin the trace
+    StdOStringStream osTrace;
+    osTrace << StdIOSFixed << StdIOSSetPrecision(3) << "{\"traceEvents\":[";
+    // Thread name metadata
+    mlRings.MutexCall([&osTrace, this](){
+      for(const ProfileRing &prRef : rRings)
+        osTrace << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                   "\"tid\":" << prRef.ProfileRingGetId()
+                << ",\"args\":{\"name\":\"" << prRef.ProfileRingGetName()
+                << "\"}},";
+    }); // Frame markers
+    const size_t stAvail = UtilMinimum(stFrames, fFrames.size());
+    for(size_t stIndex = stFrames - stAvail; stIndex < stFrames; ++stIndex)
+    { // Ignore if before the range
+      const uint64_t qwFrame = fFrames[stIndex % fFrames.size()];
+      if(qwFrame < qwFrom) continue;
+      osTrace << "\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,"
+                 "\"tid\":0,\"ts\":"
+              << static_cast<double>(qwFrame - qwFrom) / 1000 << "},";
+    } // Zones
+    size_t stZones = 0;
+    ProfileRead(stCount, [&osTrace, &stZones, qwFrom](
+      const ProfileRing &prRef, const ProfileEvent &peRef)
+    { // Write the complete zone
+      osTrace << "\n{\"name\":\"" << peRef.cpName
+              << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+              << prRef.ProfileRingGetId() << ",\"ts\":"
+              << static_cast<double>(peRef.qwStart - qwFrom) / 1000
+              << ",\"dur\":"
+              << static_cast<double>(peRef.qwEnd - peRef.qwStart) / 1000
+              << "},";
+      ++stZones;
+    }); // Finish the trace and remove the trailing comma
+    StdString strTrace{ osTrace.str() };
+    if(strTrace.back() == ',') strTrace.pop_back();
+    strTrace += "\n]}\n";
+    // Write the trace to disk
+    if(FStream fsTrace{ ssvFile, FM_W_B })
+      fsTrace.FStreamWriteString(strTrace);
+    else XC("Failed to create profile trace file!",
+      "File", ssvFile, "Reason", StrFromErrNo());
+    // Log and return number of zones written
+    cLog->LogInfoExSafe("Profile wrote $ zones to '$'.", stZones, ssvFile);
+    return stZones;
+  }
+  /* -- Default constructor ------------------------------------- */ protected:
+  Profile() :
+    /* -- Initialisers ----------------------------------------------------- */
+    fFrames{},                         // No frames recorded
+    stFrames(0),                       // No frames recorded
+    abEnabled(false)                   // Not recording
+    /* -- Set global pointer to static class ------------------------------- */
+    { cProfile = this; }
+  /* -- Destructor (threads must not use rings after this) ----------------- */
+  ~Profile() { cProfile = nullptr; }
+};/* ----------------------------------------------------------------------- */
+/* -- Return ring for the current thread or null if not recording ---------- */
+static ProfileRing *ProfileGetRing()
+{ // Not recording? (most likely)
+  if(!cProfile || !cProfile->ProfileIsEnabled()) [[likely]] return nullptr;
+  // Return ring already owned by this thread or get one
+  if(ptThread.prRing) return ptThread.prRing;
+  return ptThread.prRing = cProfile->ProfileAcquire(ptThread.strName);
+}
+/* -- Records a zone for the lifetime of the object ------------------------ */
+class ProfileZone                      // Members initially private
+{ /* -- Private variables -------------------------------------------------- */
+  ProfileRing*const prRing;            // Ring to record to (null if off)
+  const char*const cpName;             // Static name of the zone
+  const uint64_t   qwStart;            // Time the zone was entered
+  /* -- Constructor ------------------------------------------------ */ public:
+  explicit ProfileZone(const char*const cpNName) :
+    /* -- Initialisers ----------------------------------------------------- */
+    prRing(ProfileGetRing()),          // Get ring to record to
+    cpName(cpNName),                   // Set zone name
+    qwStart(prRing ?                   // Recording?
+      prRing->ProfileRingBegin() : 0)  // Set start time
+    /* -- No code ---------------------------------------------------------- */
+    {}
+  /* -- Destructor --------------------------------------------------------- */
+  ~ProfileZone() { if(prRing) prRing->ProfileRingEnd(cpName, qwStart); }
+};/* ----------------------------------------------------------------------- */
+}                                      // End of public module namespace
+/* ------------------------------------------------------------------------- */
+}                                      // End of private module namespace
+/* == EoF =========================================================== EoF == */
@@ -3,25 +3,51 @@
 ** ## Mhatxotic Engine          (c) Mhatxotic Design, All Rights Reserved ## **
 ** ######################################################################### **
 ** ## This module defines a class that can load and play sound files      ## **
-** ## using OpenAL's 3D positioning functions.                            ## **
+** ## using OpenAL's 3D positioning functions. Large OGG files can stay   ## **
+** ## compressed in memory and are decoded when played into a few small   ## **
+** ## recycled buffers by the audio thread, just like a stream.           ## **
 ** ######################################################################### **
 ** ========================================================================= */
 #pragma once                           // Only one incursion allowed
 /* ------------------------------------------------------------------------- */
 namespace ISample {                    // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
+using namespace IAsset::P;             using namespace ICodecOGG::P;
 using namespace ICollector::P;         using namespace ICVarDef::P;
-using namespace IError::P;             using namespace ILog::P;
-using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace ILuaUtil::P;           using namespace IMixer::P;
-using namespace IOal::P;               using namespace IPcmDef::P;
-using namespace IPcm::P;               using namespace IStd::P;
-using namespace ISource::P;            using namespace IString::P;
-using namespace ISysUtil::P;           using namespace Lib::OpenAL::Types;
+using namespace IError::P;             using namespace IFileMap::P;
+using namespace ILog::P;               using namespace ILuaIdent::P;
+using namespace ILuaLib::P;            using namespace ILuaUtil::P;
+using namespace IMemory::P;            using namespace IMixer::P;
+using namespace IMutex::P;             using namespace IOal::P;
+using namespace IPcmDef::P;            using namespace IPcm::P;
+using namespace IStd::P;               using namespace ISource::P;
+using namespace IStream::P;            using namespace IString::P;
+using namespace ISysUtil::P;           using namespace Lib::Ogg;
+using namespace Lib::OpenAL::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
+/* -- A compressed sample that is playing ---------------------------------- */
+class Sample;                          // Sample class prototype
+struct SampleVoice                     // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  const Sample    *sPtr;               // Sample being played
+  OggMemView       omvData;            // Decoder view of compressed data
+  OggVorbis_File   ovfContext;         // Ogg vorbis decoder context
+  Source          *sCptr;              // Locked source to stream to
+  ALUIntVector     aluvBuffers;        // Buffers owned by this voice
+  ALfloat          alfGain;            // Gain requested by the player
+  bool             bLoop;              // Rewind when the end is reached
+};/* ----------------------------------------------------------------------- */
+using SampleVoiceList = StdList<SampleVoice>;   // List of playing voices
+using SampleVoiceListIt = SampleVoiceList::iterator; // Iterator of voices
 /* -- Sample collector and member class ------------------------------------ */
-CTOR_BEGIN_NOBB(Samples, Sample, CLHelperUnsafe)
+CTOR_BEGIN(Samples, Sample, CLHelperUnsafe,
+/* -- Public variables ----------------------------------------------------- */
+MutexLock          mlVoices;           // Serialise voices with audio thread
+SampleVoiceList    svlVoices;          // Compressed samples playing
+ALUIntVector       aluvFree;           // Recycled voice buffers
+Memory             mDecode;            // Voice decoding workspace
+size_t             stCompress;);       // Decoded size to keep compressed
 /* -- Sample member class -------------------------------------------------- */
 CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
   /* -- Base classes ------------------------------------------------------- */
@@ -30,6 +56,8 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
   ALUIntVector      aluvNames;         // OpenAL buffer handle ids
   ALenum            aleFormat,         // Format type for openal
                     aleSFormat;        // Single channel format for openal
+  FileMap           fmOgg;             // Compressed data (if compressed)
+  ALdouble          dDuration;         // Duration (if compressed)
   /* ----------------------------------------------------------------------- */
   ALenum GetFormat() const { return aleFormat; }
   /* ----------------------------------------------------------------------- */
@@ -57,26 +85,183 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
   ALsizei GetALSize() const
     { return GetBufferInt<ALsizei>(AL_SIZE); }
   ALdouble GetDuration() const
-    { return static_cast<ALdouble>(GetALSize()) * 8 /
+    { return IsCompressed() ? dDuration :
+        static_cast<ALdouble>(GetALSize()) * 8 /
         GetALChannels() / GetALBits() / GetALFrequency(); }
+  /* -- Return if sample is kept compressed -------------------------------- */
+  bool IsCompressed() const { return fmOgg.FileMapOpened(); }
+  bool IsNotCompressed() const { return !IsCompressed(); }
+  /* -- Return format a voice decodes to ----------------------------------- */
+  ALenum GetVoiceFormat() const
+    { return PcmDataGetChannels() == PCT_MONO ?
+        (cOal->Have32FPPB() ? AL_FORMAT_MONO_FLOAT32 : AL_FORMAT_MONO16) :
+        (cOal->Have32FPPB() ? AL_FORMAT_STEREO_FLOAT32 : AL_FORMAT_STEREO16);
+    }
+  /* -- Decode the next part of a voice into a buffer ---------------------- */
+  bool VoiceDoRebuffer(SampleVoice &svRef, const ALuint aluBuffer) const
+  { // Decoding workspace shared by all voices and channels as size_t
+    Memory &mDecode = cSamples->mDecode;
+    const size_t stChannels = static_cast<size_t>(PcmDataGetChannels());
+    // Bytes decoded and if we rewound without decoding anything
+    size_t stPos = 0;
+    bool bRewound = false;
+    // Until the workspace is filled
+    while(stPos < mDecode.MemSize())
+    { // Decode as floats if supported else as shorts
+      long lResult;
+      if(cOal->Have32FPPB())
+      { // Read frames and convert them to interleaved floats if succeeded
+        ALfloat **alfpaPCM;
+        lResult = ov_read_float(&svRef.ovfContext, &alfpaPCM,
+          static_cast<int>((mDecode.MemSize() - stPos) / stChannels /
+            sizeof(ALfloat)), nullptr);
+        if(lResult > 0)
+        { // Convert the frames and set the bytes they took up
+          cCodecOGG->F32FromVorbisFrames(alfpaPCM,
+            static_cast<size_t>(lResult), stChannels,
+            mDecode.MemRead<ALfloat>(stPos));
+          lResult *= static_cast<long>(sizeof(ALfloat) * stChannels);
+        }
+      } // Decode to shorts
+      else lResult = ov_read(&svRef.ovfContext, mDecode.MemRead(stPos),
+        static_cast<int>(mDecode.MemSize() - stPos), 0, sizeof(ALshort), 1,
+        nullptr);
+      // Error?
+      if(lResult < 0)
+        XC("Failed to decode compressed sample!",
+          "Name",   NameGet(), "Result", lResult,
+          "Reason", cCodecOGG->GetOggErr(lResult));
+      // Add bytes decoded and decode more if we got some
+      if(lResult) { stPos += static_cast<size_t>(lResult); bRewound = false;
+                    continue; }
+      // End of data so done if not looping or the sample is empty
+      if(!svRef.bLoop || bRewound) break;
+      // Rewind to the start and decode more
+      ov_pcm_seek(&svRef.ovfContext, 0);
+      bRewound = true;
+    } // Return failure if nothing was decoded
+    if(!stPos) return false;
+    // Buffer the PCM data
+    AL(cOal->BufferData(aluBuffer, GetVoiceFormat(), mDecode.MemPtr<ALvoid>(),
+      static_cast<ALsizei>(stPos),
+      static_cast<ALsizei>(PcmDataGetRate())),
+      "Failed to buffer compressed sample data!",
+      "Name", NameGet(), "Buffer", aluBuffer, "Size", stPos);
+    // Success
+    return true;
+  }
+  /* -- Decode the next part of a voice or end the voice if failed --------- */
+  bool VoiceRebuffer(SampleVoice &svRef, const ALuint aluBuffer) const
+  { // Capture exceptions because this is called from the audio thread
+    try { return VoiceDoRebuffer(svRef, aluBuffer); }
+    catch(const StdException &eReason)
+    { // Log the error and end the voice
+      cLog->LogWarningExSafe("Sample '$' voice ended because $",
+        NameGet(), eReason.what());
+      return false;
+    }
+  }
+  /* -- Finish a voice and recycle its buffers (mlVoices locked) ----------- */
+  static SampleVoiceListIt VoiceEnd(const SampleVoiceListIt svlIt)
+  { // Get voice and if it has a source?
+    SampleVoice &svRef = *svlIt;
+    if(svRef.sCptr)
+    { // Stop the source, unqueue its buffers and let it be recycled
+      svRef.sCptr->StopAndUnQueueAllBuffers();
+      svRef.sCptr->Unlock();
+    } // Return the buffers to the free list
+    ALUIntVector &aluvFree = cSamples->aluvFree;
+    aluvFree.insert(aluvFree.cend(), svRef.aluvBuffers.cbegin(),
+      svRef.aluvBuffers.cend());
+    // Close the decoder and remove the voice
+    if(svRef.ovfContext.datasource) ov_clear(&svRef.ovfContext);
+    return cSamples->svlVoices.erase(svlIt);
+  }
+  /* -- Update a voice from the audio thread (mlVoices locked) ------------- */
+  bool VoiceUpdate(SampleVoice &svRef) const
+  { // Get source and for each buffer that has finished playing
+    const Source &sRef = *svRef.sCptr;
+    for(ALsizei alsiProcessed = sRef.GetBuffersProcessed();
+        alsiProcessed > 0; --alsiProcessed)
+    { // Unqueue the buffer and refill and queue it again if we can
+      const ALuint aluBuffer = svRef.sCptr->UnQueueBuffer();
+      if(VoiceRebuffer(svRef, aluBuffer)) sRef.QueueBuffer(aluBuffer);
+    } // Voice is finished if nothing is queued anymore
+    if(!sRef.GetBuffersQueued()) return false;
+    // Resume if the source ran out of data before we could refill it
+    if(!sRef.IsPlaying()) svRef.sCptr->Play();
+    // Voice still playing
+    return true;
+  }
+  /* -- Play a compressed sample as a new voice ---------------------------- */
+  void PlayVoice(const ALfloat alfGain, const ALfloat alfPan,
+    const ALfloat alfPitch, const bool bLoop, const unsigned uPriority)
+  { // Serialise with the audio thread
+    cSamples->mlVoices.MutexCall(
+      [this, alfGain, alfPan, alfPitch, bLoop, uPriority](){
+      // Get a free source and lock it
+      Source*const sCptr = GetSource(uPriority);
+      if(!sCptr)
+        return cLog->LogWarningExSafe(
+          "Sample cannot get a free source for playing '$'!", NameGet());
+      // Set the source parameters before any buffers are queued to it
+      PrepareSource(*sCptr, 0, alfGain * cMixer->MixerGetAdjSampleVolume(),
+        alfPan, alfPitch, false, uPriority);
+      // Add a new voice and open a decoder on the compressed data
+      SampleVoice &svRef = cSamples->svlVoices.emplace_back();
+      svRef.sPtr = this;
+      svRef.omvData = { &fmOgg, 0 };
+      svRef.sCptr = sCptr;
+      svRef.alfGain = alfGain;
+      svRef.bLoop = bLoop;
+      if(const int iResult = ov_open_callbacks(&svRef.omvData,
+           &svRef.ovfContext, nullptr, 0, cCodecOGG->GetViewCallbacks()))
+      { // Remove the voice and throw error
+        VoiceEnd(StdPrev(cSamples->svlVoices.end()));
+        XC("Init compressed sample decoder failed!",
+          "Name",   NameGet(), "Code", iResult,
+          "Reason", cCodecOGG->GetOggErr(iResult));
+      } // Make sure the decoding workspace is allocated
+      Memory &mDecode = cSamples->mDecode;
+      if(mDecode.MemSize() != cStreams->stBufSize)
+        mDecode.MemInitBlank(cStreams->stBufSize);
+      // Fill as many recycled buffers as we are allowed to
+      ALUIntVector &aluvFree = cSamples->aluvFree;
+      while(svRef.aluvBuffers.size() < cStreams->stBufCount)
+      { // Reuse a free buffer or generate a new one
+        ALuint aluBuffer;
+        if(aluvFree.empty()) aluBuffer = cOal->CreateBuffer();
+        else { aluBuffer = aluvFree.back(); aluvFree.pop_back(); }
+        svRef.aluvBuffers.push_back(aluBuffer);
+        // Done if there is no more data to decode
+        if(!VoiceRebuffer(svRef, aluBuffer)) break;
+        // Queue the buffer
+        sCptr->QueueBuffer(aluBuffer);
+      } // Nothing queued? Remove the voice because there is nothing to play
+      if(!sCptr->GetBuffersQueued())
+        return static_cast<void>(VoiceEnd(StdPrev(cSamples->svlVoices.end())));
+      // Play the buffers
+      sCptr->Play();
+    });
+  }
   /* -- Unload buffers ----------------------------------------------------- */
   void UnloadBuffer()
-  { // Bail if buffers not allocated
-    if(aluvNames.empty()) return;
-    // Stop this sample from playing in its entirety
+  { // Stop this sample from playing in its entirety
     if(const unsigned uStopped = Stop())
       cLog->LogDebugExSafe("Sample '$' cleared $ sources using it!",
         NameGet(), uStopped);
+    // Bail if buffers not allocated
+    if(aluvNames.empty()) return;
     // Delete the buffers
     ALL(cOal->DeleteBuffers(aluvNames),
       "Sample '$' failed to delete $ buffers", NameGet(), aluvNames.size());
     // Reset buffer
     aluvNames.clear();
   }
-  /* ----------------------------------------------------------------------- */
+  /* -- Set source parameters (source stays external until played) --------- */
   ALuint PrepareSource(Source &scSource, const ALuint aluBufId,
     const ALfloat alfGain, const ALfloat alfPan, const ALfloat alfPitch,
-    const bool bLoop, const bool bLuaManaged)
+    const bool bLoop, const unsigned uPriority)
   { // Set parameters
     scSource.SetBuffer(static_cast<ALint>(aluBufId));
     scSource.SetRelative(true);
@@ -84,14 +269,14 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
     scSource.SetLooping(bLoop);
     scSource.SetPitch(alfPitch);
     scSource.SetGain(alfGain);
-    scSource.SetExternal(bLuaManaged);
+    scSource.SetPriority(uPriority);
     // Return source id
     return scSource.GetSource();
   }
   /* ----------------------------------------------------------------------- */
   void PlayStereoSource(ALfloat alfGain, ALfloat alfPan,
     const ALfloat alfPitch, const bool bLoop, Source &sCLref, Source &sCRref,
-    const bool bLuaManaged)
+    const bool bLuaManaged, const unsigned uPriority)
   { // Adjust gain from global volumes
     alfGain *= cMixer->MixerGetAdjSampleVolume();
     // Half the pan
@@ -100,24 +285,38 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
     const StdArray<const ALuint,2> aSourceIds{
       // [0] Left channel
       PrepareSource(sCLref, aluvNames.front(), alfGain, -0.5f + alfPan,
-        alfPitch, bLoop, bLuaManaged),
+        alfPitch, bLoop, uPriority),
       // [1] Right channel
       PrepareSource(sCRref, aluvNames.back(), alfGain, 0.5f + alfPan,
-        alfPitch, bLoop, bLuaManaged)
+        alfPitch, bLoop, uPriority)
     }; // Play all the sources together
     ALL(cOal->PlaySources(aSourceIds),
       "Sample '$' failed to play stereo sources!", NameGet());
+    // Let the audio thread recycle them when they finish if not Lua managed
+    if(bLuaManaged) return;
+    sCLref.SetExternal(false);
+    sCRref.SetExternal(false);
   }
   /* -- Play a mono source ------------------------------------------------- */
   void PlayMonoSource(const ALfloat alfGain, ALfloat alfPan,
     const ALfloat alfPitch, const bool bLoop, Source &sCMref,
-    const bool bLuaManaged)
-  { ALL(cOal->PlaySource(PrepareSource(sCMref, aluvNames.front(),
+    const bool bLuaManaged, const unsigned uPriority)
+  { // Prepare and play the source
+    ALL(cOal->PlaySource(PrepareSource(sCMref, aluvNames.front(),
       alfGain * cMixer->MixerGetAdjSampleVolume(), alfPan, alfPitch, bLoop,
-      bLuaManaged)), "Sample '$' failed to play mono source!", NameGet()); }
+      uPriority)), "Sample '$' failed to play mono source!", NameGet());
+    // Let the audio thread recycle it when it finishes if not Lua managed
+    if(!bLuaManaged) sCMref.SetExternal(false);
+  }
   /* -- Spawn new sources in Lua ------------------------------------------- */
   size_t Spawn(lua_State*const lS)
-  { // How many sources do we need?
+  { // Compressed samples have no buffers that can be attached to a source
+    if(IsCompressed())
+    { // Log the failure and return no sources
+      cLog->LogWarningExSafe("Sample cannot spawn sources for compressed "
+        "sample '$'!", NameGet());
+      return 0;
+    } // How many sources do we need?
     switch(aluvNames.size())
     { // 1? (Mono source?) Create a new mono source and set buffer if succeeded
       case 1: if(const Source*const sCMptr = SourceGetFromLua(lS))
@@ -147,23 +346,28 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
   }
   /* ----------------------------------------------------------------------- */
   void Play(const ALfloat alfGain, const ALfloat alfPan,
-    const ALfloat alfPitch, const bool bLoop)
-  { // How many sources do we need?
+    const ALfloat alfPitch, const bool bLoop, const unsigned uPriority=0)
+  { // Compressed sample? Play it as a new voice
+    if(IsCompressed())
+      return PlayVoice(alfGain, alfPan, alfPitch, bLoop, uPriority);
+    // How many sources do we need?
     switch(aluvNames.size())
     { // 1? (Mono source?) Create a new mono source and if we got it? Play it!
-      case 1: if(Source*const sCMptr = GetSource())
+      case 1: if(Source*const sCMptr = GetSource(uPriority))
                 PlayMonoSource(alfGain, alfPan, alfPitch, bLoop, *sCMptr,
-                  false);
+                  false, uPriority);
               break;
       // 2? (Stereo sources) Get the left channel and if we got it?
-      case 2: if(Source*const sCLptr = GetSource())
+      case 2: if(Source*const sCLptr = GetSource(uPriority))
               { // Get a right channel source and if we got it? Play it
-                if(Source*const sCRptr = GetSource())
+                if(Source*const sCRptr = GetSource(uPriority))
                   PlayStereoSource(alfGain, alfPan, alfPitch, bLoop,
-                    *sCLptr, *sCRptr, false);
-                // Could not grab a right channel source? Log failure
-                else cLog->LogWarningExSafe("Sample cannot get a free source "
-                  "for playing '$' left channel!", NameGet());
+                    *sCLptr, *sCRptr, false, uPriority);
+                // Could not grab a right channel source? Release the left
+                // channel source and log failure
+                else { sCLptr->Unlock();
+                       cLog->LogWarningExSafe("Sample cannot get a free "
+                         "source for playing '$' left channel!", NameGet()); }
               } // Could not grab a left channel source? Log failure
               else cLog->LogWarningExSafe("Sample cannot get a free source "
                 "for playing '$' right channel!", NameGet());
@@ -179,14 +383,18 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
   }
   /* -- Play with a pre-allocated sources by Lua --------------------------- */
   size_t Play(lua_State*const lS, const ALfloat alfGain, const ALfloat alfPan,
-    const ALfloat alfPitch, const bool bLoop)
-  { // How many sources do we need?
+    const ALfloat alfPitch, const bool bLoop, const unsigned uPriority=0)
+  { // Compressed sample? Play it as a new voice that the engine manages
+    if(IsCompressed())
+      { PlayVoice(alfGain, alfPan, alfPitch, bLoop, uPriority); return 0; }
+    // How many sources do we need?
     switch(aluvNames.size())
     { // 1 (Mono source?)?
       case 1:
         // Create a new mono source and if we got it? Play it
-        if(Source*const sCMptr = SourceGetFromLua(lS))
-          PlayMonoSource(alfGain, alfPan, alfPitch, bLoop, *sCMptr, true);
+        if(Source*const sCMptr = SourceGetFromLua(lS, uPriority))
+          PlayMonoSource(alfGain, alfPan, alfPitch, bLoop, *sCMptr, true,
+            uPriority);
         // Could not grab a mono channel source? Log failure
         else cLog->LogWarningExSafe(
           "Sample cannot get a free source for playing '$'!", NameGet());
@@ -194,11 +402,11 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
       // 2 (Stereo sources)?
       case 2:
         // Get the left channel and if we got it?
-        if(Source*const sCLptr = SourceGetFromLua(lS))
+        if(Source*const sCLptr = SourceGetFromLua(lS, uPriority))
         { // Get a right channel source and if we got it? Play sources
-          if(Source*const sCRptr = SourceGetFromLua(lS))
+          if(Source*const sCRptr = SourceGetFromLua(lS, uPriority))
             PlayStereoSource(alfGain, alfPan, alfPitch, bLoop, *sCLptr,
-              *sCRptr, true);
+              *sCRptr, true, uPriority);
           // Could not grab a right channel source? Log failure
           else cLog->LogWarningExSafe(
             "Sample cannot get a free source for playing '$' left channel!",
@@ -222,7 +430,21 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
     return aluvNames.size();
   }
   /* == Stop the buffer ==================================================== */
-  unsigned Stop() const { return SourceStop(aluvNames); }
+  unsigned Stop() const
+  { // Stop sources playing the uncompressed buffers
+    unsigned uStopped = SourceStop(aluvNames);
+    // Done if not compressed
+    if(IsNotCompressed()) return uStopped;
+    // End all the voices playing this sample
+    cSamples->mlVoices.MutexCall([this, &uStopped](){
+      SampleVoiceList &svlVoices = cSamples->svlVoices;
+      for(SampleVoiceListIt svlIt{ svlVoices.begin() };
+                            svlIt != svlVoices.end();)
+        if(svlIt->sPtr != this) ++svlIt;
+        else { svlIt = VoiceEnd(svlIt); ++uStopped; }
+    }); // Return number of sources stopped
+    return uStopped;
+  }
   /* -- Load a single buffer from memory ----------------------------------- */
   void LoadSample(Pcm &pcmSrc)
   { // Allocate and generate openal buffers
@@ -264,7 +486,9 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
   }
   /* -- Load a single buffer ----------------------------------------------- */
   void ReloadSample()
-  { // If pcm sample was not loaded from disk? Just (re)load the bitmap data
+  { // Compressed samples have nothing to upload as voices decode on play
+    if(IsCompressed()) return;
+    // If pcm sample was not loaded from disk? Just (re)load the bitmap data
     // that already should be there and should NEVER be released.
     if(PcmDataIsDynamic()) LoadSample(*this);
     // Pcm sample is static?
@@ -278,6 +502,30 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
     } // Show what was loaded
     cLog->LogInfoExSafe("Sample loaded '$'!", NameGet());
   }
+  /* -- Keep the original ogg file instead of the decoded data ------------- */
+  bool InitCompressed()
+  { // Load the file again and ignore if it is not an ogg file
+    FileMap fmData{ AssetExtract(NameGet()) };
+    if(fmData.MemSize() < 4 || fmData.FileMapReadVar32LE() != 0x5367674FUL)
+      return false;
+    // Open a decoder on it to check it and get its duration
+    OggMemView omvData{ &fmData, 0 };
+    OggVorbis_File ovfContext;
+    if(const int iResult = ov_open_callbacks(&omvData, &ovfContext, nullptr,
+         0, cCodecOGG->GetViewCallbacks()))
+      XC("Init compressed sample decoder failed!",
+        "Name",   NameGet(), "Code", iResult,
+        "Reason", cCodecOGG->GetOggErr(iResult));
+    dDuration = ov_time_total(&ovfContext, -1);
+    ov_clear(&ovfContext);
+    // Keep the compressed data and remove the decoded data
+    fmOgg.FileMapSwap(fmData);
+    cLog->LogDebugExSafe("Sample '$' kept compressed as $ bytes instead of "
+      "$ bytes.", NameGet(), fmOgg.MemSize(), PcmDataGetAlloc());
+    PcmDataClearData();
+    // Success
+    return true;
+  }
   /* -- Init from a bitmap class ------------------------------------------- */
   void InitSample(Pcm &pcmSrc)
   { // Show filename progress
@@ -296,6 +544,9 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
     if(this != &pcmSrc) { PcmSwap(pcmSrc); NameSwap(pcmSrc); }
     // Set purpose of the PCM object as a sample
     FlagSet(PP_SAMPLE);
+    // Keep large ogg files compressed if they were loaded from a file
+    if(PcmDataIsNotDynamic() && cSamples->stCompress &&
+       PcmDataGetAlloc() >= cSamples->stCompress && InitCompressed()) return;
     // Initialise
     LoadSample(*this);
     // Remove all sample data because we can just load it from file again
@@ -307,13 +558,35 @@ CTOR_MEM_BEGIN(Samples, Sample, ICHelperUnsafe, /* n/a */),
     /* -- Initialisers ----------------------------------------------------- */
     ICHelperSample{ cSamples, this },  // Initialise collector class
     aleFormat(AL_NONE),                // Format not initialised
-    aleSFormat(AL_NONE)                // Single channel format not initialised
+    aleSFormat(AL_NONE),               // Single channel format not initialised
+    dDuration(0.0)                     // No compressed duration yet
     /* -- No code ---------------------------------------------------------- */
     {}
   /* -- Destructor --------------------------------------------------------- */
   DTORHELPER(~Sample, UnloadBuffer())
 };/* -- End ---------------------------------------------------------------- */
-CTOR_END_NOINITS(Samples, Sample, SAMPLE) // Finish collector class
+CTOR_END(Samples, Sample, SAMPLE,,,,  // Finish collector class
+  stCompress(0))                       // Never keep samples compressed
+/* == Manage compressed samples for audio thread =========================== */
+static void SampleManage()
+{ // Lock access to voices list and update each voice removing finished ones
+  cSamples->mlVoices.MutexCall([](){
+    SampleVoiceList &svlVoices = cSamples->svlVoices;
+    for(SampleVoiceListIt svlIt{ svlVoices.begin() };
+                          svlIt != svlVoices.end();)
+      if(svlIt->sPtr->VoiceUpdate(*svlIt)) ++svlIt;
+      else svlIt = Sample::VoiceEnd(svlIt);
+  });
+}
+/* == End all compressed sample voices ===================================== */
+static void SampleEndVoices()
+{ // Lock access to voices list and end every voice so their sources are
+  // released and their buffers are returned to the free list.
+  cSamples->mlVoices.MutexCall([](){
+    SampleVoiceList &svlVoices = cSamples->svlVoices;
+    while(!svlVoices.empty()) Sample::VoiceEnd(svlVoices.begin());
+  });
+}
 /* ========================================================================= */
 static void SampleStop()
 { // Stop all samples from playing
@@ -322,14 +595,21 @@ static void SampleStop()
 }
 /* ========================================================================= */
 static void SampleDeInit()
-{ // Done if empty
-  if(cSamples->empty()) return;
-  // Re-create buffers for all the samples and log pre/post de-init
-  cLog->LogDebugExSafe("Samples de-initialising $ objects...",
-    cSamples->size());
-  for(Sample*const scPtr : *cSamples) scPtr->UnloadBuffer();
-  cLog->LogInfoExSafe("Samples de-initialised $ objects.",
-    cSamples->size());
+{ // End all voices so their buffers are returned to the free list
+  SampleEndVoices();
+  // Unload buffers for all the samples and log pre/post de-init
+  if(!cSamples->empty())
+  { cLog->LogDebugExSafe("Samples de-initialising $ objects...",
+      cSamples->size());
+    for(Sample*const scPtr : *cSamples) scPtr->UnloadBuffer();
+    cLog->LogInfoExSafe("Samples de-initialised $ objects.",
+      cSamples->size()); }
+  // Delete recycled voice buffers now that every voice has ended
+  if(cSamples->aluvFree.empty()) return;
+  ALL(cOal->DeleteBuffers(cSamples->aluvFree),
+    "Sample failed to delete $ free voice buffers!",
+    cSamples->aluvFree.size());
+  cSamples->aluvFree.clear();
 }
 /* ========================================================================= */
 static void SampleReInit()
@@ -355,6 +635,12 @@ static void SampleUpdateVolume()
       scRef.SetGain(cMixer->MixerGetAdjSampleVolume());
     }
   });
+  // Update the volume of the compressed samples playing
+  cSamples->mlVoices.MutexCall([](){
+    for(const SampleVoice &svRef : cSamples->svlVoices)
+      svRef.sCptr->SetGain(svRef.alfGain *
+        cMixer->MixerGetAdjSampleVolume());
+  });
 }
 /* == Set all streams base volume ========================================== */
 static CVarReturn SampleSetVolume(const ALfloat alfVolume)
@@ -367,6 +653,9 @@ static CVarReturn SampleSetVolume(const ALfloat alfVolume)
   // Success
   return ACCEPT;
 }
+/* == Set decoded size a sample needs to be to be kept compressed ========== */
+static CVarReturn SampleSetCompress(const size_t stNewSize)
+  { return CVarSimpleSetInt(cSamples->stCompress, stNewSize); }
 /* ------------------------------------------------------------------------- */
 }                                      // End of public module namespace
 /* ------------------------------------------------------------------------- */
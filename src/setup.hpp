@@ -230,6 +230,7 @@ extern "C" { int z_verbose = 0, z_error = 0; } // Z-Lib API requires this
 #include <array>                       // Static arrays
 #include <atomic>                      // Multithreaded integers
 #include <cctype>                      // Character type functions
+#include <charconv>                    // Number to character conversion
 #include <clocale>                     // Regional specific functions
 #include <cmath>                       // Perform mathematical functions
 #include <condition_variable>          // Synchronisation conditions
@@ -364,6 +365,8 @@ namespace Lib                          // LIBRARY OF EXTERNAL API FUNCTIONS
 #  include <sys/wait.h>                // For waiting for pid
 #  include <sys/fcntl.h>               // File control macros
 #  include <sys/types.h>               // Socket types
+#  include <sys/epoll.h>               // Socket reactor events
+#  include <poll.h>                    // Idle connection checks
 #  undef Bool                          // Causes problem with FreeType
 #  define GLFW_EXPOSE_NATIVE_X11       // Expose X11 specific funcs in GLFW
 #  define GLFW_EXPOSE_NATIVE_WAYLAND   // Expose Wayland specific funcs in GLFW
@@ -388,6 +391,7 @@ namespace Lib                          // LIBRARY OF EXTERNAL API FUNCTIONS
 #  include <fcntl.h>                   // File control macros
 #  include <termios.h>                 // For changing terminal settings
 #  include <libproc.h>                 // For getting program executable
+#  include <poll.h>                    // Socket reactor events
 #  define _XOPEN_SOURCE_EXTENDED       // Unlock extended ncurses functionality
      using __sighandler_t = void (*)(int); // For signal() on MacOS
 #  define GLFW_EXPOSE_NATIVE_COCOA     // Expose Cocoa specific funcs in GLFW
@@ -454,8 +458,11 @@ namespace Lib                          // LIBRARY OF EXTERNAL API FUNCTIONS
         using GlFW::GLfloat;           // GL specific float type
         using GlFW::GLint;             // GL specific int type
         using GlFW::GLsizei;           // GL specific sizei type
+        using GlFW::GLsizeiptr;        // GL specific buffer size type
+        using GlFW::GLsync;            // GL specific sync object type
         using GlFW::GLubyte;           // GL specific unsigned char type
         using GlFW::GLuint;            // GL specific unsigned type
+        using GlFW::GLuint64;          // GL specific 64-bit unsigned type
         using GlFW::GLvoid;            // GL specific void type
       } /* ----------------------------------------------------------------- */
 #if defined(MACOS)                     // MacOS defined?
@@ -14,18 +14,19 @@ using namespace ICollector::P;         using namespace ICommon::P;
 using namespace ICrypt::P;             using namespace ICVar::P;
 using namespace ICVarDef::P;           using namespace ICVarLib::P;
 using namespace IError::P;             using namespace IEvtMain::P;
-using namespace IFlags::P;             using namespace ILockable::P;
-using namespace ILog::P;               using namespace ILuaBase::P;
-using namespace ILuaEvt::P;            using namespace ILuaIdent::P;
-using namespace ILuaLib::P;            using namespace ILuaUtil::P;
-using namespace IMemory::P;            using namespace IMutex::P;
-using namespace IName::P;              using namespace IParser::P;
-using namespace IRefCtr::P;            using namespace ISerial::P;
-using namespace IStd::P;               using namespace IString::P;
-using namespace ISystem::P;            using namespace ISysUtil::P;
-using namespace IThread::P;            using namespace IToken::P;
-using namespace IUtil::P;              using namespace IUtf::P;
-using namespace Lib::OS::OpenSSL;
+using namespace IFlags::P;             using namespace IFStream::P;
+using namespace ILockable::P;          using namespace ILog::P;
+using namespace ILuaBase::P;           using namespace ILuaEvt::P;
+using namespace ILuaIdent::P;          using namespace ILuaLib::P;
+using namespace ILuaUtil::P;           using namespace IMemory::P;
+using namespace IMutex::P;             using namespace IName::P;
+using namespace IParser::P;            using namespace IRefCtr::P;
+using namespace ISerial::P;            using namespace IStd::P;
+using namespace IString::P;            using namespace ISystem::P;
+using namespace ISysUtil::P;           using namespace IThread::P;
+using namespace IToken::P;             using namespace IUtil::P;
+using namespace IUtf::P;               using namespace Lib::OS;
+using namespace Lib::OS::OpenSSL;      using namespace Lib::OS::ZLib;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Connection flags ----------------------------------------------------- */
@@ -49,7 +50,425 @@ BUILD_SECURE_FLAGS(Socket,
   SS_EVENTERROR            {Flag(13)}, // Set if error with event callback?
   SS_READPACKET            {Flag(14)}, // Socket read a packet (not ever set)?
   SS_PONG                  {Flag(15)}  // Pong from WebSocket?
-);/* == Socket collector class for collector data and custom variables ===== */
+);/* -- Prototypes --------------------------------------------------------- */
+class Socket;                          // Class prototype
+static ThreadStatus SocketReactorThreadMain(Thread&); // Reactor event loop
+/* == Shared event thread driving many non-blocking sockets ================ **
+** Instead of each socket blocking in its own reader and writer thread, the  **
+** sockets assigned to a reactor are switched to non-blocking mode and this  **
+** one thread waits on all of their descriptors at once (epoll on Linux and  **
+** poll on MacOS) and steps each ready socket's OpenSSL state machine.       **
+** ------------------------------------------------------------------------- */
+struct SocketReactor                   // Members initially public
+{ /* -- Types -------------------------------------------------------------- */
+  enum Want : unsigned                 // Events a socket is waiting for
+  { /* --------------------------------------------------------------------- */
+    RW_NONE,                           // [0] Not waiting on the descriptor
+    RW_READ,                           // [1] Waiting to read
+    RW_WRITE,                          // [2] Waiting to write
+    RW_BOTH                            // [3] Waiting to read or write
+  };/* --------------------------------------------------------------------- */
+  struct Item                          // Socket driven by the reactor
+  { /* --------------------------------------------------------------------- */
+    Socket        *sPtr;               // Pointer to the socket
+    int            iFd;                // Descriptor waited on
+    unsigned       uWant;              // Events waited for
+    bool           bClose;             // Close requested while stepping
+  };/* --------------------------------------------------------------------- */
+  using ItemMap = StdMap<uint64_t, Item>; // Socket serial to socket
+  using ItemMapIt = ItemMap::iterator; // Iterator to a socket
+  using SerialList = StdVector<uint64_t>; // List of socket serials
+  /* -- Variables ---------------------------------------------------------- */
+  Thread           tReactor;           // The event thread
+  MutexLock        mSockets,           // Sockets list lock
+                   mWake;              // Wake list lock
+  condition_variable cvStepped;        // Signalled when a step finishes
+  uint64_t         ullStepping;        // Socket being stepped (or none)
+  ItemMap          imSockets;          // Sockets driven by this thread
+  SerialList       slWake;             // Sockets that need stepping
+  SerialList       slReady;            // Sockets with pending events
+  Memory           mBuffer;            // Receive buffer shared by sockets
+  AtomicSizeT      astSockets;         // Sockets driven (for balancing)
+  StdArray<int,2>  iaWake;             // Wake pipe read and write ends
+  int              iPoll;              // Event poll descriptor (epoll)
+  /* -- Wake the event thread ---------------------------------------------- */
+  void ReactorSignal()
+  { // Write a byte to the wake pipe. A full pipe means the thread has already
+    // been signalled so the result does not matter.
+#if !defined(WINDOWS)
+    const char cByte = 0;
+    [[maybe_unused]] const ssize_t sWritten = write(iaWake[1], &cByte, 1);
+#endif
+  }
+  /* -- Ask the event thread to step a socket ------------------------------ */
+  void ReactorWake(const uint64_t ullId)
+  { // Add the socket to the list and only signal if the list was empty
+    if(mWake.MutexCall([this, ullId](){
+      slWake.push_back(ullId);
+      return slWake.size() == 1; })) ReactorSignal();
+  }
+  /* -- Take the list of sockets that asked to be stepped ------------------ */
+  void ReactorTakeWake(SerialList &slDest)
+    { mWake.MutexCall([this, &slDest](){ slDest.swap(slWake); }); }
+  /* -- Discard all pending wake bytes ------------------------------------- */
+  void ReactorDrain()
+  { // Read until the pipe is empty
+#if !defined(WINDOWS)
+    StdArray<char, 64> caBuffer;
+    while(read(iaWake[0], caBuffer.data(), caBuffer.size()) > 0);
+#endif
+  }
+  /* -- Set the descriptor and events to wait on for a socket -------------- */
+  void ReactorSet(Item &iItem, const uint64_t ullId, const int iFd,
+    const unsigned uWant, const bool bForce=false)
+  { // Ignore if nothing changed unless the descriptor may have been recreated
+    if(!bForce && iItem.iFd == iFd && iItem.uWant == uWant) return;
+#if defined(LINUX)
+    // Descriptor changed? Stop waiting on the old one. It might have been
+    // closed already which automatically removes it so ignore errors.
+    if(iItem.iFd != -1 && iItem.iFd != iFd)
+      epoll_ctl(iPoll, EPOLL_CTL_DEL, iItem.iFd, nullptr);
+    // Have a descriptor?
+    if(iFd != -1)
+    { // Setup events to wait for
+      epoll_event eeEvent{};
+      eeEvent.events = (uWant & RW_READ ? EPOLLIN : 0u) |
+                       (uWant & RW_WRITE ? EPOLLOUT : 0u);
+      eeEvent.data.u64 = ullId;
+      // Modify the existing entry and add it if it isn't registered
+      if(iItem.iFd != iFd ||
+         epoll_ctl(iPoll, EPOLL_CTL_MOD, iFd, &eeEvent) == -1)
+        epoll_ctl(iPoll, EPOLL_CTL_ADD, iFd, &eeEvent);
+    }
+#endif
+    // Remember what we are waiting on
+    iItem.iFd = iFd;
+    iItem.uWant = uWant;
+  }
+  /* -- Stop driving a socket (mSockets must be locked) -------------------- */
+  void ReactorRemove(const uint64_t ullId)
+  { // Find the socket and ignore if not driven by us
+    const ItemMapIt imiIt{ imSockets.find(ullId) };
+    if(imiIt == imSockets.end()) return;
+    // Stop waiting on the descriptor and forget the socket
+    ReactorSet(imiIt->second, ullId, -1, RW_NONE);
+    imSockets.erase(imiIt);
+    --astSockets;
+  }
+  /* -- Mark a socket as being stepped and return it if we still drive it -- **
+  ** The item stays valid without the lock as it cannot be removed by other  **
+  ** threads until the step has finished.                                    **
+  ** ----------------------------------------------------------------------- */
+  Item *ReactorStepBegin(const uint64_t ullId)
+  { // Lock the socket list
+    return mSockets.MutexCall([this, ullId]()->Item*{
+      // Find the socket and ignore if not driven by us anymore
+      const ItemMapIt imiIt{ imSockets.find(ullId) };
+      if(imiIt == imSockets.end()) return nullptr;
+      // Mark the socket as being stepped and return it
+      ullStepping = ullId;
+      return &imiIt->second;
+    });
+  }
+  /* -- Finish stepping a socket ------------------------------------------- **
+  ** Returns true if the socket should be closed because another thread      **
+  ** asked while it was being stepped. The socket stays marked as being      **
+  ** stepped until this is called again after it was closed.                 **
+  ** ----------------------------------------------------------------------- */
+  bool ReactorStepEnd(const uint64_t ullId)
+  { // Lock the socket list
+    const bool bClose = mSockets.MutexCall([this, ullId](){
+      // Still driving the socket and a close was requested? Keep it marked
+      const ItemMapIt imiIt{ imSockets.find(ullId) };
+      if(imiIt != imSockets.end() && imiIt->second.bClose) return true;
+      // No longer stepping the socket
+      ullStepping = StdMaxUInt64;
+      return false;
+    });
+    // Wake threads waiting for the step to finish
+    if(!bClose) cvStepped.notify_all();
+    return bClose;
+  }
+  /* -- Start driving a socket --------------------------------------------- */
+  void ReactorAdd(Socket*const sPtr, const uint64_t ullId)
+  { // Register the socket and ask the thread to step it for the first time
+    mSockets.MutexCall([this, sPtr, ullId](){
+      imSockets.insert({ ullId, { sPtr, -1, RW_NONE, false } }); });
+    ++astSockets;
+    ReactorWake(ullId);
+  }
+  /* -- Wait for events and store the sockets that are ready --------------- */
+  void ReactorWait(const int iTimeout)
+  { // Reset list of ready sockets
+    slReady.clear();
+#if defined(LINUX)
+    // Wait for events on any of the descriptors
+    StdArray<epoll_event, 64> eeaEvents;
+    const int iCount = epoll_wait(iPoll, eeaEvents.data(),
+      static_cast<int>(eeaEvents.size()), iTimeout);
+    // Enumerate the events
+    for(int iIndex = 0; iIndex < iCount; ++iIndex)
+    { // Get event and if it was the wake pipe then empty it
+      const epoll_event &eeEvent = eeaEvents[static_cast<size_t>(iIndex)];
+      if(eeEvent.data.u64 == StdMaxUInt64) { ReactorDrain(); continue; }
+      // Step the socket. Errors and hang-ups are picked up by the next read
+      // or write so we don't need to know what the event was.
+      slReady.push_back(eeEvent.data.u64);
+    }
+#elif !defined(WINDOWS)
+    // poll() keeps no state so build the descriptor list every time with
+    // the wake pipe first.
+    StdVector<pollfd> pfdList{ { iaWake[0], POLLIN, 0 } };
+    SerialList slIds;
+    mSockets.MutexCall([this, &pfdList, &slIds](){
+      for(const auto &[ullId, iItem] : imSockets)
+      { // Ignore if not waiting on anything
+        if(iItem.iFd == -1 || iItem.uWant == RW_NONE) continue;
+        // Add descriptor and events to wait for
+        pfdList.push_back({ iItem.iFd, static_cast<short>(
+          (iItem.uWant & RW_READ ? POLLIN : 0) |
+          (iItem.uWant & RW_WRITE ? POLLOUT : 0)), 0 });
+        slIds.push_back(ullId);
+      }
+    });
+    // Wait for events on any of the descriptors and if there were any?
+    if(poll(pfdList.data(), static_cast<nfds_t>(pfdList.size()),
+      iTimeout) <= 0) return;
+    // Empty the wake pipe if it was signalled
+    if(pfdList.front().revents) ReactorDrain();
+    // Step the sockets that had any event
+    for(size_t stIndex = 1; stIndex < pfdList.size(); ++stIndex)
+      if(pfdList[stIndex].revents) slReady.push_back(slIds[stIndex - 1]);
+#else
+    // Not implemented on Windows
+    static_cast<void>(iTimeout);
+#endif
+  }
+  /* -- Close the wake pipe and event poll descriptors --------------------- */
+  void ReactorClose()
+  { // Close the wake pipe
+#if !defined(WINDOWS)
+    for(int &iFd : iaWake) if(iFd != -1) { close(iFd); iFd = -1; }
+    // Close the event poll descriptor
+    if(iPoll != -1) { close(iPoll); iPoll = -1; }
+#endif
+  }
+  /* -- Start the event thread if it is not running ------------------------ */
+  bool ReactorStart(const size_t stIndex, const size_t stBuffer)
+  { // Return success if already running
+    if(tReactor.ThreadIsJoinable()) return true;
+#if defined(WINDOWS)
+    // Not implemented on Windows yet so sockets use their own threads
+    static_cast<void>(stIndex);
+    static_cast<void>(stBuffer);
+    return false;
+#else
+# if defined(LINUX)
+    // Create the event poll descriptor
+    iPoll = epoll_create1(EPOLL_CLOEXEC);
+    if(iPoll == -1) return false;
+# endif
+    // Create the pipe used to wake the thread and make it non-blocking
+    if(pipe(iaWake.data())) { ReactorClose(); return false; }
+    for(const int iFd : iaWake)
+      fcntl(iFd, F_SETFL, fcntl(iFd, F_GETFL) | O_NONBLOCK);
+# if defined(LINUX)
+    // Wait on the wake pipe too
+    epoll_event eeEvent{};
+    eeEvent.events = EPOLLIN;
+    eeEvent.data.u64 = StdMaxUInt64;
+    if(epoll_ctl(iPoll, EPOLL_CTL_ADD, iaWake[0], &eeEvent))
+      { ReactorClose(); return false; }
+# endif
+    // Allocate the receive buffer and start the thread
+    mBuffer.MemInitBlank(stBuffer);
+    tReactor.ThreadInit(StrAppend("socketreactor:", stIndex),
+      SocketReactorThreadMain, this);
+    // Success
+    return true;
+#endif
+  }
+  /* -- Stop the event thread ---------------------------------------------- */
+  void ReactorStop()
+  { // If the thread is running? Tell it to exit, wake it and wait for it
+    if(tReactor.ThreadIsJoinable())
+    { // Set exit flag and wake the thread
+      tReactor.ThreadSetExit();
+      ReactorSignal();
+      // Wait for the thread to finish
+      tReactor.ThreadDeInit();
+    } // Free the descriptors and buffer
+    ReactorClose();
+    mBuffer.MemDeInit();
+  }
+  /* -- Constructor -------------------------------------------------------- */
+  SocketReactor() :
+    /* -- Initialisers ----------------------------------------------------- */
+    tReactor{ STP_LOW },               // Low priority event thread
+    ullStepping(StdMaxUInt64),         // No socket being stepped
+    astSockets(0),                     // No sockets driven
+    iaWake{ { -1, -1 } },              // No wake pipe
+    iPoll(-1)                          // No event poll descriptor
+    /* -- No code ---------------------------------------------------------- */
+    {}
+};/* ----------------------------------------------------------------------- */
+using SocketReactors = StdArray<SocketReactor, 8>; // Reactors available
+/* == Idle keep-alive connections and TLS sessions shared by requests ====== **
+** Connections are keyed by address, port and cipher settings so a request   **
+** only ever reuses a connection that it would have made itself.             **
+** ========================================================================= */
+struct SocketPool
+{ /* -- Types -------------------------------------------------------------- */
+  struct Idle                          // Idle connection
+  { /* --------------------------------------------------------------------- */
+    StdString      strKey;             // Address, port and cipher settings
+    BIO           *bioPtr;             // OpenSSL socket
+    SSL_CTX       *sslctxPtr;          // OpenSSL context
+    SSL           *sslPtr;             // OpenSSL descriptor
+    int            iFd;                // Socket descriptor
+    ClkDuration    cdIdle;             // Time connection became idle
+    StdString      strCipher,          // Cipher negotiated
+                   strIP,              // IP address connected to
+                   strRealHost;        // Real hostname connected to
+  };/* --------------------------------------------------------------------- */
+  using IdleList = StdVector<Idle>;    // List of idle connections
+  using SessionMap = StdMap<StdString, SSL_SESSION*>; // Sessions by server
+  /* -- Variables ---------------------------------------------------------- */
+  MutexLock        mPool;              // Access to idle list and sessions
+  IdleList         ilIdle;             // Idle connections (oldest first)
+  SessionMap       smSessions;         // Last TLS session for each server
+  AtomicDouble     adIdle;             // Seconds a connection can idle
+  AtomicSizeT      astMax;             // Maximum idle connections kept
+  /* -- Close an idle connection ------------------------------------------- */
+  static void PoolFree(Idle &iItem)
+  { // This automatically frees the SSL descriptor and closes the socket
+    if(iItem.bioPtr) BIO_free_all(iItem.bioPtr);
+    if(iItem.sslctxPtr) SSL_CTX_free(iItem.sslctxPtr);
+  }
+  /* -- Close connections idle for too long (mPool must be locked) --------- */
+  void PoolPrune(const ClkDuration cdNow)
+  { // Get oldest time a connection can have become idle and remove all the
+    // connections that have been idle since before then.
+    const ClkDuration cdOldest{ cdNow -
+      duration_cast<ClkDuration>(duration<double>{ adIdle.load() }) };
+    for(auto iIt{ ilIdle.begin() }; iIt != ilIdle.end();)
+      if(iIt->cdIdle < cdOldest) { PoolFree(*iIt); iIt = ilIdle.erase(iIt); }
+      else ++iIt;
+  }
+  /* -- Return if the server closed an idle connection --------------------- */
+  static bool PoolIsStale(const int iFd)
+  { // Check without waiting if there is anything to read or it hung up
+#if !defined(WINDOWS)
+    pollfd pfdItem{ iFd, POLLIN, 0 };
+    const int iResult = poll(&pfdItem, 1, 0);
+    // Error, hung up or invalid? The connection cannot be used
+    if(iResult < 0 ||
+      (iResult && pfdItem.revents & (POLLERR|POLLHUP|POLLNVAL))) return true;
+#else
+    fd_set fdsRead;
+    FD_ZERO(&fdsRead);
+    FD_SET(static_cast<SOCKET>(iFd), &fdsRead);
+    timeval tvWait{ 0, 0 };
+    const int iResult = select(iFd + 1, &fdsRead, nullptr, nullptr, &tvWait);
+    if(iResult < 0) return true;
+#endif
+    // Nothing to read means it is still usable. Readable means the server
+    // closed it (EOF) or sent something we didn't ask for which would be
+    // read as the next response so it can't be used either.
+    return iResult != 0;
+  }
+  /* -- Return if requests should keep connections open -------------------- */
+  bool PoolEnabled() const { return astMax && adIdle > 0; }
+  /* -- Take an idle connection that is still open ------------------------- */
+  bool PoolTake(const StdString &strKey, Idle &iDest)
+  { // Lock the list while we search it
+    return mPool.MutexCall([this, &strKey, &iDest](){
+      // Close connections idle for too long
+      PoolPrune(cmHiRes.GetEpochTime());
+      // Search from the most recently used connection
+      for(size_t stIndex = ilIdle.size(); stIndex--;)
+      { // Ignore if it's not for the same server
+        if(ilIdle[stIndex].strKey != strKey) continue;
+        // Remove it from the list
+        iDest = StdMove(ilIdle[stIndex]);
+        ilIdle.erase(ilIdle.begin() + static_cast<ssize_t>(stIndex));
+        // Use it unless the server closed it while it was idle
+        if(!PoolIsStale(iDest.iFd)) return true;
+        PoolFree(iDest);
+      } // No usable connection
+      return false;
+    });
+  }
+  /* -- Keep a connection open for the next request ------------------------ */
+  bool PoolPut(Idle &&iItem)
+  { // Ignore if disabled
+    if(!PoolEnabled()) return false;
+    // Lock the list while we modify it
+    mPool.MutexCall([this, &iItem](){
+      // Close connections idle for too long
+      const ClkDuration cdNow{ cmHiRes.GetEpochTime() };
+      PoolPrune(cdNow);
+      // Close the oldest connections if we have too many
+      while(!ilIdle.empty() && ilIdle.size() >= astMax)
+        { PoolFree(ilIdle.front()); ilIdle.erase(ilIdle.begin()); }
+      // Add the connection
+      iItem.cdIdle = cdNow;
+      ilIdle.emplace_back(StdMove(iItem));
+    });
+    // Success
+    return true;
+  }
+  /* -- Store the last session negotiated with a server -------------------- */
+  void SessionSet(const StdString &strKey, SSL_SESSION*const sPtr)
+  { // Lock the sessions while we modify them
+    mPool.MutexCall([this, &strKey, sPtr](){
+      // Add the session and replace the old session if there was one
+      const auto [smIt, bInserted] = smSessions.insert({ strKey, sPtr });
+      if(bInserted) return;
+      SSL_SESSION_free(smIt->second);
+      smIt->second = sPtr;
+    });
+  }
+  /* -- Use the last session negotiated with a server ---------------------- */
+  bool SessionApply(const StdString &strKey, SSL*const sslPtr)
+  { // Lock the sessions while we search them
+    return mPool.MutexCall([this, &strKey, sslPtr](){
+      // Find the session and use it for an abbreviated handshake if found
+      const auto smIt{ smSessions.find(strKey) };
+      return smIt != smSessions.cend() &&
+        SSL_set_session(sslPtr, smIt->second) == 1;
+    });
+  }
+  /* -- Close connections not allowed by the current limits ---------------- */
+  void PoolLimit()
+  { // Lock the list while we modify it
+    mPool.MutexCall([this](){
+      // Close connections idle for too long
+      PoolPrune(cmHiRes.GetEpochTime());
+      // Close the oldest connections if we have too many
+      while(ilIdle.size() > astMax)
+        { PoolFree(ilIdle.front()); ilIdle.erase(ilIdle.begin()); }
+    });
+  }
+  /* -- Close all idle connections and forget all sessions ----------------- */
+  void PoolFlush()
+  { // Lock the list and sessions while we clear them
+    mPool.MutexCall([this](){
+      for(Idle &iItem : ilIdle) PoolFree(iItem);
+      ilIdle.clear();
+      for(auto &[strKey, sPtr] : smSessions) SSL_SESSION_free(sPtr);
+      smSessions.clear();
+    });
+  }
+  /* -- Constructor -------------------------------------------------------- */
+  SocketPool() :
+    /* -- Initialisers ----------------------------------------------------- */
+    adIdle(0),                         // No idle timeout
+    astMax(0)                          // No idle connections kept
+    /* -- No code ---------------------------------------------------------- */
+    {}
+};/* ----------------------------------------------------------------------- */
+/* == Socket collector class for collector data and custom variables ======= */
 CTOR_BEGIN(Sockets, Socket, CLHelperUnsafe,
 /* -- Internal registry values for http data ------------------------------- **
 ** We use these key names internally for passing http data around without    **
@@ -78,7 +497,10 @@ AtomicUInt64       aullRX;             // Total bytes received
 AtomicUInt64       aullTX;             // Total bytes sent
 AtomicUInt64       aullRXp;            // Total packets received
 AtomicUInt64       aullTXp;            // Total packets sent
-AtomicSizeT        astConnected;,,     // Total connected sockets
+AtomicSizeT        astConnected;       // Total connected sockets
+SocketReactors     sraReactors;        // Shared socket event threads
+size_t             stReactors;         // Event threads to use (0=disabled)
+SocketPool         spPool;,,           // Keep-alive connections and sessions
 /* -- Derived classes ------------------------------------------------------ */
 public Certs,                          // Certificate store
 private LuaEvtMaster<Socket,LuaEvtTypeAsync<Socket>>);
@@ -120,6 +542,52 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
   Mutex            mWriter;            // For condition variable
   bool             bUnlock;            // Condition variable unblocker
   condition_variable cvWriter;         // Waiting for write/terminate event
+  /* -- Reactor mode ------------------------------------------------------- */
+  SocketReactor   *srReactor;          // Shared event thread or own threads
+  enum ReactorState : unsigned         // Reactor connection progress
+  { /* --------------------------------------------------------------------- */
+    RS_SETUP,                          // Creating context and socket
+    RS_CONNECT,                        // Connecting and handshaking
+    RS_REQUEST,                        // Sending HTTP request
+    RS_RESPONSE,                       // Receiving HTTP response
+    RS_DATA                            // Sending and receiving raw data
+  } rsState;                           // Current reactor progress
+  bool             bHTTP;              // Socket is a HTTP request
+  StdString        strRequest;         // HTTP request waiting to be sent
+  size_t           stSent;             // Bytes sent of request or packet
+  /* -- HTTP response progress --------------------------------------------- */
+  enum HTTPMode : unsigned             // HTTP request type
+  { /* --------------------------------------------------------------------- */
+    HM_HTTP,                           // Normal request
+    HM_HEAD,                           // HEAD request (no body expected)
+    HM_WEBSOCKET                       // WebSocket upgrade request
+  } hmMode;                            // Current HTTP request type
+  size_t           stContentRead,      // Bytes of body received
+                   stContentLength;    // Bytes of body expected (0=unknown)
+  StdString        strHeaders;         // Response headers received so far
+  bool             bHeaders,           // Still receiving response headers
+                   bPool,              // Request may use an idle connection
+                   bReused,            // Connection was an idle connection
+                   bKeepAlive;         // Response allows connection reuse
+  /* -- HTTP response body decoding ---------------------------------------- */
+  enum ChunkState : unsigned           // Chunked transfer progress
+  { /* --------------------------------------------------------------------- */
+    CS_NONE,                           // Body is not chunked
+    CS_SIZE,                           // Reading chunk size line
+    CS_DATA,                           // Reading chunk data
+    CS_DATAEND,                        // Reading line ending after data
+    CS_TRAILER,                        // Reading trailer lines
+    CS_DONE                            // Last chunk received
+  } csChunk;                           // Current chunked transfer progress
+  size_t           stChunk;            // Bytes left in current chunk
+  StdString        strChunk;           // Chunk line received so far
+  StdString        strInflateRaw;      // Input kept until something inflates
+  bool             bDecode,            // We asked for compressed content
+                   bInflate,           // Inflating the body
+                   bInflateRaw;        // Try raw deflate if zlib fails
+  z_stream         zsInflate;          // Inflate context
+  Memory           mInflate;           // Inflated data buffer
+  FStream          fsSink;             // File to write body to (optional)
   /* -- Other variables ---------------------------------------------------- */
   unsigned         uPort;              // The port number to connect to
   AtomicInt        aiError,            // Socket error
@@ -219,6 +687,30 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     } // Return thread error status
     return TS_ERROR;
   }
+  /* -- Account for bytes read from the socket ----------------------------- */
+  size_t SockReadDone(const size_t stRead)
+  { // Increment received bytes and packet counters
+    aullRX += stRead;
+    ++aullRXp;
+    cParent->aullRX += stRead;
+    ++cParent->aullRXp;
+    // Set last received timestamp
+    acdRead = cmHiRes.GetEpochTime();
+    // Return bytes read
+    return stRead;
+  }
+  /* -- Account for bytes written to the socket ---------------------------- */
+  size_t SockWriteDone(const size_t stWritten)
+  { // Increment sent bytes and packet counters
+    aullTX += stWritten;
+    ++aullTXp;
+    cParent->aullTX += stWritten;
+    ++cParent->aullTXp;
+    // Set last sent timestamp
+    acdWrite = cmHiRes.GetEpochTime();
+    // Return bytes written
+    return stWritten;
+  }
   /* -- Read socket -------------------------------------------------------- */
   size_t SockRead(char *cpData, const size_t stSize)
   { // If thread should exit
@@ -240,17 +732,8 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
       // Did openssl fail? Set error and clean up
       case static_cast<size_t>(-2):
         return static_cast<size_t>(SetErrorSafe("Not implemented!"));
-      // We read data. Incrememnt counter
-      default:
-        // Increment received bytes and packet counters
-        aullRX += stRead;
-        ++aullRXp;
-        cParent->aullRX += stRead;
-        ++cParent->aullRXp;
-        // Set last received timestamp
-        acdRead = cmHiRes.GetEpochTime();
-        // Return bytes read
-        return stRead;
+      // We read data. Account for it and return bytes read
+      default: return SockReadDone(stRead);
     }
   }
   /* -- Write socket ------------------------------------------------------- */
@@ -274,13 +757,8 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
         return static_cast<size_t>(SetErrorSafe("Not implemented!"));
       // We wrote data.
       default:
-        // Increment sent bytes and packet counters
-        aullTX += stWritten;
-        ++aullTXp;
-        cParent->aullTX += stWritten;
-        ++cParent->aullTXp;
-        // Set last sent timestamp
-        acdWrite = cmHiRes.GetEpochTime();
+        // Account for the sent bytes
+        SockWriteDone(stWritten);
         // Make sure we sent the same bytes as requested. This should never
         // happen, but if we did? Return the number of bytes written
         if(stWritten == stSize) return stWritten;
@@ -402,6 +880,12 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
   void FinishDisconnect()
   { // Lock mutex to prevent data race
     MutexCall([this](){
+      // Remember the session if we connected so the next connection to the
+      // same server can resume it.
+      if(sslPtr && FlagIsSet(SS_CONNECTED)) SessionSave();
+      // Done decoding and writing the response body
+      if(bInflate) { inflateEnd(&zsInflate); bInflate = false; }
+      fsSink.FStreamCloseSafe();
       // Have BIO socket pointer?
       if(bioPtr)
       { // This automatically frees the SSL context
@@ -454,8 +938,20 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     } // ...list is fully emptied
     while(!plData.empty());
   }
-  /* -- Create connection with select used to monitor for timeout ---------- */
-  ThreadStatus DoConnect()
+  /* -- Key identifying the server and cipher settings of the connection --- */
+  StdString PoolKey() const
+    { return StrAppend(strAddrPort, '|', strCipherSuite, '|', strCipherList); }
+  /* -- Store the current session so it can be resumed later --------------- */
+  void SessionSave()
+  { // Get the session and ignore if there is none or it can't be resumed
+    SSL_SESSION*const sPtr = SSL_get1_session(sslPtr);
+    if(!sPtr) return;
+    if(!SSL_SESSION_is_resumable(sPtr)) return SSL_SESSION_free(sPtr);
+    // Store the session
+    cParent->spPool.SessionSet(PoolKey(), sPtr);
+  }
+  /* -- Set the address to connect to and report we are connecting --------- */
+  ThreadStatus ConnectStart()
   { // Set hostname (always returns 1).
     if(CryptBIOSetConnHostname(bioPtr, GetAddressAndPort().data()) != 1)
       return SetErrorSafe("Resolve failed!");
@@ -464,13 +960,12 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
       IsSecure() ? "securely " : cCommon->CommonBlank(), GetAddressAndPort());
     // Set connecting flag. Do send an event for this
     AddStatus(SS_CONNECTING, acdConnect);
-    // Abort if requested
-    if(tReader.ThreadShouldExit()) return SetAborted();
-    // Try to connect and if failed?
-    if(BIO_do_connect(bioPtr) != 1) return SetErrorSafe("Connect failed!");
-    // Abort if requested
-    if(tReader.ThreadShouldExit()) return SetAborted();
-    // Set descriptor and set error if failed
+    // Success
+    return TS_OK;
+  }
+  /* -- Store the address we connected to ---------------------------------- */
+  ThreadStatus ConnectAddress()
+  { // Set descriptor and set error if failed
     if(!UpdateDescriptor()) return SetErrorSafe("Lost descriptor!");
     // Get and check pointer to address data
     if(const BIO_ADDR*const baData = CryptBIOGetConnAddress(bioPtr))
@@ -501,7 +996,32 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     if(strRealHost != strIP) FlagSet(SS_VHOST);
     // Show connected ip address
     SocketLogSafe(LH_DEBUG, "connected to '$'.", GetIPAddress());
+    // Success
+    return TS_OK;
+  }
+  /* -- Create connection with select used to monitor for timeout ---------- */
+  ThreadStatus DoConnect()
+  { // Set address to connect to
+    if(ConnectStart() == TS_ERROR) return TS_ERROR;
+    // Abort if requested
+    if(tReader.ThreadShouldExit()) return SetAborted();
+    // Try to connect and if failed?
+    if(BIO_do_connect(bioPtr) != 1) return SetErrorSafe("Connect failed!");
+    // Abort if requested
+    if(tReader.ThreadShouldExit()) return SetAborted();
+    // Store the address we connected to
+    if(ConnectAddress() == TS_ERROR) return TS_ERROR;
     // Set socket read and send timeout
+    ConnectTimeouts();
+    // Until thread says to terminate
+    if(tReader.ThreadShouldExit()) return SetAborted();
+    // Return success if the handshake succeeded or process error
+    return BIO_do_handshake(bioPtr) == 1 ?
+      TS_OK : SetErrorSafe("Handshake failed!");
+  }
+  /* -- Set socket read and send timeout ----------------------------------- */
+  void ConnectTimeouts()
+  { // Set socket read and send timeout
     switch(cSystem->SetSocketTimeout(aiFd,
       cParent->adRecvTimeout, cParent->adSendTimeout))
     { // Success
@@ -519,11 +1039,7 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
       default:
         SocketLogSafe(LH_WARNING, "unknown error setting socket timeouts!");
         break;
-    } // Until thread says to terminate
-    if(tReader.ThreadShouldExit()) return SetAborted();
-    // Return success if the handshake succeeded or process error
-    return BIO_do_handshake(bioPtr) == 1 ?
-      TS_OK : SetErrorSafe("Handshake failed!");
+    }
   }
   /* -- OCSP verification result ------------------------------------------- */
   int OCSPVerificationResponse(SSL*const sslCbPtr)
@@ -549,8 +1065,8 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     // handshake will fail) or a positive value if it is acceptable.
     return cParent->aiOCSP >= 2 ? 0 : 1;
   }
-  /* -- Socket initial connect function ------------------------------------ */
-  ThreadStatus InitialConnect()
+  /* -- Reset status, counters and buffers for a new connection ------------ */
+  void ConnectReset()
   { // Initialise the status flags
     FlagReset(SS_INITIALISING);
     // Reset counters and timers
@@ -559,6 +1075,11 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
       acdDisconnect = acdDisconnected = cd0;
     // Flush packets in all buffers
     FlushPackets();
+  }
+  /* -- Create the context and socket -------------------------------------- */
+  ThreadStatus ConnectSetup()
+  { // Reset status, counters and buffers
+    ConnectReset();
     // If want TLS encryption?
     if(!strCipherSuite.empty() || !strCipherList.empty())
     { // Set encryption flag. Do not send a LUA event for this
@@ -646,10 +1167,11 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
       { // Setup OCSP verification
         if(!SSL_set_tlsext_status_type(sslPtr, TLSEXT_STATUSTYPE_ocsp))
           SocketLogSafe(LH_WARNING, "failed to setup OCSP verification!");
-        // Set callback and argument
+        // Set callback and argument. The argument is cleared while the
+        // connection is idle in the pool.
         int(*fCB)(SSL*,void*) = [](SSL*const sO, void*const vpS)->int
-          { return reinterpret_cast<Socket*>(vpS)->
-              OCSPVerificationResponse(sO); };
+          { return vpS ? reinterpret_cast<Socket*>(vpS)->
+              OCSPVerificationResponse(sO) : 1; };
         if(!CryptSSLCtxSetTlsExtStatusCb(sslctxPtr, fCB))
           SocketLogSafe(LH_WARNING,
             "failed to setup OCSP verification callback!");
@@ -660,97 +1182,116 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
       } // Set SNI hostname. Some sites break if this is not set
       if(!CryptSSLSetTlsExtHostName(sslPtr, strAddr.data()))
         return SetErrorStaticSafe("Init TLS SNI hostname failed!");
-      // Log and do secure connection
-      if(DoConnect() == TS_ERROR) return TS_ERROR;
-      // This is the size of the temporary string buffer (ssl needs int)
-      const int iLen = 128;
-      // Make a buffer of that size. Shouldn't really statically allocate it.
-      const Memory mStr{ static_cast<size_t>(iLen) };
-      // Get address of memory
-      char*const cpStr = mStr.MemPtr<char>();
-      // Is the cipher available?
-      if(SSL_CIPHER_description(SSL_get_current_cipher(sslPtr), cpStr, iLen))
-      { // Synchronise access to cipher string
-        MutexCall([this, cpStr](){
-          // Set cipher and remove spaces, carriage returns and linefeeds
-          strCipher = cpStr;
-          StrCompactRef(strCipher);
-          StrChopRef(strCipher);
-          // Print encryption info. Don't need to lock twice
-          SocketLogUnsafe(LH_DEBUG, "cipher is '$'.", strCipher);
-        });
-      } // Get cipher failed? Log failure
-      else return SetErrorSafe("negotiated an invalid TLS cipher!");
-      // Get server certificate
-      if(const X509*const xCert = SSL_get0_peer_certificate(sslPtr))
-      { // Get certificate subject and if successful? Log subject line. OpenSSL
-        // doesn't give us the length so feed into logger as c-string
-        if(X509_NAME_oneline(X509_get_subject_name(xCert), cpStr, iLen))
-          SocketLogSafe(LH_DEBUG, "certificate subject is '$'.", cpStr);
-        // Get certificate issuer and if successful? Log issuer line
-        if(X509_NAME_oneline(X509_get_issuer_name(xCert), cpStr, iLen))
-          SocketLogSafe(LH_DEBUG, "certificate issuer is '$'.", cpStr);
-        // Don't free certificate since we're using SSL_get0_*
-      } // Only show log entry for this and let the below catch the error
-      else SocketLogSafe(LH_WARNING, "certificate metadata missing.");
-      // Get X509 chain verificiation result
-      switch(const size_t stRes =
-        static_cast<size_t>(SSL_get_verify_result(sslPtr)))
-      { // No error?
-        case X509_V_OK:
-          // Log success and carry on
-          SocketLogSafe(LH_DEBUG, "certificate chain is good.");
-          break;
-        // Anything else?
-        default:
-        { // Find error code if the error code information is not found?
-          const Certs::X509ErrConstIt xeciIt{ cParent->CertsGetError(stRes) };
-          if(cParent->CertsIsNotErrorValid(xeciIt))
-          { // Return success if user wants to bypass it
-            if(cParent->CertsIsNotX509BypassFlagSet(1, 0x8000000000000000ULL))
-            { // Set error and return status
-              SetErrorStaticSafe(StrAppend("X509_V_ERR_UNKNOWN_", stRes));
-              return TS_ERROR;
-            } // Log the warning and return success
-            SocketLogSafe(LH_WARNING,
-              "unknown certificate error $ bypassed!", stRes);
-          } // Found the error code
-          else
-          { // Get reference to structure
-            const Certs::X509ErrInfo &xeiData = xeciIt->second;
-            // Build error code
-            const StdString strErr{ StrAppend("X509_V_ERR_", xeiData.cpErr) };
-            // Return success if user wants to bypass it
-            if(cParent->CertsIsNotX509BypassFlagSet(
-                 xeiData.stBank, xeiData.ullFlag))
-            { // Set error and return status
-              SetErrorStaticSafe(strErr);
-              return TS_ERROR;
-            } // Log the warning and return success
-            SocketLogSafe(LH_WARNING,
-              "certificate error '$' bypassed!", strErr);
-            // Set socket error and error string
-          } // Done
-          break;
-        }
-      }
+      // Offer the last session with this server for an abbreviated handshake
+      if(cParent->spPool.SessionApply(PoolKey(), sslPtr))
+        SocketLogSafe(LH_DEBUG, "offering previous TLS session...");
     } // No security
     else
     { // Create socket and bail out if failed
       bioPtr = BIO_new(BIO_s_connect());
       if(!bioPtr) return SetErrorSafe("Failed to create BIO socket!");
-      // Log and do insecure connection
-      if(DoConnect() == TS_ERROR) return TS_ERROR;
-    } // Now connected
+    } // Success
+    return TS_OK;
+  }
+  /* -- Check the negotiated encryption ------------------------------------ */
+  ThreadStatus ConnectVerify()
+  { // This is the size of the temporary string buffer (ssl needs int)
+    const int iLen = 128;
+    // Make a buffer of that size. Shouldn't really statically allocate it.
+    const Memory mStr{ static_cast<size_t>(iLen) };
+    // Get address of memory
+    char*const cpStr = mStr.MemPtr<char>();
+    // Is the cipher available?
+    if(SSL_CIPHER_description(SSL_get_current_cipher(sslPtr), cpStr, iLen))
+    { // Synchronise access to cipher string
+      MutexCall([this, cpStr](){
+        // Set cipher and remove spaces, carriage returns and linefeeds
+        strCipher = cpStr;
+        StrCompactRef(strCipher);
+        StrChopRef(strCipher);
+        // Print encryption info. Don't need to lock twice
+        SocketLogUnsafe(LH_DEBUG, "cipher is '$'.", strCipher);
+      });
+    } // Get cipher failed? Log failure
+    else return SetErrorSafe("negotiated an invalid TLS cipher!");
+    // Get server certificate
+    if(const X509*const xCert = SSL_get0_peer_certificate(sslPtr))
+    { // Get certificate subject and if successful? Log subject line. OpenSSL
+      // doesn't give us the length so feed into logger as c-string
+      if(X509_NAME_oneline(X509_get_subject_name(xCert), cpStr, iLen))
+        SocketLogSafe(LH_DEBUG, "certificate subject is '$'.", cpStr);
+      // Get certificate issuer and if successful? Log issuer line
+      if(X509_NAME_oneline(X509_get_issuer_name(xCert), cpStr, iLen))
+        SocketLogSafe(LH_DEBUG, "certificate issuer is '$'.", cpStr);
+      // Don't free certificate since we're using SSL_get0_*
+    } // Only show log entry for this and let the below catch the error
+    else SocketLogSafe(LH_WARNING, "certificate metadata missing.");
+    // Get X509 chain verificiation result
+    switch(const size_t stRes =
+      static_cast<size_t>(SSL_get_verify_result(sslPtr)))
+    { // No error?
+      case X509_V_OK:
+        // Log success and carry on
+        SocketLogSafe(LH_DEBUG, "certificate chain is good.");
+        break;
+      // Anything else?
+      default:
+      { // Find error code if the error code information is not found?
+        const Certs::X509ErrConstIt xeciIt{ cParent->CertsGetError(stRes) };
+        if(cParent->CertsIsNotErrorValid(xeciIt))
+        { // Return success if user wants to bypass it
+          if(cParent->CertsIsNotX509BypassFlagSet(1, 0x8000000000000000ULL))
+          { // Set error and return status
+            SetErrorStaticSafe(StrAppend("X509_V_ERR_UNKNOWN_", stRes));
+            return TS_ERROR;
+          } // Log the warning and return success
+          SocketLogSafe(LH_WARNING,
+            "unknown certificate error $ bypassed!", stRes);
+        } // Found the error code
+        else
+        { // Get reference to structure
+          const Certs::X509ErrInfo &xeiData = xeciIt->second;
+          // Build error code
+          const StdString strErr{ StrAppend("X509_V_ERR_", xeiData.cpErr) };
+          // Return success if user wants to bypass it
+          if(cParent->CertsIsNotX509BypassFlagSet(
+               xeiData.stBank, xeiData.ullFlag))
+          { // Set error and return status
+            SetErrorStaticSafe(strErr);
+            return TS_ERROR;
+          } // Log the warning and return success
+          SocketLogSafe(LH_WARNING,
+            "certificate error '$' bypassed!", strErr);
+          // Set socket error and error string
+        } // Done
+        break;
+      }
+    } // Success
+    return TS_OK;
+  }
+  /* -- Connection established --------------------------------------------- */
+  ThreadStatus ConnectEstablished()
+  { // Now connected
     AddStatus(SS_CONNECTED, acdConnected);
     // Increase connected count
     ++cParent->astConnected;
     // Successful connect
     return TS_OK;
   }
+  /* -- Socket initial connect function ------------------------------------ */
+  ThreadStatus InitialConnect()
+  { // Create the context and socket and connect to the server
+    if(ConnectSetup() == TS_ERROR || DoConnect() == TS_ERROR) return TS_ERROR;
+    // Check the negotiated encryption if this is a secure connection
+    if(IsSecure() && ConnectVerify() == TS_ERROR) return TS_ERROR;
+    // Now connected
+    return ConnectEstablished();
+  }
   /* -- Writer thread notification ----------------------------------------- */
   void WriteUnblock()
-  { // Acquire unique lock
+  { // Driven by a shared event thread? Ask it to send the data
+    if(srReactor) return srReactor->ReactorWake(Serial());
+    // Acquire unique lock
     mWriter.MutexCall([this](){
       // Unblock variable
       bUnlock = true;
@@ -1011,217 +1552,568 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     } // Thread should terminate
     return TS_OK;
   }
-  /* -- HTTP Socket main thread function ----------------------------------- */
-  ThreadStatus HTTPMain()
-  { // Connect and send http request and break loop if failed.
-    if(InitialConnect() == TS_ERROR) return TS_ERROR;
-    // Check if websocket
-    enum { HTTP, HTTP_HEAD, WEBSOCKET } eMode;
-    { // Check for websocket key and if we have it
-      ParserStringVolIt psvciIt{ GetRegistryIterator("Sec-WebSocket-Key") };
-      if(psvciIt != psvRegistry.cend())
-      { // Create base 64 key
-        psvciIt->second.assign(CryptMBtoB64(CryptRandomBlock(16)));
-        // Set mode
-        eMode = WEBSOCKET;
-        // Remove request method from registry so it doesn't accidentally get
-        // sent as a header.
-        psvciIt = GetRegistryIterator(cParent->strRegVarMETHOD);
-        if(psvciIt != psvRegistry.cend()) psvRegistry.erase(psvciIt);
-      } // Set normal HTTP request or HEAD request
-      else eMode = GetRegistry(cParent->strRegVarMETHOD) == "HEAD" ?
-                     HTTP_HEAD : HTTP;
-    } // Set sending request status event
+  /* -- Build the HTTP request from the registry --------------------------- */
+  StdString HTTPBuildRequest()
+  { // Check for websocket key and if we have it
+    ParserStringVolIt psvciIt{ GetRegistryIterator("Sec-WebSocket-Key") };
+    if(psvciIt != psvRegistry.cend())
+    { // Create base 64 key
+      psvciIt->second.assign(CryptMBtoB64(CryptRandomBlock(16)));
+      // Set mode
+      hmMode = HM_WEBSOCKET;
+      // Remove request method from registry so it doesn't accidentally get
+      // sent as a header.
+      psvciIt = GetRegistryIterator(cParent->strRegVarMETHOD);
+      if(psvciIt != psvRegistry.cend()) psvRegistry.erase(psvciIt);
+    } // Set normal HTTP request or HEAD request
+    else hmMode = GetRegistry(cParent->strRegVarMETHOD) == "HEAD" ?
+                    HM_HEAD : HM_HTTP;
+    // Set sending request status event
     AddStatus(SS_SENDREQUEST);
-    { // Get resource requested
-      const StdString strReq{ StdMove(GetRegistry(cParent->strRegVarREQ)) };
-      // Get body requested
-      const StdString strBody{ StdMove(GetRegistry(cParent->strRegVarBODY)) };
-      // Get the request headers to be sent
-      const StdString strHdrs{
-        StdMove(psvRegistry.ParserImplodeEx(": ", cCommon->CommonCrLf())) };
-      // Build entire packet to send
-      const StdString strPk{
-        StrAppend(strReq, strHdrs, cCommon->CommonCrLf(), strBody) };
-      // Write the full request to the server and return if failed
-      if(SockWrite(strPk) == static_cast<size_t>(TS_ERROR)) return TS_ERROR;
-      // Set sent request status event and log the event
-      AddStatus(SS_REPLYWAIT);
-      SocketLogSafe(LH_DEBUG, "request of $ bytes sent...",
-        strPk.size());
-    } // Content read and content-length
-    size_t stContentRead = 0, stContentLength = 0;
+    // Get resource requested
+    const StdString strReq{ StdMove(GetRegistry(cParent->strRegVarREQ)) };
+    // Get body requested
+    const StdString strBody{ StdMove(GetRegistry(cParent->strRegVarBODY)) };
+    // Get the request headers to be sent
+    const StdString strHdrs{
+      StdMove(psvRegistry.ParserImplodeEx(": ", cCommon->CommonCrLf())) };
+    // Build entire packet to send
+    return StrAppend(strReq, strHdrs, cCommon->CommonCrLf(), strBody);
+  }
+  /* -- HTTP request was sent so prepare for the response ------------------ */
+  void HTTPRequestSent(const size_t stBytes)
+  { // Set sent request status event and log the event
+    AddStatus(SS_REPLYWAIT);
+    SocketLogSafe(LH_DEBUG, "request of $ bytes sent...", stBytes);
+    // Content read and content-length
+    stContentRead = stContentLength = 0;
     // Initialise memory for response headers
-    StdReserved<StdString> strHeaders{ 1024 };
+    strHeaders.clear();
+    strHeaders.reserve(1024);
+    // Expecting reponse headers
+    bHeaders = true;
+    // Don't know if the connection can be reused yet
+    bKeepAlive = false;
+    // Don't know how the body is encoded yet
+    csChunk = CS_NONE;
+    stChunk = 0;
+    strChunk.clear();
+  }
+  /* -- Use an idle connection to the same server if there is one ---------- */
+  bool HTTPReuse()
+  { // Ignore if the request can't use an idle connection or there is none
+    if(!bPool) return false;
+    SocketPool::Idle iItem{};
+    if(!cParent->spPool.PoolTake(PoolKey(), iItem)) return false;
+    // Reset status, counters and buffers
+    ConnectReset();
+    if(iItem.sslPtr) FlagSet(SS_ENCRYPTION);
+    // Take ownership of the connection
+    MutexCall([this, &iItem](){
+      bioPtr = iItem.bioPtr;
+      sslctxPtr = iItem.sslctxPtr;
+      sslPtr = iItem.sslPtr;
+      strCipher = StdMove(iItem.strCipher);
+      strIP = StdMove(iItem.strIP);
+      strRealHost = StdMove(iItem.strRealHost);
+      // The context may still point its OCSP callback at us
+      if(sslctxPtr) SSL_CTX_set_tlsext_status_arg(sslctxPtr, this);
+    });
+    aiFd = iItem.iFd;
+    // Set a flag if address and host are not the same
+    if(strRealHost != strIP) FlagSet(SS_VHOST);
+    // Report that we are connecting and connected
+    AddStatus(SS_CONNECTING, acdConnect);
+    SocketLogSafe(LH_DEBUG, "reusing connection to '$'.", GetIPAddress());
+    ConnectEstablished();
+    // The server may have closed it just as we took it so remember to retry
+    // the request on a new connection if it fails before any response.
+    bReused = true;
+    // Success
+    return true;
+  }
+  /* -- Close a failed reused connection so the request can be retried ----- */
+  bool HTTPRetry()
+  { // Ignore if not reused, already retried, anything was received or the
+    // request was aborted.
+    if(!bReused || aullRX || IsDisconnectedByClient()) return false;
+    bReused = false;
+    SocketLogSafe(LH_DEBUG, "reused connection failed, retrying...");
+    // Close the connection and forget the error it caused
+    MutexCall([this](){
+      if(bioPtr) { BIO_free_all(bioPtr); bioPtr = nullptr; sslPtr = nullptr; }
+      if(sslctxPtr) { SSL_CTX_free(sslctxPtr); sslctxPtr = nullptr; }
+      aiError = 0;
+      strError.clear();
+    });
+    aiFd = -1;
+    // No longer connected
+    --cParent->astConnected;
+    // Retry
+    return true;
+  }
+  /* -- Response complete so keep the connection for the next request ------ */
+  void HTTPRelease()
+  { // Remember the session in case the connection is closed while idle
+    if(sslPtr) SessionSave();
+    // The context must not point its OCSP callback at us as we might be
+    // destroyed while the connection is idle.
+    if(sslctxPtr) SSL_CTX_set_tlsext_status_arg(sslctxPtr, nullptr);
+    // Give the connection to the pool and return if it was not accepted
+    if(!cParent->spPool.PoolPut({ PoolKey(), bioPtr, sslctxPtr, sslPtr, aiFd,
+      cd0, strCipher, strIP, strRealHost })) return;
+    // We no longer own the connection
+    MutexCall([this](){
+      bioPtr = nullptr;
+      sslctxPtr = nullptr;
+      sslPtr = nullptr;
+      aiFd = -1;
+    });
+    // Log that the connection was kept
+    SocketLogSafe(LH_DEBUG, "keeping connection for reuse.");
+  }
+  /* -- Return if the server will keep the connection open ----------------- */
+  bool HTTPIsKeepAlive(const StdStringView &ssvProto)
+  { // Not using idle connections? Never keep the connection
+    if(!bPool) return false;
+    // HTTP/1.1 keeps the connection open unless it says otherwise
+    const StrNCStrMapConstIt sncsmciConn{ GetRegistryIterator("connection") };
+    if(sncsmciConn == psvRegistry.cend()) return ssvProto == "HTTP/1.1";
+    // Return if the server agreed to keep the connection open
+    return StrToLowCase(sncsmciConn->second).find("keep-alive") != StdNPos;
+  }
+  /* -- Check how the response body is encoded ----------------------------- */
+  ThreadStatus HTTPSetupBody()
+  { // Body sent in chunks?
+    const StrNCStrMapConstIt sncsmciTE{
+      GetRegistryIterator("transfer-encoding") };
+    if(sncsmciTE != psvRegistry.cend() &&
+      StrToLowCase(sncsmciTE->second).find("chunked") != StdNPos)
+    { // Start reading the first chunk size
+      csChunk = CS_SIZE;
+      SocketLogSafe(LH_DEBUG, "content is chunked.");
+    } // Done if we did not ask for compressed content or it isn't compressed
+    if(!bDecode) return TS_OK;
+    const StrNCStrMapConstIt sncsmciCE{
+      GetRegistryIterator("content-encoding") };
+    if(sncsmciCE == psvRegistry.cend()) return TS_OK;
+    // Get the encoding and the zlib window bits needed to decode it
+    const StdString strEncoding{ StrToLowCase(sncsmciCE->second) };
+    int iBits;
+    if(strEncoding == "gzip" || strEncoding == "x-gzip") iBits = MAX_WBITS+16;
+    else if(strEncoding == "deflate") iBits = MAX_WBITS;
+    else if(strEncoding == "identity") return TS_OK;
+    else return SetErrorStaticSafe(
+      StrFormat("Unsupported content encoding '$'!", strEncoding));
+    // Initialise the inflate context
+    zsInflate = {};
+    if(inflateInit2(&zsInflate, iBits) != Z_OK)
+      return SetErrorStaticSafe("Inflate init failed!");
+    bInflate = true;
+    // Some servers send raw deflate data without the zlib header
+    bInflateRaw = iBits == MAX_WBITS;
+    strInflateRaw.clear();
+    // Allocate the inflate buffer if we haven't already
+    if(mInflate.MemIsEmpty()) mInflate.MemInitBlank(cParent->astBufferSize);
+    // Log what we're doing
+    SocketLogSafe(LH_DEBUG, "decoding $ content.", strEncoding);
+    // Success
+    return TS_OK;
+  }
+  /* -- Write decoded body data to the file or the receive list ------------ */
+  ThreadStatus HTTPSink(const char*const cpData, const size_t stBytes)
+  { // Writing to a file? Write the data and return if succeeded
+    if(fsSink.FStreamOpened())
+    { // Write the data and return if succeeded
+      if(fsSink.FStreamWrite(cpData, stBytes) == stBytes) return TS_OK;
+      return SetErrorStaticSafe(StrFormat("Write to '$' failed: $!",
+        fsSink.NameGet(), StrFromErrNo()));
+    } // Push data block into list ready for LUA to collect
+    PushDataSafe(plRX, stRX, cpData, stBytes);
+    // Success
+    return TS_OK;
+  }
+  /* -- Decompress body data if needed and write it ------------------------ */
+  ThreadStatus HTTPDecode(const char*const cpData, const size_t stBytes)
+  { // Not compressed? Write it as is
+    if(!bInflate) return HTTPSink(cpData, stBytes);
+    // Keep the data until something is inflated in case the whole stream
+    // has to be inflated again as raw deflate.
+    if(bInflateRaw && !zsInflate.total_out)
+      strInflateRaw.append(cpData, stBytes);
+    // Set the data to inflate
+    zsInflate.next_in = StdToNonConstCast<Bytef*>(cpData);
+    zsInflate.avail_in = static_cast<uInt>(stBytes);
+    // Until the output buffer is not filled
+    do
+    { // Inflate as much as fits in the output buffer
+      zsInflate.next_out = mInflate.MemPtr<Bytef>();
+      zsInflate.avail_out = mInflate.MemSize<uInt>();
+      const int iResult = inflate(&zsInflate, Z_NO_FLUSH);
+      switch(iResult)
+      { // Success or need more input
+        case Z_OK: case Z_BUF_ERROR: case Z_STREAM_END: break;
+        // Bad data? Retry as raw deflate if nothing was decoded yet
+        case Z_DATA_ERROR:
+          if(bInflateRaw && !zsInflate.total_out)
+          { // Only try once and restart with raw deflate
+            bInflateRaw = false;
+            inflateEnd(&zsInflate);
+            zsInflate = {};
+            if(inflateInit2(&zsInflate, -MAX_WBITS) != Z_OK)
+            { // Context is invalid now
+              bInflate = false;
+              return SetErrorStaticSafe("Inflate init failed!");
+            } // Decode everything received so far again
+            const StdString strData{ StdMove(strInflateRaw) };
+            strInflateRaw.clear();
+            return HTTPDecode(strData.data(), strData.size());
+          } // Fall through to error
+          [[fallthrough]];
+        // Anything else is an error
+        default: return SetErrorStaticSafe(
+          StrFormat("Inflate failed: $!", zError(iResult)));
+      } // Write the inflated data
+      const size_t stOut = mInflate.MemSize() - zsInflate.avail_out;
+      if(stOut && HTTPSink(mInflate.MemPtr<char>(), stOut) == TS_ERROR)
+        return TS_ERROR;
+      // End of compressed stream? Ignore anything after it
+      if(iResult == Z_STREAM_END) break;
+    } // Output buffer was filled so there may be more to inflate
+    while(!zsInflate.avail_out);
+    // Data is valid so it will not be inflated again
+    if(zsInflate.total_out && !strInflateRaw.empty())
+      { strInflateRaw.clear(); strInflateRaw.shrink_to_fit(); }
+    // Success
+    return TS_OK;
+  }
+  /* -- Decode chunked body data ------------------------------------------- */
+  ThreadStatus HTTPChunked(const char *cpData, size_t stBytes)
+  { // Until all the data is processed
+    while(stBytes)
+    { // Receiving chunk data?
+      if(csChunk == CS_DATA)
+      { // Use as much of the chunk as we have
+        const size_t stUsed = UtilMinimum(stChunk, stBytes);
+        stContentRead += stUsed;
+        if(HTTPDecode(cpData, stUsed) == TS_ERROR) return TS_ERROR;
+        cpData += stUsed;
+        stBytes -= stUsed;
+        // Read the line ending after the chunk if it's all received
+        stChunk -= stUsed;
+        if(!stChunk) csChunk = CS_DATAEND;
+        continue;
+      } // Receiving a line so find the end of it and add what we have
+      const char*const cpEnd =
+        static_cast<const char*>(memchr(cpData, '\n', stBytes));
+      const size_t stUsed =
+        cpEnd ? static_cast<size_t>(cpEnd - cpData) + 1 : stBytes;
+      strChunk.append(cpData, stUsed);
+      cpData += stUsed;
+      stBytes -= stUsed;
+      // Don't let the server send us an endless line
+      if(strChunk.size() > 4096)
+        return SetErrorStaticSafe("Chunk line too long!");
+      // Wait for more data if the line is not complete
+      if(!cpEnd) break;
+      // Remove the line ending
+      while(!strChunk.empty() &&
+        (strChunk.back() == '\n' || strChunk.back() == '\r'))
+          strChunk.pop_back();
+      // What were we reading?
+      switch(csChunk)
+      { // Line ending after chunk data? Should be empty
+        case CS_DATAEND:
+          if(!strChunk.empty())
+            return SetErrorStaticSafe("Bad chunk terminator!");
+          csChunk = CS_SIZE;
+          break;
+        // Chunk size line?
+        case CS_SIZE:
+        { // Get the hex size before any extensions and check it's valid
+          const StdString strSize{ strChunk.substr(0, strChunk.find(';')) };
+          const size_t stFirst = strSize.find_first_not_of(' '),
+            stLast = strSize.find_last_not_of(' ');
+          if(stFirst == StdNPos || stLast - stFirst >= sizeof(size_t) * 2 ||
+            strSize.find_first_not_of("0123456789abcdefABCDEF", stFirst) <=
+              stLast)
+            return SetErrorStaticSafe("Bad chunk size!");
+          // Read the chunk or the trailer if it was the last chunk
+          stChunk = StrHexToInt<size_t>(
+            strSize.substr(stFirst, stLast - stFirst + 1));
+          csChunk = stChunk ? CS_DATA : CS_TRAILER;
+          break;
+        } // Trailer line? Empty line ends the body
+        case CS_TRAILER:
+          if(!strChunk.empty()) break;
+          csChunk = CS_DONE;
+          // Anything after the body leaves the connection in an unknown
+          // state so don't reuse it.
+          if(stBytes) bKeepAlive = false;
+          strChunk.clear();
+          return HTTPComplete();
+        // Should never get here
+        default: return SetErrorStaticSafe("Invalid chunk state!");
+      } // Done with the line
+      strChunk.clear();
+    } // Wait for more data
+    return TS_RUNNING;
+  }
+  /* -- Process received body data ----------------------------------------- */
+  ThreadStatus HTTPContent(const char*const cpData, const size_t stBytes)
+  { // Body is chunked? Decode the chunks
+    if(csChunk != CS_NONE) return HTTPChunked(cpData, stBytes);
+    // Increment content read and if we don't know the length? Use it all
+    stContentRead += stBytes;
+    if(!stContentLength)
+      return HTTPDecode(cpData, stBytes) == TS_ERROR ? TS_ERROR : TS_RUNNING;
+    // Truncate bytes read past the content length
+    size_t stUsed = stBytes;
+    if(stContentRead > stContentLength)
+    { // Log the excess and don't reuse a connection in an unknown state
+      const size_t stExcess = stContentRead - stContentLength;
+      SocketLogSafe(LH_WARNING, "downloaded resource ($ bytes excess)!",
+        stExcess);
+      bKeepAlive = false;
+      stUsed -= stExcess;
+      stContentRead = stContentLength;
+    } // Write the data
+    if(HTTPDecode(cpData, stUsed) == TS_ERROR) return TS_ERROR;
+    // Return if we need more or everything is downloaded
+    return stContentRead < stContentLength ? TS_RUNNING : HTTPComplete();
+  }
+  /* -- Whole body was received -------------------------------------------- */
+  ThreadStatus HTTPComplete()
+  { // Log and return success
+    SocketLogSafe(LH_DEBUG, "download complete.");
+    return TS_OK;
+  }
+  /* -- Connection ended so check the response was complete ---------------- */
+  ThreadStatus HTTPFinish()
+  { // If we were waiting for headers still?
+    if(bHeaders) return SetErrorSafe("Response failed!");
+    // Chunked body not finished? The server dropped us
+    if(csChunk != CS_NONE)
+      return SetErrorSafe(StrFormat("Download failed at $ bytes!",
+        stContentRead));
+    // We were downloading so if there was a content length?
+    if(stContentLength)
+    { // Read the correct number of bytes? Or we're just doing a HEAD req?
+      // Log that the download was successful.
+      if(stContentRead == stContentLength || hmMode == HM_HEAD)
+        SocketLogSafe(LH_DEBUG, "download successful.");
+      // We did not get the correct number of bytes? Set error code.
+      else return
+        SetErrorSafe(StrFormat("Download failed at $ bytes!", stContentRead));
+    } // There was no content length? Just log the bytes downloaded
+    else SocketLogSafe(LH_DEBUG, "downloaded $ bytes.", stContentRead);
+    // We're done with the connection
+    return TS_OK;
+  }
+  /* -- Process data received from the server ------------------------------ **
+  ** Returns TS_RUNNING if more data is needed else the final status.        **
+  ** ----------------------------------------------------------------------- */
+  ThreadStatus HTTPProcess(Memory &mDest, const size_t stRead)
+  { // Already received the headers? Process the body
+    if(!bHeaders) return HTTPContent(mDest.MemPtr<char>(), stRead);
+    // Make string view of response which could contain binary chars
+    StdStringView ssvResp{ mDest.MemPtr<char>(), stRead };
+    // Find end of headers marker and if we do not have it yet?
+    const size_t stEnd = ssvResp.find(cCommon->CommonCrLf2());
+    if(stEnd == StdNPos)
+    { // Check for binary data and if we found binary data? Bail out!
+      if(!ValidHeaderPacket(ssvResp))
+        return SetErrorStaticSafe("Binary code in headers");
+      // Add to full headers string
+      strHeaders += ssvResp;
+      // Wait for next packet
+      return TS_RUNNING;
+    } // Ok we got the headers. Collect data.
+    bHeaders = false;
+    // Get cut off point between headers to data and if we got it? Keep it
+    // until we know how the body is encoded and truncate extra bytes.
+    const size_t stInitial = ssvResp.size() - (stEnd + 4);
+    const char*const cpInitial = mDest.MemPtr<char>() + stEnd + 4;
+    if(stInitial > 0) ssvResp = { mDest.MemPtr<char>(), stEnd };
+    // Check for binary code in the last packet returned? Bail out!
+    if(!ValidHeaderPacket(ssvResp))
+      return SetErrorStaticSafe("Binary code in headers!");
+    // Add rest of response to headers
+    strHeaders += ssvResp;
+    // Build output headers list by exploding header string
+    psvRegistry.ParserReInit(strHeaders, cCommon->CommonCrLf(), ':');
+    if(psvRegistry.empty()) return SetErrorStaticSafe("No response!");
+    // Done with the headers string
+    strHeaders.clear();
+    strHeaders.shrink_to_fit();
+    // Find initial reponse (should be #0 set by VARS class)
+    const StrNCStrMapConstIt
+      vlR{ GetRegistryIterator(cParent->strRegVarRESPONSE) };
+    if(vlR == psvRegistry.cend()) return SetErrorStaticSafe("Bad response!");
+    // Split into words. We should have got at least three words
+    const TokenStrView tsvWords{ vlR->second, cCommon->CommonSpaceV() };
+    if(tsvWords.size() < 3) return SetErrorStaticSafe("Unknown response!");
+    // Get protocol and if it is not valid?
+    const StdStringView &ssvProtoRecv = tsvWords.front();
+    if(ssvProtoRecv != "HTTP/1.0" && ssvProtoRecv != "HTTP/1.1")
+      return SetErrorStaticSafe(
+        StrFormat("Bad protocol '$'!", ssvProtoRecv));
+    // Get http status code string and if not a valid number?
+    const StdStringView &ssvStatus = tsvWords[1];
+    if(!StrIsInt(ssvStatus))
+      return SetErrorStaticSafe(StrFormat("Bad status '$'!", ssvStatus));
+    // Convert to integer and if valid?
+    const size_t stStatus = StrToNum<size_t>(ssvStatus);
+    if(stStatus < 100 || stStatus > 999)
+      return SetErrorStaticSafe(
+        StrFormat("Bad status code '$'!", ssvStatus));
+    // If the status code is anything but an error? Log successful code
+    if(stStatus < 400) SocketLogSafe(LH_DEBUG, "status code $.", ssvStatus);
+    // Error status code? Log error status code
+    else SocketLogSafe(LH_WARNING, "status error $!", ssvStatus);
+    // If connection upgrade required? Handle websocket if requested else
+    // throw an error because the socket might be left in a waiting state
+    // which our client expects the server to close the connection.
+    if(stStatus == 101)
+      return hmMode == HM_WEBSOCKET ? WebSocketMain(mDest):
+        SetErrorStaticSafe("Not upgrading");
+    // Other informational response? It has no body and the real response
+    // follows it so read the headers again.
+    if(stStatus < 200)
+    { // Expecting response headers again
+      bHeaders = true;
+      strHeaders.clear();
+      // Wait for more data if there is nothing after the headers
+      if(!stInitial) return TS_RUNNING;
+      // Process the rest as the start of the next response
+      mDest.MemMove(0, mDest.MemRead(stEnd + 4, stInitial), stInitial);
+      return HTTPProcess(mDest, stInitial);
+    }
+    // Add protocol and status code to registry so guest can read them
+    // without having to perform any special string operations
+    psvRegistry.ParserPushOrUpdatePair(cParent->strRegVarPROTO,
+      StdString{ ssvProtoRecv });
+    psvRegistry.ParserPushOrUpdatePair(cParent->strRegVarCODE,
+      StdString{ ssvStatus });
+    // We have to lock the TX list since a LUA function can read this
+    MutexCall([this](){
+      // Enumerate registry entries
+      for(const StrNCStrMapPair &sncsmpPair : psvRegistry)
+      { // Get items and push into TX since we're not using it anymore. Make
+        // sure to include the null-terminator so we can use StdStringView
+        // for when LUA grabs the list.
+        PushData(plTX, stTX,
+          StrToLowCaseRef(UtilToNonConst(sncsmpPair.first)).data(),
+          sncsmpPair.first.size() + 1);
+        PushData(plTX, stTX, sncsmpPair.second.data(),
+          sncsmpPair.second.size() + 1);
+      }
+    });
+    // If we got a content type?
+    const StrNCStrMapConstIt sncsmciType{
+      GetRegistryIterator("content-type") };
+    if(sncsmciType != psvRegistry.cend())
+      SocketLogSafe(LH_DEBUG, "content type is '$'.", sncsmciType->second);
+    // Check if the server will keep the connection open for another request
+    bKeepAlive = HTTPIsKeepAlive(ssvProtoRecv);
+    // No body expected? The response is already complete whatever the
+    // headers say about the body.
+    if(hmMode == HM_HEAD || stStatus == 204 || stStatus == 304)
+    { // Anything after the headers leaves the connection in an unknown
+      // state so don't reuse it.
+      if(stInitial) bKeepAlive = false;
+      // Nothing to download
+      SocketLogSafe(LH_DEBUG, "no content expected.");
+      return TS_OK;
+    }
+    // Check how the body is encoded and bail out if we can't decode it
+    if(HTTPSetupBody() == TS_ERROR) return TS_ERROR;
+    // Set downloading status
+    AddStatus(SS_DOWNLOADING);
+    // Body is chunked? The last chunk marks the end of the body
+    if(csChunk != CS_NONE) stContentLength = 0;
+    // Should get content length otherwise
+    else if(const StrNCStrMapConstIt sncsmciLen{
+      GetRegistryIterator("content-length") };
+        sncsmciLen != psvRegistry.cend())
+    { // Get reference to string and if it's not valid?
+      const StdString &strVal = sncsmciLen->second;
+      if(!StrIsInt(strVal))
+      { // Read until the server closes the connection and log the warning
+        stContentLength = 0;
+        bKeepAlive = false;
+        SocketLogSafe(LH_WARNING, "invalid content length!");
+      } // Valid content-length
+      else
+      { // Convert length string to integer and log the length
+        stContentLength = StrToNum<size_t>(strVal);
+        SocketLogSafe(LH_DEBUG, "content length is $ bytes.",
+          stContentLength);
+        // Empty body? The response is complete
+        if(!stContentLength)
+        { // Anything after the headers leaves the connection in an unknown
+          // state so don't reuse it.
+          if(stInitial) bKeepAlive = false;
+          return HTTPComplete();
+        }
+      }
+    } // No content length so the end of the body is only known when the
+    // server closes the connection.
+    else
+    { // Set zero content length and we can't reuse the connection
+      stContentLength = 0;
+      bKeepAlive = false;
+    } // Process body data that came with the headers or wait for more
+    return stInitial ? HTTPContent(cpInitial, stInitial) : TS_RUNNING;
+  }
+  /* -- Send the HTTP request and retry on a new connection if needed ------ */
+  ThreadStatus HTTPSend(const StdString &strPk)
+  { // Write the full request to the server and if failed? Try again on a new
+    // connection if it was a reused one or return failure.
+    if(SockWrite(strPk) == static_cast<size_t>(TS_ERROR) &&
+      (!HTTPRetry() || InitialConnect() == TS_ERROR ||
+        SockWrite(strPk) == static_cast<size_t>(TS_ERROR)))
+      return TS_ERROR;
+    // Request sent so wait for the response
+    HTTPRequestSent(strPk.size());
+    // Success
+    return TS_OK;
+  }
+  /* -- HTTP Socket main thread function ----------------------------------- */
+  ThreadStatus HTTPMain()
+  { // Reuse an idle connection to the same server if there is one
+    if(HTTPReuse())
+    { // It may have been used by a shared event thread so make it blocking
+      BIO_socket_nbio(aiFd, 0);
+      ConnectTimeouts();
+    } // Connect and break loop if failed
+    else if(InitialConnect() == TS_ERROR) return TS_ERROR;
+    // Build the request to send. It is kept in case it has to be sent again
+    // because a reused connection was closed by the server.
+    const StdString strPk{ HTTPBuildRequest() };
+    if(HTTPSend(strPk) == TS_ERROR) return TS_ERROR;
     // Allocate memory for read buffer
     Memory mDest{ cParent->astBufferSize };
-    // Expecting reponse headers? and connection closed status
-    bool bHeaders = true;
     // Begin monitoring for reply and break if thread should exit
     while(tReader.ThreadShouldNotExit())
     { // Wait for data from connected server
       const size_t stRead = SockRead(mDest.MemPtr<char>(), mDest.MemSize());
       // Connection error or server closed connection?
       if(stRead == static_cast<size_t>(TS_ERROR))
-      { // If we were waiting for headers still?
-        if(bHeaders) return SetErrorSafe("Response failed!");
-        // We were downloading so if there was a content length?
-        if(stContentLength)
-        { // Read the correct number of bytes? Or we're just doing a HEAD req?
-          // Log that the download was successful.
-          if(stContentRead == stContentLength || eMode == HTTP_HEAD)
-            SocketLogSafe(LH_DEBUG, "download successful.");
-          // We did not get the correct number of bytes? Set error code.
-          else return
-            SetErrorSafe(StrFormat("Download failed at $ bytes!",
-              stContentRead));
-        } // There was no content length? Just log the bytes downloaded
-        else SocketLogSafe(LH_DEBUG, "downloaded $ bytes.", stContentRead);
-        // We're done with the connection
-        return TS_OK;
-      } // Not processing headers?
-      if(!bHeaders)
-      { // Not processing headers? Processing content? Increment content read
-        stContentRead += stRead;
-        // Push data into RX list. Truncate bytes read if we have a content
-        // length and the we read past the content length.
-        PushDataSafe(plRX, stRX, mDest.MemPtr<char>(),
-          stContentLength && stContentRead > stContentLength ?
-            stRead - static_cast<size_t>(stContentLength - stContentRead) :
-            stRead);
-        // Have content length and at EOF? Log it
-        if(stContentLength && stContentRead == stContentLength)
-        { // All downloaded
-          SocketLogSafe(LH_DEBUG, "download complete.");
-          // So below scopes can jump here
-          return TS_OK;
-        } // Wait for next packet, thread abort or server disconnect.
-        continue;
-      } // Make string view of response which could contain binary chars
-      StdStringView ssvResp{ mDest.MemPtr<char>(), stRead };
-      // Find end of headers marker and if we do not have it yet?
-      const size_t stEnd = ssvResp.find(cCommon->CommonCrLf2());
-      if(stEnd == StdNPos)
-      { // Check for binary data and if we found binary data? Bail out!
-        if(!ValidHeaderPacket(ssvResp))
-          return SetErrorStaticSafe("Binary code in headers");
-        // Add to full headers string
-        strHeaders += ssvResp;
-        // Wait for next packet
+      { // Check the response unless a reused connection was closed before
+        // responding in which case send the request again on a new one.
+        if(!HTTPRetry()) return HTTPFinish();
+        if(InitialConnect() == TS_ERROR || HTTPSend(strPk) == TS_ERROR)
+          return TS_ERROR;
         continue;
-      } // Ok we got the headers. Collect data.
-      bHeaders = false;
-      // Get cut off point between headers to data and if we got it?
-      const size_t stInitial = ssvResp.size() - (stEnd + 4);
-      if(stInitial > 0)
-      { // Push data into RX list
-        PushDataSafe(plRX, stRX, mDest.MemRead(stEnd+4), stInitial);
-        // Increment content read
-        stContentRead += stInitial;
-        // Truncate extra bytes
-        ssvResp = { mDest.MemPtr<char>(), stEnd };
-      } // Check for binary code in the last packet returned? Bail out!
-      if(!ValidHeaderPacket(ssvResp))
-        return SetErrorStaticSafe("Binary code in headers!");
-      // Add rest of response to headers
-      strHeaders += ssvResp;
-      // Build output headers list by exploding header string
-      psvRegistry.ParserReInit(strHeaders, cCommon->CommonCrLf(), ':');
-      if(psvRegistry.empty()) return SetErrorStaticSafe("No response!");
-      // Done with the headers string
-      strHeaders.clear();
-      strHeaders.shrink_to_fit();
-      // Find initial reponse (should be #0 set by VARS class)
-      const StrNCStrMapConstIt
-        vlR{ GetRegistryIterator(cParent->strRegVarRESPONSE) };
-      if(vlR == psvRegistry.cend()) return SetErrorStaticSafe("Bad response!");
-      // Split into words. We should have got at least three words
-      const TokenStrView tsvWords{ vlR->second, cCommon->CommonSpaceV() };
-      if(tsvWords.size() < 3) return SetErrorStaticSafe("Unknown response!");
-      // Get protocol and if it is not valid?
-      const StdStringView &ssvProtoRecv = tsvWords.front();
-      if(ssvProtoRecv != "HTTP/1.0" && ssvProtoRecv != "HTTP/1.1")
-        return SetErrorStaticSafe(
-          StrFormat("Bad protocol '$'!", ssvProtoRecv));
-      // Get http status code string and if not a valid number?
-      const StdStringView &ssvStatus = tsvWords[1];
-      if(!StrIsInt(ssvStatus))
-        return SetErrorStaticSafe(StrFormat("Bad status '$'!", ssvStatus));
-      // Convert to integer and if valid?
-      const size_t stStatus = StrToNum<size_t>(ssvStatus);
-      if(stStatus < 100 || stStatus > 999)
-        return SetErrorStaticSafe(
-          StrFormat("Bad status code '$'!", ssvStatus));
-      // If the status code is anything but an error? Log successful code
-      if(stStatus < 400) SocketLogSafe(LH_DEBUG, "status code $.", ssvStatus);
-      // Error status code? Log error status code
-      else SocketLogSafe(LH_WARNING, "status error $!", ssvStatus);
-      // If connection upgrade required? Handle websocket if requested else
-      // throw an error because the socket might be left in a waiting state
-      // which our client expects the server to close the connection.
-      if(stStatus == 101)
-        return eMode == WEBSOCKET ? WebSocketMain(mDest):
-          SetErrorStaticSafe("Not upgrading");
-      // Add protocol and status code to registry so guest can read them
-      // without having to perform any special string operations
-      psvRegistry.ParserPushOrUpdatePair(cParent->strRegVarPROTO,
-        StdString{ ssvProtoRecv });
-      psvRegistry.ParserPushOrUpdatePair(cParent->strRegVarCODE,
-        StdString{ ssvStatus });
-      // We have to lock the TX list since a LUA function can read this
-      MutexCall([this](){
-        // Enumerate registry entries
-        for(const StrNCStrMapPair &sncsmpPair : psvRegistry)
-        { // Get items and push into TX since we're not using it anymore. Make
-          // sure to include the null-terminator so we can use StdStringView
-          // for when LUA grabs the list.
-          PushData(plTX, stTX,
-            StrToLowCaseRef(UtilToNonConst(sncsmpPair.first)).data(),
-            sncsmpPair.first.size() + 1);
-          PushData(plTX, stTX, sncsmpPair.second.data(),
-            sncsmpPair.second.size() + 1);
-        }
-      });
-      // If we got a content type?
-      const StrNCStrMapConstIt sncsmciType{
-        GetRegistryIterator("content-type") };
-      if(sncsmciType != psvRegistry.cend())
-        SocketLogSafe(LH_DEBUG, "content type is '$'.", sncsmciType->second);
-      // Should get content length
-      const StrNCStrMapConstIt sncsmciLen{
-        GetRegistryIterator("content-length") };
-      if(sncsmciLen != psvRegistry.cend())
-      { // Get reference to string and if it's not valid?
-        const StdString &strVal = sncsmciLen->second;
-        if(!StrIsInt(strVal))
-        { // Assume zero, safe to continue and log the warning
-          stContentLength = 0;
-          SocketLogSafe(LH_WARNING, "invalid content length!");
-        } // Valid content-length
-        else
-        { // Convert length string to integer and log the length
-          stContentLength = StrToNum<size_t>(strVal);
-          SocketLogSafe(LH_DEBUG, "content length is $ bytes.",
-            stContentLength);
-        } // Set downloading status
-        AddStatus(SS_DOWNLOADING);
-        // If we already got enough bytes from the header packet?
-        if(stInitial == stContentLength)
-          SocketLogSafe(LH_DEBUG, "downloaded esource in one packet.");
-        // If we got too many bytes? treat it as completed anyway
-        else if(stInitial > stContentLength)
-          SocketLogSafe(LH_WARNING, "downloaded resource ($ bytes excess)!",
-            stInitial - stContentLength);
-        // Keep waiting for data
-        else continue;
-        // Success
-        return TS_OK;
-      } // No content length and connection not closed
-      else
-      { // Set zero content length and downloading flag
-        stContentLength = 0;
-        AddStatus(SS_DOWNLOADING);
-      } // Wait for next packet, thread abort or server disconnect
+      }
+      // Process the data and return if finished
+      const ThreadStatus tsResult = HTTPProcess(mDest, stRead);
+      if(tsResult == TS_RUNNING) continue;
+      // Keep the connection for another request if the server allows it
+      if(tsResult == TS_OK && bKeepAlive) HTTPRelease();
+      // Done
+      return tsResult;
     } // Got here because the thread was aborted
     return SetAborted();
   }
@@ -1471,6 +2363,269 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     // Return status
     return tsReturn;
   }
+  /* -- Read from a non-blocking socket ------------------------------------ **
+  ** Returns the bytes read, zero if nothing is available yet or TS_ERROR.   **
+  ** ----------------------------------------------------------------------- */
+  size_t ReactorRead(char*const cpData, const size_t stSize)
+  { // Read what is available and if we got something? Account for it
+    const int iRead = BIO_read(bioPtr, cpData, static_cast<int>(stSize));
+    if(iRead > 0) return SockReadDone(static_cast<size_t>(iRead));
+    // Nothing available yet? Wait for the descriptor to be ready
+    if(BIO_should_retry(bioPtr)) return 0;
+    // Server closed the connection? Return error status but no socket error
+    if(!iRead)
+    { // Server closed the connection
+      FlagSet(SS_CLOSEDBYSERVER);
+      return static_cast<size_t>(TS_ERROR);
+    } // Read failed so set error and clean up
+    return static_cast<size_t>(SetErrorSafe("Read error!"));
+  }
+  /* -- Write to a non-blocking socket ------------------------------------- **
+  ** Returns the bytes written, zero if the socket is full or TS_ERROR.      **
+  ** ----------------------------------------------------------------------- */
+  size_t ReactorWrite(const char*const cpData, const size_t stSize)
+  { // Write what we can and if we wrote something? Account for it
+    const int iWritten = BIO_write(bioPtr, cpData, static_cast<int>(stSize));
+    if(iWritten > 0) return SockWriteDone(static_cast<size_t>(iWritten));
+    // Socket is full? Wait for the descriptor to be ready
+    if(BIO_should_retry(bioPtr)) return 0;
+    // Server closed the connection? Set error and clean up
+    if(!iWritten)
+    { // Server closed the connection so return that the server closed
+      FlagSet(SS_CLOSEDBYSERVER);
+      return static_cast<size_t>(SetErrorStaticSafe("EOF from server!"));
+    } // Write failed so set error and clean up
+    return static_cast<size_t>(SetErrorSafe("Send error!"));
+  }
+  /* -- Send as much of the HTTP request as possible ----------------------- */
+  ThreadStatus ReactorSendRequest()
+  { // Until the whole request is sent
+    while(stSent < strRequest.size())
+    { // Send what we can and return if error or the socket is full
+      const size_t stWritten =
+        ReactorWrite(strRequest.data() + stSent, strRequest.size() - stSent);
+      if(stWritten == static_cast<size_t>(TS_ERROR)) return TS_ERROR;
+      if(!stWritten) return TS_RUNNING;
+      // Sent some of the request
+      stSent += stWritten;
+    } // Request sent so wait for the response
+    HTTPRequestSent(strRequest.size());
+    // Done with the request unless it may have to be sent again because a
+    // reused connection was closed by the server.
+    if(!bReused) { strRequest.clear(); strRequest.shrink_to_fit(); }
+    // Success
+    return TS_OK;
+  }
+  /* -- Send as many queued packets as possible ---------------------------- */
+  ThreadStatus ReactorSendPackets()
+  { // For each packet waiting to be written
+    while(IsTXPacketAvailable())
+    { // Get oldest available TX packet and until all of it is sent
+      const MemConst &mcPacket = GetOldestTXPacketSafe();
+      while(stSent < mcPacket.MemSize())
+      { // Send what we can and return if error or the socket is full
+        const size_t stLeft = mcPacket.MemSize() - stSent,
+          stWritten = ReactorWrite(mcPacket.MemRead(stSent, stLeft), stLeft);
+        if(stWritten == static_cast<size_t>(TS_ERROR)) return TS_ERROR;
+        if(!stWritten) return TS_RUNNING;
+        // Sent some of the packet
+        stSent += stWritten;
+      } // Subtract total bytes counter and pop the packet we just sent
+      MutexCall([this, &mcPacket](){
+        stTX -= mcPacket.MemSize();
+        plTX.pop_front();
+      });
+      // Nothing sent of the next packet
+      stSent = 0;
+    } // All packets sent
+    return TS_OK;
+  }
+  /* -- Receive as much data as possible ----------------------------------- */
+  ThreadStatus ReactorReceive(Memory &mDest)
+  { // Until there is nothing more to read
+    for(;;)
+    { // Read what is available
+      const size_t stRead =
+        ReactorRead(mDest.MemPtr<char>(), mDest.MemSize());
+      // Error or nothing available? Return error or wait for more
+      if(stRead == static_cast<size_t>(TS_ERROR)) return TS_ERROR;
+      if(!stRead) return TS_RUNNING;
+      // Receiving a HTTP response? Process the data and return if finished
+      if(bHTTP)
+      { // Process the data and return if finished
+        const ThreadStatus tsResult = HTTPProcess(mDest, stRead);
+        if(tsResult != TS_RUNNING) return tsResult;
+      } // Receiving raw data?
+      else
+      { // Push data block into list ready for LUA to collect
+        PushDataSafe(plRX, stRX, mDest.MemPtr<char>(), stRead);
+        // Send read event
+        DispatchEvent(SS_READPACKET);
+      }
+    }
+  }
+  /* -- Retry a request that failed on a reused connection ----------------- */
+  ThreadStatus ReactorRetry(Memory &mDest, unsigned &uWant, bool &bForce)
+  { // Return the error if it can't be retried
+    if(!HTTPRetry()) return TS_ERROR;
+    // Connect again. The new descriptor might have the same number as the
+    // old one so it must be registered again.
+    rsState = RS_SETUP;
+    bForce = true;
+    return ReactorAdvance(mDest, uWant, bForce);
+  }
+  /* -- Advance the connection as far as possible without blocking --------- **
+  ** Returns TS_RUNNING and sets the events to wait for while the socket     **
+  ** still needs the reactor else the final status of the connection.        **
+  ** ----------------------------------------------------------------------- */
+  ThreadStatus ReactorAdvance(Memory &mDest, unsigned &uWant, bool &bForce)
+  { // What state is the connection in?
+    switch(rsState)
+    { // Creating the context and socket?
+      case RS_SETUP:
+      { // Reuse an idle connection to the same server if there is one unless
+        // we are retrying a request that failed on a reused connection.
+        if(bHTTP && strRequest.empty() && HTTPReuse())
+        { // Make sure it doesn't block and wait on the new descriptor
+          BIO_socket_nbio(aiFd, 1);
+          bForce = true;
+          // Build the request to send
+          strRequest = HTTPBuildRequest();
+          stSent = 0;
+          rsState = RS_REQUEST;
+          return ReactorAdvance(mDest, uWant, bForce);
+        } // Create the context and socket and set the address to connect to
+        if(ConnectSetup() == TS_ERROR) return TS_ERROR;
+        // Don't let OpenSSL block the event thread
+        BIO_set_nbio(bioPtr, 1);
+        // Report that we are connecting
+        if(ConnectStart() == TS_ERROR) return TS_ERROR;
+        // Start connecting
+        rsState = RS_CONNECT;
+        [[fallthrough]];
+      } // Connecting and handshaking?
+      case RS_CONNECT:
+      { // Step the connect and handshake and if it has not finished?
+        if(BIO_do_connect(bioPtr) != 1)
+        { // Connect failed? Set error and clean up
+          if(!BIO_should_retry(bioPtr))
+            return SetErrorSafe("Connect failed!");
+          // OpenSSL may have moved on to another address with a new socket
+          // so get the descriptor again and make sure it is waited on.
+          UpdateDescriptor();
+          uWant = BIO_should_read(bioPtr) ?
+            SocketReactor::RW_READ : SocketReactor::RW_WRITE;
+          bForce = true;
+          // Wait for the descriptor to be ready
+          return TS_RUNNING;
+        } // Store the address we connected to
+        if(ConnectAddress() == TS_ERROR) return TS_ERROR;
+        // Check the negotiated encryption if this is a secure connection
+        if(IsSecure() && ConnectVerify() == TS_ERROR) return TS_ERROR;
+        // Now connected
+        ConnectEstablished();
+        // Not a HTTP request? Send and receive raw data
+        if(!bHTTP)
+        { // Send and receive raw data
+          rsState = RS_DATA;
+          return ReactorAdvance(mDest, uWant, bForce);
+        } // Build the request to send unless we are retrying it
+        if(strRequest.empty()) strRequest = HTTPBuildRequest();
+        stSent = 0;
+        rsState = RS_REQUEST;
+        [[fallthrough]];
+      } // Sending HTTP request?
+      case RS_REQUEST:
+      { // Send what we can of the request and wait if socket full or error
+        const ThreadStatus tsResult = ReactorSendRequest();
+        if(tsResult == TS_RUNNING) uWant = SocketReactor::RW_WRITE;
+        if(tsResult == TS_ERROR) return ReactorRetry(mDest, uWant, bForce);
+        if(tsResult != TS_OK) return tsResult;
+        // Request sent so wait for the response
+        rsState = RS_RESPONSE;
+        [[fallthrough]];
+      } // Receiving HTTP response?
+      case RS_RESPONSE:
+      { // Process what we can and check the response if the connection ended
+        uWant = SocketReactor::RW_READ;
+        const ThreadStatus tsResult = ReactorReceive(mDest);
+        if(tsResult == TS_ERROR)
+        { // Reused connection closed before responding? Send it again on a
+          // new connection else check the response.
+          if(bReused && !aullRX) return ReactorRetry(mDest, uWant, bForce);
+          return HTTPFinish();
+        }
+        // Keep the connection for another request if the server allows it
+        if(tsResult == TS_OK && bKeepAlive) HTTPRelease();
+        // Done or waiting for more data
+        return tsResult;
+      } // Sending and receiving raw data?
+      case RS_DATA:
+      { // Receive what we can and return if error
+        if(ReactorReceive(mDest) == TS_ERROR) return TS_ERROR;
+        // Send what we can and wait to write more if the socket is full
+        switch(ReactorSendPackets())
+        { // Error? Clean up
+          case TS_ERROR: return TS_ERROR;
+          // Socket full? Wait to read or write
+          case TS_RUNNING: uWant = SocketReactor::RW_BOTH; break;
+          // Everything sent? Wait for more data to read
+          default: uWant = SocketReactor::RW_READ; break;
+        } // Keep waiting for data
+        return TS_RUNNING;
+      } // Should never get here
+      default: return SetErrorStaticSafe("Invalid reactor state!");
+    }
+  }
+  /* -- Connection finished so stop the reactor and clean up --------------- */
+  void ReactorFinish()
+  { // Stop the reactor driving the socket
+    srReactor->mSockets.MutexCall([this](){
+      srReactor->ReactorRemove(Serial()); });
+    // Clear connection and clean-up
+    SocketClose();
+    FinishDisconnect();
+  }
+  /* -- Check if the connection stalled for too long ----------------------- */
+  bool ReactorTimedOut(const ClkDuration cdNow) const
+  { // Never time out if the receive timeout is disabled
+    const double dTimeout = cParent->adRecvTimeout;
+    if(dTimeout <= 0) return false;
+    // Get the time of the last activity on the socket
+    const ClkDuration cdLast{ UtilMaximum(
+      UtilMaximum(acdConnect.load().count(), acdConnected.load().count()),
+      UtilMaximum(acdRead.load().count(), acdWrite.load().count())) };
+    // Return if there was no activity for longer than the timeout
+    return duration<double>{ cdNow - cdLast }.count() > dTimeout;
+  }
+  /* -- Drive the socket from a shared event thread if enabled ------------- */
+  bool ReactorAttach(const bool bNHTTP)
+  { // Use own threads if shared event threads are disabled
+    srReactor = nullptr;
+    const size_t stCount = cParent->stReactors;
+    if(!stCount) return false;
+    // Find the event thread driving the least sockets
+    size_t stBest = 0;
+    for(size_t stIndex = 1; stIndex < stCount; ++stIndex)
+      if(cParent->sraReactors[stIndex].astSockets <
+         cParent->sraReactors[stBest].astSockets) stBest = stIndex;
+    SocketReactor &srBest = cParent->sraReactors[stBest];
+    // Start the event thread if needed and use own threads if it failed
+    if(!srBest.ReactorStart(stBest, cParent->astBufferSize))
+    { // Log the failure and use own threads
+      SocketLogSafe(LH_WARNING, "shared event thread failed: $!",
+        StrFromErrNo());
+      return false;
+    } // Setup the connection progress
+    rsState = RS_SETUP;
+    bHTTP = bNHTTP;
+    stSent = 0;
+    // Ask the event thread to start connecting
+    srReactor = &srBest;
+    srReactor->ReactorAdd(this, Serial());
+    // Success
+    return true;
+  }
   /* -- Error occured in event so start cleaning up ------------------------ */
   void EventError()
   { // Add error flag
@@ -1639,9 +2794,47 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     return EventError();
   } // Exception occured? Cleanup and rethrow exception
   catch(const StdException &) { EventError(); throw; }
+  /* -- Advance the socket from its shared event thread -------------------- **
+  ** The reactor does not hold its socket list lock while this is called so  **
+  ** a slow connect or name lookup does not stall other threads.             **
+  ** ----------------------------------------------------------------------- */
+  void ReactorDoStep(SocketReactor::Item &iItem, const ClkDuration cdNow) try
+  { // Events to wait for and if they must be registered again
+    unsigned uWant = iItem.uWant;
+    bool bForce = false;
+    // Advance the connection unless it stalled for too long
+    const ThreadStatus tsResult = ReactorTimedOut(cdNow) ?
+      SetErrorStaticSafe("Read error or timeout!") :
+      ReactorAdvance(srReactor->mBuffer, uWant, bForce);
+    // Still in progress? Wait for the requested events
+    if(tsResult == TS_RUNNING)
+      return srReactor->ReactorSet(iItem, Serial(), aiFd, uWant, bForce);
+    // Connection finished so clean up
+    ReactorFinish();
+  } // exception occured?
+  catch(const StdException &eReason)
+  { // Report the error and clean up
+    SocketLogSafe(LH_ERROR, "(SOCKET REACTOR EXCEPTION) $", eReason.what());
+    SetErrorStaticSafe(eReason.what());
+    ReactorFinish();
+  }
+  /* -- Step the socket and close it if asked to while it was stepped ------ */
+  void ReactorStep(SocketReactor::Item &iItem, const ClkDuration cdNow)
+  { // Advance the connection
+    ReactorDoStep(iItem, cdNow);
+    // Finish the step and close the socket if it was asked to meanwhile. The
+    // socket might be destroyed as soon as the step has finished so don't
+    // touch it afterwards.
+    SocketReactor &srRef = *srReactor;
+    const uint64_t ullId = Serial();
+    if(srRef.ReactorStepEnd(ullId))
+      { ReactorFinish(); srRef.ReactorStepEnd(ullId); }
+  }
   /* -- Send request to disconnect ----------------------------------------- */
   bool SendDisconnectAndWait()
-  { // Send disconnect to socket
+  { // Driven by a shared event thread? Wait for it to finish stepping
+    if(srReactor) return SendDisconnect(true);
+    // Send disconnect to socket
     SendDisconnect();
     // Have read thread running?
     if(tReader.ThreadIsJoinable())
@@ -1703,7 +2896,42 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     });
   }
   /* -- Send request to disconnect ----------------------------------------- */
-  bool SendDisconnect()
+  bool SendDisconnect(const bool bWait=false)
+  { // Using own threads or called from the shared event thread? Just close
+    if(!srReactor || srReactor->tReactor.ThreadIsCurrent())
+      return SocketClose();
+    // Stop the shared event thread driving the socket first so it cannot
+    // touch the socket while it is being cleaned up.
+    return srReactor->mSockets.MutexUniqueCall([this, bWait]
+      (UniqueLock &ulSockets){
+      // Wait until the event thread has finished stepping the socket if
+      // requested as the socket might be destroyed after.
+      const uint64_t ullId = Serial();
+      if(bWait) srReactor->cvStepped.wait(ulSockets, [this, ullId](){
+        return srReactor->ullStepping != ullId; });
+      // Ignore if already disconnecting
+      if(IsDisconnectingOrDisconnected()) return false;
+      // The event thread is stepping the socket right now?
+      if(srReactor->ullStepping == ullId)
+      { // Find the socket and ignore if we don't drive it anymore
+        const SocketReactor::ItemMapIt
+          imiIt{ srReactor->imSockets.find(ullId) };
+        if(imiIt == srReactor->imSockets.end()) return false;
+        // Ask the event thread to close it after the step
+        imiIt->second.bClose = true;
+        // Closing
+        return true;
+      } // Stop the reactor driving the socket
+      srReactor->ReactorRemove(Serial());
+      // Clear connection and clean-up
+      SocketClose();
+      FinishDisconnect();
+      // Closing
+      return true;
+    });
+  }
+  /* -- Close the socket --------------------------------------------------- */
+  bool SocketClose()
   { // Ignore if already disconnecting
     if(IsDisconnectingOrDisconnected()) return false;
     // If the connection was closed by the server then it's a clean exit
@@ -1742,6 +2970,8 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     SetAddressAndCipher(ssvAddress, uNPort, ssvCipher);
     // Init LUA references
     LuaEvtInitEx(lS);
+    // Start connecting on a shared event thread if enabled
+    if(ReactorAttach(false)) return;
     // Initialise thread and start the connection process
     tReader.ThreadInit(StrAppend("socketreader:", Serial()),
       bind(&Socket::SockReadThreadMain, this, _1), this);
@@ -1751,7 +2981,7 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     const StdStringView &ssvCipher,  const StdStringView &ssvAddress,
     const unsigned uNPort, const StdStringView &ssvRequest,
     const StdStringView &ssvMethod, const StdStringView &ssvHeaders,
-    const StdStringView &ssvBody)
+    const StdStringView &ssvBody, const StdStringView &ssvFile)
   { // Initialise name
     NameSet(ssvName);
     // Request must begin with a forward slash
@@ -1782,8 +3012,16 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     else
     { // Set chosen method
       ssvChosenMethod = ssvMethod;
-      // Disable keep-alive, we don't support it (yet?).
-      psvRegistry.ParserPushPair("Connection", "close");
+      // Keep the connection open for more requests if idle connections are
+      // enabled.
+      bPool = cParent->spPool.PoolEnabled();
+      psvRegistry.ParserPushPair("Connection",
+        bPool ? "keep-alive" : "close");
+      // Ask for compressed content and decode it as it arrives unless the
+      // guest asked for a specific encoding.
+      bDecode = GetRegistryIterator("Accept-Encoding") == psvRegistry.cend();
+      if(bDecode)
+        psvRegistry.ParserPushPair("Accept-Encoding", "gzip, deflate");
     } // Find if the request contains a bookmark fragment
     const size_t stFrag = ssvRequest.find('#');
     // Format the request
@@ -1797,7 +3035,7 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
       { "Host", strAddrPort },
       // Push the formulated request line. Remove the right hand fragment from
       // the URL if neccesary.
-      { cParent->strRegVarREQ, StrFormat("$ $ HTTP/1.0\r\n",
+      { cParent->strRegVarREQ, StrFormat("$ $ HTTP/1.1\r\n",
           ssvChosenMethod, StrUrlEncodeSpaces(strRequest())) },
       // Push method because we need to check if this is a HEAD request and
       // thus to know when to expect no output.
@@ -1810,8 +3048,20 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
       // Add body text
       { cParent->strRegVarBODY, StdString{ ssvBody } }
     });
-    // Init LUA references
+    // Write the body to a file as it arrives if requested
+    if(!ssvFile.empty())
+    { // Websockets don't have a body to write
+      if(ssvMethod == "WS")
+        XC("Websocket cannot be written to a file!", "File", ssvFile);
+      // Create the file and throw if failed
+      if(const int iError = fsSink.FStreamOpen(ssvFile, FM_W_B))
+        XC("Failed to create download file!",
+           "File", ssvFile, "Reason", StrFromErrNo(iError));
+    } // Init LUA references
     LuaEvtInitEx(lS);
+    // Start the request on a shared event thread if enabled. Websockets
+    // still need their own reader and writer threads.
+    if(ssvMethod != "WS" && ReactorAttach(true)) return;
     // Initialse thread and start the connection process
     tReader.ThreadInit(StrAppend("sockethttp:", Serial()),
       bind(&Socket::SocketHTTPThreadMain, this, _1), this);
@@ -1831,6 +3081,23 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     tReader{ STP_LOW },                // Low priority reader thread
     tWriter{ STP_LOW },                // Low priority writer thread
     bUnlock(false),                    // Block sock writer thread
+    srReactor(nullptr),                // Not using a shared event thread
+    rsState(RS_SETUP),                 // Reactor not connecting yet
+    bHTTP(false),                      // Not a HTTP request
+    stSent(0),                         // Nothing sent yet
+    hmMode(HM_HTTP),                   // Normal HTTP request
+    stContentRead(0),                  // No body received yet
+    stContentLength(0),                // No body length yet
+    bHeaders(true),                    // Waiting for headers
+    bPool(false),                      // Not using idle connections
+    bReused(false),                    // Connection not reused
+    bKeepAlive(false),                 // Connection not reusable
+    csChunk(CS_NONE),                  // Body not chunked
+    stChunk(0),                        // No chunk data left
+    bDecode(false),                    // Not asking for compressed content
+    bInflate(false),                   // Not inflating
+    bInflateRaw(false),                // Not trying raw deflate
+    zsInflate{},                       // No inflate context
     uPort(0),                          // No port
     aiError(0),                        // No error
     aiFd(-1),                          // Invalid file descriptor
@@ -1839,8 +3106,8 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
     {}
   /* -- Destructor --------------------------------------------------------- */
   DTORHELPER(~Socket,
-    // Send disconnect to socket
-    SendDisconnect();
+    // Send disconnect to socket and wait for the event thread to let go
+    SendDisconnect(true);
     // Have read thread running? Tell the thread to stop and wait for it. The
     // end of the thread should call FinishDisconnect() already.
     if(tReader.ThreadIsJoinable()) tReader.ThreadStopNoThrow();
@@ -1858,12 +3125,53 @@ static void DestroyAllSockets()
   cLog->LogInfoExSafe("Sockets closed all connections [$]!",
     cSockets->size());
 }
+/* -- Shared event thread driving many non-blocking sockets ---------------- */
+static ThreadStatus SocketReactorThreadMain(Thread &tThread)
+{ // Get the reactor this thread is for
+  SocketReactor &srRef = *tThread.ThreadGetParam<SocketReactor>();
+  // Sockets to step that were not reported ready by the event poll
+  SocketReactor::SerialList slStep;
+  // Time all sockets were last checked for timeouts
+  ClkDuration cdChecked{ cmHiRes.GetEpochTime() };
+  // Loop until thread should exit
+  while(tThread.ThreadShouldNotExit())
+  { // Wait for events or wake requests
+    srRef.ReactorWait(250);
+    srRef.ReactorTakeWake(slStep);
+    // Step every socket once a second so stalled sockets can time out
+    const ClkDuration cdNow{ cmHiRes.GetEpochTime() };
+    if(cdNow - cdChecked >= cd1S)
+    { // Add every socket and record when we did it
+      srRef.mSockets.MutexCall([&srRef, &slStep](){
+        for(const auto &[ullId, iItem] : srRef.imSockets)
+          slStep.push_back(ullId); });
+      cdChecked = cdNow;
+    } // Step a socket if we still drive it. The socket list is only locked
+    // to find the socket so other threads are never blocked by a slow step.
+    const auto fStep = [&srRef, cdNow](const uint64_t ullId){
+      SocketReactor::Item*const iPtr = srRef.ReactorStepBegin(ullId);
+      if(iPtr) iPtr->sPtr->ReactorStep(*iPtr, cdNow);
+    };
+    // Step sockets that are ready and sockets that asked to be stepped
+    for(const uint64_t ullId : srRef.slReady) fStep(ullId);
+    for(const uint64_t ullId : slStep) fStep(ullId);
+    // Done with the requests
+    slStep.clear();
+  } // Clean up OpenSSL data for this thread
+  OPENSSL_thread_stop();
+  // Terminate thread
+  return TS_OK;
+}
 /* ------------------------------------------------------------------------- */
 static void DeInitSockets()
 { // Deregister event so callbacks cannot fire
   cEvtMain->Unregister(EMC_MP_SOCKET);
   // Close all socket
   DestroyAllSockets();
+  // Stop all shared event threads
+  for(SocketReactor &srRef : cSockets->sraReactors) srRef.ReactorStop();
+  // Close idle connections and forget sessions
+  cSockets->spPool.PoolFlush();
 }
 /* ------------------------------------------------------------------------- */
 static void InitSockets()
@@ -1889,7 +3197,8 @@ CTOR_END(Sockets, Socket, SOCKET, InitSockets(), DeInitSockets(),,
   ssvRX{ "RX" }, ssvTX{ "TX" },        // RX and TX strings
   aullRX(0), aullTX(0),                // Init received and sent bytes
   aullRXp(0), aullTXp(0),              // Init received and sent packets
-  astConnected(0)                      // Init sockets connected
+  astConnected(0),                     // Init sockets connected
+  stReactors(0)                        // Init no shared event threads
 ) /* ======================================================================= */
 static size_t SocketWaitAsync()
 { // No sockets? Ignore
@@ -1918,6 +3227,32 @@ static size_t SocketReset()
   // Return number of connections reset
   return static_cast<size_t>(stClosed);
 }
+/* -- Set number of shared event threads (0 = thread pair per socket) ------ */
+static CVarReturn SocketSetReactors(const size_t stCount)
+{ // Not implemented on Windows yet so only allow own threads
+#if defined(WINDOWS)
+  return stCount ? DENY : ACCEPT;
+#else
+  return CVarSimpleSetIntNG(cSockets->stReactors, stCount,
+    cSockets->sraReactors.size());
+#endif
+}
+/* -- Set seconds an idle keep-alive connection is kept (0 = disabled) ----- */
+static CVarReturn SocketSetKeepAlive(const double dNew)
+{ // Set the new time and close connections that have been idle for longer
+  const CVarReturn cvrResult{
+    CVarSimpleSetIntNLG(cSockets->spPool.adIdle, dNew, 0, 3600) };
+  cSockets->spPool.PoolLimit();
+  return cvrResult;
+}
+/* -- Set maximum number of idle keep-alive connections kept --------------- */
+static CVarReturn SocketSetKeepAliveMax(const size_t stCount)
+{ // Set the new limit and close the oldest connections over it
+  const CVarReturn cvrResult{
+    CVarSimpleSetIntNG(cSockets->spPool.astMax, stCount, 256UL) };
+  cSockets->spPool.PoolLimit();
+  return cvrResult;
+}
 /* -- OCSP options --------------------------------------------------------- */
 static CVarReturn SocketOCSPModified(const int iState)
   { return CVarSimpleSetIntNG(cSockets->aiOCSP, iState, 2); }
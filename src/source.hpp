@@ -7,7 +7,10 @@
 ** ## manage the collector list with concurrency locks instead of the     ## **
 ** ## ICHelper class. The Lockable class is also used for a different     ## **
 ** ## reason to all the other interfaces to stop the source from being    ## **
-** ## deleted while it is in use by the engine and not OpenAL.            ## **
+** ## deleted while it is in use by the engine and not OpenAL. Idle       ## **
+** ## sources are found by the audio thread and kept in a free list so    ## **
+** ## getting one is cheap, and when none are left the least important    ## **
+** ## playing sample source is stolen.                                    ## **
 ** ######################################################################### **
 ** ========================================================================= */
 #pragma once                           // Only one incursion allowed
@@ -18,20 +21,24 @@ using namespace ICollector::P;         using namespace ICVarDef::P;
 using namespace IFlags::P;             using namespace ILockable::P;
 using namespace ILog::P;               using namespace ILuaIdent::P;
 using namespace ILuaLib::P;            using namespace ILuaUtil::P;
-using namespace IName::P;              using namespace IOal::P;
-using namespace ISerial::P;            using namespace IStd::P;
-using namespace ISysUtil::P;           using namespace IUtil::P;
-using namespace Lib::OpenAL::Types;
+using namespace IMutex::P;             using namespace IName::P;
+using namespace IOal::P;               using namespace ISerial::P;
+using namespace IStd::P;               using namespace ISysUtil::P;
+using namespace IUtil::P;              using namespace Lib::OpenAL::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Public typedefs ------------------------------------------------------ */
-BUILD_FLAGS(Source,                    // Source flags
+BUILD_SECURE_FLAGS(Source,             // Source flags
   /* ----------------------------------------------------------------------- */
   SF_NONE                   {Flag(0)}, // No flags
   SF_EXTERNAL               {Flag(1)}, // Source is managed externally
   SF_CLASS                  {Flag(2)}  // Source is managed by LUA
 );/* -- Source collector class for collector data and custom variables ----- */
-CTOR_BEGIN(Sources, Source, CLHelperSafe, size_t stSources;);
+CTOR_BEGIN(Sources, Source, CLHelperSafe,
+/* -- Public variables ----------------------------------------------------- */
+MutexLock          mlFree;             // Serialise free list with audio thread
+StdVector<Source*> svFree;             // Idle sources found by audio thread
+size_t             stSources;);        // Number of sources to preallocate
 /* ------------------------------------------------------------------------- */
 CTOR_MEM_BEGIN_CSLAVE(Sources, Source, ICHelperSafe),
   /* -- Base classes ------------------------------------------------------- */
@@ -39,6 +46,8 @@ CTOR_MEM_BEGIN_CSLAVE(Sources, Source, ICHelperSafe),
   public SourceFlags                   // Source flags
 { /* -- Private variables -------------------------------------------------- */
   ALuint           aluId;              // Source id
+  unsigned         uPriority;          // Priority of what is playing
+  bool             bFree;              // Source is in the free list
   /* -- Get/set source float ----------------------------------------------- */
   void SetSourceFloat(const ALenum aleP, const ALfloat alfV) const
     { AL(cOal->SetSourceFloat(aluId, aleP, alfV), "Set source float failed!",
@@ -113,6 +122,20 @@ CTOR_MEM_BEGIN_CSLAVE(Sources, Source, ICHelperSafe),
   /* -- Get/set externally managed by LUA source --------------------------- */
   bool GetClass() const { return FlagIsSet(SF_CLASS); }
   void SetClass(const bool bState) { FlagSetOrClear(SF_CLASS, bState); }
+  /* -- Get/set priority of what is playing -------------------------------- */
+  unsigned GetPriority() const { return uPriority; }
+  void SetPriority(const unsigned uNPriority) { uPriority = uNPriority; }
+  /* -- Get/set if source is in the free list (mlFree locked) -------------- */
+  bool GetFree() const { return bFree; }
+  void SetFree(const bool bState) { bFree = bState; }
+  /* -- Return how audible the source is for voice stealing ---------------- */
+  ALfloat GetAudibility() const
+  { // Get position and the distance from the listener
+    ALfloat alfX, alfY, alfZ;
+    GetPosition(alfX, alfY, alfZ);
+    // Attenuate the gain by the distance
+    return GetGain() / (1.0f + sqrtf(alfX * alfX + alfY * alfY + alfZ * alfZ));
+  }
   /* -- Get/set elapsed time ----------------------------------------------- */
   ALfloat GetElapsed() const { return GetSourceFloat(AL_SEC_OFFSET); }
   void SetElapsed(const ALfloat alfSeconds) const
@@ -291,7 +314,9 @@ CTOR_MEM_BEGIN_CSLAVE(Sources, Source, ICHelperSafe),
     ICHelperSource{ cSources, this },  // Register in Sources list
     SerialSlave{ cParent->Serial() },  // Initialise identification number
     SourceFlags{ sfFlags },            // Set source managed flags
-    aluId(cOal->CreateSource())        // Initialise a new source from OpenAL
+    aluId(cOal->CreateSource()),       // Initialise a new source from OpenAL
+    uPriority(0),                      // Lowest priority
+    bFree(false)                       // Not in the free list yet
     /* -- Check for CreateSource error or initialise ----------------------- */
     { // Generate source
       ALNF("Error generating al source id!");
@@ -300,6 +325,14 @@ CTOR_MEM_BEGIN_CSLAVE(Sources, Source, ICHelperSafe),
     }
   /* -- Destructor --------------------------------------------------------- */
   DTORHELPER(~Source,
+    // Remove the collector registration to stop audio thread polling
+    ICHelperSource::CollectorUnregister();
+    // Remove from the free list if it is in there
+    cParent->mlFree.MutexCall([this](){
+      if(!bFree) return;
+      StdVector<Source*> &svFree = cParent->svFree;
+      svFree.erase(StdFind(seq, svFree.cbegin(), svFree.cend(), this));
+    });
     // Delete the sourcess if id allocated
     if(aluId) ALL(cOal->DeleteSource(aluId),
       "Source failed to delete $!", aluId);
@@ -338,6 +371,9 @@ static void SourceDeInit()
   // Walk through the sources, only deleting the ones that aren't LUA owned
   const size_t stSources = cSources->size();
   cLog->LogDebugExSafe("Sources de-initialising $ objects...", stSources);
+  // Empty the free list as the audio thread is not running
+  for(Source*const sCptr : cSources->svFree) sCptr->SetFree(false);
+  cSources->svFree.clear();
   // Get first item and repeat until...
   SourcesIt siIt{ cSources->begin() };
   do
@@ -366,25 +402,83 @@ static void SourceReInit()
   for(Source*const soPtr : *cSources) soPtr->ReInit();
   cLog->LogInfoExSafe("Sources reinitialised $ objects.", cSources->size());
 }
-/* == Manage sources (from audio thread) =================================== */
+/* == Find idle sources and add them to the free list (audio thread) ======= */
+static void SourceManage()
+{ // Lock access to sources list and free list
+  cSources->MutexCall([](){
+    cSources->mlFree.MutexCall([](){
+      // Add each source that is not managed elsewhere and stopped playing.
+      // A source taken from the free list stays external until it has been
+      // played so it cannot be added back before it starts playing.
+      for(Source*const sCptr : *cSources)
+        if(!sCptr->GetFree() && !sCptr->GetExternal() && !sCptr->IsPlaying())
+        { sCptr->SetFree(true); cSources->svFree.push_back(sCptr); }
+    });
+  });
+}
+/* == Get a source from the free list ====================================== */
 static Source *SourceGetFree()
-{ // Iterate through available sources
-  for(Source*const sCptr : *cSources)
-  { // Is a locked stream? Then it's active and locked!
-    if(sCptr->GetExternal() || sCptr->IsPlaying()) continue;
-    // Reset source and return it
-    sCptr->Reset();
+{ // Take the most recently freed source from the free list
+  Source*const sCptr = cSources->mlFree.MutexCall([]()->Source*{
+    StdVector<Source*> &svFree = cSources->svFree;
+    if(svFree.empty()) return nullptr;
+    Source*const sCptr = svFree.back();
+    svFree.pop_back();
+    // Mark the source as ours before the audio thread can free it again
+    sCptr->SetFree(false);
+    sCptr->SetExternal(true);
     return sCptr;
-  } // Couldn't find one
-  return nullptr;
+  }); // Reset source and return it if we got one
+  if(sCptr) sCptr->Reset();
+  return sCptr;
+}
+/* == Steal the least important sample source ============================== */
+static Source *SourceSteal(const unsigned uPriority)
+{ // Find the least important source with the same or lower priority
+  Source*const sCptr = cSources->MutexCall([uPriority]()->Source*{
+    Source *sCptrSteal = nullptr;
+    unsigned uPriorityMin = uPriority;
+    ALfloat alfAudibilityMin = StdLimits<ALfloat>::max();
+    for(Source*const sCptr : *cSources)
+    { // Ignore sources managed elsewhere or more important
+      if(sCptr->GetExternal() || sCptr->GetPriority() > uPriorityMin)
+        continue;
+      // Ignore if same priority and more audible
+      const ALfloat alfAudibility = sCptr->GetAudibility();
+      if(sCptr->GetPriority() == uPriorityMin &&
+         alfAudibility >= alfAudibilityMin) continue;
+      // This is the least important source so far
+      sCptrSteal = sCptr;
+      uPriorityMin = sCptr->GetPriority();
+      alfAudibilityMin = alfAudibility;
+    } // Mark the source as ours before the audio thread can free it
+    if(sCptrSteal) sCptrSteal->SetExternal(true);
+    return sCptrSteal;
+  }); // Return if nothing could be stolen
+  if(!sCptr) return nullptr;
+  // Stop it and remove it from the free list if it finished meanwhile
+  sCptr->Stop();
+  cSources->mlFree.MutexCall([sCptr](){
+    if(!sCptr->GetFree()) return;
+    StdVector<Source*> &svFree = cSources->svFree;
+    svFree.erase(StdFind(seq, svFree.cbegin(), svFree.cend(), sCptr));
+    sCptr->SetFree(false);
+  }); // Log, reset and return the stolen source
+  cLog->LogDebugExSafe("Source $ stolen for priority $.",
+    sCptr->GetSource(), uPriority);
+  sCptr->Reset();
+  return sCptr;
 }
 /* == Returns if we can make a new source ================================== */
 static bool SourceCanMakeNew()
   { return cSources->size() < cOal->GetMaxMonoSources(); }
 /* == Get a source using Lua to allocate it ================================ */
-static Source *SourceGetFromLua(lua_State*const lS)
-{ // Try to get a used source and if failed?
-  if(Source*const soNew = SourceGetFree())
+static Source *SourceGetFromLua(lua_State*const lS,
+  const unsigned uPriority = 0)
+{ // Try to get a used source or steal one if we can't make a new one
+  Source*const soOld = SourceGetFree();
+  if(Source*const soNew = soOld ? soOld :
+       (SourceCanMakeNew() ? nullptr : SourceSteal(uPriority)))
   { // Set that this is a LUA managed class
     soNew->SetClass(true);
     // Return reused class
@@ -399,11 +493,11 @@ static Source *SourceGetFromLua(lua_State*const lS)
   return soNew;
 }
 /* == Return a free source ================================================= */
-static Source *GetSource()
+static Source *GetSource(const unsigned uPriority = 0)
 { // Try to get an idle source and return it if possible
   if(Source*const soNew = SourceGetFree()) return soNew;
-  // Else return a brand new source
-  return SourceCanMakeNew() ? new Source : nullptr;
+  // Else return a brand new source or steal a less important one
+  return SourceCanMakeNew() ? new Source : SourceSteal(uPriority);
 }
 /* == SourceAlloc ========================================================== */
 static bool SourceAlloc(const size_t stCount)
@@ -14,17 +14,20 @@ using namespace IAsset::P;             using namespace IClock::P;
 using namespace ICmdLine::P;           using namespace ICommon::P;
 using namespace ICollector::P;         using namespace ICrypt::P;
 using namespace ICVarDef::P;           using namespace IDir::P;
-using namespace IError::P;             using namespace IFlags::P;
-using namespace IFrame::P;             using namespace IInterval::P;
-using namespace ILockable::P;          using namespace ILog::P;
-using namespace ILookupArray::P;       using namespace ILuaBase::P;
-using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace ILuaUtil::P;           using namespace IPSplit::P;
+using namespace IError::P;             using namespace IEvtMain::P;
+using namespace IFlags::P;             using namespace IFrame::P;
+using namespace IInterval::P;          using namespace ILockable::P;
+using namespace ILog::P;               using namespace ILookupArray::P;
+using namespace ILuaBase::P;           using namespace ILuaEvt::P;
+using namespace ILuaFunc::P;           using namespace ILuaIdent::P;
+using namespace ILuaLib::P;            using namespace ILuaUtil::P;
+using namespace IMutex::P;             using namespace IPSplit::P;
 using namespace IMemory::P;            using namespace IName::P;
 using namespace ISerial::P;            using namespace IStd::P;
 using namespace IString::P;            using namespace ISystem::P;
-using namespace ISysUtil::P;           using namespace ITime::P;
-using namespace IUtil::P;              using namespace Lib::Sqlite;
+using namespace ISysUtil::P;           using namespace IThread::P;
+using namespace ITime::P;              using namespace IUtil::P;
+using namespace Lib::Sqlite;
 /* -- Replacement for SQLITE_TRANSIENT which cases warnings ---------------- */
 static sqlite3_destructor_type fcbSqliteTransient =
   reinterpret_cast<sqlite3_destructor_type>(-1);
@@ -40,7 +43,8 @@ BUILD_FLAGS(Sql,                       // Sql flags classes
   /* ----------------------------------------------------------------------- */
   SF_NONE                   {Flag(0)}, // No settings?
   SF_ISTEMPDB               {Flag(1)}, // Is temporary database?
-  SF_DELETEEMPTYDB          {Flag(2)}  // Delete empty databases?
+  SF_DELETEEMPTYDB          {Flag(2)}, // Delete empty databases?
+  SF_ASYNCCVARS             {Flag(3)}  // Queue cvar writes to db thread?
 );/* ----------------------------------------------------------------------- */
 enum ADResult                          // Results for CanDeleteDatabase()
 { /* ----------------------------------------------------------------------- */
@@ -87,7 +91,11 @@ CTOR_BEGIN(Sqls, Sql, CLHelperUnsafe,  // Sql collector class
   const StdStringView ssvSVersionKey;  // Name of schema version record name
   unsigned         uQueryRetries;      // Times to retry query before failing
   ClkDuration      cdRetry;            // Sleep for this time when retrying
-);/* ----------------------------------------------------------------------- */
+  size_t           stStmtCache;        // Prepared statements to keep per db
+  ClkDuration      cdBatch;,,          // Time to collect async queries for
+  /* -- Derived classes ---------------------------------------------------- */
+  private LuaEvtMaster<Sql,LuaEvtTypeAsync<Sql>>); // Async query events
+/* ------------------------------------------------------------------------- */
 static Sql        *cSql = nullptr;     // Pointer to main SQL db (Core::Sql)
 /* ------------------------------------------------------------------------- */
 struct SqlData :                       // Query response data item class
@@ -129,17 +137,71 @@ enum CreateTableResult                 // Create table result
   CTR_OK,                              // [1] Sql call commited the variable
   CTR_OK_ALREADY,                      // [2] Sql table already exists
 };/* ----------------------------------------------------------------------- */
+static void SqlStmtsDetach(const Sql*const); // Detach statement handles
+/* ------------------------------------------------------------------------- */
 CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
   /* -- Base classes ------------------------------------------------------- */
   public SqlFlags,                     // Flags for this database
-  public Lockable                      // Lua garbage collector instruction
+  public Lockable,                     // Lua garbage collector instruction
+  public LuaEvts                       // Async query completion events
 { /* -- Schema version ----------------------------------------------------- */
   constexpr static const sqlite3_int64 llVersion = 1; // Expected schema ver
+  /* -- Private typedefs --------------------------------------------------- */
+  using SqliteStatementPtr = StdUniquePtr<sqlite3_stmt,
+    function<decltype(sqlite3_finalize)>>;
+  struct SqlStmt                       // Cached prepared statement
+  { /* --------------------------------------------------------------------- */
+    StdString      strQuery;           // Query the statement was built from
+    sqlite3_stmt  *stmtData;           // The prepared statement
+  };/* --------------------------------------------------------------------- */
+  using SqlStmtList   = StdList<SqlStmt>; // Statements (most recent first)
+  using SqlStmtListIt = SqlStmtList::iterator; // Iterator to a statement
+  using SqlParams = StdVector<SqlData>; // Parameters of an async query
+  using LuaFuncPtr = StdUniquePtr<LuaFunc>; // Callback of an async query
+  struct SqlAsync                      // Queued asynchronous query
+  { /* --------------------------------------------------------------------- */
+    StdString      strQuery;           // Query to execute
+    SqlParams      spParams;           // Parameters to bind to the query
+    LuaFuncPtr     lfpCallback;        // Lua callback (none for cvars)
+    int            iResult;            // Result code of the query
+    SqlResult      srRecords;          // Records returned by the query
+    int            iAffected;          // Rows changed by the query
+  };/* --------------------------------------------------------------------- */
+  using SqlAsyncList = StdList<SqlAsync>; // Queued or completed queries
+  struct SqlHandleLock                 // Database handle lock for the engine
+  { /* --------------------------------------------------------------------- */
+    Sql           &sRef;               // Database the handle belongs to
+    const LockGuard lgHandle;          // Lock on the database handle
+    /* -- Lock the database handle ----------------------------------------- */
+    explicit SqlHandleLock(Sql &sNRef) :
+      /* -- Initialisers --------------------------------------------------- */
+      sRef(sNRef),                     // Set database
+      lgHandle{ sNRef.mHandle.MutexGet() } // Lock the database handle
+      /* -- No code -------------------------------------------------------- */
+      {}
+    /* -- Keep the results before the database thread can change them ------ */
+    ~SqlHandleLock() { sRef.SqlCapture(); }
+  };/* --------------------------------------------------------------------- */
   /* -- Variables ---------------------------------------------------------- */
   sqlite3         *sqlDB;              // Pointer to SQL context
   int              iError;             // Last error code
+  StdString        strErrorMsg;        // Last error message
+  int              iChanges;           // Rows changed by the last query
+  bool             bAutoCommit;        // No transaction open after last query
   SqlResult        srKeys;             // Last execute data result
   ClkDuration      cdQuery;            // Last query execution time
+  SqlStmtList      sslStmts;           // Cached prepared statements
+  uint64_t         ullStmtHits,        // Queries that used a cached stmt
+                   ullStmtMisses;      // Queries that had to be prepared
+  /* -- Asynchronous query variables --------------------------------------- */
+  Thread           tAsync;             // Thread executing queued queries
+  MutexLock        mHandle,            // Serialises use of the db handle
+                   mAsync;             // Serialises access to the queues
+  condition_variable cvAsync;          // Waiting for queries or a flush
+  SqlAsyncList     salQueued,          // Queries waiting to be executed
+                   salDone;            // Queries waiting for their callback
+  size_t           stAsyncPending;     // Queries queued but not executed
+  bool             bAsyncFlush;        // Execute queued queries right now
   /* -- Convert sql error id to string ---------------------------- */ private:
   const StdStringView &SqlResultToString(const int iCode) const
     { return cParent->elStrings.Get(iCode); }
@@ -164,7 +226,7 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
       NameGet(), uRetries);
   }
   /* -- Build a new node into the a records list --------------------------- */
-  void SqlDoPair(SqlRecordsMap &srmMap, const int iType,
+  static void SqlDoPair(SqlRecordsMap &srmMap, const int iType,
     const char*const cpKey, const void*const vpPtr, const size_t stSize)
   { // Generate the memory block with the specified data.
     Memory mData{ stSize, vpPtr };
@@ -176,33 +238,106 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
   /* -- Build a new node from an integral value ---------------------------- */
   template<typename PtrType>
     requires (!StdIsPointer<PtrType>)
-  void SqlDoPair(SqlRecordsMap &srmMap, const int iType,
+  static void SqlDoPair(SqlRecordsMap &srmMap, const int iType,
     const char*const cpKey, const PtrType ptVal)
   { SqlDoPair(srmMap, iType, cpKey, &ptVal, sizeof(ptVal)); }
   /* -- Set error code ----------------------------------------------------- */
   void SqlSetError(const int iCode) { iError = iCode; }
-  /* -- Compile the sql command and store output rows ---------------------- */
-  void SqlDoStep(sqlite3_stmt*const stmtData)
+  /* -- Return error string of the database handle ------------------------- */
+  const char *SqlDoGetErrorStr() const { return sqlite3_errmsg(sqlDB); }
+  /* -- Keep the results of the last query on the engine thread ------------ */
+  void SqlCapture()
+  { // Ignore if database is not opened
+    if(!sqlDB) return;
+    // The database thread shares the handle so these must be read while the
+    // handle is still locked.
+    strErrorMsg = SqlDoGetErrorStr();
+    iChanges = sqlite3_changes(sqlDB);
+    bAutoCommit = !!sqlite3_get_autocommit(sqlDB);
+  }
+  /* -- Make a cached statement ready for its next use --------------------- */
+  static int SqlStmtRelease(sqlite3_stmt*const stmtData)
+    { sqlite3_clear_bindings(stmtData); return sqlite3_reset(stmtData); }
+  /* -- Returns if a query changes the schema ------------------------------ */
+  static bool SqlStmtIsSchema(const StdStringView &ssvQuery)
+  { // Find the first keyword and return if there is none
+    const size_t stPos = ssvQuery.find_first_not_of(" \t\r\n");
+    if(stPos == StdNPos) return false;
+    const StdStringView ssvWord{ ssvQuery.substr(stPos) };
+    // Compare against statements that change the schema
+    for(const StdStringView &ssvSchema :
+      { "CREATE", "DROP", "ALTER", "ATTACH", "DETACH" })
+      if(ssvWord.size() >= ssvSchema.size() &&
+         !sqlite3_strnicmp(ssvWord.data(), ssvSchema.data(),
+           static_cast<int>(ssvSchema.size()))) return true;
+    // Does not change the schema
+    return false;
+  }
+  /* -- Prepare a statement that will be used more than once --------------- */
+  sqlite3_stmt *SqlStmtDoPrepare(const StdStringView &ssvQuery)
+  { // Prepare the statement telling sqlite it will be kept for a while
+    sqlite3_stmt *stmtData = nullptr;
+    SqlSetError(sqlite3_prepare_v3(sqlDB, ssvQuery.data(),
+      UtilIntOrMax<int>(ssvQuery.size()), SQLITE_PREPARE_PERSISTENT,
+      &stmtData, nullptr));
+    return stmtData;
+  }
+  /* -- Get a cached statement or prepare and cache a new one -------------- */
+  SqliteStatementPtr SqlStmtGet(const StdStringView &ssvQuery)
+  { // Find a cached statement with the same query
+    const SqlStmtListIt sliIt{ StdFindIf(seq, sslStmts.begin(),
+      sslStmts.end(), [&ssvQuery](const SqlStmt &ssItem)
+        { return ssItem.strQuery == ssvQuery; }) };
+    if(sliIt != sslStmts.end())
+    { // Statement is now the most recently used
+      sslStmts.splice(sslStmts.begin(), sslStmts, sliIt);
+      ++ullStmtHits;
+      // Reset and clear its bindings when the caller is done with it
+      return { sliIt->stmtData, SqlStmtRelease };
+    } // Not cached so prepare it
+    ++ullStmtMisses;
+    // Query changes the schema? Drop cached statements and don't cache it
+    // as it is unlikely to be executed again.
+    if(SqlStmtIsSchema(ssvQuery) || !cParent->stStmtCache)
+    { // Cached statements would just be recompiled by sqlite anyway
+      SqlStmtFlush();
+      // Prepare the statement and finalise it when the caller is done
+      sqlite3_stmt *stmtData = nullptr;
+      SqlSetError(sqlite3_prepare_v2(sqlDB, ssvQuery.data(),
+        UtilIntOrMax<int>(ssvQuery.size()), &stmtData, nullptr));
+      return { stmtData, sqlite3_finalize };
+    } // Prepare the statement and return if failed or query was empty
+    sqlite3_stmt*const stmtData = SqlStmtDoPrepare(ssvQuery);
+    if(!stmtData) return { nullptr, sqlite3_finalize };
+    // Make room and cache the statement as the most recently used
+    SqlStmtTrim(cParent->stStmtCache - 1);
+    sslStmts.push_front({ StdString{ ssvQuery }, stmtData });
+    // Reset and clear its bindings when the caller is done with it
+    return { stmtData, SqlStmtRelease };
+  }
+  /* -- Compile the sql command and store output rows in specified list ---- */
+  int SqlDoStepInto(sqlite3_stmt*const stmtData, SqlResult &srOut,
+    const bool bRetry=true) const
   { // Retry count
     unsigned uRetries = 0;
     // Until we're done with all the data
-    for(SqlSetError(sqlite3_step(stmtData));
-        SqlIsErrorNotEqual(SQLITE_DONE);
-        SqlSetError(sqlite3_step(stmtData)))
+    for(int iCode = sqlite3_step(stmtData);
+        iCode != SQLITE_DONE;
+        iCode = sqlite3_step(stmtData))
     { // Check status
-      switch(SqlGetError())
+      switch(iCode)
       { // Success so continue execution normal or error in the row
         case SQLITE_OK: case SQLITE_ROW: break;
         // The database is busy?
         case SQLITE_BUSY:
           // Wait a little and try again if busy until we've retried enough
-          if(++uRetries < cParent->uQueryRetries ||
-             cParent->uQueryRetries == StdMaxUInt)
+          if(bRetry && (++uRetries < cParent->uQueryRetries ||
+             cParent->uQueryRetries == StdMaxUInt))
             { StdSuspend(cParent->cdRetry); continue; }
           // Return failure
           [[fallthrough]];
         // Complete and utter failure
-        default: return;
+        default: return iCode;
       } // Create key/memblock map and reserve entries
       SqlRecordsMap srmMap;
       // For each column, add to string/memblock map
@@ -253,9 +388,421 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
           }
         }
       } // Move key/values into records list if there were keys inserted
-      if(!srmMap.empty()) srKeys.emplace_back(StdMove(srmMap));
-    } // Set error code to OK because it's set to SQLITE_DONE
-    SqlSetError(SQLITE_OK);
+      if(!srmMap.empty()) srOut.emplace_back(StdMove(srmMap));
+    } // Return OK because the last step returned SQLITE_DONE
+    return SQLITE_OK;
+  }
+  /* -- Compile the sql command and store output rows ---------------------- */
+  void SqlDoStep(sqlite3_stmt*const stmtData)
+    { SqlSetError(SqlDoStepInto(stmtData, srKeys)); }
+  /* -- Add a parameter to an async query ---------------------------------- */
+  static void SqlAsyncAddParam(SqlParams &spParams, const int iType,
+    const void*const vpPtr, const size_t stSize)
+      { spParams.emplace_back(Memory{ stSize, vpPtr }, iType); }
+  /* -- Bind a parameter of an async query --------------------------------- */
+  static int SqlAsyncBind(sqlite3_stmt*const stmtData, const int iCol,
+    const SqlData &sdRef)
+  { // Compare type of parameter
+    switch(sdRef.iType)
+    { // 64-bit integer?
+      case SQLITE_INTEGER: return sqlite3_bind_int64(stmtData, iCol,
+        sdRef.MemReadInt<sqlite3_int64>());
+      // 64-bit IEEE float?
+      case SQLITE_FLOAT: return sqlite3_bind_double(stmtData, iCol,
+        sdRef.MemReadInt<double>());
+      // Text?
+      case SQLITE_TEXT: return sqlite3_bind_text(stmtData, iCol,
+        sdRef.MemIsEmpty() ? "" : sdRef.MemPtr<char>(),
+        UtilIntOrMax<int>(sdRef.MemSize()), fcbSqliteTransient);
+      // Raw data?
+      case SQLITE_BLOB: return sqlite3_bind_blob(stmtData, iCol,
+        sdRef.MemPtr<char>(), UtilIntOrMax<int>(sdRef.MemSize()),
+        fcbSqliteTransient);
+      // Anything else is a null
+      default: return sqlite3_bind_null(stmtData, iCol);
+    }
+  }
+  /* -- Call function again while the database is busy --------------------- */
+  template<typename Func>int SqlRetryBusy(Func &&fCb) const
+  { // Until the database is no longer busy or we've retried enough
+    for(unsigned uRetries = 0;; StdSuspend(cParent->cdRetry))
+    { // Call the function and return if not busy
+      const int iCode = fCb();
+      if(iCode != SQLITE_BUSY) return iCode;
+      // Return failure if we've retried enough
+      if(++uRetries >= cParent->uQueryRetries &&
+         cParent->uQueryRetries != StdMaxUInt) return iCode;
+    }
+  }
+  /* -- Execute a transaction statement on the database thread ------------- */
+  int SqlAsyncTransaction(const char*const cpQuery)
+    { return sqlite3_exec(sqlDB, cpQuery, nullptr, nullptr, nullptr); }
+  /* -- Step a statement retrying while the database is busy --------------- */
+  int SqlStepRetry(sqlite3_stmt*const stmtData) const
+    { return SqlRetryBusy([stmtData]{ return sqlite3_step(stmtData); }); }
+  /* -- Throw error about a statement -------------------------------------- */
+  [[noreturn]] void SqlStmtError(sqlite3_stmt*const stmtData,
+    const char*const cpReason, const int iCode) const
+  { XC(cpReason, "Name",  NameGet(),        "Query", sqlite3_sql(stmtData),
+                 "Error", SqlDoGetErrorStr(), "Code", iCode); }
+  /* -- Push a column of the current row of a statement to Lua ------------- */
+  static void SqlColumnToLua(lua_State*const lS, sqlite3_stmt*const stmtData,
+    const int iCol)
+  { // What's the column type?
+    switch(sqlite3_column_type(stmtData, iCol))
+    { // 64-bit integer?
+      case SQLITE_INTEGER:
+        LuaBasePushInt(lS, sqlite3_column_int64(stmtData, iCol));
+        break;
+      // 64-bit IEEE float?
+      case SQLITE_FLOAT:
+        LuaBasePushNum(lS, sqlite3_column_double(stmtData, iCol));
+        break;
+      // Text? The text must be fetched before its size
+      case SQLITE_TEXT:
+      { // Push the text
+        const unsigned char*const ucpText =
+          sqlite3_column_text(stmtData, iCol);
+        LuaBasePushLStr(lS, ucpText, sqlite3_column_bytes(stmtData, iCol));
+        break;
+      } // Raw data? The data must be fetched before its size
+      case SQLITE_BLOB:
+      { // Create memory block array class
+        const void*const vpData = sqlite3_column_blob(stmtData, iCol);
+        const size_t stBytes =
+          static_cast<size_t>(sqlite3_column_bytes(stmtData, iCol));
+        Asset &aRef = LuaUtilClassCreateRef<Asset>(lS, cAssets);
+        // Initialise the memory block depending on if we have data
+        if(stBytes) aRef.MemInitData(stBytes, vpData);
+        else aRef.MemInitBlank();
+        // Done
+        break;
+      } // No data? Push a 'false' since we can't have 'nil' in keypairs.
+      default: LuaUtilPushFalse(lS); break;
+    }
+  }
+  /* -- Push the current row of a statement to Lua as a key/value table ---- */
+  static void SqlRowToLuaTable(lua_State*const lS,
+    sqlite3_stmt*const stmtData)
+  { // Create the table, we're creating non-indexed key/value pairs
+    const int iColMax = sqlite3_column_count(stmtData);
+    LuaUtilPushObject(lS, iColMax);
+    const int iOIndex = LuaBaseGetTop(lS);
+    // Push each column and set its name
+    for(int iCol = 0; iCol < iColMax; ++iCol)
+    { // Push the value and set the key name
+      SqlColumnToLua(lS, stmtData, iCol);
+      LuaBaseSetField(lS, iOIndex, sqlite3_column_name(stmtData, iCol));
+    }
+  }
+  /* -- Push a numeric column as an asset ---------------------------------- */
+  template<typename IntType>
+    static void SqlColumnToAsset(lua_State*const lS,
+      const StdVector<IntType> &vData)
+  { // Create memory block array class
+    Asset &aRef = LuaUtilClassCreateRef<Asset>(lS, cAssets);
+    // Initialise the memory block depending on if we have data
+    if(vData.empty()) aRef.MemInitBlank();
+    else aRef.MemInitData(vData.size() * sizeof(IntType), vData.data());
+  }
+  /* -- Bind all parameters from Lua without executing --------------------- */
+  void SqlDoBindFromLua(lua_State*const lS, sqlite3_stmt*const stmtData,
+    const int iStartParam)
+  { // Rewind the statement and clear the previous parameters
+    SqlStmtRelease(stmtData);
+    // Bind every parameter the statement takes
+    const int iMax = sqlite3_bind_parameter_count(stmtData);
+    for(int iCol = 1, iParam = iStartParam; iCol <= iMax; ++iCol, ++iParam)
+    { // Throw error if the parameter was not specified
+      if(LuaBaseIsNone(lS, iParam))
+        XC("Not enough parameters for statement!",
+          "Query", sqlite3_sql(stmtData), "Expected", iMax,
+          "Actual", iCol - 1);
+      // Bind the parameter and throw error if failed
+      if(const int iCode = SqlBindFromLua(lS, stmtData, iCol, iParam))
+        SqlStmtError(stmtData, "Failed to bind parameter!", iCode);
+    }
+  }
+  /* -- Step statement to the end and push the results as columns ---------- */
+  lua_Integer SqlDoColumnsToLua(lua_State*const lS,
+    sqlite3_stmt*const stmtData)
+  { // Create the table of columns
+    const int iColMax = sqlite3_column_count(stmtData);
+    LuaUtilPushObject(lS, iColMax);
+    const int iTIndex = LuaBaseGetTop(lS);
+    // We need room for a table per column and a value
+    if(!LuaBaseCheckStack(lS, iColMax + 2))
+      XC("Too many columns in statement!",
+        "Query", sqlite3_sql(stmtData), "Columns", iColMax);
+    // Integer and float columns are gathered into contiguous arrays. Other
+    // columns are written straight into a Lua table.
+    struct SqlColumn                   // Column being gathered
+    { /* ------------------------------------------------------------------- */
+      int          iType;              // Type of column from first row
+      int          iIndex;             // Stack index of table if not numeric
+      StdVector<sqlite3_int64> vInt;   // Values if integer column
+      StdVector<double> vFloat;        // Values if float column
+    };/* ------------------------------------------------------------------- */
+    StdVector<SqlColumn> vColumns(static_cast<size_t>(iColMax));
+    // Number of rows read
+    lua_Integer liRows = 0;
+    // Until there are no more rows
+    for(int iCode = SqlStepRetry(stmtData);
+        iCode != SQLITE_DONE;
+        iCode = SqlStepRetry(stmtData))
+    { // Throw error if there is no row
+      if(iCode != SQLITE_ROW)
+        SqlStmtError(stmtData, "Failed to step statement!", iCode);
+      // First row? The type of each column is taken from it
+      if(!liRows++) for(int iCol = 0; iCol < iColMax; ++iCol)
+      { // Get column and its type and ignore if it is numeric
+        SqlColumn &scRef = vColumns[static_cast<size_t>(iCol)];
+        scRef.iType = sqlite3_column_type(stmtData, iCol);
+        if(scRef.iType == SQLITE_INTEGER || scRef.iType == SQLITE_FLOAT)
+          continue;
+        // Create a table for the column, keep it on the stack and also
+        // store it in the table of columns.
+        LuaBasePushTable(lS);
+        scRef.iIndex = LuaBaseGetTop(lS);
+        LuaBasePushValue(lS, scRef.iIndex);
+        LuaBaseSetField(lS, iTIndex, sqlite3_column_name(stmtData, iCol));
+      } // Add each value of the row to its column
+      for(int iCol = 0; iCol < iColMax; ++iCol)
+      { // Get column and compare its type
+        SqlColumn &scRef = vColumns[static_cast<size_t>(iCol)];
+        switch(scRef.iType)
+        { // Integer column? Sqlite converts other types for us
+          case SQLITE_INTEGER:
+            scRef.vInt.push_back(sqlite3_column_int64(stmtData, iCol));
+            break;
+          // Float column? Sqlite converts other types for us
+          case SQLITE_FLOAT:
+            scRef.vFloat.push_back(sqlite3_column_double(stmtData, iCol));
+            break;
+          // Anything else? Push the value and add it to the table
+          default:
+            SqlColumnToLua(lS, stmtData, iCol);
+            LuaBaseRawSetI(lS, scRef.iIndex, liRows);
+            break;
+        }
+      }
+    } // Move each numeric column into an asset or add an empty table if
+    // there were no rows so the caller still gets the column names.
+    for(int iCol = 0; iCol < iColMax; ++iCol)
+    { // Get column and compare its type
+      const SqlColumn &scRef = vColumns[static_cast<size_t>(iCol)];
+      if(!liRows) LuaBasePushTable(lS);
+      else if(scRef.iType == SQLITE_INTEGER) SqlColumnToAsset(lS, scRef.vInt);
+      else if(scRef.iType == SQLITE_FLOAT)
+        SqlColumnToAsset(lS, scRef.vFloat);
+      else continue;
+      // Store it in the table of columns
+      LuaBaseSetField(lS, iTIndex, sqlite3_column_name(stmtData, iCol));
+    } // Remove the column tables we kept on the stack
+    LuaBaseSetTop(lS, iTIndex);
+    // Return number of rows read
+    return liRows;
+  }
+  /* -- Execute a queued query on the database thread ---------------------- */
+  void SqlAsyncExecute(SqlAsync &saRef, SqliteStatementPtr &sspStmt,
+    const bool bRetry)
+  { // Clear results of a previous attempt
+    saRef.iResult = SQLITE_OK;
+    saRef.srRecords.clear();
+    saRef.iAffected = 0;
+    // Reuse the statement of the previous query if it was the same because
+    // cvar writes are all the same query.
+    if(sspStmt && saRef.strQuery == sqlite3_sql(sspStmt.get()))
+      SqlStmtRelease(sspStmt.get());
+    // Different query so prepare a new one and return if failed or empty
+    else
+    { // Prepare the query and finalise the previous one
+      sqlite3_stmt *stmtData = nullptr;
+      saRef.iResult = sqlite3_prepare_v2(sqlDB, saRef.strQuery.data(),
+        UtilIntOrMax<int>(saRef.strQuery.size()), &stmtData, nullptr);
+      sspStmt.reset(stmtData);
+      if(!stmtData) return;
+    } // Get the statement and number of parameters it needs
+    sqlite3_stmt*const stmtData = sspStmt.get();
+    // Statement does not need any parameters? Just execute the statement
+    if(const int iMax = sqlite3_bind_parameter_count(stmtData); !iMax)
+      saRef.iResult = SqlDoStepInto(stmtData, saRef.srRecords, bRetry);
+    // Parameters needed but none were specified?
+    else if(saRef.spParams.empty()) saRef.iResult = SQLITE_FORMAT;
+    // Bind parameters and execute each time all of them are bound
+    else for(int iCol = 0; const SqlData &sdRef : saRef.spParams)
+    { // Bind the parameter and stop if failed
+      saRef.iResult = SqlAsyncBind(stmtData, ++iCol, sdRef);
+      if(saRef.iResult != SQLITE_OK) break;
+      // Bind the next parameter if not all of them are bound yet
+      if(iCol < iMax) continue;
+      // Execute the statement and stop if failed
+      saRef.iResult = SqlDoStepInto(stmtData, saRef.srRecords, bRetry);
+      if(saRef.iResult != SQLITE_OK) break;
+      // Reset the statement so it can be executed again
+      saRef.iResult = sqlite3_reset(stmtData);
+      if(saRef.iResult != SQLITE_OK) break;
+      // Start binding from the first parameter again
+      iCol = 0;
+    } // Record the number of rows changed by the query
+    saRef.iAffected = sqlite3_changes(sqlDB);
+  }
+  /* -- Execute every query of a batch on the database thread -------------- */
+  bool SqlAsyncExecuteAll(SqlAsyncList &salBatch, const bool bRetry)
+  { // Statement that can be reused by the next query
+    SqliteStatementPtr sspStmt{ nullptr, sqlite3_finalize };
+    // Execute every query in the batch and stop if the database was busy
+    for(SqlAsync &saRef : salBatch)
+    { // Execute the query and return if the database was busy
+      SqlAsyncExecute(saRef, sspStmt, bRetry);
+      if(saRef.iResult == SQLITE_BUSY) return true;
+    } // The database was not busy
+    return false;
+  }
+  /* -- Execute a batch of queued queries on the database thread ----------- */
+  bool SqlAsyncExecuteBatch(SqlAsyncList &salBatch, const bool bForce)
+  { // Until the batch is written or we've retried enough
+    for(unsigned uRetries = 0;; ++uRetries)
+    { // Wait before retrying without holding the database handle so the
+      // engine thread is not stalled while the database is busy.
+      if(uRetries) StdSuspend(cParent->cdRetry);
+      // Serialise use of the database handle with the engine thread
+      const LockGuard lgHandle{ mHandle.MutexGet() };
+      // The engine thread has a transaction open? The batch would become
+      // part of it so leave it queued until the transaction has ended unless
+      // the engine thread is waiting for the batch.
+      if(!sqlite3_get_autocommit(sqlDB))
+      { // Keep the batch queued if nothing is waiting for it
+        if(!bForce) return false;
+        // Execute it in the transaction retrying while holding the handle
+        // as the engine thread is waiting for it anyway.
+        SqlAsyncExecuteAll(salBatch, true);
+        return true;
+      } // Write the whole batch in one transaction so it can be rolled back
+      // and retried as a whole if the database is busy.
+      int iCode = SqlAsyncTransaction("BEGIN IMMEDIATE TRANSACTION");
+      if(iCode == SQLITE_OK)
+      { // Capture exceptions so we can roll back the transaction
+        try
+        { // Execute the queries and commit them if none were busy
+          iCode = SqlAsyncExecuteAll(salBatch, false) ?
+            SQLITE_BUSY : SqlAsyncTransaction("END TRANSACTION");
+        } // Exception occured? Roll back the transaction and rethrow
+        catch(const StdException &)
+          { SqlAsyncTransaction("ROLLBACK TRANSACTION"); throw; }
+        // Written so return success
+        if(iCode == SQLITE_OK) return true;
+        // Roll back the transaction
+        SqlAsyncTransaction("ROLLBACK TRANSACTION");
+      } // Try again if the database was busy and we haven't retried enough
+      if(iCode == SQLITE_BUSY && (uRetries + 1 < cParent->uQueryRetries ||
+           cParent->uQueryRetries == StdMaxUInt)) continue;
+      // Queries were not written so report the failure to their callbacks
+      for(SqlAsync &saRef : salBatch)
+        if(saRef.iResult == SQLITE_OK) saRef.iResult = iCode;
+      // Log the failure
+      cLog->LogWarningExSafe(
+        "Sql '$' failed to write $ queued queries because $ ($)!",
+        NameGet(), salBatch.size(), SqlResultToString(iCode), iCode);
+      return true;
+    }
+  }
+  /* -- Database thread executing queued queries --------------------------- */
+  ThreadStatus SqlAsyncThreadMain(Thread &)
+  { // Until there are no queued queries left and we are asked to exit
+    for(;;)
+    { // Queries to execute in this batch
+      SqlAsyncList salBatch;
+      // The engine thread is waiting for the batch
+      bool bForce = false;
+      // Wait for queries to be queued then take all of them
+      mAsync.MutexUniqueCall([this, &salBatch, &bForce](UniqueLock &ulLock){
+        // Wait for a query to be queued or a request to exit
+        cvAsync.wait(ulLock, [this]{
+          return !salQueued.empty() || tAsync.ThreadShouldExit(); });
+        // Give the engine thread time to queue more queries so they can all
+        // be written in the same transaction.
+        if(cParent->cdBatch != cd0)
+          cvAsync.wait_for(ulLock, cParent->cdBatch, [this]{
+            return bAsyncFlush || tAsync.ThreadShouldExit(); });
+        // Take all the queued queries
+        salBatch.swap(salQueued);
+        bForce = bAsyncFlush || tAsync.ThreadShouldExit();
+      });
+      // Nothing queued means we were asked to exit
+      if(salBatch.empty()) return TS_OK;
+      // Remember how many queries were in the batch
+      const size_t stBatch = salBatch.size();
+      // Execute the batch and report failure to the callbacks on exception
+      try
+      { // The engine thread has a transaction open? Put the batch back and
+        // check again shortly.
+        if(!SqlAsyncExecuteBatch(salBatch, bForce))
+        { mAsync.MutexUniqueCall([this, &salBatch](UniqueLock &ulLock){
+            salQueued.splice(salQueued.begin(), salBatch);
+            cvAsync.wait_for(ulLock, cd10MS, [this]{
+              return bAsyncFlush || tAsync.ThreadShouldExit(); });
+          });
+          continue;
+        }
+      } // Exception occured?
+      catch(const StdException &eReason)
+      { // Log the exception and fail all the queries in the batch
+        cLog->LogErrorExSafe("Sql '$' async batch failed: $",
+          NameGet(), eReason.what());
+        for(SqlAsync &saRef : salBatch) saRef.iResult = SQLITE_ABORT;
+      } // Queries queued without a callback need nothing else doing
+      salBatch.remove_if([](const SqlAsync &saRef)
+        { return !saRef.lfpCallback; });
+      const bool bCallbacks = !salBatch.empty();
+      // Hand the completed queries to the engine thread
+      mAsync.MutexCall([this, &salBatch, stBatch]{
+        // Move the completed queries to the callbacks list
+        salDone.splice(salDone.end(), salBatch);
+        // Queries no longer pending and stop flushing if there are none
+        stAsyncPending -= stBatch;
+        if(!stAsyncPending) bAsyncFlush = false;
+        // Wake anything waiting for queries to finish
+        cvAsync.notify_all();
+      });
+      // Tell the engine thread to call the callbacks
+      if(bCallbacks) LuaEvtsDispatch(EMC_MP_SQL, this);
+    }
+  }
+  /* -- Queue a query for the database thread ------------------------------ */
+  void SqlAsyncQueue(const StdStringView &ssvQuery, SqlParams &&spParams,
+    LuaFuncPtr &&lfpCallback={})
+  { // Build the query outside of the lock
+    SqlAsyncList salItem;
+    salItem.push_back({ StdString{ ssvQuery }, StdMove(spParams),
+      StdMove(lfpCallback), SQLITE_OK, {}, 0 });
+    // Serialise access to the queue
+    mAsync.MutexCall([this, &salItem]{
+      // Start the database thread if it is not running
+      if(tAsync.ThreadIsNotJoinable())
+        tAsync.ThreadInit(StrAppend("sqlasync:", Serial()),
+          bind(&Sql::SqlAsyncThreadMain, this, _1), this);
+      // Queue the query and wake the database thread
+      salQueued.splice(salQueued.end(), salItem);
+      ++stAsyncPending;
+      cvAsync.notify_all();
+    });
+  }
+  /* -- Execute queued queries and stop the database thread ---------------- */
+  void SqlAsyncDeInit()
+  { // Have database thread?
+    if(tAsync.ThreadIsJoinable())
+    { // Tell the thread to exit when the queue is empty and wake it up
+      mAsync.MutexCall([this]{
+        tAsync.ThreadSetExit();
+        cvAsync.notify_all();
+      });
+      // Wait for thread to terminate and deinit
+      tAsync.ThreadStop();
+      tAsync.ThreadDeInit();
+    } // Cancel callback events and release callbacks that were not called
+    LuaEvtsDeInit();
+    salDone.clear();
   }
   /* -- Can database be deleted, no point keeping if it's empty! ----------- */
   ADResult SqlCanDatabaseBeDeleted()
@@ -506,21 +1053,18 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
   /* -- Send command to sql in raw format ---------------------------------- */
   template<typename ...VarArgs>
     void SqlDoExecute(const StdString &strQuery, VarArgs &&...vaArgs)
-  { // Reset previous results
+  { // Serialise use of the database handle with the database thread
+    const SqlHandleLock shlHandle{ *this };
+    // Reset previous results
     SqlReset();
     // Set query start time
     const Interval ivStart;
-    // Statement preparation
-    sqlite3_stmt *stmtData = nullptr;
-    SqlSetError(sqlite3_prepare_v2(sqlDB, strQuery.data(),
-      UtilIntOrMax<int>(strQuery.size()), &stmtData, nullptr));
-    // If succeeded then start parsing the input and ouput
-    if(SqlIsNoError())
-    { // Free the statement context incase of exception
-      using SqliteStatementPtr = StdUniquePtr<sqlite3_stmt,
-        function<decltype(sqlite3_finalize)>>;
-      const SqliteStatementPtr sspPtr{ stmtData, sqlite3_finalize };
-      // Get number of parameters required to bind and if there is any
+    // Get cached statement or prepare a new one which is released when
+    // leaving scope, even if an exception occurs. If succeeded then start
+    // parsing the input and output.
+    const SqliteStatementPtr sspPtr{ SqlStmtGet(strQuery) };
+    if(sqlite3_stmt*const stmtData = sspPtr.get())
+    { // Get number of parameters required to bind and if there is any
       if(const int iMax = sqlite3_bind_parameter_count(stmtData))
       { // Column id
         int iCol = 1;
@@ -561,6 +1105,8 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
     SqlSetError(sqlite3_open_v2(strFilename.data(), &sqlDBout,
       SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX |
       SQLITE_OPEN_SHAREDCACHE, reinterpret_cast<char*>(sqlDBout)));
+    strErrorMsg = sqlDBout ?
+      sqlite3_errmsg(sqlDBout) : sqlite3_errstr(SqlGetError());
     return sqlDBout;
   }
   /* -- Set a pragma (used only with cvar callbacks) --------------- */ public:
@@ -629,126 +1175,246 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
     { return SqlGetUsage(SQLITE_DBSTATUS_CACHE_SPILL); }
   SqlIntPair SqlGetTempBufSpill() const
     { return SqlGetUsage(SQLITE_DBSTATUS_TEMPBUF_SPILL); }
+  /* -- Bind a Lua value to a statement parameter -------------------------- */
+  static int SqlBindFromLua(lua_State*const lS, sqlite3_stmt*const stmtData,
+    const int iCol, const int iParam)
+  { // Get lua variable type and compare its type
+    switch(const int iType = LuaBaseType(lS, iParam))
+    { // Variable is a number?
+      case LUA_TNUMBER:
+      { // Variable is actually an integer?
+        if(LuaBaseIsInt(lS, iParam))
+        { // Get integer, log it and add it as integer
+          const lua_Integer liInt = LuaBaseToInt(lS, iParam);
+          cLog->LogDebugExSafe("- Arg #$<Integer/Int> = $ <$0x$>.",
+            iCol, liInt, StdIOSHex, liInt);
+          return sqlite3_bind_int64(stmtData, iCol,
+            static_cast<sqlite_int64>(liInt));
+        } // Variable is actually a number
+        else
+        { // Get double, log it and add it as number
+          const lua_Number lnFloat = LuaBaseToNum(lS, iParam);
+          cLog->LogDebugExSafe("- Arg #$<Number/Float> = $$.",
+            iCol, StdIOSFixed, lnFloat);
+          return sqlite3_bind_double(stmtData, iCol,
+            static_cast<double>(lnFloat));
+        }
+      } // Variable is a string
+      case LUA_TSTRING:
+      { // Get string, store size, log parameter, add as string
+        size_t stS;
+        const char*const cpStr = LuaBaseToLStr(lS, iParam, stS);
+        cLog->LogDebugExSafe(
+          "- Arg #$<String/Text> = \"$\" ($ bytes).",
+          iCol, cpStr, stS);
+        return sqlite3_bind_text(stmtData,
+          iCol, cpStr, UtilIntOrMax<int>(stS), fcbSqliteTransient);
+      } // Variable is a boolean
+      case LUA_TBOOLEAN:
+      { // Get boolean, log parameter, convert and add as integer
+        const bool bBool = LuaBaseToBool(lS, iParam);
+        cLog->LogDebugExSafe("- Arg #$<Bool/Int> = $.",
+          iCol, StrFromBoolTF(bBool));
+        return sqlite3_bind_int64(stmtData, iCol,
+          static_cast<sqlite_int64>(bBool));
+      } // Variable is a 'nil'
+      case LUA_TNIL:
+      { // Log the nil and add it to the Sql query
+        cLog->LogDebugExSafe("- Arg #$<Nil/Null>.", iCol);
+        return sqlite3_bind_null(stmtData, iCol);
+      } // Variable is userdata
+      case LUA_TUSERDATA:
+      { // Get reference to memory block, log it and push data to list
+        const MemConst &mcRef =
+          LuaUtilGetClassRef<Asset>(lS, iParam, cAssets);
+        cLog->LogDebugExSafe("- Arg #$<Asset/Blob> = $ bytes.",
+          iCol, mcRef.MemSize());
+        return sqlite3_bind_blob(stmtData, iCol,
+          mcRef.MemPtr<char>(), UtilIntOrMax<int>(mcRef.MemSize()),
+          fcbSqliteTransient);
+      } // Other variable (ignore)
+      default: XC("Unsupported parameter type!",
+        "Param", iParam, "LuaType", iType,
+        "Typename", LuaBaseTypeName(lS, iType));
+    }
+  }
+  /* -- Bind parameters from Lua and execute the statement ----------------- */
+  int SqlDoExecuteFromLua(lua_State*const lS, sqlite3_stmt*const stmtData,
+    const int iStartParam)
+  { // Current enumerated parameter
+    int iParam = iStartParam;
+    // Get maximum parameters allowed before we have to send them
+    if(const int iMax = sqlite3_bind_parameter_count(stmtData))
+    { // No parameters specified? Just execute the statement
+      if(LuaBaseIsNone(lS, iParam)) SqlSetError(SQLITE_FORMAT);
+      // Parameter is valid?
+      else
+      { // Column id
+        int iCol = 1;
+        // Repeat...
+        do
+        { // Bind the parameter
+          SqlSetError(SqlBindFromLua(lS, stmtData, iCol, iParam));
+          // Do the step if needed break if not needed or error
+          if(!SqlDoExecuteParamCheckCommit(stmtData, iCol, iMax)) break;
+        } // ...until no parameters left
+        while(!LuaBaseIsNone(lS, ++iParam));
+      }
+    } // We can't add parameters so just execute the statement
+    else SqlDoStep(stmtData);
+    // Return number of parameters sent
+    return iParam - iStartParam;
+  }
+  /* -- Log the result of a query from Lua --------------------------------- */
+  int SqlLogResultFromLua(const int iParams)
+  { // Log result
+    cLog->LogDebugExSafe("- Total: $; Code: $<$>; RTT: $ sec.",
+      iParams, SqlResultToString(SqlGetError()), SqlGetError(),
+      SqlTimeStr());
+    // Return error status
+    return SqlGetError();
+  }
   /* -- Execute a command from Lua ----------------------------------------- */
   int SqlExecuteFromLua(lua_State*const lS, const StdStringView &ssvQuery)
   { // Log progress
     cLog->LogDebugExSafe("Sql executing '$'<$> from LUA...",
       ssvQuery, ssvQuery.size());
+    // Serialise use of the database handle with the database thread
+    const SqlHandleLock shlHandle{ *this };
     // Reset previous results
     SqlReset();
     // Set query start time
     const Interval ivStart;
-    // Statement preparation
-    sqlite3_stmt *stmtData = nullptr;
-    SqlSetError(sqlite3_prepare_v2(sqlDB, ssvQuery.data(),
-      UtilIntOrMax<int>(ssvQuery.size()), &stmtData, nullptr));
-    // Starting LUA parameter and current enumerated parameter
-    const int iStartParam = 3;
-    int iParam = iStartParam;
-    // If succeeded then start parsing the input and ouput
-    if(SqlIsNoError())
-    { // Free the statement context incase of exception
-      using SqliteStatementPtr = StdUniquePtr<sqlite3_stmt,
-        function<decltype(sqlite3_finalize)>>;
-      const SqliteStatementPtr sspPtr{ stmtData, sqlite3_finalize };
-      // Get maximum parameters allowed before we have to send them
-      if(const int iMax = sqlite3_bind_parameter_count(stmtData))
-      { // No parameters specified? Just execute the statement
-        if(LuaBaseIsNone(lS, iParam)) SqlSetError(SQLITE_FORMAT);
-        // Parameter is valid?
-        else
-        { // Column id
-          int iCol = 1;
-          // Repeat...
-          do
-          { // Get lua variable type and compare its type
-            switch(const int iType = LuaBaseType(lS, iParam))
-            { // Variable is a number?
-              case LUA_TNUMBER:
-              { // Variable is actually an integer?
-                if(LuaBaseIsInt(lS, iParam))
-                { // Get integer, log it and add it as integer
-                  const lua_Integer liInt = LuaBaseToInt(lS, iParam);
-                  cLog->LogDebugExSafe("- Arg #$<Integer/Int> = $ <$0x$>.",
-                    iCol, liInt, StdIOSHex, liInt);
-                  SqlSetError(sqlite3_bind_int64(stmtData, iCol,
-                    static_cast<sqlite_int64>(liInt)));
-                } // Variable is actually a number
-                else
-                { // Get double, log it and add it as number
-                  const lua_Number lnFloat = LuaBaseToNum(lS, iParam);
-                  cLog->LogDebugExSafe("- Arg #$<Number/Float> = $$.",
-                    iCol, StdIOSFixed, lnFloat);
-                  SqlSetError(sqlite3_bind_double(stmtData, iCol,
-                    static_cast<double>(lnFloat)));
-                } // Done
-                break;
-              } // Variable is a string
-              case LUA_TSTRING:
-              { // Get string, store size, log parameter, add as string
-                size_t stS;
-                const char*const cpStr = LuaBaseToLStr(lS, iParam, stS);
-                cLog->LogDebugExSafe(
-                  "- Arg #$<String/Text> = \"$\" ($ bytes).",
-                  iCol, cpStr, stS);
-                SqlSetError(sqlite3_bind_text(stmtData,
-                  iCol, cpStr, UtilIntOrMax<int>(stS), fcbSqliteTransient));
-                break;
-              } // Variable is a boolean
-              case LUA_TBOOLEAN:
-              { // Get boolean, log parameter, convert and add as integer
-                const bool bBool = LuaBaseToBool(lS, iParam);
-                cLog->LogDebugExSafe("- Arg #$<Bool/Int> = $.",
-                  iCol, StrFromBoolTF(bBool));
-                SqlSetError(sqlite3_bind_int64(stmtData, iCol,
-                  static_cast<sqlite_int64>(bBool)));
-                break;
-              } // Variable is a 'nil'
-              case LUA_TNIL:
-              { // Log the nil and add it to the Sql query
-                cLog->LogDebugExSafe("- Arg #$<Nil/Null>.", iCol);
-                SqlSetError(sqlite3_bind_null(stmtData, iCol));
-                break;
-              } // Variable is userdata
-              case LUA_TUSERDATA:
-              { // Get reference to memory block, log it and push data to list
-                const MemConst &mcRef =
-                  LuaUtilGetClassRef<Asset>(lS, iParam, cAssets);
-                cLog->LogDebugExSafe("- Arg #$<Asset/Blob> = $ bytes.",
-                  iCol, mcRef.MemSize());
-                SqlSetError(sqlite3_bind_blob(stmtData, iCol,
-                  mcRef.MemPtr<char>(), UtilIntOrMax<int>(mcRef.MemSize()),
-                  fcbSqliteTransient));
-                break;
-              } // Other variable (ignore)
-              default: XC("Unsupported parameter type!",
-                "Param", iParam, "LuaType", iType,
-                "Typename", LuaBaseTypeName(lS, iType));
-            } // Do the step if needed break if not needed or error
-            if(!SqlDoExecuteParamCheckCommit(stmtData, iCol, iMax)) break;
-          } // ...until no parameters left
-          while(!LuaBaseIsNone(lS, ++iParam));
-        }
-      } // We can't add parameters so just execute the statement
-      else SqlDoStep(stmtData);
-    } // Get end query time to get total execution duration
+    // Number of parameters sent
+    int iParams = 0;
+    // Get cached statement or prepare a new one which is released when
+    // leaving scope, even if an exception occurs. If succeeded then start
+    // parsing the input and output.
+    if(const SqliteStatementPtr sspPtr{ SqlStmtGet(ssvQuery) })
+      iParams = SqlDoExecuteFromLua(lS, sspPtr.get(), 3);
+    // Get end query time to get total execution duration
     cdQuery = ivStart.CIDelta();
-    // Log result
-    cLog->LogDebugExSafe("- Total: $; Code: $<$>; RTT: $ sec.",
-      iParam - iStartParam, SqlResultToString(SqlGetError()), SqlGetError(),
-      SqlTimeStr());
-    // Return error status
-    return SqlGetError();
+    // Log result and return error status
+    return SqlLogResultFromLua(iParams);
   }
-  /* -- Convert records to lua table --------------------------------------- */
-  void RecordsToLuaTable(lua_State*const lS)
+  /* -- Execute a statement prepared with SqlStmtPrepare() from Lua -------- */
+  int SqlExecuteStmtFromLua(lua_State*const lS, sqlite3_stmt*const stmtData,
+    const int iStartParam)
+  { // Log progress
+    cLog->LogDebugExSafe("Sql executing prepared '$' from LUA...",
+      sqlite3_sql(stmtData));
+    // Serialise use of the database handle with the database thread
+    const SqlHandleLock shlHandle{ *this };
+    // Reset previous results
+    SqlReset();
+    // Set query start time
+    const Interval ivStart;
+    // Reset and clear bindings of the statement when leaving scope, even if
+    // an exception occurs.
+    const SqliteStatementPtr sspPtr{ stmtData, SqlStmtRelease };
+    // Bind parameters and execute the statement
+    const int iParams = SqlDoExecuteFromLua(lS, stmtData, iStartParam);
+    // Get end query time to get total execution duration
+    cdQuery = ivStart.CIDelta();
+    // Log result and return error status
+    return SqlLogResultFromLua(iParams);
+  }
+  /* -- Bind parameters from Lua to a statement for stepping --------------- */
+  void SqlStmtBindFromLua(lua_State*const lS, sqlite3_stmt*const stmtData,
+    const int iStartParam)
+  { // Serialise use of the database handle with the database thread
+    const SqlHandleLock shlHandle{ *this };
+    // Bind the parameters
+    SqlDoBindFromLua(lS, stmtData, iStartParam);
+  }
+  /* -- Step a statement and push the row to Lua if there is one ----------- */
+  bool SqlStmtStepToLua(lua_State*const lS, sqlite3_stmt*const stmtData)
+  { // Serialise use of the database handle with the database thread
+    const SqlHandleLock shlHandle{ *this };
+    // Step the statement and compare the result
+    switch(const int iCode = SqlStepRetry(stmtData))
+    { // Have a row? Push it and return success
+      case SQLITE_ROW: SqlRowToLuaTable(lS, stmtData); return true;
+      // No more rows? Return failure
+      case SQLITE_DONE: return false;
+      // Anything else is an error
+      default: SqlStmtError(stmtData, "Failed to step statement!", iCode);
+    }
+  }
+  /* -- Rewind a statement and clear its parameters ------------------------ */
+  void SqlStmtRewind(sqlite3_stmt*const stmtData)
+  { // Serialise use of the database handle with the database thread
+    const SqlHandleLock shlHandle{ *this };
+    // Rewind the statement
+    SqlStmtRelease(stmtData);
+  }
+  /* -- Bind parameters from Lua and push statement results as columns ----- */
+  lua_Integer SqlStmtColumnsFromLua(lua_State*const lS,
+    sqlite3_stmt*const stmtData, const int iStartParam)
+  { // Serialise use of the database handle with the database thread
+    const SqlHandleLock shlHandle{ *this };
+    // Rewind the statement when leaving scope, even if an exception occurs.
+    const SqliteStatementPtr sspPtr{ stmtData, SqlStmtRelease };
+    // Bind the parameters and push the columns
+    SqlDoBindFromLua(lS, stmtData, iStartParam);
+    return SqlDoColumnsToLua(lS, stmtData);
+  }
+  /* -- Execute a query from Lua and push the results as columns ----------- */
+  lua_Integer SqlColumnsFromLua(lua_State*const lS,
+    const StdStringView &ssvQuery)
+  { // Log progress
+    cLog->LogDebugExSafe("Sql reading columns of '$'<$> from LUA...",
+      ssvQuery, ssvQuery.size());
+    // Serialise use of the database handle with the database thread
+    const SqlHandleLock shlHandle{ *this };
+    // Get cached statement or prepare a new one which is released when
+    // leaving scope, even if an exception occurs.
+    const SqliteStatementPtr sspPtr{ SqlStmtGet(ssvQuery) };
+    if(!sspPtr)
+      XC("Failed to prepare statement!",
+        "Name",  NameGet(),          "Query", ssvQuery,
+        "Error", SqlDoGetErrorStr(), "Code",  SqlGetError());
+    // Bind the parameters and push the columns
+    SqlDoBindFromLua(lS, sspPtr.get(), 3);
+    return SqlDoColumnsToLua(lS, sspPtr.get());
+  }
+  /* -- Prepare a statement for a Lua statement handle --------------------- */
+  sqlite3_stmt *SqlStmtPrepare(const StdStringView &ssvQuery)
+  { // Serialise use of the database handle with the database thread
+    const SqlHandleLock shlHandle{ *this };
+    // Prepare the statement and return it if succeeded
+    if(sqlite3_stmt*const stmtData = SqlStmtDoPrepare(ssvQuery))
+      return stmtData;
+    // Failed or query was empty
+    XC("Failed to prepare statement!",
+      "Name",  NameGet(),          "Query", ssvQuery,
+      "Error", SqlDoGetErrorStr(), "Code",  SqlGetError());
+  }
+  /* -- Evict least recently used statements until 'stLimit' remain -------- */
+  void SqlStmtTrim(const size_t stLimit)
+  { // Until we are under the limit, finalise the oldest statement
+    while(sslStmts.size() > stLimit)
+    { // Finalise the oldest statement
+      sqlite3_finalize(sslStmts.back().stmtData);
+      sslStmts.pop_back();
+    }
+  }
+  /* -- Finalise all cached statements ------------------------------------- */
+  void SqlStmtFlush() { SqlStmtTrim(0); }
+  /* -- Return statement cache counters ------------------------------------ */
+  size_t SqlStmtGetCached() const { return sslStmts.size(); }
+  uint64_t SqlStmtGetHits() const { return ullStmtHits; }
+  uint64_t SqlStmtGetMisses() const { return ullStmtMisses; }
+  /* -- Convert specified records to lua table ----------------------------- */
+  static void SqlResultToLuaTable(lua_State*const lS,
+    const SqlResult &srResult)
   { // Create the table, we're creating a indexed/value array
-    LuaUtilPushArray(lS, srKeys.size());
+    LuaUtilPushArray(lS, srResult.size());
     const int iAIndex = LuaBaseGetTop(lS);
     // Memory id
     lua_Integer liId = 1;
     // For each table item
-    for(const SqlRecordsMap &srmRef : srKeys)
+    for(const SqlRecordsMap &srmRef : srResult)
     { // Table index
       LuaBasePushInt(lS, liId);
       // Create the table, we're creating non-indexed key/value pairs
@@ -799,6 +1465,133 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
       ++liId;
     }
   }
+  /* -- Convert records to lua table --------------------------------------- */
+  void RecordsToLuaTable(lua_State*const lS)
+    { SqlResultToLuaTable(lS, srKeys); }
+  /* -- Queue a query from Lua for the database thread --------------------- */
+  void SqlExecAsyncFromLua(lua_State*const lS, const StdStringView &ssvQuery)
+  { // Copy the parameters from the table as the Lua values may be collected
+    // before the query is executed.
+    SqlParams spParams;
+    const lua_Integer liLen = UtilIntOrMax<lua_Integer>(LuaBaseRawLen(lS, 3));
+    spParams.reserve(static_cast<size_t>(liLen));
+    for(lua_Integer liIndex = 1; liIndex <= liLen; ++liIndex)
+    { // Get the value at the specified index
+      LuaBaseRawGetI(lS, 3, liIndex);
+      const int iIndex = LuaBaseGetTop(lS);
+      // Get lua variable type and compare its type
+      switch(const int iType = LuaBaseType(lS, iIndex))
+      { // Variable is a number?
+        case LUA_TNUMBER:
+        { // Variable is actually an integer?
+          if(LuaBaseIsInt(lS, iIndex))
+          { // Add it as an integer
+            const sqlite3_int64 llInt =
+              static_cast<sqlite3_int64>(LuaBaseToInt(lS, iIndex));
+            SqlAsyncAddParam(spParams, SQLITE_INTEGER, &llInt, sizeof(llInt));
+          } // Variable is actually a number
+          else
+          { // Add it as a number
+            const double dFloat = static_cast<double>(LuaBaseToNum(lS, iIndex));
+            SqlAsyncAddParam(spParams, SQLITE_FLOAT, &dFloat, sizeof(dFloat));
+          } // Done
+          break;
+        } // Variable is a string
+        case LUA_TSTRING:
+        { // Get string and add it as text
+          size_t stS;
+          const char*const cpStr = LuaBaseToLStr(lS, iIndex, stS);
+          SqlAsyncAddParam(spParams, SQLITE_TEXT, cpStr, stS);
+          break;
+        } // Variable is a boolean
+        case LUA_TBOOLEAN:
+        { // Convert boolean and add it as an integer
+          const sqlite3_int64 llBool = LuaBaseToBool(lS, iIndex);
+          SqlAsyncAddParam(spParams, SQLITE_INTEGER, &llBool, sizeof(llBool));
+          break;
+        } // Variable is a 'nil'
+        case LUA_TNIL:
+          SqlAsyncAddParam(spParams, SQLITE_NULL, nullptr, 0);
+          break;
+        // Variable is userdata
+        case LUA_TUSERDATA:
+        { // Get reference to memory block and add it as a blob
+          const MemConst &mcRef =
+            LuaUtilGetClassRef<Asset>(lS, iIndex, cAssets);
+          SqlAsyncAddParam(spParams, SQLITE_BLOB,
+            mcRef.MemPtr<void>(), mcRef.MemSize());
+          break;
+        } // Other variable (ignore)
+        default: XC("Unsupported parameter type!",
+          "Index", liIndex, "LuaType", iType,
+          "Typename", LuaBaseTypeName(lS, iType));
+      } // Remove the value from the stack
+      LuaBaseRemove(lS, iIndex);
+    } // Log progress
+    cLog->LogDebugExSafe("Sql queued '$'<$> with $ parameters from LUA.",
+      ssvQuery, ssvQuery.size(), spParams.size());
+    // Reference the callback on the top of the stack and queue the query
+    SqlAsyncQueue(ssvQuery, StdMove(spParams),
+      LuaFuncPtr{ new LuaFunc{ StrAppend("SQ:", NameGet()), true } });
+  }
+  /* -- Wait for all queued queries to be executed ------------------------- */
+  void SqlAsyncWait()
+  { // Serialise access to the queue
+    mAsync.MutexUniqueCall([this](UniqueLock &ulLock){
+      // Return if nothing is pending
+      if(!stAsyncPending) return;
+      // Tell the database thread not to wait for more queries
+      bAsyncFlush = true;
+      cvAsync.notify_all();
+      // Wait for the database thread to execute everything
+      cvAsync.wait(ulLock, [this]{ return !stAsyncPending; });
+    });
+  }
+  /* -- Number of queries queued but not executed yet ---------------------- */
+  size_t SqlAsyncPending()
+    { return mAsync.MutexCall([this]{ return stAsyncPending; }); }
+  /* -- Call callbacks of completed queries (called by LuaEvtMaster) ------- */
+  void LuaEvtCallbackAsync(const EvtMainEvent &emeEvent)
+  { // Remove iterator from our events dispatched list
+    LuaEvtsCheckParams<2>(emeEvent.eaArgs);
+    // Keep the results until Lua is resumed if Lua is paused
+    if(uLuaPaused) return;
+    // Take the completed queries
+    SqlAsyncList salComplete;
+    mAsync.MutexCall([this, &salComplete]{ salComplete.swap(salDone); });
+    // First error raised by a callback
+    StdString strFirstError;
+    // For each completed query
+    for(const SqlAsync &saRef : salComplete)
+    { // Ignore if the callback was released because Lua was reset
+      const LuaFunc &lfRef = *saRef.lfpCallback;
+      if(LuaUtilIsNotRefValid(lfRef.LuaFuncGet())) continue;
+      // Push the error handler, callback, result code, records and affected
+      // rows.
+      lua_State*const lS = cLuaFuncs->LuaRefGetState();
+      const int iHandler = LuaUtilPushAndGetGenericErrId(lS);
+      lfRef.LuaFuncPushFunc();
+      LuaBasePushInt(lS, saRef.iResult);
+      SqlResultToLuaTable(lS, saRef.srRecords);
+      LuaBasePushInt(lS, saRef.iAffected);
+      // Call the callback protected so an error does not stop the other
+      // callbacks from being called.
+      if(LuaUtilPCallExSafe(lS, 3, 0, iHandler) == LUA_OK) continue;
+      // Log the error and keep the first one
+      const StdString strError{ LuaUtilGetAndPopStr(lS) };
+      cLog->LogErrorExSafe("Sql '$' async callback failed: $",
+        NameGet(), strError);
+      if(strFirstError.empty()) strFirstError = strError;
+    } // Raise the first error now that every callback has been called
+    if(!strFirstError.empty())
+      XC(StrAppend("Runtime error! > ", strFirstError));
+  }
+  /* -- Call callbacks that were held back while Lua was paused ------------ */
+  void SqlAsyncResume()
+  { // Dispatch the completion event if any callbacks are waiting
+    if(mAsync.MutexCall([this]{ return !salDone.empty(); }))
+      LuaEvtsDispatch(EMC_MP_SQL, this);
+  }
   /* -- Reset last sql result ---------------------------------------------- */
   void SqlReset()
   { // Clear error
@@ -886,7 +1679,7 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
     return ullPageSize * ullPageCount;
   }
   /* -- Return error string ------------------------------------------------ */
-  const char *SqlGetErrorStr() const { return sqlite3_errmsg(sqlDB); }
+  const char *SqlGetErrorStr() const { return strErrorMsg.c_str(); }
   /* -- Return error code -------------------------------------------------- */
   int SqlGetError() const { return iError; }
   bool SqlIsErrorEqual(const int iWhat) const
@@ -908,7 +1701,7 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
   /* -- Return formatted query time ---------------------------------------- */
   StdString SqlTimeStr() const { return TimeToShortDuration(SqlTime()); }
   /* -- Returns if sql is in a transaction --------------------------------- */
-  bool SqlNotActive() const { return !!sqlite3_get_autocommit(sqlDB); }
+  bool SqlNotActive() const { return bAutoCommit; }
   bool SqlActive() const { return !SqlNotActive(); }
   /* -- Return string map of records --------------------------------------- */
   const SqlResult &SqlGetRecords() const { return srKeys; }
@@ -920,7 +1713,7 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
   int SqlFlushTable(const StdStringView &ssvTable)
     { return SqlExecute(StrFormat("DELETE from `$`", ssvTable)); }
   int SqlOptimise() { return SqlExecute("VACUUM"); }
-  int SqlAffected() const { return sqlite3_changes(sqlDB); }
+  int SqlAffected() const { return iChanges; }
   /* -- Process a count(*) requested --------------------------------------- */
   size_t SqlGetRecordCount(const StdStringView &ssvTable,
     const StdStringView &ssvCondition=cCommon->CommonCBlank())
@@ -1066,14 +1859,30 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
   CreateTableResult SqlLuaCacheRebuildTable()
     { SqlLuaCacheDropTable(); return SqlLuaCacheCreateTable(); }
   /* ----------------------------------------------------------------------- */
+  StdString SqlCVarCommitQuery() const
+    { return StrFormat("INSERT or REPLACE into `$`(`$`,`$`,`$`) VALUES(?,?,?)",
+        cParent->ssvCVTable, cParent->strCVKeyColumn,
+        cParent->strCVFlagsColumn, cParent->strCVValueColumn); }
+  /* ----------------------------------------------------------------------- */
   bool SqlCVarCommitData(const StdString &strVar,
     const SqlCVarDataFlagsConst &scvdfcFlags, const int iType,
     const char*const cpData, const size_t stLength)
-  { // Try to write the specified cvar and if failed?
-    if(SqlExecute(StrFormat(
-         "INSERT or REPLACE into `$`(`$`,`$`,`$`) VALUES(?,?,?)",
-         cParent->ssvCVTable, cParent->strCVKeyColumn,
-         cParent->strCVFlagsColumn, cParent->strCVValueColumn),
+  { // Queue the write for the database thread if requested
+    if(FlagIsSet(SF_ASYNCCVARS))
+    { // Copy the parameters as the value may change before it is written
+      SqlParams spParams;
+      spParams.reserve(3);
+      SqlAsyncAddParam(spParams, SQLITE_TEXT, strVar.data(), strVar.size());
+      const sqlite3_int64 llFlags = scvdfcFlags.FlagGet<int>();
+      SqlAsyncAddParam(spParams, SQLITE_INTEGER, &llFlags, sizeof(llFlags));
+      SqlAsyncAddParam(spParams, iType, cpData, stLength);
+      // Queue the write and report success
+      SqlAsyncQueue(SqlCVarCommitQuery(), StdMove(spParams));
+      cLog->LogDebugExSafe("Sql queued CVar '$' (T:$;ST:$;B:$).",
+        strVar, scvdfcFlags.FlagGet(), iType, stLength);
+      return true;
+    } // Try to write the specified cvar and if failed?
+    if(SqlExecute(SqlCVarCommitQuery(),
          strVar, scvdfcFlags.FlagGet<int>(), cpData, stLength, iType))
     { // Log the warning and return failure
       cLog->LogWarningExSafe(
@@ -1096,7 +1905,16 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
         SQLITE_BLOB, mcSrc.MemPtr<char>(), mcSrc.MemSize()); }
   /* ----------------------------------------------------------------------- */
   PurgeResult SqlCVarPurgeData(const char*const cpKey, const size_t stKey)
-  { // Try to purge the cvar from the database and if it failed?
+  { // Queue the purge for the database thread if requested
+    if(FlagIsSet(SF_ASYNCCVARS))
+    { // Copy the key and queue the purge
+      SqlParams spParams;
+      SqlAsyncAddParam(spParams, SQLITE_TEXT, cpKey, stKey);
+      SqlAsyncQueue("DELETE from `C` WHERE `K`=?", StdMove(spParams));
+      // We don't know if it changed anything so report that it did
+      cLog->LogDebugExSafe("Sql queued purge of CVar '$'.", cpKey);
+      return PR_OK;
+    } // Try to purge the cvar from the database and if it failed?
     if(!SqlExecuteAndSuccess("DELETE from `C` WHERE `K`=?", stKey, cpKey))
     { // Log the warning and return failure
       cLog->LogWarningExSafe("Sql failed to purge CVar '$' because $ ($)!",
@@ -1113,10 +1931,15 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
     { return SqlCVarPurgeData(strVar.data(), strVar.size()); }
   /* -- DeInit ------------------------------------------------------------- */
   void SqlDeInit()
-  { // Ignore if no handle to deinit
+  { // Execute queued queries and stop the database thread
+    SqlAsyncDeInit();
+    // Ignore if no handle to deinit
     if(SqlIsNotOpened()) return;
     // Log deinitialisation
     cLog->LogDebugExSafe("Sql database '$' is closing...", NameGet());
+    // Finalise cached statements and statements held by Lua
+    SqlStmtFlush();
+    SqlStmtsDetach(this);
     // Finalise statements and if we found orphans
     if(const size_t stOrphans = SqlFinalise())
       cLog->LogWarningExSafe("Sql finalised $ orphan statements.", stOrphans);
@@ -1417,8 +2240,14 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
       cLog->LogWarningExSafe("Sql could not open core '$' because $ ($)!",
         strDb, SqlGetErrorStr(), SqlGetError());
       return false;
-    } // Set to this database and set name
+    } // Queued queries belong to the old database so execute them
+    SqlAsyncWait();
+    // Statements belong to the old database so finalise them
+    SqlStmtFlush();
+    SqlStmtsDetach(this);
+    // Set to this database and set name
     sqlDB = sqlDBtemp;
+    SqlCapture();
     NameSet(strDb);
     // Load schema version then private key
     SqlLoadSchemaVersion();
@@ -1435,7 +2264,14 @@ CTOR_MEM_BEGIN_CSLAVE(Sqls, Sql, ICHelperUnsafe),
     SqlFlags{ cParent->sFlags },       // Copy global sql flags
     Lockable{ bLocked },               // Set locked by LUA flag
     sqlDB(nullptr),                    // No sql database handle yet
-    iError(SQLITE_OK)                  // Initialise sqlite and store error
+    iError(SQLITE_OK),                 // Initialise sqlite and store error
+    iChanges(0),                       // No rows changed yet
+    bAutoCommit(true),                 // No transaction open yet
+    ullStmtHits(0),                    // No cached statements used yet
+    ullStmtMisses(0),                  // No statements prepared yet
+    tAsync{ STP_LOW },                 // Low priority database thread
+    stAsyncPending(0),                 // No queries queued yet
+    bAsyncFlush(false)                 // Not flushing queued queries
   /* -- No code ------------------------------------------------------------ */
   { }
   /* -- Destructor to de-initialise database if opened --------------------- */
@@ -1448,6 +2284,20 @@ static CVarReturn SqlPragmaOnOff(const StdString &strVar, const bool bState)
 /* -- Set retry count ------------------------------------------------------ */
 static CVarReturn SqlRetryCountModified(const unsigned uCount)
   { return CVarSimpleSetInt(cSqls->uQueryRetries, uCount); }
+/* -- Set prepared statement cache size ------------------------------------ */
+static CVarReturn SqlSetStmtCacheSize(const size_t stSize)
+{ // Deny if invalid value
+  if(CVarSimpleSetIntNG(cSqls->stStmtCache, stSize, 1024UL) == DENY)
+    return DENY;
+  // Evict statements that no longer fit from all databases
+  for(Sql*const sCptr : *cSqls) sCptr->SqlStmtTrim(cSqls->stStmtCache);
+  // Success
+  return ACCEPT;
+}
+/* -- Set async query batch window ----------------------------------------- */
+static CVarReturn SqlBatchWindowModified(const uint64_t ullMilliseconds)
+  { return CVarSimpleSetIntNLG(cSqls->cdBatch,
+      milliseconds{ ullMilliseconds }, cd0, cd1S); }
 /* -- Set retry suspend time ----------------------------------------------- */
 static CVarReturn SqlRetrySuspendModified(const uint64_t ullMilliseconds)
   { return CVarSimpleSetIntNLG(cSqls->cdRetry,
@@ -1538,6 +2388,7 @@ static void SqlDeInit(void)
 }
 /* ------------------------------------------------------------------------- */
 CTOR_END(Sqls, Sql, SQL, SqlInit(), SqlDeInit(),,
+  LuaEvtMaster{ EMC_MP_SQL },          // Setup async query event
   elStrings{{                          // Init sqlite error strings list
     "OK",       /*00-01*/ "ERROR",     "INTERNAL", /*02-03*/ "PERM",
     "ABORT",    /*04-05*/ "BUSY",      "LOCKED",   /*06-07*/ "NOMEM",
@@ -1573,7 +2424,92 @@ CTOR_END(Sqls, Sql, SQL, SqlInit(), SqlDeInit(),,
   ssvSValueColumn{ "V" },              // Init name of schema 'value' column
   ssvSVersionKey{ "V" },               // Init name of version # key in schema
   uQueryRetries(3),                    // Initially 3 retries
-  cdRetry{ cd1S })                     // Initially wait 1 second per retry
+  cdRetry{ cd1S },                     // Initially wait 1 second per retry
+  stStmtCache(32),                     // Initially cache 32 statements
+  cdBatch{ cd10MS })                   // Initially collect queries for 10ms
+/* == Prepared statement collector and member class ======================== */
+CTOR_BEGIN_DUO(Stmts, Stmt, CLHelperUnsafe, ICHelperUnsafe),
+  /* -- Base classes ------------------------------------------------------- */
+  public Lockable                      // Lua garbage collect instruction
+{ /* -- Private variables -------------------------------------------------- */
+  Sql             *sqlOwner;           // Database the statement belongs to
+  sqlite3_stmt    *stmtData;           // The prepared statement
+  /* -- Check the statement is still usable -------------------------------- */
+  void StmtCheck() const
+    { if(!stmtData) XC("Database of prepared statement was closed!"); }
+  /* -- Get owning database ---------------------------------------- */ public:
+  const Sql *StmtGetOwner() const { return sqlOwner; }
+  /* -- Finalise the statement --------------------------------------------- */
+  void StmtDetach()
+  { // Ignore if already finalised
+    if(!stmtData) return;
+    // Finalise the statement and forget the database
+    sqlite3_finalize(stmtData);
+    stmtData = nullptr;
+    sqlOwner = nullptr;
+  }
+  /* -- Bind parameters from Lua and execute the statement ----------------- */
+  int StmtExecuteFromLua(lua_State*const lS, const int iStartParam)
+  { // Make sure the database was not closed
+    StmtCheck();
+    // Execute the statement
+    return sqlOwner->SqlExecuteStmtFromLua(lS, stmtData, iStartParam);
+  }
+  /* -- Bind parameters from Lua for stepping through the results ---------- */
+  void StmtBindFromLua(lua_State*const lS, const int iStartParam)
+  { // Make sure the database was not closed
+    StmtCheck();
+    // Bind the parameters
+    sqlOwner->SqlStmtBindFromLua(lS, stmtData, iStartParam);
+  }
+  /* -- Step to the next row and push it to Lua if there is one ------------ */
+  bool StmtStepToLua(lua_State*const lS)
+  { // Make sure the database was not closed
+    StmtCheck();
+    // Step the statement
+    return sqlOwner->SqlStmtStepToLua(lS, stmtData);
+  }
+  /* -- Rewind the statement and clear its parameters ---------------------- */
+  void StmtRewind()
+    { StmtCheck(); sqlOwner->SqlStmtRewind(stmtData); }
+  /* -- Bind parameters from Lua and push the results as columns ----------- */
+  lua_Integer StmtColumnsFromLua(lua_State*const lS, const int iStartParam)
+  { // Make sure the database was not closed
+    StmtCheck();
+    // Bind the parameters and push the columns
+    return sqlOwner->SqlStmtColumnsFromLua(lS, stmtData, iStartParam);
+  }
+  /* -- Return query text of the statement --------------------------------- */
+  const char *StmtGetQuery() const
+    { StmtCheck(); return sqlite3_sql(stmtData); }
+  /* -- Return number of parameters the statement takes -------------------- */
+  int StmtGetParams() const
+    { StmtCheck(); return sqlite3_bind_parameter_count(stmtData); }
+  /* -- Prepare the statement on the specified database -------------------- */
+  void StmtInit(Sql &sqlRef, const StdStringView &ssvQuery)
+  { // Prepare the statement which throws if it fails
+    stmtData = sqlRef.SqlStmtPrepare(ssvQuery);
+    sqlOwner = &sqlRef;
+  }
+  /* -- Constructor -------------------------------------------------------- */
+  Stmt() :
+    /* -- Initialisers ----------------------------------------------------- */
+    ICHelperStmt{ cStmts, this },      // Automatic (de)registration
+    SerialSlave{ cParent->Serial() },  // Initialise identification number
+    sqlOwner(nullptr),                 // No database yet
+    stmtData(nullptr)                  // No statement yet
+    /* -- No code ---------------------------------------------------------- */
+    {}
+  /* -- Destructor --------------------------------------------------------- */
+  DTORHELPER(~Stmt, StmtDetach())
+};/* ----------------------------------------------------------------------- */
+CTOR_END_NOINITS(Stmts, Stmt, STMT)    // End of statement objects collector
+/* -- Finalise statement handles that belong to the specified database ----- */
+static void SqlStmtsDetach(const Sql*const sqlPtr)
+{ // Finalise all statements that belong to this database
+  for(Stmt*const sPtr : *cStmts)
+    if(sPtr->StmtGetOwner() == sqlPtr) sPtr->StmtDetach();
+}
 /* ------------------------------------------------------------------------- */
 }                                      // End of public module namespace
 /* ------------------------------------------------------------------------- */
@@ -11,15 +11,17 @@ namespace ISShot {                     // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IClock::P;             using namespace ICommon::P;
 using namespace ICollector::P;         using namespace ICVarDef::P;
-using namespace IFbo::P;               using namespace IFboCore::P;
-using namespace IImage::P;             using namespace IImageDef::P;
+using namespace IError::P;             using namespace IFbo::P;
+using namespace IFboCore::P;           using namespace IImage::P;
+using namespace IImageData::P;         using namespace IImageDef::P;
 using namespace IImageLib::P;          using namespace ILog::P;
 using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace IMemory::P;            using namespace IName::P;
-using namespace IOgl::P;               using namespace IStd::P;
-using namespace IString::P;            using namespace ISystem::P;
-using namespace ISysUtil::P;           using namespace ITexDef::P;
-using namespace IThread::P;            using namespace Lib::OS::GlFW::Types;
+using namespace IMemory::P;            using namespace IMutex::P;
+using namespace IName::P;              using namespace IOgl::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISystem::P;            using namespace ISysUtil::P;
+using namespace ITexDef::P;            using namespace IThread::P;
+using namespace Lib::OS::GlFW::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Begin collector class ------------------------------------------------ */
@@ -30,19 +32,76 @@ CTOR_BEGIN(SShots, SShot, CLHelperUnsafe,
 CTOR_MEM_BEGIN(SShots, SShot, ICHelperUnsafe, /* n/a */),
   /* -- Initialisers ------------------------------------------------------- */
   public Image                         // Image class to store screen raw data
-{ /* -- Screenshot thread -------------------------------------------------- */
+{ /* -- Pending asynchronous readback of an Fbo ---------------------------- */
+  struct Readback                      // Pixel pack buffer in flight
+  { GLuint         gluPbo;             // Pixel pack buffer object
+    GLsync         glsFence;           // Signalled when the read completes
+    unsigned       uWidth, uHeight,    // Dimensions of the pixels read
+                   uFrames;            // Frames waited for the fence
+    StdString      strFile;            // Filename to write the pixels to
+  };
+  using Readbacks = StdArray<Readback, 3>; // Enough for capturing each frame
+  /* -- Captured frame waiting to be written ------------------------------- */
+  struct Frame                         // Frame waiting for the writer
+  { StdString      strFile;            // Filename to write the pixels to
+    Memory         mData;              // Pixel data (already the right way up)
+    unsigned       uWidth, uHeight;    // Dimensions of the pixel data
+  };
+  using FrameList = StdList<Frame>;    // Frames waiting for the writer
+  /* -- Private variables -------------------------------------------------- */
   ImageFormat          ifFormatId;     // Screenshot type to save as
+  Readbacks            rbSlots;        // Readbacks in flight
+  size_t               stSlot;         // Next readback slot to use
+  MutexLock            mlQueue;        // Lock for frame queue
+  FrameList            flQueue;        // Frames waiting to be written
+  StdString            strPrefix;      // Capture filename prefix
+  unsigned             uInterval,      // Capture every this many frames
+                       uCounter;       // Frames left until next capture
+  size_t               stQueue,        // Maximum frames waiting for writer
+                       stIndex,        // Next capture frame number
+                       stDropped;      // Frames dropped as writer was full
   Thread               tThread;        // Thread processing the request
+  /* -- Write a captured frame to disk ------------------------------------- */
+  void DumpWrite(Frame &fRef) const
+  { // Wrap the pixels in image data the codec can understand
+    ImageData idFrame;
+    idFrame.SetBitsAndBytesPerPixel(BD_RGB);
+    idFrame.SetPixelType(TT_RGB);
+    idFrame.DimSet(fRef.uWidth, fRef.uHeight);
+    idFrame.AddSlot(fRef.mData);
+    // Save the image to disk
+    ImageSave(ifFormatId, fRef.strFile, idFrame,
+      idFrame.GetSlotsConst().front());
+  }
+  /* -- Take the next captured frame from the queue ------------------------ */
+  bool DumpDequeue(FrameList &flOut)
+  { // Move the oldest frame over if there is one
+    return mlQueue.MutexCall([this, &flOut](){
+      if(flQueue.empty()) return false;
+      flOut.splice(flOut.end(), flQueue, flQueue.cbegin());
+      return true;
+    });
+  }
   /* -- Fbo dumper thread callback ----------------------------------------- */
-  ThreadStatus DumpThread(const Thread &)
+  ThreadStatus DumpThread(const Thread &tClass)
   { // Code to return
     ThreadStatus tsReturn;
     // Capture exceptions
     try
-    { // Reverse pixels or they will be upside down
-      ReversePixels();
-      // Save the image to disk
-      SaveFile(NameGet(), 0, ifFormatId);
+    { // Capturing a sequence?
+      if(uInterval)
+      { // Frame being written
+        FrameList flFrame;
+        // Write frames until told to stop and there are none left
+        for(;;) if(DumpDequeue(flFrame))
+        { // Write it and discard it
+          DumpWrite(flFrame.front());
+          flFrame.clear();
+        } // Nothing waiting so stop if requested or wait for more
+        else if(tClass.ThreadShouldExit()) break;
+        else StdSuspend();
+      } // Save the single image to disk
+      else SaveFile(NameGet(), 0, ifFormatId);
       // Success
       tsReturn = TS_OK;
     } // exception occured?
@@ -56,23 +115,26 @@ CTOR_MEM_BEGIN(SShots, SShot, ICHelperUnsafe, /* n/a */),
     // Return the code specified
     return tsReturn;
   }
-  /* -- Capture screenshot from Fbo -------------------------------- */ public:
-  bool DumpFbo(const Fbo &fboRef,
-    const StdStringView &ssvFile = cCommon->CommonBlankV())
-  { // Cancel if thread is still running
-    if(tThread.ThreadIsJoinable()) return false;
-    // DeInit old thread, we need to reuse it
-    tThread.ThreadDeInit();
-    // Log procedure
-    cLog->LogDebugExSafe(
-      "SShot '$' grabbing back buffer to write to screenshot...",
-      fboRef.NameGet());
+  /* -- Queue a read of the Fbo into a pixel pack buffer ------------------- */
+  bool ReadbackIssue(const Fbo &fboRef, const StdStringView &ssvFile)
+  { // Get next slot and fail if the gpu still has it
+    Readback &rbRef = rbSlots[stSlot];
+    if(rbRef.glsFence) return false;
     // Allocate storage (Writing as RGB 24-bit).
-    const BitDepth bdBPP = BD_RGB;
-    const TextureType ttMode = TT_RGB;
-    const size_t stBytesPerPixel = bdBPP / 8;
-    Memory mBuffer{ fboRef.DimGetWidth<size_t>() *
-      fboRef.DimGetHeight<size_t>() * stBytesPerPixel };
+    const size_t stBytes = fboRef.DimGetWidth<size_t>() *
+      fboRef.DimGetHeight<size_t>() * (BD_RGB / 8);
+    // Create the pixel pack buffer if we haven't already
+    if(!rbRef.gluPbo)
+      GL(cOgl->GenVertexBuffers(1, &rbRef.gluPbo),
+        "Failed to create pixel pack buffer!", "Name", NameGet());
+    // Bind the pixel pack buffer and (re)size it for this read
+    GL(cOgl->BindPackBuffer(rbRef.gluPbo),
+      "Failed to bind pixel pack buffer!",
+      "Name", NameGet(), "Id", rbRef.gluPbo);
+    GL(cOgl->BufferData(GL_PIXEL_PACK_BUFFER,
+      static_cast<GLsizei>(stBytes), nullptr, GL_STREAM_READ),
+      "Failed to allocate pixel pack buffer!",
+      "Name", NameGet(), "Id", rbRef.gluPbo, "Bytes", stBytes);
     // Bind the Fbo
     GL(cOgl->BindFbo(fboRef.gluFbo), "Failed to bind Fbo to dump!",
       "Name", fboRef.NameGet(), "Id", fboRef.gluFbo);
@@ -80,39 +142,224 @@ CTOR_MEM_BEGIN(SShots, SShot, ICHelperUnsafe, /* n/a */),
     GL(cOgl->BindTexture(fboRef.gluFbotex),
       "Failed to bind Fbo texture to dump!",
       "Name", fboRef.NameGet(), "Id", fboRef.gluFbotex);
-    // Read into buffer
-    GL(cOgl->ReadTextureTT(ttMode, mBuffer.MemPtr<GLvoid>()),
+    // Read into the start of the pixel pack buffer. This only queues the
+    // transfer so we do not stall here waiting for the gpu.
+    GL(cOgl->ReadTextureTT(TT_RGB, nullptr),
       "Failed to read Fbo pixel data!",
-      "Name", fboRef.NameGet(), "Mode", ImageGetPixelFormat(ttMode));
-    // Get new filename or original filename
-    NameSet(ssvFile.empty() ? StrAppend(cSystem->SysGetGuestShortTitle(),
-      cmSys.FormatTime("-%Y%m%d-%H%M%S")) : ssvFile);
-    // Log status
-    cLog->LogDebugExSafe("SShot '$' screen capture to '$' ($x$x$;$)...",
-      fboRef.NameGet(), NameGet(), fboRef.DimGetWidth(),
-      fboRef.DimGetHeight(), bdBPP, ImageGetPixelFormat(ttMode));
+      "Name", fboRef.NameGet(), "Mode", ImageGetPixelFormat(TT_RGB));
+    // Unbind so other pixel reads go to client memory again
+    cOgl->BindPackBuffer(0);
+    // Fence so we know when the transfer completes
+    rbRef.glsFence = cOgl->FenceSync();
+    // Remember what we read
+    rbRef.uWidth = fboRef.DimGetWidth<unsigned>();
+    rbRef.uHeight = fboRef.DimGetHeight<unsigned>();
+    rbRef.uFrames = 0;
+    rbRef.strFile = ssvFile;
+    // Use the next slot next time
+    stSlot = (stSlot + 1) % rbSlots.size();
+    // Success
+    return true;
+  }
+  /* -- Copy a completed readback out and hand it to the writer ------------ */
+  void ReadbackComplete(Readback &rbRef)
+  { // Done with the fence. Mapping will wait if the gpu still isn't done.
+    cOgl->DeleteSync(rbRef.glsFence);
+    rbRef.glsFence = nullptr;
+    // Allocate storage for the pixels
+    const size_t stStride = static_cast<size_t>(rbRef.uWidth) * (BD_RGB / 8),
+                 stBytes = stStride * rbRef.uHeight;
+    Memory mBuffer{ stBytes };
+    // Map the pixel pack buffer
+    GL(cOgl->BindPackBuffer(rbRef.gluPbo),
+      "Failed to bind pixel pack buffer!",
+      "Name", NameGet(), "Id", rbRef.gluPbo);
+    const GLvoid*const vpPixels =
+      cOgl->MapPackBuffer(static_cast<GLsizeiptr>(stBytes));
+    if(!vpPixels)
+    { // This is called every frame so don't throw. Unbind and release the
+      // pixel pack buffer so the slot gets a new one next time.
+      cOgl->BindPackBuffer(0);
+      cLog->LogWarningExSafe("SShot '$' failed to map pixel pack buffer $ "
+        "of $ bytes so dropped capture '$'!",
+        NameGet(), rbRef.gluPbo, stBytes, rbRef.strFile);
+      cOgl->DeleteVertexBuffers(1, &rbRef.gluPbo);
+      rbRef.gluPbo = 0;
+      rbRef.strFile.clear();
+      // Frame dropped
+      ++stDropped;
+      return;
+    } // Copy scanlines last to first or they will be upside down
+    const char*const cpPixels = reinterpret_cast<const char*>(vpPixels);
+    for(size_t stRow = 0; stRow < rbRef.uHeight; ++stRow)
+      mBuffer.MemWrite(stRow * stStride,
+        cpPixels + (rbRef.uHeight - 1 - stRow) * stStride, stStride);
+    // Done with the pixel pack buffer
+    if(!cOgl->UnmapPackBuffer())
+      cLog->LogWarningExSafe("SShot '$' pixel pack buffer was corrupted!",
+        NameGet());
+    cOgl->BindPackBuffer(0);
+    // Capturing a sequence?
+    if(uInterval)
+    { // Put the frame in a list so it can be spliced into the queue
+      FrameList flFrame;
+      flFrame.push_back({ StdMove(rbRef.strFile), StdMove(mBuffer),
+        rbRef.uWidth, rbRef.uHeight });
+      // Queue it unless the writer has fallen too far behind
+      if(mlQueue.MutexCall([this, &flFrame](){
+        if(flQueue.size() >= stQueue) return false;
+        flQueue.splice(flQueue.cend(), flFrame);
+        return true;
+      })) return;
+      // Frame dropped
+      ++stDropped;
+      cLog->LogDebugExSafe("SShot '$' dropped frame '$' as writer is busy!",
+        NameGet(), flFrame.front().strFile);
+      // Done
+      return;
+    } // Log status
+    cLog->LogDebugExSafe("SShot '$' screen capture ($x$x$;$)...",
+      NameGet(), rbRef.uWidth, rbRef.uHeight, BD_RGB,
+      ImageGetPixelFormat(TT_RGB));
     // Setup raw image
-    InitRaw(NameGet(), mBuffer, fboRef.DimGetWidth<unsigned>(),
-      fboRef.DimGetHeight<unsigned>(), bdBPP);
+    InitRaw(NameGet(), mBuffer, rbRef.uWidth, rbRef.uHeight, BD_RGB);
     // Launch thread to write the screenshot to disk in the background
     tThread.ThreadStart();
-    // Success
-    return true;
+  }
+  /* -- Complete readbacks that are ready (oldest first) ------------------- */
+  void ReadbackPoll(const bool bForce)
+  { // For each slot starting with the oldest
+    for(size_t stCount = 0; stCount < rbSlots.size(); ++stCount)
+    { // Ignore if nothing in flight
+      Readback &rbRef = rbSlots[(stSlot + stCount) % rbSlots.size()];
+      if(!rbRef.glsFence) continue;
+      // Complete it if forced, the gpu is done or we waited two frames
+      if(bForce || cOgl->FenceSignalled(rbRef.glsFence) ||
+        ++rbRef.uFrames >= 2) ReadbackComplete(rbRef);
+    }
+  }
+  /* -- Return if a readback is in flight ---------------------------------- */
+  bool ReadbackPending() const
+  { return StdFindIf(seq, rbSlots.cbegin(), rbSlots.cend(),
+      [](const Readback &rbRef){ return !!rbRef.glsFence; }) !=
+        rbSlots.cend(); }
+  /* -- Screenshot filename prefix ----------------------------------------- */
+  static StdString DumpGetPrefix()
+    { return StrAppend(cSystem->SysGetGuestShortTitle(),
+        cmSys.FormatTime("-%Y%m%d-%H%M%S")); }
+  /* -- Complete readbacks and release pixel pack buffers ---------- */ public:
+  void ReadbackDeInit()
+  { // Complete anything in flight so nothing is lost
+    ReadbackPoll(true);
+    // Delete the pixel pack buffers
+    for(Readback &rbRef : rbSlots)
+    { // Ignore if not created
+      if(!rbRef.gluPbo) continue;
+      // Delete it
+      cOgl->DeleteVertexBuffers(1, &rbRef.gluPbo);
+      rbRef.gluPbo = 0;
+    }
+  }
+  /* -- Called after every rendered frame ---------------------------------- */
+  void DumpFrame()
+  { // Complete readbacks that are ready
+    ReadbackPoll(false);
+    // Done if not capturing or not time to capture yet
+    if(!uInterval || --uCounter) return;
+    // Reset counter
+    uCounter = uInterval;
+    // Queue read of the main Fbo or drop the frame if the gpu is behind
+    if(!ReadbackIssue(cFboCore->FboCoreGetMain(), StrFormat("$-$$$$",
+      strPrefix, StdIOSSetWidth(6), StdIOSRight, StdIOSSetFill('0'),
+      stIndex))) ++stDropped;
+    // Next frame number
+    ++stIndex;
+  }
+  /* -- Capture screenshot from Fbo ---------------------------------------- */
+  bool DumpFbo(const Fbo &fboRef,
+    const StdStringView &ssvFile = cCommon->CommonBlankV())
+  { // Cancel if capturing, thread is still running or a read is in flight
+    if(uInterval || tThread.ThreadIsJoinable() || ReadbackPending())
+      return false;
+    // DeInit old thread, we need to reuse it
+    tThread.ThreadDeInit();
+    // Log procedure
+    cLog->LogDebugExSafe(
+      "SShot '$' queueing read of back buffer to write to screenshot...",
+      fboRef.NameGet());
+    // Get new filename or original filename
+    NameSet(ssvFile.empty() ? DumpGetPrefix() : ssvFile);
+    // Queue read of the Fbo which is written a frame or two later
+    return ReadbackIssue(fboRef, NameGet());
   }
   /* -- Dump main Fbo ------------------------------------------------------ */
   void DumpMain() { DumpFbo(cFboCore->FboCoreGetMain()); }
+  /* -- Capture every nth frame of the main Fbo to a numbered sequence ----- */
+  void DumpCapture(const unsigned uNInterval, const size_t stNQueue,
+    const StdStringView &ssvPrefix = cCommon->CommonBlankV())
+  { // Fail if capturing or a screenshot is still being taken
+    if(uInterval || tThread.ThreadIsJoinable() || ReadbackPending())
+      XC("Screenshot object is busy!", "Name", NameGet());
+    // DeInit old thread, we need to reuse it
+    tThread.ThreadDeInit();
+    // Set new prefix
+    strPrefix = ssvPrefix.empty() ? DumpGetPrefix() : ssvPrefix;
+    NameSet(strPrefix);
+    // Set capture parameters
+    uInterval = uCounter = uNInterval;
+    stQueue = stNQueue;
+    stIndex = stDropped = 0;
+    // Log procedure
+    cLog->LogDebugExSafe("SShot '$' capturing every $ frames (queue $)...",
+      NameGet(), uInterval, stQueue);
+    // Launch thread to write frames to disk in the background
+    tThread.ThreadStart();
+  }
+  /* -- Stop capturing ----------------------------------------------------- */
+  void DumpStop()
+  { // Ignore if not capturing
+    if(!uInterval) return;
+    // Complete anything in flight so nothing is lost
+    ReadbackPoll(true);
+    // Wait for the writer to write everything that was queued
+    tThread.ThreadStop();
+    // Log result
+    cLog->LogDebugExSafe("SShot '$' captured $ frames and dropped $.",
+      NameGet(), stIndex, stDropped);
+    // No longer capturing
+    uInterval = 0;
+  }
+  /* -- Return capture statistics ------------------------------------------ */
+  bool DumpIsCapturing() const { return !!uInterval; }
+  size_t DumpGetFrames() const { return stIndex; }
+  size_t DumpGetDropped() const { return stDropped; }
   /* -- Default constructor ------------------------------------------------ */
   SShot() :
     /* -- Initialisers ----------------------------------------------------- */
     ICHelperSShot{ cSShots },          // Initialise collector helper
     ifFormatId(cSShots->ifFormatId),   // Not truly initialised yet
+    rbSlots{},                         // No readbacks in flight
+    stSlot(0),                         // Start at first readback slot
+    uInterval(0),                      // Not capturing
+    uCounter(0),                       // Not capturing
+    stQueue(0),                        // Not capturing
+    stIndex(0),                        // No frames captured
+    stDropped(0),                      // No frames dropped
     tThread{ "sshot", STP_LOW,         // Prepare low perf screenshot thread
       bind(&SShot::DumpThread,         // Dump thread entry function
         this, _1) }                    // Send this class pointer
     /* -- No code ---------------------------------------------------------- */
     {}
+  /* -- Destructor (complete pending reads and wait for writer) ------------ */
+  DTORHELPER(~SShot, ReadbackDeInit(); tThread.ThreadStop())
 };/* ----------------------------------------------------------------------- */
 CTOR_END(SShots, SShot, SSHOT,,,, ifFormatId(IFMT_MAX)) // Initialised by cvars
+/* -- Called after every rendered frame ------------------------------------ */
+static void SShotsFrame()
+  { for(SShot*const sCptr : *cSShots) sCptr->DumpFrame(); }
+/* -- Complete reads and release pixel pack buffers before gl de-init ------ */
+static void SShotsDeInit()
+  { for(SShot*const sCptr : *cSShots) sCptr->ReadbackDeInit(); }
 /* -- Set screenshot format flags ------------------------------------------ */
 static CVarReturn SShotsSetType(const ImageFormat ifNFormatId)
   { return CVarSimpleSetIntNGE(cSShots->ifFormatId, ifNFormatId, IFMT_MAX); }
@@ -119,6 +119,10 @@ template<typename StrType>
 template<typename...VarArgs>
   constexpr static void StdSwap(VarArgs &&...aArgs)
 { return ::std::swap(StdForward<VarArgs>(aArgs)...); }
+/* -- Wrapper for STL to_chars function ------------------------------------ */
+template<typename...VarArgs>
+  static auto StdToChars(VarArgs &&...aArgs)
+{ return ::std::to_chars(StdForward<VarArgs>(aArgs)...); }
 /* -- Since compiler warns about use of the STL move() function ------------ */
 template<class AnyType, typename AnyTypeRR = StdRemoveReference<AnyType>>
   requires (StdIsReference<AnyType> || StdIsSame<AnyType, AnyTypeRR>)
@@ -277,6 +281,16 @@ template<typename DestType, typename SrcType>
     StdIsTrCopyable<SrcType> && StdIsTrCopyable<DestType>
 static DestType StdBruteCast(const SrcType stV)
   { return ::std::bit_cast<DestType>(stV); }
+/* -- Returns number of consecutive zero bits from the lowest bit ---------- */
+template<typename IntType>
+  requires StdIsUnsigned<IntType>
+constexpr static int StdCountRZero(const IntType itV)
+  { return ::std::countr_zero(itV); }
+/* -- Returns number of bits needed to store the specified value ----------- */
+template<typename IntType>
+  requires StdIsUnsigned<IntType>
+constexpr static int StdBitWidth(const IntType itV)
+  { return static_cast<int>(::std::bit_width(itV)); }
 /* -- Brute cast one type to another if pointer is valid ------------------- */
 template<typename FuncTypeDest, typename FuncTypeSrc>
   requires StdIsPointer<FuncTypeDest> && StdIsPointer<FuncTypeSrc> &&
@@ -343,6 +357,9 @@ constexpr static bool                  // MacOS doesn't have these policies
 constexpr static decltype(auto) StdSort(auto&, auto &&...aArgs)
   { return ::std::sort(StdForward<decltype(aArgs)>(aArgs)...); }
 /* ------------------------------------------------------------------------- */
+constexpr static decltype(auto) StdStableSort(auto&, auto &&...aArgs)
+  { return ::std::stable_sort(StdForward<decltype(aArgs)>(aArgs)...); }
+/* ------------------------------------------------------------------------- */
 constexpr static decltype(auto) StdFill(auto&, auto &&...aArgs)
   { return ::std::fill(StdForward<decltype(aArgs)>(aArgs)...); }
 /* ------------------------------------------------------------------------- */
@@ -379,6 +396,9 @@ using ::std::execution::seq;           // Serialised
 constexpr static decltype(auto) StdSort(auto &&...aArgs)
   { return ::std::sort(StdForward<decltype(aArgs)>(aArgs)...); }
 /* ------------------------------------------------------------------------- */
+constexpr static decltype(auto) StdStableSort(auto &&...aArgs)
+  { return ::std::stable_sort(StdForward<decltype(aArgs)>(aArgs)...); }
+/* ------------------------------------------------------------------------- */
 constexpr static decltype(auto) StdFill(auto &&...aArgs)
   { return ::std::fill(StdForward<decltype(aArgs)>(aArgs)...); }
 /* ------------------------------------------------------------------------- */
@@ -121,6 +121,7 @@ using StdWideString     = ::std::wstring;
 using StdWideStringView = ::std::wstring_view;
 using StdWOStream       = ::std::wostream;
 using StdNullPtr        = ::std::nullptr_t;
+using StdCharsFormat    = ::std::chars_format;
 /* -- Exception aliases ---------------------------------------------------- */
 using StdException    = ::std::exception;
 using StdRunTimeError = ::std::runtime_error;
@@ -18,16 +18,17 @@ using namespace IAsset::P;             using namespace IASync::P;
 using namespace ICodecOGG::P;          using namespace ICollector::P;
 using namespace ICVarDef::P;           using namespace IError::P;
 using namespace IEvtMain::P;           using namespace IFileMap::P;
-using namespace ILog::P;               using namespace ILookupArray::P;
-using namespace ILockable::P;          using namespace ILuaEvt::P;
-using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace ILuaUtil::P;           using namespace IMemory::P;
-using namespace IMixer::P;             using namespace IMutex::P;
-using namespace IName::P;              using namespace IOal::P;
-using namespace ISerial::P;            using namespace ISource::P;
-using namespace IStd::P;               using namespace IString::P;
-using namespace ISysUtil::P;           using namespace IUtil::P;
-using namespace Lib::Ogg;              using namespace Lib::OpenAL::Types;
+using namespace IJobs::P;              using namespace ILog::P;
+using namespace ILookupArray::P;       using namespace ILockable::P;
+using namespace ILuaEvt::P;            using namespace ILuaIdent::P;
+using namespace ILuaLib::P;            using namespace ILuaUtil::P;
+using namespace IMemory::P;            using namespace IMixer::P;
+using namespace IMutex::P;             using namespace IName::P;
+using namespace IOal::P;               using namespace ISerial::P;
+using namespace ISource::P;            using namespace IStd::P;
+using namespace IString::P;            using namespace ISysUtil::P;
+using namespace IUtil::P;              using namespace Lib::Ogg;
+using namespace Lib::OpenAL::Types;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* ------------------------------------------------------------------------- */
@@ -598,7 +599,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Streams, Stream, ICHelperSafe),
     ICHelperStream{ cStreams },        // Initialise collector unregistered
     SerialSlave{ cParent->Serial() },  // Initialise identification number
     AsyncLoaderStream{ this,           // Initialise async loader
-      EMC_MP_STREAM },                 //   with our streaming event
+      EMC_MP_STREAM, JP_AUDIO },       //   with our event and priority
     LuaEvtSlave{ this,                 // Initialise stream event manager
       EMC_STR_EVENT },                 //   with our stremaing event
     ovfContext{},                      // No file opened yet
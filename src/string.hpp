@@ -82,17 +82,140 @@ template<typename AnyType, typename ...VarArgs>
   // Process more parameters if we can.
   StrFormatParam(osS, ssvPos, stNewPos, StdForward<VarArgs>(vaArgs)...);
 }
+/* -- Get format string as a string view ----------------------------------- */
+template<typename StrType>
+  static StdStringView StrFormatView(StrType &&strFormat)
+{ // Get type without reference and a decayed type
+  using StrTypeNoRef = StdRemoveReference<StrType>;
+  using StrTypeDecayed = StdDecay<StrType>;
+  // If type is an C-style text array?
+  if constexpr(StdIsArray<StrTypeNoRef>)
+  { // Get the size of the text array and throw error if no size
+    constexpr size_t stN = StdExtent<StrTypeNoRef>;
+    static_assert(stN > 0);
+    // Return view of the array without the terminator
+    return { strFormat, stN - 1 };
+  } // If type is a null-terminated pointer to a C-String? We don't know the
+    // size so StdStringView will have to check for us
+  else if constexpr(StdIsPointer<StrTypeDecayed>) return { strFormat };
+  // Correct type is a StdString or StdStringView?
+  else if constexpr(StdIsString<StrTypeDecayed>) return strFormat;
+  // Anything else is invalid
+  else static_assert(sizeof(StrType) == 0, "Invalid format type!");
+}
+/* -- Types that can be written without a string stream -------------------- */
+template<typename AnyType, typename DecayedType = StdDecay<AnyType>>
+  concept StrIsFastType =
+    StdIsIntegral<DecayedType> ||             // Is a boolean or an integer?
+#if !defined(MACOS)                    // Apple only has this from 13.3
+    StdIsFloat<DecayedType> ||                // Is a floating point number?
+#endif
+    StdIsString<DecayedType> ||               // Is StdString or StdStringView?
+    StdIsSame<DecayedType, const char*> ||    // Is a C-string?
+    StdIsSame<DecayedType, char*> ||          // Is a mutable C-string?
+    StdIsSame<DecayedType, StdException>;     // Is an exception?
+/* -- All the specified types can be written without a string stream ------- */
+template<typename ...VarArgs>
+  constexpr static bool StrIsFastArgs = (StrIsFastType<VarArgs> && ...);
+/* -- Append a value the same way a default string stream would ------------ */
+template<typename AnyType>
+  static void StrFastValue(StdString &strOut, const AnyType &atVal)
+{ // Get decayed type
+  using DecayedType = StdDecay<AnyType>;
+  // Boolean? String stream writes these as a digit
+  if constexpr(StdIsSame<DecayedType, bool>) strOut += atVal ? '1' : '0';
+  // Character? String stream writes these as is
+  else if constexpr(StdIsSame<DecayedType, char> ||
+                    StdIsSame<DecayedType, signed char> ||
+                    StdIsSame<DecayedType, unsigned char>)
+    strOut += static_cast<char>(atVal);
+  // Integer? Convert it without the locale
+  else if constexpr(StdIsIntegral<DecayedType>)
+  { char cBuffer[48];
+    strOut.append(cBuffer,
+      StdToChars(cBuffer, cBuffer + sizeof(cBuffer), atVal).ptr); }
+  // Floating point? Same as the string stream default of six significant
+  // digits in the shortest of fixed or scientific notation.
+  else if constexpr(StdIsFloat<DecayedType>)
+  { char cBuffer[48];
+    strOut.append(cBuffer, StdToChars(cBuffer, cBuffer + sizeof(cBuffer),
+      atVal, StdCharsFormat::general, 6).ptr); }
+  // Exception? Write its reason
+  else if constexpr(StdIsSame<DecayedType, StdException>)
+    strOut += atVal.what();
+  // C-string array? Write it as is
+  else if constexpr(StdIsArray<AnyType>) strOut += atVal;
+  // C-string pointer? Write it if it is valid
+  else if constexpr(StdIsPointer<DecayedType>) { if(atVal) strOut += atVal; }
+  // String or string view
+  else strOut += atVal;
+}
+/* -- Format final parameter to string ------------------------------------- */
+static void StrFastFormatParam(StdString &strOut, const StdStringView &ssvPos,
+  const size_t stPos) { strOut += ssvPos.substr(stPos); }
+/* -- Format any parameter to string --------------------------------------- */
+template<typename AnyType, typename ...VarArgs>
+  static void StrFastFormatParam(StdString &strOut,
+    const StdStringView &ssvPos, const size_t stPos, const AnyType &atVal,
+    const VarArgs &...vaArgs)
+{ // Find mark that will be replaced by this param and if no more tokens?
+  const size_t stNewPos = ssvPos.find('$', stPos);
+  if(stNewPos == StdNPos) return StrFastFormatParam(strOut, ssvPos, stPos);
+  // Copy text up to the mark and the value that replaces it
+  strOut += ssvPos.substr(stPos, stNewPos - stPos);
+  StrFastValue(strOut, atVal);
+  // Process more parameters if we can.
+  StrFastFormatParam(strOut, ssvPos, stNewPos + 1, vaArgs...);
+}
+/* -- Scratch buffer for building strings (one per thread) ----------------- */
+static thread_local StdString strFastBuffer;
+/* -- Prepare the scratch buffer ------------------------------------------- */
+static StdString &StrFastBegin()
+  { strFastBuffer.clear(); return strFastBuffer; }
+/* -- Return a copy of the scratch buffer ---------------------------------- */
+static StdString StrFastEnd()
+{ // Copy the built string with an exact allocation
+  StdString strOut{ strFastBuffer };
+  // Give back memory if an unusually large string was built
+  if(strFastBuffer.capacity() > 65536)
+    { strFastBuffer.clear(); strFastBuffer.shrink_to_fit(); }
+  // Return the built string
+  return strOut;
+}
 /* -- Public functions ----------------------------------------------------- */
 namespace P {                          // Start of public module namespace
-/* -- Append main function ------------------------------------------------- */
+/* -- Append with a string stream ------------------------------------------ */
 template<typename ...VarArgs>
   requires (sizeof...(VarArgs) > 0)
-static StdString StrAppend(VarArgs &&...vaArgs)
+static StdString StrAppendStream(VarArgs &&...vaArgs)
 { // Create stream to write to, build it and return it
   StdOStringStream osS;
   StrAppendParam(osS, StdForward<VarArgs>(vaArgs)...);
   return osS.str();
 }
+/* -- Append main function ------------------------------------------------- */
+template<typename ...VarArgs>
+  requires (sizeof...(VarArgs) > 0)
+static StdString StrAppend(VarArgs &&...vaArgs)
+{ // Use a string stream if any value needs it (i.e. manipulators)
+  if constexpr(!StrIsFastArgs<VarArgs...>)
+    return StrAppendStream(StdForward<VarArgs>(vaArgs)...);
+  // Build the string in the scratch buffer and return a copy of it
+  else
+  { StdString &strOut = StrFastBegin();
+    (StrFastValue(strOut, vaArgs), ...);
+    return StrFastEnd(); }
+}
+/* -- Append values to the end of an existing string ----------------------- */
+template<typename ...VarArgs>
+  requires (sizeof...(VarArgs) > 0)
+static void StrAppendTo(StdString &strOut, VarArgs &&...vaArgs)
+{ // Use a string stream if any value needs it (i.e. manipulators)
+  if constexpr(!StrIsFastArgs<VarArgs...>)
+    strOut += StrAppendStream(StdForward<VarArgs>(vaArgs)...);
+  // Write the values directly
+  else (StrFastValue(strOut, vaArgs), ...);
+}
 /* -- Append with formatted numbers ---------------------------------------- */
 template<typename ...VarArgs>
   requires (sizeof...(VarArgs) > 0)
@@ -106,36 +229,47 @@ static StdString StrAppendImbue(VarArgs &&...vaArgs)
   // Return appended string
   return osS.str();
 }
-/* -- Prepare message from a c-string pointer ------------------------------ */
+/* -- Prepare message with a string stream --------------------------------- */
+template<typename StrType, typename ...VarArgs>
+  requires (sizeof...(VarArgs) > 0)
+static StdString StrFormatStream(StrType &&strFormat, VarArgs &&...vaArgs)
+{ // Get format string and return empty string if empty
+  const StdStringView ssvFormat{
+    StrFormatView(StdForward<StrType>(strFormat)) };
+  if(ssvFormat.empty()) return {};
+  // Create stringstream to write to, format the text and return it
+  StdOStringStream osS;
+  StrFormatParam(osS, ssvFormat, 0, StdForward<VarArgs>(vaArgs)...);
+  return osS.str();
+}
+/* -- Prepare message from a format string --------------------------------- */
 template<typename StrType, typename ...VarArgs>
   requires (sizeof...(VarArgs) > 0)
 static StdString StrFormat(StrType &&strFormat, VarArgs &&...vaArgs)
-{ // Get type without reference and a decayed type
-  using StrTypeNoRef = StdRemoveReference<StrType>;
-  using StrTypeDecayed = StdDecay<StrType>;
-  // If type is an C-style text array?
-  if constexpr(StdIsArray<StrTypeNoRef>)
-  { // Get the size of the text array and throw error if no size
-    constexpr size_t stN = StdExtent<StrTypeNoRef>;
-    static_assert(stN > 0);
-    // Call itself again with the correct format
-    return StrFormat(StdStringView{ strFormat, stN - 1 },
+{ // Use a string stream if any value needs it (i.e. manipulators)
+  if constexpr(!StrIsFastArgs<VarArgs...>)
+    return StrFormatStream(StdForward<StrType>(strFormat),
       StdForward<VarArgs>(vaArgs)...);
-  } // If type is a null-terminated pointer to a C-String?
-  else if constexpr(StdIsPointer<StrTypeDecayed>)
-  { // We don't know the size so StdStringView will have to check for us
-    return StrFormat(StdStringView{ strFormat },
-      StdForward<VarArgs>(vaArgs)...);
-  } // Correct type is a StdString?
-  else if constexpr(StdIsString<StrTypeDecayed>)
-  { // Create stringstream to write to, format the text and return it
-    if(strFormat.empty()) return {};
-    StdOStringStream osS;
-    StrFormatParam(osS, StdForward<StrType>(strFormat), 0,
+  // Build the string in the scratch buffer and return a copy of it
+  else
+  { const StdStringView ssvFormat{
+      StrFormatView(StdForward<StrType>(strFormat)) };
+    if(ssvFormat.empty()) return {};
+    StrFastFormatParam(StrFastBegin(), ssvFormat, 0, vaArgs...);
+    return StrFastEnd(); }
+}
+/* -- Append formatted message to the end of an existing string ------------ */
+template<typename StrType, typename ...VarArgs>
+  requires (sizeof...(VarArgs) > 0)
+static void StrFormatTo(StdString &strOut, StrType &&strFormat,
+  VarArgs &&...vaArgs)
+{ // Use a string stream if any value needs it (i.e. manipulators)
+  if constexpr(!StrIsFastArgs<VarArgs...>)
+    strOut += StrFormatStream(StdForward<StrType>(strFormat),
       StdForward<VarArgs>(vaArgs)...);
-    return osS.str();
-  } // Anything else is invalid
-  else static_assert(sizeof(StrType) == 0, "Invalid format type!");
+  // Write the values directly
+  else StrFastFormatParam(strOut,
+    StrFormatView(StdForward<StrType>(strFormat)), 0, vaArgs...);
 }
 /* -- Format a number ------------------------------------------------------ */
 template<typename IntType>
@@ -27,6 +27,16 @@ using namespace Lib::OS::GlFW::Types;
 namespace P {                          // Start of public module namespace
 /* -- Define texture collector class --------------------------------------- */
 CTOR_BEGIN_NOBB(Textures, Texture, CLHelperUnsafe)
+/* -- Packed sprite record as read by Texture::BlitBatch ------------------- */
+struct TextureBatchRecord              // 28 bytes per sprite, no padding
+{ /* ----------------------------------------------------------------------- */
+  uint32_t         uTileId;            // Tile index in the sub-texture
+  GLfloat          glfX, glfY,         // Left and top co-ordinates
+                   glfW, glfH,         // Width and height
+                   glfAngle;           // Angle from centre (-1 to 1, 0=none)
+  uint32_t         uColour;            // Colour intensity (0xAARRGGBB)
+};/* ----------------------------------------------------------------------- */
+static_assert(sizeof(TextureBatchRecord) == 28);
 /* -- Texture base class so we can reduce initialiser duplication ---------- */
 class TextureBase :                    // All members initially private
   /* -- Base classes ------------------------------------------------------- */
@@ -80,6 +90,7 @@ class TextureBase :                    // All members initially private
   DimGLFloat       dglfPad,            // Texture tile padding (GL)
                    dglfImage,          // Texture image width and height (GL)
                    dglfTile;           // Same as dgluTile but as a GLfloat
+  FboTriVec       *ftvpCapture;        // Capture triangles here if set
   /* -- Constructor -------------------------------------------------------- */
   explicit TextureBase(const ImageFlagsConst ifcPurpose) :
     /* -- Initialisers ----------------------------------------------------- */
@@ -88,7 +99,8 @@ class TextureBase :                    // All members initially private
     gliTexMagFilter(GL_NONE),          // No magnification filter set et
     gliMipmaps(0),                     // No mipmaps yet
     ofeTexFilter(OF_N_N),              // No texture filter index set yet
-    shpProgram(nullptr)                // No shader programme yet
+    shpProgram(nullptr),               // No shader programme yet
+    ftvpCapture(nullptr)               // Not capturing triangles yet
     /* -- No code ---------------------------------------------------------- */
     {}
 };/* ----------------------------------------------------------------------- */
@@ -519,7 +531,13 @@ CTOR_MEM_BEGIN(Textures, Texture, ICHelperUnsafe, /* No SerialSlave<> */),
   /* -- Blit a triangle ---------------------------------------------------- */
   void BlitTri(const GLuint gluTexId, const TriTexData &ttdTex,
     const TriPosData &tpdVert, const TriIntData &tidClr)
-  { FboActive()->FboBlit(gluTexId, tpdVert, ttdTex, tidClr, 0, shpProgram); }
+  { // Capturing triangles for later? Just store the triangle
+    if(ftvpCapture)
+      ftvpCapture->push_back(Fbo::FboMakeTri(tpdVert, ttdTex, tidClr));
+    // Send triangle to the active Fbo
+    else FboActive()->FboBlit(gluTexId, tpdVert, ttdTex, tidClr, 0,
+      shpProgram);
+  }
   /* -- Blit two triangles that form a square ------------------------------ */
   void BlitQuad(const GLuint gluTexId, const QuadTexData &qtdVert,
     const QuadPosData &qpdTex, const QuadIntData &qidClr)
@@ -589,6 +607,63 @@ CTOR_MEM_BEGIN(Textures, Texture, ICHelperUnsafe, /* No SerialSlave<> */),
   { BlitQuad(GetSubName(stSubTexId), clTiles[stSubTexId][stTileId],
       FboItemSetAndGetVertex(glfX1, glfY1, glfX1 + glfWidth, glfY1 + glfHeight,
         glfAngle), FboItemGetCData()); }
+  /* -- Blit packed sprite records in one pass ----------------------------- */
+  size_t BlitBatch(const size_t stSubTexId, const MemConst &mcSrc)
+  { // Data must consist of whole records
+    static constexpr size_t stStride = sizeof(TextureBatchRecord);
+    if(mcSrc.MemSize() % stStride)
+      XC("Batch data is not a multiple of the record size!",
+        "Name", NameGet(), "Bytes", mcSrc.MemSize(), "Stride", stStride);
+    // Number of records to draw and done if there are none
+    const size_t stCount = mcSrc.MemSize() / stStride;
+    if(!stCount) return 0;
+    // Everything that is the same for every record is resolved only once
+    const CoordList &clSub = clTiles[stSubTexId];
+    const GLuint gluTexId = GetSubName(stSubTexId);
+    const unsigned char*const ucpData =
+      mcSrc.MemRead<unsigned char>(0, mcSrc.MemSize());
+    Fbo &fActive = *FboActive();
+    fActive.FboReserveMore(stCount * stTrisPerQuad);
+    // Verify tile ids before anything is drawn so failure leaves no garbage
+    for(size_t stIndex = 0; stIndex < stCount; ++stIndex)
+    { // Read unaligned tile id and check it
+      uint32_t uTileId;
+      StdMemCopy(&uTileId, ucpData + (stIndex * stStride), sizeof(uTileId));
+      if(uTileId >= clSub.size())
+        XC("Batch record has an invalid tile id!",
+          "Name",   NameGet(), "Record",  stIndex,
+          "TileId", uTileId,   "Maximum", clSub.size());
+    }
+    // The records overwrite the stored colour so keep the original here and
+    // not in the push slot which belongs to Texture:PushColour/PopColour.
+    const QuadIntData qidSaved{ FboItemGetCData() };
+    // Capture exceptions so the colour is always restored
+    try
+    { // For each record
+      TextureBatchRecord tbrRec;
+      for(size_t stIndex = 0; stIndex < stCount; ++stIndex)
+      { // Copy the unaligned record
+        StdMemCopy(&tbrRec, ucpData + (stIndex * stStride), stStride);
+        // Set the position (skipping the rotation maths when not rotated)
+        if(tbrRec.glfAngle == 0.0f)
+          FboItemSetVertexWH(tbrRec.glfX, tbrRec.glfY,
+            tbrRec.glfW, tbrRec.glfH);
+        else FboItemSetVertexWH(tbrRec.glfX, tbrRec.glfY, tbrRec.glfW,
+          tbrRec.glfH, tbrRec.glfAngle);
+        // Set the colour
+        FboItemSetQuadRGBAInt(tbrRec.uColour);
+        // Add both triangles straight to the active fbo
+        const CoordData &cdTex = clSub[tbrRec.uTileId];
+        for(size_t stTriId = 0; stTriId < stTrisPerQuad; ++stTriId)
+          fActive.FboBlit(gluTexId, FboItemGetVData(stTriId), cdTex[stTriId],
+            FboItemGetCData(stTriId), 0, shpProgram);
+      }
+    } // Restore the original colour and rethrow
+    catch(...) { FboItemGetCData() = qidSaved; throw; }
+    // Restore the original colour and return number of sprites drawn
+    FboItemGetCData() = qidSaved;
+    return stCount;
+  }
   /* -- Blit all quads as full image --------------------------------------- */
   void BlitMulti(const GLuint gluColumns, const GLfloat glfX1,
     const GLfloat glfY1, const GLfloat glfX2, const GLfloat glfY2)
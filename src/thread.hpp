@@ -14,9 +14,10 @@ using namespace IClock::P;             using namespace ICollector::P;
 using namespace IError::P;             using namespace ILog::P;
 using namespace ILookupMap::P;         using namespace ILuaIdent::P;
 using namespace ILuaLib::P;            using namespace IMutex::P;
-using namespace IName::P ;             using namespace ISerial::P;
-using namespace IStd::P;               using namespace IString::P;
-using namespace ITime::P;        using namespace ISysUtil::P;
+using namespace IName::P ;             using namespace IProfile::P;
+using namespace ISerial::P;            using namespace IStd::P;
+using namespace IString::P;            using namespace ITime::P;
+using namespace ISysUtil::P;
 using ::std::thread;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public namespace
@@ -128,6 +129,8 @@ CTOR_MEM_BEGIN_CSLAVE(Threads, Thread, ICHelperUnsafe),
       if(!SysInitThread(tPtr->NameGetData(), tPtr->stPerf))
         cLog->LogWarningExSafe("Thread '$' update priority to $ failed: $!",
           tPtr->NameGet(), tPtr->ThreadGetPerf(), StrFromErrNo());
+      // Name the thread for the profiler
+      ProfileSetThreadName(tPtr->NameGet());
       // Run the thread callback
       tPtr->ThreadHandler();
     } // Report the problem
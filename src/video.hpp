@@ -15,13 +15,14 @@ using namespace ICollector::P;         using namespace ICVarDef::P;
 using namespace IError::P;             using namespace IEvtMain::P;
 using namespace IFbo::P;               using namespace IFileMap::P;
 using namespace IFlags::P;             using namespace IFrame::P;
-using namespace IInterval::P;          using namespace ILog::P;
-using namespace ILookupArray::P;       using namespace ILuaEvt::P;
-using namespace ILuaIdent::P;          using namespace ILuaLib::P;
-using namespace ILuaUtil::P;           using namespace IMemory::P;
-using namespace IMixer::P;             using namespace IMutex::P;
-using namespace IName::P;              using namespace IOal::P;
-using namespace IOgl::P;               using namespace IPcmLib::P;
+using namespace IInterval::P;          using namespace IJobs::P;
+using namespace ILog::P;               using namespace ILookupArray::P;
+using namespace ILuaEvt::P;            using namespace ILuaIdent::P;
+using namespace ILuaLib::P;            using namespace ILuaUtil::P;
+using namespace IMemory::P;            using namespace IMixer::P;
+using namespace IMutex::P;             using namespace IName::P;
+using namespace IOal::P;               using namespace IOgl::P;
+using namespace IPcmLib::P;            using namespace IProfile::P;
 using namespace IShader::P;            using namespace IShaders::P;
 using namespace ISource::P;            using namespace IStd::P;
 using namespace IStream::P;            using namespace IString::P;
@@ -40,6 +41,7 @@ using PFStrings = LookupArray<TH_PF_NFORMATS>;
 const PFStrings    pfStrings;          // Pixel format strings list
 double             dAudioBufferSize;   // Default audio buffer size
 size_t             stIOBufferSize;     // Default IO buffer size
+size_t             stPageQueue;        // Default demuxed page queue size
 double             dMaxDrift;,,        // Maximum drift before drop frames
 /* -- Derived classes ------------------------------------------------------ */
 private LuaEvtMaster<Video, LuaEvtTypeParam<Video>>); // Lua event
@@ -108,6 +110,23 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
   using FrameArray = StdArray<Frame, 2>;
   /* -- Y, Cb and Cr texture ids ------------------------------------------- */
   using GLuintArray = StdArray<GLuint, 3>;
+  /* ----------------------------------------------------------------------- */
+  struct Page                          // Demuxed ogg page
+  { /* -- Public variables ------------------------------------------------- */
+    Memory         mData;              // Page header and body
+    long           lHeader,            // Length of header in 'mData'
+                   lBody;              // Length of body in 'mData'
+    bool           bEnd;               // End of file reached (no page data)
+  };/* -- Ring of demuxed pages (single producer and consumer) ------------- */
+  using PageVector = StdVector<Page>;
+  /* ----------------------------------------------------------------------- */
+  struct KeyFrame                      // Position we can seek to
+  { /* -- Public variables ------------------------------------------------- */
+    double         dTime;              // Time of the keyframe in seconds
+    size_t         stOffset;           // Offset of page to start demuxing at
+    ogg_int64_t    llGranule;          // Theora granule before the keyframe
+  };/* -- Keyframe index sorted by time ------------------------------------ */
+  using KeyFrameVector = StdVector<KeyFrame>;
   /* -- Thread unblock reasons ------------------------------------- */ public:
   enum Unblock { UB_STANDBY, UB_BLOCK, UB_DATA, UB_REINIT, UB_PLAY, UB_STOP,
                  UB_PAUSE, UB_FINISH };
@@ -116,6 +135,7 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
   enum Event { VE_PLAY, VE_LOOP, VE_STOP, VE_PAUSE, VE_FINISH };
   /* -- Concurrency -------------------------------------------------------- */
   Thread           tThread;            // Video Decoding Thread
+  Thread           tDemux;             // Video demuxing thread
   AtomicUnblock    auReason;           // Unlock condition variable
   AtomicSizeT      astLoop;            // Loops count
   double           dDrift;             // Drift between audio and video
@@ -129,6 +149,10 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
   const size_t     stIOBuf;            // IO buffer size
   const long       lIOBuf;             // IO buffer size
   FileMap          fmFile;             // File map for reading file
+  PageVector       pvPages;            // Demuxed pages waiting for decoder
+  const size_t     stPageMask;         // Mask to wrap page ring position
+  AtomicSizeT      astPageWrite,       // Next page to write (demux thread)
+                   astPageRead;        // Next page to read (decode thread)
   /* -- Theora ------------------------------------------------------------- */
   ogg_stream_state ostsTheora;         // Ogg (Theora) stream states
   th_info          tiData;             // Theora info struct
@@ -156,6 +180,11 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
   vorbis_block     vbData;             // Vorbis decoder block
   AtomicDouble     adAudioTime;        // Audio time index
   StrNCStrMap      sncsmVoMetaData;    // Vorbis comments block
+  /* -- Seeking ------------------------------------------------------------ */
+  KeyFrameVector   kfvIndex;           // Positions we can seek to
+  double           dSeekVideo,         // Skip video frames ending before
+                   dSeekAudio;         // Skip audio before this time
+  bool             bSeekKey;           // Skip video packets until keyframe
   /* -- OpenGL ------------------------------------------------------------- */
   FboItem          fiYCbCr;            // Blit data for actual YCbCr components
   GLuintArray      gluaYCbCr;          // Texture id's for YCbCr components
@@ -166,6 +195,8 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
   ALfloat          alfAudioVolume;     // Audio volume
   const ALdouble   aldAudBufMax;       // Audio buffer size
   ALdouble         aldAudioBuffer;     // Audio buffered
+  ALUIntVector     aluvFree;           // Unqueued buffers ready for reuse
+  StdDeque<ALdouble> dqLengths;        // Lengths of queued buffers in order
   /* == Buffer more data for OGG decoder ========================== */ private:
   bool DoIOBuffer()
   { // Get some memory from ogg which we have to do every time we need to read
@@ -177,16 +208,64 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     // EOF or buffer invalid so return error
     return true;
   }
-  /* -- Rewind the theora stream ------------------------------------------- */
-  void DoRewind()
-  { // Rewind video to start
-    fmFile.FileMapRewind();
-    // Tell theora we reset the video position
+  /* -- Reset the decoders to play from the start -------------------------- */
+  void DoRewindDecoders()
+  { // Tell theora we reset the video position
     if(FlagIsSet(FL_THEORA))
       SetParameter<ogg_int64_t>(TH_DECCTL_SET_GRANPOS, 0);
     // Reset Vorbis dsp as required by documentation
     if(FlagIsSet(FL_VORBIS)) vorbis_synthesis_restart(&vdsData);
   }
+  /* -- Rewind the theora stream (threads must not be running) ------------- */
+  void DoRewind()
+  { // Rewind video to start
+    fmFile.FileMapRewind();
+    // Discard pages already demuxed and any partially synced page or packet
+    astPageRead = astPageWrite = 0;
+    ogg_sync_reset(&osysData);
+    if(FlagIsSet(FL_THEORA)) ogg_stream_reset(&ostsTheora);
+    if(FlagIsSet(FL_VORBIS)) ogg_stream_reset(&ostsVorbis);
+    // Reset the decoders
+    DoRewindDecoders();
+  }
+  /* -- Demux another page into the ring (false if the ring is full) ------- */
+  bool DemuxPage()
+  { // Return if the decoder has not consumed enough pages yet
+    const size_t stWrite = astPageWrite;
+    if(stWrite - astPageRead >= pvPages.size()) return false;
+    // Get the free page
+    Page &pPage = pvPages[stWrite & stPageMask];
+    // Break apart file data to pages until we get one
+    for(int iR; (iR = ogg_sync_pageout(&osysData, &opgData)) != 1;)
+    { // Stream has not yet captured sync (bytes were skipped)? Try again
+      if(iR == -1) continue;
+      // Unknown error?
+      if(iR) XC("Unknown sync page out result!",
+               "Name", NameGet(), "Result", iR);
+      // More data needed so load more data if there is some
+      if(fmFile.FileMapIsNotEOF())
+      { // Throw exception if failed else try to sync another page
+        if(DoIOBuffer()) XCL("Read video data failed!", "Name", NameGet());
+        continue;
+      } // Rewind the file so the pages after the marker are from the start
+      fmFile.FileMapRewind();
+      // Publish end of file marker so the decoder can loop or finish
+      pPage.bEnd = true;
+      astPageWrite = stWrite + 1;
+      return true;
+    } // Copy the page since the sync buffer it points to will be reused
+    const size_t stHeader = static_cast<size_t>(opgData.header_len),
+                 stBody = static_cast<size_t>(opgData.body_len);
+    pPage.mData.MemResizeUp(stHeader + stBody);
+    pPage.mData.MemWrite(0, opgData.header, stHeader);
+    if(stBody) pPage.mData.MemWrite(stHeader, opgData.body, stBody);
+    pPage.lHeader = opgData.header_len;
+    pPage.lBody = opgData.body_len;
+    pPage.bEnd = false;
+    // Publish the page to the decoder
+    astPageWrite = stWrite + 1;
+    return true;
+  }
   /* -- Rewind the theora stream and reset variables ----------------------- */
   void DoRewindAndReset()
   { // Rewind video to start
@@ -194,8 +273,68 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     // Reset granule position and frames rendered
     llVideoGranulePos = 0;
     auVideoFrames = auVideoFramesLost = 0;
+    // Stop audio and keep the buffers that were queued for reuse
+    if(IsSourceAvailable())
+      { soSource->Stop(); ProcessExhaustedAudioBuffers(); }
+    dqLengths.clear();
     // Reset counters
     adVideoTime = adAudioTime = dDrift = aldAudioBuffer = 0.0;
+    // Not seeking
+    dSeekVideo = dSeekAudio = -1.0;
+    bSeekKey = false;
+  }
+  /* -- Build keyframe index from the page headers of the file ------------- */
+  void IndexBuild()
+  { // Index the video stream if there is one else the audio stream
+    const bool bTheora = FlagIsSet(FL_THEORA);
+    const int iSerial = bTheora ? ostsTheora.serialno : ostsVorbis.serialno,
+              iShift = tiData.keyframe_granule_shift;
+    // We can always seek to the start
+    kfvIndex.clear();
+    kfvIndex.push_back({ 0.0, 0, 0 });
+    // Start of last page of the stream that finished a packet (Theora) and
+    // the keyframe number (Theora) or sample (Vorbis) of that packet.
+    size_t stLast = 0;
+    ogg_int64_t llLast = -1;
+    // Until we reach the end of the file
+    for(size_t stPos = 0; stPos + 27 <= fmFile.MemSize();)
+    { // Not a page? Skip junk until we capture sync again
+      if(fmFile.ReadIntBE<uint32_t>(stPos) != 0x4f676753)
+        { ++stPos; continue; }
+      // Get size of page and stop if the file is truncated
+      const size_t stSegs = fmFile.MemReadInt<uint8_t>(stPos + 26);
+      size_t stSize = 27 + stSegs;
+      if(stPos + stSize > fmFile.MemSize()) break;
+      for(size_t stSeg = 0; stSeg < stSegs; ++stSeg)
+        stSize += fmFile.MemReadInt<uint8_t>(stPos + 27 + stSeg);
+      // Get granule position and ignore if for another stream or no packet
+      // finishes on this page
+      const ogg_int64_t llGranule =
+        fmFile.ReadIntLE<ogg_int64_t>(stPos + 6);
+      if(llGranule != -1 &&
+         static_cast<int>(fmFile.ReadIntLE<uint32_t>(stPos + 14)) == iSerial)
+      { // Video stream?
+        if(bTheora)
+        { // A new keyframe finished on this page? The keyframe packet starts
+          // on or after the last page that finished a packet. We can skip
+          // the first keyframe as the start of the file is already indexed.
+          const ogg_int64_t llKey = llGranule >> iShift;
+          if(llKey != llLast && llLast != -1)
+            kfvIndex.push_back({ static_cast<double>(th_granule_frame(tdcPtr,
+              llKey << iShift)) / GetFPS(), stLast,
+              UtilMaximum(llKey - 1, static_cast<ogg_int64_t>(0)) << iShift });
+          // Remember keyframe and position of this page
+          llLast = llKey;
+          stLast = stPos;
+        } // Audio stream? Audio on this page follows the last sample
+        else
+        { kfvIndex.push_back({ static_cast<double>(UtilMaximum(llLast,
+            static_cast<ogg_int64_t>(0))) /
+              static_cast<double>(GetSampleRate()), stPos, 0 });
+          llLast = llGranule; }
+      } // Next page
+      stPos += stSize;
+    }
   }
   /* -- Set theora decoder control ----------------------------------------- */
   template<typename IntType = int>
@@ -216,15 +355,14 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     { // Unqueue a buffer and break if failed
       const ALuint aluBuffer = soSource->UnQueueBuffer();
       if(cOal->HaveError()) continue;
-      // Remove buffer time
-      aldAudioBuffer = UtilMaximum(aldAudioBuffer -
-        (static_cast<ALdouble>(cOal->GetBufferInt<ALint>(aluBuffer, AL_SIZE)) /
-          static_cast<ALdouble>(GetSampleRate()) /
-          static_cast<ALdouble>(GetChannels())), 0.0);
-      // Delete the buffer that was returned continue if successful
-      ALL(cOal->DeleteBuffer(aluBuffer),
-        "Video failed to delete unqueued buffer $ in '$'!",
-        aluBuffer, NameGet());
+      // Buffers are processed in the order they were queued so remove the
+      // buffer time that was recorded when it was queued.
+      if(!dqLengths.empty())
+      { aldAudioBuffer =
+          UtilMaximum(aldAudioBuffer - dqLengths.front(), 0.0);
+        dqLengths.pop_front(); }
+      // Keep the buffer so the next decoded packet can reuse it
+      aluvFree.push_back(aluBuffer);
     }
   }
   /* -- Try to parse and render more Vorbis data --------------------------- */
@@ -240,6 +378,10 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
         vorbis_synthesis_read(&vdsData, iFrames);
         // Set audio time
         adAudioTime = vorbis_granule_time(&vdsData, vdsData.granulepos);
+        // Still seeking and this audio is before the requested time? Skip it
+        if(dSeekAudio >= 0.0)
+        { if(GetAudioTime() < dSeekAudio) continue;
+          dSeekAudio = -1.0; }
         // Set that we got audio
         bParsed = true;
         // No need to do anymore if there is no source
@@ -266,9 +408,13 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
           MemResizeUp(stFrameSize);
           cCodecOGG->I16FromVorbisFrames(alfpaPCM, stFrames, stChannels,
             MemPtr<ALshort>());
-        } // Generate a buffer for the pcm data and if succeeded?
-        const ALuint aluBuffer = cOal->CreateBuffer();
-        ALenum aleErr = cOal->GetError();
+        } // Reuse an unqueued buffer or generate a new one if there are none
+        ALuint aluBuffer;
+        ALenum aleErr = AL_NO_ERROR;
+        if(aluvFree.empty())
+          { aluBuffer = cOal->CreateBuffer(); aleErr = cOal->GetError(); }
+        else { aluBuffer = aluvFree.back(); aluvFree.pop_back(); }
+        // If we have a buffer for the pcm data?
         if(aleErr == AL_NO_ERROR) try
         { // Buffer the data and throw exception if failed
           cOal->BufferData(aluBuffer, GetAudioFormat(), MemPtr<ALvoid>(),
@@ -280,20 +426,21 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
           soSource->QueueBuffer(aluBuffer);
           aleErr = cOal->GetError();
           if(aleErr != AL_NO_ERROR) throw "queuing";
-          // We ate everything so set audio time and add to buffer
-          aldAudioBuffer += static_cast<ALdouble>(stFrameSize) /
+          // We ate everything so set audio time and add to buffer. Record
+          // the time so we don't need to query it when it is unqueued.
+          const ALdouble aldLength = static_cast<ALdouble>(stFrameSize) /
             static_cast<ALdouble>(GetSampleRate()) /
             static_cast<ALdouble>(GetChannels());
+          dqLengths.push_back(aldLength);
+          aldAudioBuffer += aldLength;
           // Play the source if the audio timer has started
           soSource->Play();
           // Try to parse more data
           break;
         } // Exception occured?
         catch(const char*const cpReason)
-        { // Delete the buffers because of error
-          ALL(cOal->DeleteBuffer(aluBuffer),
-            "Video failed to delete buffer $ in '$' "
-            "after failed data upload attempt!", aluBuffer, NameGet());
+        { // Buffer was not queued so keep it for reuse
+          aluvFree.push_back(aluBuffer);
           // Log the warning
           cLog->LogWarningExSafe("Video '$' $ audio failed "
             "(B:$;F:$<$$$>;A:$;S:$;R:$;AL:$<$$>)!",
@@ -351,11 +498,22 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
       switch(const int iR1 = ogg_stream_packetout(&ostsTheora, &opkData))
       { // if a packet was assembled normally?
         case 1:
+          // Just seeked? Frames can only be decoded from a keyframe
+          if(bSeekKey)
+          { if(th_packet_iskeyframe(&opkData) != 1) continue;
+            bSeekKey = false; }
           // Decode the packet and if we get a positive result?
           switch(const int iR2 =
             th_decode_packetin(tdcPtr, &opkData, &llVideoGranulePos))
           { // Success?
             case 0:
+              // Still seeking and this frame is before the requested time?
+              // Skip outputting it. The decoder still needed it as a
+              // reference for the frames that follow.
+              if(dSeekVideo >= 0.0)
+              { if(th_granule_time(tdcPtr, llVideoGranulePos) <= dSeekVideo)
+                  continue;
+                dSeekVideo = -1.0; }
               // Prevent uploading while we modify the upload data
               MutexCall([this](){
                 // Get next frame to draw
@@ -387,6 +545,8 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
               continue;
             // Duplicate frame? We don't need to decode anything
             case TH_DUPFRAME:
+              // Still seeking? Nothing to output
+              if(dSeekVideo >= 0.0) continue;
               // We processed a video frame
               bParsed = true;
               // Update video time and increment frames counter
@@ -411,46 +571,46 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
                    "Name", NameGet(), "Result", iR1);
       } // Break out of loop
       break;
-    } // ...until the timer continues to trigger
-    while(tThread.ThreadShouldNotExit() && CIIsTriggered());
+    } // ...until the timer continues to trigger or we're still seeking
+    while(tThread.ThreadShouldNotExit() &&
+      (bSeekKey || dSeekVideo >= 0.0 || CIIsTriggered()));
     // Return parse result
     return bParsed;
   }
-  /* -- Try to parse more raw data ----------------------------------------- */
-  bool ParseRawData()
-  { // Break apart file data to useful packets
-    switch(const int iR = ogg_sync_pageout(&osysData, &opgData))
-    { // A page was synced and returned.
-      case 1: return true;
-      // Stream has not yet captured sync (bytes were skipped).
-      case -1: break;
-      // More data needed or an internal error occurred.
-      case 0: break;
-      // Unknown error
-      default: XC("Unknown sync page out result!",
-                 "Name", NameGet(), "Result", iR);
-    } // Break loop
-    return false;
-  }
-  /* -- Try to load more raw data ------------------------------------------ */
+  /* -- Feed pages from the demux thread to the decoders ------------------- */
   bool LoadRawData()
-  { // Is end of file?
-    if(fmFile.FileMapIsEOF())
-    { // Rewind video
-      DoRewind();
-      // We should loop?
-      if(astLoop > 0)
-      { // Reduce loops if not infinity then send looping event
-        if(astLoop != StdMaxSizeT) --astLoop;
-        LuaEvtDispatch(VE_LOOP);
-      } // No more loops? so set finished reason and exit the thread
-      else
-      { // Set finished. We're not processing more data
+  { // Demux thread not running (i.e. advancing manually)? Demux it ourselves
+    if(tDemux.ThreadIsNotJoinable()) DemuxPage();
+    // Get read and write positions and wait a little if there are no pages
+    size_t stRead = astPageRead;
+    const size_t stWrite = astPageWrite;
+    if(stRead == stWrite) { StdSuspend(); return false; }
+    // Until we've consumed all the pages available
+    for(; stRead != stWrite; ++stRead)
+    { // Get page and if the demux thread reached the end of file?
+      Page &pPage = pvPages[stRead & stPageMask];
+      if(pPage.bEnd)
+      { // Release the marker and reset the decoders. If we seeked past the
+        // end then there is nothing left to skip.
+        astPageRead = stRead + 1;
+        DoRewindDecoders();
+        dSeekVideo = dSeekAudio = -1.0;
+        // We should loop? Reduce loops if not infinity then send looping
+        // event. The pages that follow the marker are from the start.
+        if(astLoop > 0)
+        { if(astLoop != StdMaxSizeT) --astLoop;
+          LuaEvtDispatch(VE_LOOP);
+          return false; }
+        // Set finished. We're not processing more data
         auReason = UB_FINISH;
         return true;
-      }
-    } // Load more data and throw exception if failed
-    else if(DoIOBuffer()) XCL("Read video data failed!", "Name", NameGet());
+      } // Parse more video and audio data. No point logging failures.
+      ogg_page opgPage{ pPage.mData.MemPtr<unsigned char>(), pPage.lHeader,
+        pPage.mData.MemPtr<unsigned char>() + pPage.lHeader, pPage.lBody };
+      if(FlagIsSet(FL_THEORA)) ogg_stream_pagein(&ostsTheora, &opgPage);
+      if(FlagIsSet(FL_VORBIS)) ogg_stream_pagein(&ostsVorbis, &opgPage);
+    } // Give the pages back to the demux thread
+    astPageRead = stRead;
     // There is more data
     return false;
   }
@@ -463,11 +623,8 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
       StdSuspend(cd10MS);
     // Parse and render more vorbis data and if we didn't?
     else if(!ParseAndRenderVorbisData())
-    { // Try to load more raw data and return if we're at the end of file
+    { // Feed more pages to the decoder and return if at the end of file
       if(LoadRawData()) return false;
-      // Repeat until there are more audio packets to parse
-      while(tThread.ThreadShouldNotExit() && ParseRawData())
-        ogg_stream_pagein(&ostsVorbis, &opgData);
     } // Done
     return true;
   }
@@ -482,11 +639,8 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
       adVideoTime = th_granule_time(tdcPtr, llVideoGranulePos);
     // No video rendered?
     else
-    { // Try to load more raw data and return if at end of file
+    { // Feed more pages to the decoder and return if at the end of file
       if(LoadRawData()) return false;
-      // Repeat until there are more video packets to parse
-      while(tThread.ThreadShouldNotExit() && ParseRawData())
-        ogg_stream_pagein(&ostsTheora, &opgData);
     } // Keep thread loop alive
     return true;
   }
@@ -529,14 +683,8 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
       }
     } // Didn't process anything this time?
     if(!bAudioParsed && !bVideoParsed)
-    { // Try to load more raw data and return if we're at the end of file
+    { // Feed more pages to the decoders and return if at the end of file
       if(LoadRawData()) return false;
-      // Repeat until there are more audio and video packets to parse
-      while(tThread.ThreadShouldNotExit() && ParseRawData())
-      { // Parse more video and audio data. No point logging failures.
-        ogg_stream_pagein(&ostsTheora, &opgData);
-        ogg_stream_pagein(&ostsVorbis, &opgData);
-      }
     } // Keep thread loop alive
     return true;
   }
@@ -551,6 +699,8 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
       while(tClass.ThreadShouldNotExit() && VideoHandleAudioOnly());
     else if(FlagIsSet(FL_THEORA))      // Ogg has video only stream?
       while(tClass.ThreadShouldNotExit() && VideoHandleVideoOnly());
+    // Nothing is consuming pages anymore so stop demuxing
+    tDemux.ThreadSetExit();
     // Log the reason why the thread should be terminated
     cLog->LogDebugExSafe("Video '$' main loop exit with reason $!",
       NameGet(), auReason.load());
@@ -581,6 +731,23 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
   catch(const StdException &eReason)
   { // Report it to log
     cLog->LogErrorExSafe("(VIDEO THREAD EXCEPTION) $", eReason);
+    // Nothing is consuming pages anymore so stop demuxing
+    tDemux.ThreadSetExit();
+    // Failure exit code
+    return TS_ERROR;
+  }
+  /* -- Demux thread main function ----------------------------------------- */
+  ThreadStatus VideoDemuxMain(const Thread &tClass) try
+  { // Keep the page ring topped up and wait a little when it is full
+    while(tClass.ThreadShouldNotExit()) if(!DemuxPage()) StdSuspend();
+    // Exit thread cleanly
+    return TS_OK;
+  } // exception occured?
+  catch(const StdException &eReason)
+  { // Report it to log
+    cLog->LogErrorExSafe("(VIDEO DEMUX THREAD EXCEPTION) $", eReason);
+    // Decoder will not get anymore pages so stop decoding too
+    tThread.ThreadSetExit();
     // Failure exit code
     return TS_ERROR;
   }
@@ -871,8 +1038,11 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
         MemSize());
       // Reset audio position and drift
       adAudioTime = dDrift = 0.0;
-    } // Log success
-    cLog->LogInfoExSafe("Video loaded '$' successfully.", NameGet());
+    } // Index the positions we can seek to
+    IndexBuild();
+    // Log success
+    cLog->LogInfoExSafe("Video loaded '$' successfully with $ seek points.",
+      NameGet(), kfvIndex.size());
     // Log debug inforation
     cLog->LogDebugExSafe(
       "- Version: $$.$.$.\n"         "- Serial: $ <0x$$$>.\n"
@@ -952,6 +1122,9 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
   }
   /* -- Video is playing? -------------------------------------------------- */
   bool IsPlaying() const { return tThread.ThreadIsJoinable(); }
+  /* -- Video is playing and has not reached the end ----------------------- */
+  bool IsPlayingNotFinished() const
+    { return FlagIsSet(FL_PLAY) && IsPlaying() && auReason != UB_FINISH; }
   /* -- DeInitialise audio ouput (because reinitialising) ------------------ */
   void DeInitAudio()
   { // Return if there is no audio in this video
@@ -977,6 +1150,13 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     // Stop from playing so all buffers are unqueued and wait for stop
     // then unqueue and delete the buffer
     soSource->StopUnQueueAndDeleteAllBuffers();
+    // Delete the unqueued buffers that were kept for reuse
+    if(!aluvFree.empty())
+    { ALL(cOal->DeleteBuffers(aluvFree),
+        "Video failed to delete $ recycled buffers in '$'!",
+        aluvFree.size(), NameGet());
+      aluvFree.clear(); }
+    dqLengths.clear();
     // Unlock the source so the source manager can recycle it
     soSource->Unlock();
     soSource = nullptr;
@@ -990,6 +1170,8 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     auReason = ubNewReason;
     // DeInit the thread, unblock the worker thread and stop and unload buffers
     tThread.ThreadStop();
+    // Stop demuxing. Pages already demuxed are kept for when we resume.
+    tDemux.ThreadStop();
     // Success
     return true;
   }
@@ -1022,6 +1204,8 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
   void Advance()
   { // If not playing
     if(tThread.ThreadIsNotExited()) return;
+    // We will demux pages ourselves
+    tDemux.ThreadStop();
     // Loop until thread should exit
     if(FlagIsSet(FL_THEORAVORBIS)) // Ogg has both audio and video streams?
       while(!VideoHandleAudioVideo() && !stFWaiting);
@@ -1094,7 +1278,8 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     CISync();
     // Set playing flag
     FlagSet(FL_PLAY);
-    // Start decoding if we're still playing
+    // Start demuxing and decoding if we're still playing
+    tDemux.ThreadStart(this);
     tThread.ThreadStart(this);
     // Log that the video was started
     cLog->LogDebugExSafe("Video '$' playing with reason $!",
@@ -1106,11 +1291,54 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
   void Rewind()
   { // Ignore if already rewound
     if(llVideoGranulePos <= 0) return;
-    // Rewind video to start
+    // Only resume if we were playing and had not finished. Pause() returns
+    // true for a finished video too as finishing does not clear FL_PLAY.
+    const bool bResume = IsPlayingNotFinished();
+    // Threads must not be running while the page ring is reset
+    Pause(UB_REINIT);
+    // Rewind video to start and resume if we were playing
     DoRewindAndReset();
+    if(bResume) Play(UB_REINIT);
     // Log that the video was rewound
     cLog->LogDebugExSafe("Video '$' rewound!", NameGet());
   }
+  /* -- Seek video --------------------------------------------------------- */
+  bool Seek(const double dTime)
+  { // Ignore if not loaded
+    if(kfvIndex.empty()) return false;
+    // Bisect the index to find the last keyframe at or before the time
+    size_t stLow = 0, stHigh = kfvIndex.size();
+    while(stHigh - stLow > 1)
+    { const size_t stMid = (stLow + stHigh) / 2;
+      if(kfvIndex[stMid].dTime <= dTime) stLow = stMid;
+      else stHigh = stMid; }
+    const KeyFrame &kfKey = kfvIndex[stLow];
+    // Only resume if we were playing and had not finished
+    const bool bResume = IsPlayingNotFinished();
+    // Threads must not be running while the decoders are reset
+    Pause(UB_REINIT);
+    // Flush everything and start demuxing from the keyframe page
+    DoRewindAndReset();
+    fmFile.FileMapSeekSet(kfKey.stOffset);
+    // Tell theora the granule position of the frame before the keyframe
+    // and skip packets until the keyframe then skip frames until the time.
+    if(FlagIsSet(FL_THEORA))
+    { SetParameter<ogg_int64_t>(TH_DECCTL_SET_GRANPOS, kfKey.llGranule);
+      llVideoGranulePos = kfKey.llGranule;
+      bSeekKey = true;
+      dSeekVideo = dTime; }
+    // Skip audio until the time too so audio and video are in sync
+    if(FlagIsSet(FL_VORBIS)) dSeekAudio = dTime;
+    // Report the requested time until the decoders catch up
+    adVideoTime = adAudioTime = dTime;
+    // Resume if we were playing
+    if(bResume) Play(UB_REINIT);
+    // Log that the video was seeked
+    cLog->LogDebugExSafe("Video '$' seeked to $ from keyframe at $ (P:$).",
+      NameGet(), dTime, kfKey.dTime, kfKey.stOffset);
+    // Success
+    return true;
+  }
   /* -- (De)Initialise video ouput ----------------------------------------- */
   void DeInitTexture()
   { // Delete the component textures
@@ -1223,13 +1451,16 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     ICHelperVideo{ cVideos, this },    // Initialise collector class
     Fbo{ GL_RGBA8, false },            // Create unregistered opaque surface
     AsyncLoaderVideo{ this,            // Initialise async loader
-      EMC_MP_VIDEO },                  // ...video event code
+      EMC_MP_VIDEO, JP_IMAGE },        // ...video event code and priority
     LuaEvtSlave{ this,                 // Initialise event handler
       EMC_VID_EVENT },                 // ...event handler code
     VideoFlags{ FL_FDR|FL_REC709 },    // Use full-dynamic range and Rec.709
     tThread{ "video", STP_HIGH,        // Initialise thread with high priority
       bind(&Video::VideoThreadMain,    // ...preset callback
         this, _1) },                   // ...class as parameter
+    tDemux{ "videodemux", STP_HIGH,    // Initialise demux thread
+      bind(&Video::VideoDemuxMain,     // ...preset callback
+        this, _1) },                   // ...class as parameter
     auReason(UB_STANDBY),              // Initially set to blocked
     astLoop(0),                        // Initialise no loops remaining
     dDrift(0.0),                       // Initialise drift time
@@ -1240,6 +1471,10 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     opkData{ /* Zeroed */ },           // Clear ogg packet data
     stIOBuf(cVideos->stIOBufferSize),  // Initialise buffer length
     lIOBuf(static_cast<long>(stIOBuf)),// Initialise buffer length as long
+    pvPages(cVideos->stPageQueue),     // Initialise demuxed page ring
+    stPageMask(pvPages.size() - 1),    // Initialise page ring position mask
+    astPageWrite{ 0 },                 // Initialise page write position
+    astPageRead{ 0 },                  // Initialise page read position
     ostsTheora{ /* Zeroed */ },        // Clear ogg stream state
     tiData{ /* Zeroed */ },            // Clear Theora info struct
     tcData{ /* Zeroed */ },            // Clear Theora comment struct
@@ -1263,6 +1498,9 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     vdsData{ /* Zeroed */ },           // Clear Vorbis DSP state data
     vbData{ /* Zeroed */ },            // Clear Vorbis decoder block data
     adAudioTime(0.0),                  // Initialise audio position
+    dSeekVideo(-1.0),                  // Not skipping video frames
+    dSeekAudio(-1.0),                  // Not skipping audio
+    bSeekKey(false),                   // Not waiting for a keyframe
     shpProgram(nullptr),               // Initialise pointer to Shader used
     soSource(nullptr),                 // Initialise pointer to Source used
     aleFormat(AL_NONE),                // Initialise audio format type
@@ -1282,6 +1520,7 @@ CTOR_MEM_BEGIN_ASYNC(Videos, Video, ICHelperSafe, /* No CLHelper */),
     auReason = UB_FINISH;
     // DeInit the thread, unblock the worker thread and stop and unload buffers
     tThread.ThreadStopNoThrow();
+    tDemux.ThreadStopNoThrow();
     // Ignore if file data not initialised
     if(fmFile.FileMapClosed()) return;
     // Prevent more events being generated
@@ -1323,6 +1562,7 @@ CTOR_END_ASYNC_NOFUNCS(Videos, Video, VIDEO, VIDEO, // Finish collector class
   }, "TH_PF_UNSUPPORTED" },            // End of pixel format strings list
   dAudioBufferSize(0),                 // Audio buffer size init by cvar
   stIOBufferSize(0),                   // Buffer size initialised by cvar
+  stPageQueue(0),                      // Page queue size initialised by cvar
   dMaxDrift(0.0)                       // Max drift initialised by cvar
 )/* == Reinit textures (after engine thread shutdown) ====================== */
 static void VideoReInitTextures()
@@ -1387,7 +1627,11 @@ static void VideoReInit()
 }
 /* == Render all videos ==================================================== */
 static void VideoRender()
-  { for(Video*const vVideo : *cVideos) vVideo->Render(); }
+{ // Record time spent rendering videos
+  const ProfileZone pzZone{ "VideoRender" };
+  // Render each video
+  for(Video*const vVideo : *cVideos) vVideo->Render();
+}
 /* == Update all streams base volume ======================================= */
 static void VideoCommitVolume()
   { for(Video*const vVideo : *cVideos) vVideo->CommitVolume(); }
@@ -1395,6 +1639,9 @@ static void VideoCommitVolume()
 static CVarReturn VideoSetIOBufferSize(const size_t stSize)
   { return CVarSimpleSetIntNLG(cVideos->stIOBufferSize,
       stSize, 4096UL, 16777216UL); }
+/* == Set demuxed page queue size ========================================== */
+static CVarReturn VideoSetPageQueueSize(const size_t stSize)
+  { return CVarSimpleSetIntNLG(cVideos->stPageQueue, stSize, 4UL, 4096UL); }
 /* == Set drift length maximum ============================================= */
 static CVarReturn VideoSetMaximumDrift(const double dMax)
   { return CVarSimpleSetIntNLG(cVideos->dMaxDrift, dMax, 0.01, 1.0); }
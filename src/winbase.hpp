@@ -629,6 +629,7 @@ class SysBase                          // Members initially private
       // Write engine log
       SEHSubTitle(osS, "Log");
         cLog->LogGetBufferLines(osS);
+        cLog->LogFlushSafe();
         osS << cCommon->CommonCrLf();
       // Write the final end-of-file label
       SEHSubTitle(osS, "End-of-File");